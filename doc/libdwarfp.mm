@@ -943,6 +943,69 @@ appears exactly once.
 On success it returns \f(CWDW_DLV_OK\fP.
 On error it returns \f(CWDW_DLV_ERROR\fP.
 
+.H 3 "dwarf_pro_set_section_write_callback()"
+
+.DS
+\f(CWint dwarf_pro_set_section_write_callback(
+    Dwarf_P_Debug dbg,
+    Dwarf_Section_Write_Func func,
+    void *user_data,
+    Dwarf_Error *error) \fP
+.DE
+.P
+The function
+\f(CWdwarf_pro_set_section_write_callback()\fP
+is new in October 2026.
+It turns on streaming output:
+\f(CWdwarf_transform_to_disk_form_a()\fP
+calls
+\f(CWfunc\fP
+with each piece of section data as it is
+finished instead of keeping every section in
+memory for
+\f(CWdwarf_get_section_bytes_a()\fP.
+.DS
+\f(CWtypedef int (*Dwarf_Section_Write_Func)(
+    Dwarf_Unsigned elf_section_index,
+    Dwarf_Ptr      section_bytes,
+    Dwarf_Unsigned length,
+    void *         user_data);\fP
+.DE
+.P
+The arguments mean the same as those returned by
+\f(CWdwarf_get_section_bytes_a()\fP
+and the pieces arrive in the same order.
+Each section is complete before the next generated
+section starts, and a large
+\f(CW.debug_info\fP
+is passed in pieces of about a megabyte.
+The bytes are freed when
+\f(CWfunc\fP
+returns, so it must copy or write them out.
+It returns
+\f(CWDW_DLV_OK\fP,
+or
+\f(CWDW_DLV_ERROR\fP
+to make
+\f(CWdwarf_transform_to_disk_form_a()\fP
+fail with
+\f(CWDW_DLE_SECTION_WRITE_ERR\fP.
+.P
+With streaming on
+\f(CWdwarf_transform_to_disk_form_a()\fP
+returns a chunk count of zero and
+\f(CWdwarf_get_section_bytes_a()\fP
+returns
+\f(CWDW_DLV_NO_ENTRY\fP.
+Relocations and other information are
+fetched as usual.
+Passing a NULL
+\f(CWfunc\fP
+turns streaming off.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+
 .H 3 "dwarf_transform_to_disk_form_a()"
 .DS
 \f(CWint dwarf_transform_to_disk_form_a(
@@ -324,6 +324,7 @@ static void arg_format_suppress_utf8(void);
 
 static void arg_print_section_allocations(void);
 static void arg_allocate_via_mmap(void);
+static void arg_allocate_via_mmap_whole(void);
 static void arg_format_file(void);
 static void arg_format_gcc(void);
 static void arg_format_groupnumber(void);
@@ -660,6 +661,12 @@ static const char *usage_long_text[] = {
 "     --show-dwarfdump-conf Show what dwarfdump.conf is being used.",
 "     --show-args    Show the  current date, time, library version,",
 "                    dwarfdump version, and command arguments.",
+"     --alloc-arena  Tells libdwarf to allocate DIEs,",
+"                    attributes, lines and other fixed-size",
+"                    records from large slabs, freed all",
+"                    at once by dwarf_finish().",
+"     --die-attr-cache Tells libdwarf to remember where",
+"                    each attribute of the current DIE is.",
 "     --suppress-de-alloc-tree Turns off the libdwarf-cleanup of",
 "                    libdwarf-allocated memory on calling",
 "                    dwarf_finish(). Used to test that",
@@ -681,6 +688,11 @@ static const char *usage_long_text[] = {
 "                    loading sections will be with mmap.",
 "                    See also environment variable",
 "                    DWARF_WHICH_ALLOC.",
+"     --allocate-via-mmap-whole  Map the entire object",
+"                    file once with mmap and use",
+"                    section data in place.",
+"                    See also environment variable",
+"                    DWARF_WHICH_ALLOC.",
 "",
 };
 
@@ -827,6 +839,9 @@ OPT_TRACE,                    /* -# --trace=<num>            */
 OPT_NO_DUP_ATTR_CHECK,        /*  --no-dup-attr-check  */
 OPT_ALLOC_TREE_OFF,           /* --suppress-de-alloc-tree */
 OPT_ALLOCATE_VIA_MMAP,        /* --allocate-via-mmap */
+OPT_ALLOCATE_VIA_MMAP_WHOLE,  /* --allocate-via-mmap-whole */
+OPT_ALLOC_ARENA,              /* --alloc-arena */
+OPT_DIE_ATTR_CACHE,           /* --die-attr-cache */
 OPT_END
 };
 
@@ -984,11 +999,15 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
 {"show-args",     dwno_argument, 0, OPT_SHOW_ARGS },
 {"no-dup-attr-check", dwno_argument, 0, OPT_NO_DUP_ATTR_CHECK },
 {"allocate-via-mmap", dwno_argument, 0, OPT_ALLOCATE_VIA_MMAP },
+{"allocate-via-mmap-whole", dwno_argument, 0,
+    OPT_ALLOCATE_VIA_MMAP_WHOLE },
 
 /* Trace. */
 {"trace", dwrequired_argument, 0, OPT_TRACE},
 
 {"suppress-de-alloc-tree",dwno_argument,0,OPT_ALLOC_TREE_OFF},
+{"alloc-arena",dwno_argument,0,OPT_ALLOC_ARENA},
+{"die-attr-cache",dwno_argument,0,OPT_DIE_ATTR_CACHE},
 {"suppress-harmless-errors",dwno_argument,0,OPT_SUPPRESS_HARMLESS},
 {0,0,0,0}
 };
@@ -2482,6 +2501,12 @@ static void arg_allocate_via_mmap(void)
     glflags.gf_allocation_via_mmap = TRUE;
     dwarf_set_load_preference(Dwarf_Alloc_Mmap);
 }
+/*  --allocate-via-mmap-whole */
+static void arg_allocate_via_mmap_whole(void)
+{
+    glflags.gf_allocation_via_mmap = TRUE;
+    dwarf_set_load_preference(Dwarf_Alloc_Mmap_Whole);
+}
 
 /*  Process the command line arguments and set the
     appropriate options. All
@@ -2717,6 +2742,17 @@ set_command_options(int argc, char *argv[])
         case OPT_ALLOCATE_VIA_MMAP:
             arg_allocate_via_mmap();
             break;
+        case OPT_ALLOCATE_VIA_MMAP_WHOLE:
+            arg_allocate_via_mmap_whole();
+            break;
+        case OPT_ALLOC_ARENA:
+            /*  Slab allocation of libdwarf records. */
+            dwarf_set_de_alloc_arena_flag(TRUE);
+            break;
+        case OPT_DIE_ATTR_CACHE:
+            /*  See dwarf_set_die_attr_offset_cache(). */
+            glflags.gf_die_attr_cache = TRUE;
+            break;
 
         default: arg_usage_error = TRUE; break;
         }
@@ -2748,10 +2784,13 @@ static const char *simplestdargs[] ={
 "--no-dup-form-check",
 "--verbose-more",
 "--suppress-de-alloc-tree",
+"--alloc-arena",
+"--die-attr-cache",
 "--suppress-debuglink-crc",
 "--no-follow-debuglink",
 "--no-dup-attr-check",
 "--allocate-via-mmap",
+"--allocate-via-mmap-whole",
 0
 };
 
@@ -86,6 +86,7 @@ init_global_flags(void)
         */
     glflags.gf_line_skeleton_flag = TRUE;
     glflags.gf_line_print_pc = TRUE;    /* Print <pc> addresses. */
+    glflags.gf_die_attr_cache = FALSE;
     glflags.gf_abbrev_flag = FALSE;
     glflags.gf_frame_flag = FALSE;      /* .debug_frame section. */
     glflags.gf_eh_frame_flag = FALSE;   /* GNU .eh_frame section. */
@@ -774,6 +774,9 @@ dbgsetup(Dwarf_Debug dbg,struct dwconf_s *setup_config_file_data)
             (Dwarf_Small)setup_config_file_data->cf_address_size);
     }
     dwarf_set_harmless_error_list_size(dbg,50);
+    if (glflags.gf_die_attr_cache) {
+        dwarf_set_die_attr_offset_cache(dbg,TRUE);
+    }
 }
 
 /*  Callable at any time, Sets section sizes with the sizes
@@ -1837,6 +1840,7 @@ process_one_file(
         printf("  Global preference for sections  : %s\n",
             pref == Dwarf_Alloc_Malloc?"Dwarf_Alloc_Malloc":
             pref == Dwarf_Alloc_Mmap?  "Dwarf_Alloc_Mmap":
+            pref == Dwarf_Alloc_Mmap_Whole?"Dwarf_Alloc_Mmap_Whole":
             "<Unknown. an ERROR");
     }
     if (glflags.gf_print_all_srcfiles) {
@@ -248,6 +248,13 @@ struct die_stack_data_s {
 };
 static struct die_stack_data_s empty_stack_entry;
 static struct die_stack_data_s die_stack[DIE_STACK_SIZE];
+/*  The DIEs of the tree walk, one per nesting level
+    for the first child and one for the later siblings,
+    reused for every DIE at that level so printing
+    a CU allocates no DIE per DIE.
+    print_die_and_children() frees them. */
+static Dwarf_Die level_child_die[DIE_STACK_SIZE+1];
+static Dwarf_Die level_sibling_die[DIE_STACK_SIZE+1];
 #define SET_DIE_STACK_ENTRY(i,x,o)                \
     { die_stack[(i)].die_ = (x);                  \
     die_stack[(i)].cu_die_offset_ = o;            \
@@ -1015,6 +1022,7 @@ print_die_and_children(Dwarf_Debug dbg,
     int             res = 0;
     Dwarf_Off     *offset_array = 0;
     Dwarf_Unsigned offset_count = 0;
+    int            i = 0;
 
     /* A CU_die has a single child */
     local_symbols_already_begun = FALSE;
@@ -1022,6 +1030,16 @@ print_die_and_children(Dwarf_Debug dbg,
         in_die_in, dieprint_cu_goffset, is_info,
         srcfiles,srcfiles_count,
         offset_array,offset_count,err);
+    for (i = 0; i <= DIE_STACK_SIZE; ++i) {
+        if (level_child_die[i]) {
+            dwarf_dealloc_die(level_child_die[i]);
+            level_child_die[i] = 0;
+        }
+        if (level_sibling_die[i]) {
+            dwarf_dealloc_die(level_sibling_die[i]);
+            level_sibling_die[i] = 0;
+        }
+    }
     return res;
 }
 
@@ -2030,6 +2048,9 @@ dd_validate_die_sibling(Dwarf_Debug dbg, Dwarf_Die sibling)
     For children of in_die we recurse on this function.
     We use a DIE_STACK to keep track of where
     we are in the current loop and in the recursion.
+    The DIEs come from level_child_die[] and
+    level_sibling_die[] and are never deallocated
+    here.
 */
 static int
 print_die_and_children_internal(Dwarf_Debug dbg,
@@ -2042,9 +2063,10 @@ print_die_and_children_internal(Dwarf_Debug dbg,
     Dwarf_Unsigned   sibling_off_count,
     Dwarf_Error     *err)
 {
-    Dwarf_Die sibling = 0;
     Dwarf_Die in_die = in_die_in;
     Dwarf_Unsigned loop_iteration = 0;
+    Dwarf_Die *siblingslot =
+        &level_sibling_die[die_stack_indent_level];
 
     /*  Loop through siblings of in_die_in */
     for (;;++loop_iteration) {
@@ -2053,6 +2075,8 @@ print_die_and_children_internal(Dwarf_Debug dbg,
         int       childres = 0;
         int       siblingres = 0;
         Dwarf_Die child = 0;
+        Dwarf_Die *childslot =
+            &level_child_die[die_stack_indent_level+1];
         int       pdacires = 0;
 
         /* Get the CU offset for easy error reporting */
@@ -2067,7 +2091,6 @@ print_die_and_children_internal(Dwarf_Debug dbg,
         res = dd_check_tag_tree(dbg,in_die,err);
         if (res != DW_DLV_OK){
             if (in_die != in_die_in) {
-                dwarf_dealloc_die(in_die);
                 return res;
             }
         }
@@ -2079,21 +2102,18 @@ print_die_and_children_internal(Dwarf_Debug dbg,
             dieprint_cu_goffset, srcfiles,srcfilescount,
             err);
         if (res != DW_DLV_OK) {
-            if (in_die != in_die_in) {
-                dwarf_dealloc_die(in_die);
-            }
             return res;
         }
-        childres = dwarf_child(in_die, &child, err);
+        childres = dwarf_child_reuse(in_die, childslot, err);
         if (childres == DW_DLV_ERROR) {
             print_error_and_continue(
                 "Call to dwarf_child failed printing die tree",
                 childres,*err);
-            if (in_die != in_die_in) {
-                dwarf_dealloc_die(in_die);
-            }
             return childres;
         }
+        if (childres == DW_DLV_OK) {
+            child = *childslot;
+        }
         /* Check for specific compiler, gf_check_abbreviations */
         if (glflags.gf_check_abbreviations &&
             checking_this_compiler()) {
@@ -2101,10 +2121,6 @@ print_die_and_children_internal(Dwarf_Debug dbg,
 
             cdares = dd_check_die_abbrevs(dbg, in_die,childres);
             if (cdares != DW_DLV_OK) {
-                dwarf_dealloc_die(child);
-                if (in_die != in_die_in) {
-                    dwarf_dealloc_die(in_die);
-                }
                 return cdares;
             }
         }
@@ -2115,18 +2131,10 @@ print_die_and_children_internal(Dwarf_Debug dbg,
             chkoffres = dwarf_check_child_offset(dbg,child,
                 err);
             if (chkoffres == DW_DLV_ERROR) {
-                dwarf_dealloc_die(child);
-                if (in_die != in_die_in) {
-                    dwarf_dealloc_die(in_die);
-                }
                 return chkoffres;
             }
             if ((1+die_stack_indent_level) >= DIE_STACK_SIZE ) {
                 report_die_stack_error(dbg,err);
-                if (in_die != in_die_in) {
-                    dwarf_dealloc_die(in_die);
-                }
-                dwarf_dealloc_die(child);
                 return DW_DLV_ERROR;
             }
             /*  Use DIE_STACK to process children
@@ -2153,16 +2161,12 @@ print_die_and_children_internal(Dwarf_Debug dbg,
             }
 
             EMPTY_DIE_STACK_ENTRY(die_stack_indent_level);
-            dwarf_dealloc_die(child);
             child = 0;
             /*  Unwind DIE_STACK one level to get
                 back to our sibling list to process the
                 next sibling at our level. */
             die_stack_indent_level--;
             if (pdacires == DW_DLV_ERROR) {
-                if (in_die != in_die_in) {
-                    dwarf_dealloc_die(in_die);
-                }
                 return pdacires;
             }
         } /* End processing child */
@@ -2173,19 +2177,16 @@ print_die_and_children_internal(Dwarf_Debug dbg,
             glflags.gf_info_flag = FALSE;
             glflags.gf_types_flag = FALSE;
         }
-        sibling = 0;
-        dwarf_dealloc_die(child);
-        child = 0;
-        /*  Find the next sibling or get DW_DLV_NO_ENTRY */
-        siblingres = dwarf_siblingof_c(in_die, &sibling, err);
+        /*  Find the next sibling or get DW_DLV_NO_ENTRY.
+            After the first sibling in_die is *siblingslot
+            and simply moves along the list. */
+        siblingres = dwarf_siblingof_reuse(in_die, siblingslot,
+            err);
         if (siblingres == DW_DLV_ERROR) {
             print_error_and_continue(
                 "ERROR: dwarf_siblingof fails"
                 " tracing siblings of a DIE.",
                 siblingres, *err);
-            if (in_die != in_die_in) {
-                dwarf_dealloc_die(in_die);
-            }
             return siblingres;
         }
         /*  If we have a sibling, verify that its offset
@@ -2194,28 +2195,18 @@ print_die_and_children_internal(Dwarf_Debug dbg,
         if (siblingres == DW_DLV_OK &&
             glflags.gf_check_di_gaps &&
             checking_this_compiler()) {
-            dd_validate_die_sibling(dbg,sibling);
+            dd_validate_die_sibling(dbg,*siblingslot);
         }
 
         /*  Here do any post-descent (ie post-dwarf_child)
             processing of the in_die (we prepare
             to loop again). */
         EMPTY_DIE_STACK_ENTRY(die_stack_indent_level);
-        if (in_die != in_die_in) {
-            /*  Dealloc our in_die, but not the
-                argument die, it belongs
-                to our caller. Whether the siblingof
-                call worked or not. */
-            dwarf_dealloc_die(in_die);
-            in_die = 0;
-        }
         if (siblingres == DW_DLV_OK) {
             /*  Set to process the sibling, loop again. */
-            in_die = sibling;
-            sibling = 0;
+            in_die = *siblingslot;
         } else {
             /* ASSERT: siblingres is DW_DLV_NO_ENTRY  */
-            sibling = 0;
             in_die = 0;
             /*  We are done, no more siblings at this level. */
             check_sibling_offset_list_count(loop_iteration,
@@ -160,6 +160,7 @@ using std::string;
 using std::cout;
 using std::endl;
 using std::vector;
+using std::list;
 extern "C" {
 static int CallbackFunc(
     const char* name,
@@ -269,6 +270,8 @@ static void           create_text_section(void);
 static Dwarf_Unsigned create_namestr_section(void);
 static void           write_generated_dbg(Dwarf_P_Debug dbg,
     IRepresentation &irep);
+static int            StreamDataIntoElf(Dwarf_Unsigned,
+    Dwarf_Ptr,Dwarf_Unsigned,void *);
 
 static string outfile("testout.o");
 static string infile;
@@ -299,7 +302,8 @@ CmdOptions cmdoptions = {
     false, //addSUNfuncoffsets
     false, //add_debug_sup
     false, //addskipbranch
-    false //addlanguageversion
+    false, //addlanguageversion
+    false //streamoutput
 };
 
 // loff_t is signed for some reason (strange)
@@ -713,6 +717,7 @@ main(int argc, char **argv)
             {"high-pc-as-const",dwno_argument,0,'h'},
             {"add-skip-branch-ops",dwno_argument,0,1007},
             {"add-language-version",dwno_argument,0,1008},
+            {"stream-output",dwno_argument,0,1009},
             {0,0,0,0},
         };
         // -p is pointer size
@@ -775,6 +780,12 @@ main(int argc, char **argv)
                 //{"add-language-version",dwno_argument,0,1008},
                 cmdoptions.addlanguageversion = true;
                 break;
+            case 1009:
+                //{"stream-output",dwno_argument,0,1009},
+                // To test dwarf_pro_set_section_write_callback().
+                // The object written should not change.
+                cmdoptions.streamoutput = true;
+                break;
             case 'c':
                 // At present we can only create a single
                 // cu in the output of the libdwarf producer.
@@ -932,6 +943,15 @@ main(int argc, char **argv)
                 "dwarf_pro_set_default_string_form" << endl;
             exit(EXIT_FAILURE);
         }
+        if (cmdoptions.streamoutput) {
+            res = dwarf_pro_set_section_write_callback(dbg,
+                StreamDataIntoElf,0,&err);
+            if (res != DW_DLV_OK) {
+                cout << "dwarfgen: Failed " <<
+                    "dwarf_pro_set_section_write_callback" << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
         if (force_empty_dnames) {
             /*  Fills out a default dnames for testing. */
             res = dwarf_force_dnames(dbg,0,&err);
@@ -1161,6 +1181,33 @@ InsertDataIntoElf(Dwarf_Unsigned d,Dwarf_P_Debug dbg)
     return;
 }
 
+// With --stream-output the producer hands us the same
+// blocks InsertDataIntoElf() would fetch, as it makes them.
+// The producer frees each block when we return, so
+// keep a copy. A list so the copies never move.
+static list<vector<unsigned char> > streamedblocks;
+static int
+StreamDataIntoElf(Dwarf_Unsigned dw_section_index,
+    Dwarf_Ptr bytes,Dwarf_Unsigned length,
+    void *user_data)
+{
+    (void)user_data;
+    if (dw_section_index >= dwsectab.size()) {
+        cout << "dwarfgen: streamed bytes for unknown section "
+            << dw_section_index << endl;
+        return DW_DLV_ERROR;
+    }
+    unsigned char *b = static_cast<unsigned char *>(bytes);
+    streamedblocks.push_back(vector<unsigned char>(b,b+length));
+    SectionForDwarf &ds = dwsectab[dw_section_index];
+    ds.add_section_content(length?&streamedblocks.back()[0]:b,
+        length);
+    cout << "Inserted " << length <<
+        " bytes into elf section index "
+        << dw_section_index << endl;
+    return DW_DLV_OK;
+}
+
 #if 0
 {
     if (!scn) {
@@ -49,6 +49,7 @@ extern struct CmdOptions {
     bool adddebugsup;
     bool addskipbranch;
     bool addlanguageversion;
+    bool streamoutput;
 } cmdoptions;
 
 template <typename T >
@@ -80,6 +80,7 @@
 #include "dwarf_dsc.h"
 #include "dwarf_string.h"
 #include "dwarf_str_offsets.h"
+#include "dwarf_decompress_cache.h"
 
 /* if DEBUG_ALLOC is defined a lot of stdout is generated here. */
 #undef DEBUG_ALLOC
@@ -137,6 +138,22 @@ int dwarf_set_de_alloc_flag(int v)
     return ov;
 }
 
+/*  If non-zero then each Dwarf_Debug created afterwards
+    carves fixed-size records (DIEs, attributes,
+    lines, CU contexts and the like) out of
+    per-type slabs instead of malloc()
+    and the slabs are freed in bulk by dwarf_finish().
+    Defaults to zero. */
+static signed char global_de_alloc_arena_on = 0;
+
+/*  Returns the value the flag was before this call. */
+int dwarf_set_de_alloc_arena_flag(int v)
+{
+    int ov = global_de_alloc_arena_on;
+    global_de_alloc_arena_on = (char)v;
+    return ov;
+}
+
 void
 _dwarf_error_destructor(void *m)
 {
@@ -175,6 +192,39 @@ struct reserve_data_s {
 };
 #define DW_RESERVE sizeof(struct reserve_size_s)
 
+/*  An object carved from an arena slab has this bit
+    set in rd_type.  Such an object is never
+    passed to free(), dwarf_dealloc() puts it on
+    the free list of its type instead. */
+#define DW_RESERVE_ARENA_FLAG 0x8000
+#define DW_RESERVE_TYPE_MASK  0x7fff
+
+/*  A slab holds as many objects as fit in about
+    this many bytes, but never fewer than
+    DW_ARENA_SLAB_MIN_OBJECTS. */
+#define DW_ARENA_SLAB_TARGET      32768
+#define DW_ARENA_SLAB_MIN_OBJECTS 8
+
+/*  One of these per DW_DLA type in each Dwarf_Debug.
+    The counts are kept whether or not the
+    arena is in use. */
+struct Dwarf_Alloc_Type_s {
+    Dwarf_Unsigned at_live_count;
+    Dwarf_Unsigned at_total_count;
+    Dwarf_Unsigned at_total_bytes;
+
+    /*  The remaining fields are only used when
+        de_alloc_arena_on is set. at_slab_list
+        chains the slabs through the first pointer of each.
+        at_free_list chains dealloc-ed objects through
+        the first bytes after their reserve area. */
+    Dwarf_Unsigned at_arena_bytes;
+    char *at_slab_list;
+    char *at_slab_next;
+    char *at_slab_end;
+    char *at_free_list;
+};
+
 /*  In rare cases (bad object files) an error is created
     via malloc with no dbg to attach it to.
     We do not expect this except on corrupt objects.
@@ -607,6 +657,113 @@ simple_compare_function(const void *l, const void *r)
     return 0;
 }
 
+/*  Only fixed-size records with no constructor
+    or destructor are taken from an arena. */
+static int
+arena_type_eligible(unsigned int type)
+{
+    const struct ial_s *ia = &alloc_instance_basics[type];
+
+    if (ia->ia_multiply_count != MULTIPLY_NO) {
+        return FALSE;
+    }
+    if (ia->specialconstructor || ia->specialdestructor) {
+        return FALSE;
+    }
+    if (ia->ia_struct_size < (short)sizeof(void *)) {
+        /*  Placeholder table entries, and the free
+            list link needs room. */
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*  Returns zeroed space of size bytes (which includes
+    DW_RESERVE) or NULL if out of memory. */
+static char *
+arena_get_space(struct Dwarf_Alloc_Type_s *at,
+    Dwarf_Unsigned size)
+{
+    char *mem = 0;
+    Dwarf_Unsigned slot = 0;
+
+    /*  Round so every object stays aligned as
+        well as malloc() would align it. */
+    slot = (size + DW_RESERVE - 1) / DW_RESERVE * DW_RESERVE;
+    if (at->at_free_list) {
+        mem = at->at_free_list;
+        memcpy(&at->at_free_list,mem + DW_RESERVE,
+            sizeof(at->at_free_list));
+    } else {
+        if (!at->at_slab_next ||
+            (Dwarf_Unsigned)(at->at_slab_end - at->at_slab_next)
+            < slot) {
+            Dwarf_Unsigned count = DW_ARENA_SLAB_TARGET/slot;
+            Dwarf_Unsigned slabsize = 0;
+            char *slab = 0;
+
+            if (count < DW_ARENA_SLAB_MIN_OBJECTS) {
+                count = DW_ARENA_SLAB_MIN_OBJECTS;
+            }
+            /*  The first DW_RESERVE bytes hold the chain
+                pointer to the previous slab. */
+            slabsize = DW_RESERVE + count*slot;
+            slab = malloc((size_t)slabsize);
+            if (!slab) {
+                return NULL;
+            }
+            memcpy(slab,&at->at_slab_list,sizeof(at->at_slab_list));
+            at->at_slab_list = slab;
+            at->at_slab_next = slab + DW_RESERVE;
+            at->at_slab_end = slab + slabsize;
+            at->at_arena_bytes += slabsize;
+        }
+        mem = at->at_slab_next;
+        at->at_slab_next += slot;
+    }
+    memset(mem, 0, (size_t)size);
+    return mem;
+}
+
+/*  Put an arena object back on the free list of its type. */
+static void
+arena_release_space(struct Dwarf_Alloc_Type_s *at, char *mem)
+{
+    memcpy(mem + DW_RESERVE,&at->at_free_list,
+        sizeof(at->at_free_list));
+    at->at_free_list = mem;
+}
+
+/*  Frees every slab at once, whatever objects
+    in them are still live. */
+static void
+arena_free_all(Dwarf_Debug dbg)
+{
+    unsigned int i = 0;
+
+    if (!dbg->de_alloc_types) {
+        return;
+    }
+    for ( ; i < ALLOC_AREA_INDEX_TABLE_MAX; ++i) {
+        struct Dwarf_Alloc_Type_s *at = &dbg->de_alloc_types[i];
+        char *slab = at->at_slab_list;
+
+        while (slab) {
+            char *next = 0;
+
+            memcpy(&next,slab,sizeof(next));
+            free(slab);
+            slab = next;
+        }
+        at->at_slab_list = 0;
+        at->at_slab_next = 0;
+        at->at_slab_end = 0;
+        at->at_free_list = 0;
+    }
+    free(dbg->de_alloc_types);
+    dbg->de_alloc_types = 0;
+}
+
 /*  This function returns a pointer to a region
     of memory.  For alloc_types that are not
     strings or lists of pointers, only 1 struct
@@ -632,6 +789,8 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
     Dwarf_Unsigned size = 0;
     unsigned int type = alloc_type;
     short action = 0;
+    struct Dwarf_Alloc_Type_s *at = 0;
+    int in_arena = FALSE;
 
     if (IS_INVALID_DBG(dbg)) {
 #if DEBUG_ALLOC
@@ -669,7 +828,17 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
             sizeof(Dwarf_Addr) : sizeof(Dwarf_Off));
     }
     size += DW_RESERVE;
-    alloc_mem = malloc(size);
+    if (dbg->de_alloc_types) {
+        at = &dbg->de_alloc_types[type];
+        if (dbg->de_alloc_arena_on && arena_type_eligible(type)) {
+            in_arena = TRUE;
+        }
+    }
+    if (in_arena) {
+        alloc_mem = arena_get_space(at,size);
+    } else {
+        alloc_mem = malloc(size);
+    }
     if (!alloc_mem) {
         return NULL;
     }
@@ -679,10 +848,15 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
         struct reserve_data_s *r = (struct reserve_data_s*)alloc_mem;
         void *result = 0;
 
-        memset(alloc_mem, 0, size);
+        if (!in_arena) {
+            memset(alloc_mem, 0, size);
+        }
         /* We are not actually using rd_dbg, we are using rd_type. */
         r->rd_dbg = dbg;
         r->rd_type = (unsigned short)alloc_type;
+        if (in_arena) {
+            r->rd_type |= DW_RESERVE_ARENA_FLAG;
+        }
         /*  The following is wrong for large records, but
             it's not important, so let it be truncated.*/
         r->rd_length = (unsigned short)size;
@@ -708,10 +882,17 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
             is unable to free anything the caller
             omitted to dealloc. Normally
             the global flag is non-zero */
+        if (at) {
+            at->at_live_count++;
+            at->at_total_count++;
+            at->at_total_bytes += size - DW_RESERVE;
+        }
         /*  As of March 14, 2020 it's
             not necessary to test for alloc type, but instead
-            only call tsearch if de_alloc_tree_on. */
-        if (global_de_alloc_tree_on) {
+            only call tsearch if de_alloc_tree_on.
+            Arena objects are never in de_alloc_tree,
+            dwarf_finish() frees their slabs instead. */
+        if (global_de_alloc_tree_on && !in_arena) {
             result = dwarf_tsearch((void *)key,
                 &dbg->de_alloc_tree,simple_compare_function);
             if (!result) {
@@ -784,6 +965,7 @@ dwarf_set_load_preference(
     switch(dw_load_preference) {
     case  Dwarf_Alloc_Malloc:
     case  Dwarf_Alloc_Mmap:
+    case  Dwarf_Alloc_Mmap_Whole:
         _dwarf_global_load_preference = dw_load_preference;
         break;
     case  Dwarf_Alloc_None:
@@ -846,6 +1028,41 @@ dwarf_get_mmap_count(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+int
+dwarf_get_alloc_type_counts(Dwarf_Debug dbg,
+    Dwarf_Unsigned  alloc_type,
+    Dwarf_Unsigned *live_count,
+    Dwarf_Unsigned *total_count,
+    Dwarf_Unsigned *total_bytes,
+    Dwarf_Unsigned *arena_bytes)
+{
+    struct Dwarf_Alloc_Type_s *at = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return DW_DLV_ERROR;
+    }
+    if (!alloc_type || alloc_type >= ALLOC_AREA_INDEX_TABLE_MAX) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!dbg->de_alloc_types) {
+        return DW_DLV_NO_ENTRY;
+    }
+    at = &dbg->de_alloc_types[alloc_type];
+    if (live_count) {
+        *live_count = at->at_live_count;
+    }
+    if (total_count) {
+        *total_count = at->at_total_count;
+    }
+    if (total_bytes) {
+        *total_bytes = at->at_total_bytes;
+    }
+    if (arena_bytes) {
+        *arena_bytes = at->at_arena_bytes;
+    }
+    return DW_DLV_OK;
+}
+
 enum Dwarf_Sec_Alloc_Pref
 _dwarf_determine_section_allocation_type(void)
 {
@@ -855,6 +1072,10 @@ _dwarf_determine_section_allocation_type(void)
     char *whichalloc = getenv("DWARF_WHICH_ALLOC");
 
     if (whichalloc) {
+        if (!strcmp(whichalloc,"mmap-whole")) {
+            dwarf_set_load_preference(Dwarf_Alloc_Mmap_Whole);
+            return Dwarf_Alloc_Mmap_Whole;
+        }
         if (!strcmp(whichalloc,"mmap")) {
             dwarf_set_load_preference(Dwarf_Alloc_Mmap);
             return Dwarf_Alloc_Mmap;
@@ -955,6 +1176,8 @@ dwarf_dealloc(Dwarf_Debug dbg,
     unsigned int type = 0;
     char * malloc_addr = 0;
     struct reserve_data_s * r = 0;
+    unsigned int rtype = 0;
+    int in_arena = FALSE;
 
     if (!space) {
 #ifdef DEBUG_ALLOC
@@ -987,6 +1210,18 @@ dwarf_dealloc(Dwarf_Debug dbg,
         return;
 #endif /* DEBUG_ALLOC*/
     }
+    if (alloc_type == DW_DLA_LINE) {
+        /*  A Dwarf_Line is a row of its line table
+            array (see dwarf_line.h), it has no
+            reserve header to read.  The rows are
+            freed with their Dwarf_Line_Context. */
+#ifdef DEBUG_ALLOC
+        printf("DEALLOC DW_DLA_LINE does nothing "
+            "line %d %s\n", __LINE__,__FILE__);
+        fflush(stdout);
+#endif /* DEBUG_ALLOC*/
+        return;
+    }
     if (dbg && alloc_type == DW_DLA_ERROR) {
         dbg = dbg->de_errors_dbg;
     }
@@ -1026,6 +1261,10 @@ dwarf_dealloc(Dwarf_Debug dbg,
         return;
     }
     r =(struct reserve_data_s *)malloc_addr;
+    rtype = r->rd_type & DW_RESERVE_TYPE_MASK;
+    if (r->rd_type & DW_RESERVE_ARENA_FLAG) {
+        in_arena = TRUE;
+    }
     if (dbg && dbg != r->rd_dbg) {
         /*  Mixed up or originally a no_dbg alloc */
 #ifdef DEBUG_ALLOC
@@ -1038,7 +1277,7 @@ dwarf_dealloc(Dwarf_Debug dbg,
         fflush(stdout);
 #endif /* DEBUG_ALLOC*/
     }
-    if (dbg && alloc_type != r->rd_type) {
+    if (dbg && alloc_type != rtype) {
         /*  Something is mixed up. */
 #ifdef DEBUG_ALLOC
         printf("DEALLOC does nothing, type 0x%lx rd_type 0x%lx"
@@ -1113,7 +1352,7 @@ dwarf_dealloc(Dwarf_Debug dbg,
     if (alloc_instance_basics[type].specialdestructor) {
         alloc_instance_basics[type].specialdestructor(space);
     }
-    if (dbg && dbg->de_alloc_tree) {
+    if (dbg && dbg->de_alloc_tree && !in_arena) {
         /*  The 'space' pointer we get points after the
             reserve space.  The key is 'space'
             and address to free
@@ -1132,6 +1371,22 @@ dwarf_dealloc(Dwarf_Debug dbg,
             In any case, we simply don't worry about it.
             Not Supposed To Happen. */
     }
+    if (in_arena) {
+        /*  Goes back to the arena of the Dwarf_Debug
+            that allocated it. */
+        Dwarf_Debug owner = (Dwarf_Debug)r->rd_dbg;
+        struct Dwarf_Alloc_Type_s *at = &owner->de_alloc_types[type];
+
+        at->at_live_count--;
+        r->rd_dbg  = (void *)(uintptr_t)0xfeadbeef;
+        r->rd_length = 0;
+        r->rd_type = 0;
+        arena_release_space(at,malloc_addr);
+        return;
+    }
+    if (dbg && dbg == r->rd_dbg && dbg->de_alloc_types) {
+        dbg->de_alloc_types[type].at_live_count--;
+    }
     r->rd_dbg  = (void *)(uintptr_t)0xfeadbeef;
     r->rd_length = 0;
     r->rd_type = 0;
@@ -1155,6 +1410,14 @@ _dwarf_get_debug(Dwarf_Unsigned filesize)
     memset(dbg, 0, sizeof(struct Dwarf_Debug_s));
     /* Set up for a dwarf_tsearch hash table */
     dbg->de_magic = DBG_IS_VALID;
+    /*  If this calloc fails we simply have no
+        allocation counts and no arena. */
+    dbg->de_alloc_types = (struct Dwarf_Alloc_Type_s *)
+        calloc(ALLOC_AREA_INDEX_TABLE_MAX,
+        sizeof(struct Dwarf_Alloc_Type_s));
+    if (dbg->de_alloc_types && global_de_alloc_arena_on) {
+        dbg->de_alloc_arena_on = TRUE;
+    }
 
     /*  See also dwarf_tsearchhash.c the prime number
         table 'primes[]'. */
@@ -1188,6 +1451,12 @@ _dwarf_malloc_section_free(struct Dwarf_Section_s * sec)
     /*  Compressed sections will be malloc not mmap
         by the time we get here.
         No matter what the preference was.  */
+    if (sec->dss_dcache_entry) {
+        /* The cache owns the data, not this section. */
+        _dwarf_dcache_release(sec->dss_dcache_entry);
+        sec->dss_dcache_entry = 0;
+        sec->dss_was_alloc = FALSE;
+    }
     switch(sec->dss_actual_load_type) {
     case Dwarf_Alloc_Malloc:
         if (sec->dss_was_alloc) {
@@ -1228,22 +1497,24 @@ freecontextlist(Dwarf_Debug dbg, Dwarf_Debug_InfoTypes dis)
     Dwarf_CU_Context nextcontext = 0;
     for (context = dis->de_cu_context_list;
         context; context = nextcontext) {
-        Dwarf_Hash_Table hash_table = 0;
-
-        hash_table = context->cc_abbrev_hash_table;
-
-        _dwarf_free_abbrev_hash_table_contents(hash_table,
-            FALSE);
-        hash_table->tb_entries = 0;
         nextcontext = context->cc_next;
         context->cc_next = 0;
-        /*  See also  local_dealloc_cu_context() in
+        /*  The abbrev table is shared, it is freed by
+            _dwarf_destroy_abbrev_tables().
+            See also  local_dealloc_cu_context() in
             dwarf_die_deliv.c */
-        free(hash_table);
         context->cc_abbrev_hash_table = 0;
         dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
     }
     dis->de_cu_context_list = 0;
+    free(dis->de_cu_context_index);
+    dis->de_cu_context_index = 0;
+    dis->de_cu_context_index_count = 0;
+    dis->de_cu_context_index_size = 0;
+    free(dis->de_sig_hash);
+    dis->de_sig_hash = 0;
+    dis->de_sig_hash_count = 0;
+    dis->de_sig_hash_size = 0;
 }
 
 /*
@@ -1283,6 +1554,11 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     }
     freecontextlist(dbg,&dbg->de_info_reading);
     freecontextlist(dbg,&dbg->de_types_reading);
+    _dwarf_destroy_abbrev_tables(dbg);
+    free(dbg->de_die_attr_cache.dac_form);
+    free(dbg->de_die_attr_cache.dac_offset);
+    dbg->de_die_attr_cache.dac_form = 0;
+    dbg->de_die_attr_cache.dac_offset = 0;
     /* Housecleaning done. Now really free all the space. */
     _dwarf_malloc_section_free(&dbg->de_debug_info);
     _dwarf_malloc_section_free(&dbg->de_debug_types);
@@ -1341,6 +1617,9 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
             _dwarf_tied_destroy_free_node);
         dbg->de_tied_data.td_tied_search = 0;
     }
+    /*  Everything that could dealloc an arena
+        object is done, so free all the slabs. */
+    arena_free_all(dbg);
     free((void *)dbg->de_path);
     dbg->de_path = 0;
     for (g = 0; g < dbg->de_gnu_global_path_count; ++g) {
@@ -32,6 +32,7 @@
 
 #include <stddef.h> /* NULL size_t */
 #include <stdio.h> /* debug printf */
+#include <stdlib.h> /* calloc() free() qsort() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -596,6 +597,316 @@ dwarf_get_arange(Dwarf_Arange * aranges,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  For building a Dwarf_Arange_Index: one non-empty
+    arange, remembering its position in the caller's
+    array as dwarf_get_arange() prefers earlier entries. */
+struct ai_build_s {
+    Dwarf_Addr     ab_low;
+    Dwarf_Addr     ab_high;
+    Dwarf_Unsigned ab_order;
+    Dwarf_Arange   ab_arange;
+};
+
+static int
+ai_build_compare(const void *l, const void *r)
+{
+    const struct ai_build_s *lp = l;
+    const struct ai_build_s *rp = r;
+
+    if (lp->ab_low < rp->ab_low) {
+        return -1;
+    }
+    if (lp->ab_low > rp->ab_low) {
+        return 1;
+    }
+    if (lp->ab_order < rp->ab_order) {
+        return -1;
+    }
+    if (lp->ab_order > rp->ab_order) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  A binary heap of indexes into the sorted
+    build array, smallest ab_order at the top:
+    the arange dwarf_get_arange() would return
+    among those covering the current address. */
+static void
+ai_heap_push(Dwarf_Unsigned *heap, Dwarf_Unsigned *count,
+    struct ai_build_s *b, Dwarf_Unsigned val)
+{
+    Dwarf_Unsigned k = *count;
+
+    ++*count;
+    while (k > 0) {
+        Dwarf_Unsigned parent = (k-1)/2;
+
+        if (b[heap[parent]].ab_order <= b[val].ab_order) {
+            break;
+        }
+        heap[k] = heap[parent];
+        k = parent;
+    }
+    heap[k] = val;
+}
+
+static void
+ai_heap_pop(Dwarf_Unsigned *heap, Dwarf_Unsigned *count,
+    struct ai_build_s *b)
+{
+    Dwarf_Unsigned k = 0;
+    Dwarf_Unsigned n = --*count;
+    Dwarf_Unsigned last = heap[n];
+
+    for (;;) {
+        Dwarf_Unsigned child = 2*k + 1;
+
+        if (child >= n) {
+            break;
+        }
+        if (child+1 < n && b[heap[child+1]].ab_order <
+            b[heap[child]].ab_order) {
+            ++child;
+        }
+        if (b[last].ab_order <= b[heap[child]].ab_order) {
+            break;
+        }
+        heap[k] = heap[child];
+        k = child;
+    }
+    heap[k] = last;
+}
+
+/*  Builds a sorted array of disjoint address ranges
+    from an arange array so lookups are a binary search.
+    Where aranges overlap the index records the earliest
+    in the array, which is the one dwarf_get_arange()
+    would return, so the answers are the same. */
+int
+dwarf_make_arange_index(Dwarf_Arange *aranges,
+    Dwarf_Signed arange_count,
+    Dwarf_Arange_Index *index_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Arange_Index_s *ai = 0;
+    struct ai_build_s *b = 0;
+    Dwarf_Unsigned *heap = 0;
+    Dwarf_Unsigned heapcount = 0;
+    Dwarf_Unsigned bcount = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Addr pos = 0;
+
+    if (!aranges || arange_count < 0 || !index_out) {
+        _dwarf_error(NULL, error, DW_DLE_ARANGES_NULL);
+        return DW_DLV_ERROR;
+    }
+    ai = (struct Dwarf_Arange_Index_s *)calloc(1,
+        sizeof(struct Dwarf_Arange_Index_s));
+    if (!ai) {
+        _dwarf_error_string(NULL, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating a Dwarf_Arange_Index");
+        return DW_DLV_ERROR;
+    }
+    if (!arange_count) {
+        *index_out = ai;
+        return DW_DLV_OK;
+    }
+    b = (struct ai_build_s *)calloc((size_t)arange_count,
+        sizeof(struct ai_build_s));
+    heap = (Dwarf_Unsigned *)calloc((size_t)arange_count,
+        sizeof(Dwarf_Unsigned));
+    /*  n ranges have at most 2n boundaries so
+        at most 2n-1 pieces. */
+    ai->ai_entries = (struct Dwarf_Arange_Index_Entry_s *)
+        calloc((size_t)arange_count*2,
+        sizeof(struct Dwarf_Arange_Index_Entry_s));
+    if (!b || !heap || !ai->ai_entries) {
+        free(b);
+        free(heap);
+        dwarf_dealloc_arange_index(ai);
+        _dwarf_error_string(NULL, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating Dwarf_Arange_Index"
+            " entries");
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < (Dwarf_Unsigned)arange_count; ++i) {
+        Dwarf_Arange ar = aranges[i];
+        Dwarf_Addr high = 0;
+
+        if (!ar) {
+            free(b);
+            free(heap);
+            dwarf_dealloc_arange_index(ai);
+            _dwarf_error(NULL, error, DW_DLE_ARANGE_NULL);
+            return DW_DLV_ERROR;
+        }
+        high = ar->ar_address + ar->ar_length;
+        if (high <= ar->ar_address) {
+            /*  Empty, or wraps around so that
+                dwarf_get_arange() never matches it. */
+            continue;
+        }
+        b[bcount].ab_low = ar->ar_address;
+        b[bcount].ab_high = high;
+        b[bcount].ab_order = i;
+        b[bcount].ab_arange = ar;
+        ++bcount;
+    }
+    qsort(b,(size_t)bcount,sizeof(struct ai_build_s),
+        ai_build_compare);
+
+    /*  Sweep the boundaries in address order. Between
+        two boundaries the covering arange earliest in
+        the caller's array is at the top of the heap.
+        Aranges already ended are dropped when
+        they reach the top. */
+    i = 0;
+    while (i < bcount || heapcount) {
+        struct ai_build_s *top = 0;
+        Dwarf_Addr next = 0;
+
+        if (!heapcount) {
+            pos = b[i].ab_low;
+        }
+        while (i < bcount && b[i].ab_low <= pos) {
+            ai_heap_push(heap,&heapcount,b,i);
+            ++i;
+        }
+        while (heapcount && b[heap[0]].ab_high <= pos) {
+            ai_heap_pop(heap,&heapcount,b);
+        }
+        if (!heapcount) {
+            continue;
+        }
+        top = &b[heap[0]];
+        next = top->ab_high;
+        if (i < bcount && b[i].ab_low < next) {
+            next = b[i].ab_low;
+        }
+        if (ai->ai_count &&
+            ai->ai_entries[ai->ai_count-1].ae_high == pos &&
+            ai->ai_entries[ai->ai_count-1].ae_arange ==
+            top->ab_arange) {
+            ai->ai_entries[ai->ai_count-1].ae_high = next;
+        } else {
+            struct Dwarf_Arange_Index_Entry_s *e =
+                &ai->ai_entries[ai->ai_count];
+
+            e->ae_low = pos;
+            e->ae_high = next;
+            e->ae_arange = top->ab_arange;
+            ++ai->ai_count;
+        }
+        pos = next;
+    }
+    free(b);
+    free(heap);
+    *index_out = ai;
+    return DW_DLV_OK;
+}
+
+/*  Index of the first entry ending above address,
+    ai_count if none. As the entries are disjoint and
+    sorted their ae_high values are sorted too. */
+static Dwarf_Unsigned
+ai_first_above(Dwarf_Arange_Index ai,
+    Dwarf_Unsigned lo,
+    Dwarf_Addr address)
+{
+    Dwarf_Unsigned hi = ai->ai_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (ai->ai_entries[mid].ae_high <= address) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+int
+dwarf_lookup_arange_index(Dwarf_Arange_Index ai,
+    Dwarf_Addr address,
+    Dwarf_Arange *returned_arange,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned k = 0;
+
+    if (!ai || !returned_arange) {
+        _dwarf_error(NULL, error, DW_DLE_ARANGES_NULL);
+        return DW_DLV_ERROR;
+    }
+    k = ai_first_above(ai,0,address);
+    if (k < ai->ai_count &&
+        ai->ai_entries[k].ae_low <= address) {
+        *returned_arange = ai->ai_entries[k].ae_arange;
+        return DW_DLV_OK;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  With sorted addresses this is a merge of the two
+    sorted lists. An address lower than the one before
+    it just costs a binary search. */
+int
+dwarf_lookup_arange_index_batch(Dwarf_Arange_Index ai,
+    Dwarf_Addr *addresses,
+    Dwarf_Unsigned address_count,
+    Dwarf_Arange *returned_aranges,
+    Dwarf_Unsigned *found_count,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned k = 0;
+    Dwarf_Unsigned found = 0;
+
+    if (!ai || (address_count &&
+        (!addresses || !returned_aranges))) {
+        _dwarf_error(NULL, error, DW_DLE_ARANGES_NULL);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < address_count; ++i) {
+        Dwarf_Addr address = addresses[i];
+
+        if (i && address < addresses[i-1]) {
+            k = ai_first_above(ai,0,address);
+        } else {
+            /*  Usually a few steps or none. */
+            while (k < ai->ai_count &&
+                ai->ai_entries[k].ae_high <= address) {
+                ++k;
+            }
+        }
+        if (k < ai->ai_count &&
+            ai->ai_entries[k].ae_low <= address) {
+            returned_aranges[i] = ai->ai_entries[k].ae_arange;
+            ++found;
+        } else {
+            returned_aranges[i] = 0;
+        }
+    }
+    if (found_count) {
+        *found_count = found;
+    }
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_arange_index(Dwarf_Arange_Index ai)
+{
+    if (!ai) {
+        return;
+    }
+    free(ai->ai_entries);
+    ai->ai_entries = 0;
+    ai->ai_count = 0;
+    free(ai);
+}
+
 /*
     This function takes an Dwarf_Arange,
     and returns the offset of the first
@@ -52,6 +52,22 @@ struct Dwarf_Arange_s {
     Dwarf_Half ar_segment_selector_size;
 };
 
+/*  One piece of a Dwarf_Arange_Index: the addresses
+    ae_low up to (not including) ae_high are in
+    ae_arange. */
+struct Dwarf_Arange_Index_Entry_s {
+    Dwarf_Addr   ae_low;
+    Dwarf_Addr   ae_high;
+    Dwarf_Arange ae_arange;
+};
+
+/*  Disjoint pieces sorted by address,
+    see dwarf_make_arange_index(). */
+struct Dwarf_Arange_Index_s {
+    Dwarf_Unsigned ai_count;
+    struct Dwarf_Arange_Index_Entry_s *ai_entries;
+};
+
 int
 _dwarf_get_aranges_addr_offsets(Dwarf_Debug dbg,
     Dwarf_Addr ** addrs,
@@ -42,6 +42,8 @@
 #include "dwarf_opaque.h"
 #include "dwarf_error.h"
 
+#define DW_CRC32_READ_SIZE (1024*1024)
+
 /*  Returns DW_DLV_OK DW_DLV_NO_ENTRY or DW_DLV_ERROR
     crc32 used for debuglink crc calculation.
     Caller passes pointer to an
@@ -71,8 +73,10 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
     /*  size_t is unsigned, defined in C89. */
     Dwarf_Unsigned   fsize = 0;
     /*  Named with u to remind the reader that this is
-        an unsigned value. */
-    Dwarf_Unsigned  readlenu = 10000;
+        an unsigned value.
+        Big reads: the crc itself is now fast enough
+        that per-read overhead matters. */
+    Dwarf_Unsigned  readlenu = DW_CRC32_READ_SIZE;
     Dwarf_Unsigned  size_left = 0;
     const unsigned char *readbuf = 0;
     unsigned int   tcrc = 0;
@@ -111,12 +115,8 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         return DW_DLV_NO_ENTRY;
     }
     size_left = fsize;
-    res = _dwarf_seekr(fd,0,SEEK_SET,0);
-    if (res != DW_DLV_OK) {
-        _dwarf_error_string(dbg,error,DW_DLE_SEEK_ERROR,
-            "DW_DLE_SEEK_ERROR: dwarf_crc32 seek "
-            "to start fails");
-        return DW_DLV_ERROR;
+    if (readlenu > fsize) {
+        readlenu = fsize;
     }
     readbuf = (unsigned char *)malloc(readlenu);
     if (!readbuf) {
@@ -129,7 +129,8 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         if (size_left < readlenu) {
             readlenu = size_left;
         }
-        res = _dwarf_readr(fd,(char *)readbuf,readlenu,0);
+        res = _dwarf_preadr(fd,(char *)readbuf,
+            fsize - size_left,readlenu);
         if (res != DW_DLV_OK) {
             _dwarf_error_string(dbg,error,DW_DLE_READ_ERROR,
                 "DW_DLE_READ_ERROR: dwarf_crc32 read fails ");
@@ -1745,6 +1745,96 @@ isformrefval(Dwarf_Debug dbg,Dwarf_Half form,
     }
     return DW_DLV_OK;
 }
+/*  Reads the value of one IDX/form pair from the
+    entry pool, advancing *poolptr.
+    A DW_IDX_type_hash is copied to *sig_out (if non-null)
+    and *val_out is set to zero.
+    Shared by dwarf_dnames_entrypool_values() and
+    the name lookup functions so both decode the
+    pool identically. */
+static int
+dnames_read_idx_value(Dwarf_Dnames_Head dn,
+    Dwarf_Half      idx,
+    Dwarf_Half      form,
+    Dwarf_Small   **poolptr,
+    Dwarf_Small    *endpool,
+    Dwarf_Unsigned *val_out,
+    Dwarf_Sig8     *sig_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned val = 0;
+    Dwarf_Unsigned bytesread = 0;
+    int res = 0;
+
+    if (form == DW_FORM_data8 && idx == DW_IDX_type_hash) {
+        bytesread = sizeof(Dwarf_Sig8);
+        if ((*poolptr + bytesread) > endpool) {
+            _dwarf_error(dbg,error,
+                DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET);
+            return DW_DLV_ERROR;
+        }
+        if (sig_out) {
+            memcpy(sig_out,*poolptr,bytesread);
+        }
+        *poolptr += bytesread;
+        *val_out = 0;
+        return DW_DLV_OK;
+    }
+    if (form == DW_FORM_udata) {
+        return _dwarf_read_uleb_ck(poolptr,val_out,dbg,error,
+            endpool);
+    }
+    if (_dwarf_allow_formudata(form)) {
+        res = _dwarf_formudata_internal(dbg,0,form,*poolptr,
+            endpool,&val,&bytesread,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        *poolptr += bytesread;
+        *val_out = val;
+        return DW_DLV_OK;
+    }
+    res = isformrefval(dbg,form,*poolptr,
+        endpool,&val,&bytesread,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        *poolptr += bytesread;
+        if (*poolptr >= endpool) {
+            _dwarf_error_string(dbg,error,
+                DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET,
+                "DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET:"
+                " a DW_FORM_ref* would read past end"
+                " of the entrypool");
+            return DW_DLV_ERROR;
+        }
+        *val_out = val;
+        return DW_DLV_OK;
+    }
+    /*  There is some mistake/omission in our code here or in
+        the data. */
+    {
+    dwarfstring m;
+    const char *name = "<unexpected form>";
+
+    dwarfstring_constructor(&m);
+    dwarfstring_append_printf_u(&m,
+        "DW_DLE_DEBUG_NAMES_UNHANDLED_FORM: Form 0x%x",
+        form);
+    dwarf_get_FORM_name(form,&name);
+    dwarfstring_append_printf_s(&m,
+        " %s is not currently supported for .debug_names ",
+        (char *)name);
+    _dwarf_error_string(dbg,error,
+        DW_DLE_DEBUG_NAMES_UNHANDLED_FORM,
+        dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+    }
+    return DW_DLV_ERROR;
+}
+
 /*  Caller, knowing array size needed, passes in arrays
     it allocates of for idx, form, offset-size-values,
     and signature values.  Caller must examine idx-number
@@ -1781,7 +1871,6 @@ int dwarf_dnames_entrypool_values(Dwarf_Dnames_Head dn,
         offset_in_entrypool_of_values;
     Dwarf_Small             * endpool = 0;
     Dwarf_Small             * poolptr = 0;
-    Dwarf_Unsigned            bytesread = 0;
 
     if (!dn || dn->dn_magic != DWARF_DNAMES_MAGIC) {
         _dwarf_error_string(NULL, error,DW_DLE_DBG_NULL,
@@ -1845,6 +1934,7 @@ int dwarf_dnames_entrypool_values(Dwarf_Dnames_Head dn,
     for (n = 0; n < abcount ; ++n) {
         Dwarf_Half idxtype =  0;
         Dwarf_Half form = 0;
+        Dwarf_Small *startptr = poolptr;
 
         idxtype = abbrev->da_idxattr[n];
         form = abbrev->da_form[n];
@@ -1855,83 +1945,412 @@ int dwarf_dnames_entrypool_values(Dwarf_Dnames_Head dn,
             break;
         }
 
-        if (form == DW_FORM_data8 && idxtype == DW_IDX_type_hash) {
-            if ((poolptr + sizeof(Dwarf_Sig8)) > endpool){
-                _dwarf_error(dbg,error,
-                    DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET);
-                return DW_DLV_ERROR;
-            }
-            bytesread = sizeof(Dwarf_Sig8);
-            memcpy(array_of_signatures+n,
-                poolptr,bytesread);
-            poolptr += bytesread;
-            pooloffset += bytesread;
-            continue;
-        } else if (_dwarf_allow_formudata(form)) {
+        res = dnames_read_idx_value(dn,idxtype,form,&poolptr,
+            endpool,array_of_offsets+n,array_of_signatures+n,
+            error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        pooloffset += poolptr - startptr;
+    }
+    if ( dn->dn_single_cu) {
+        if (single_cu && single_cu_offset) {
+            *single_cu = dn->dn_single_cu;
+            *single_cu_offset = dn->dn_single_cu_offset;
+        }
+    }
+    *offset_of_next_entrypool = pooloffset;
+    return DW_DLV_OK;
+}
+
+/*  The DWARF5 name hash (section 6.1.1.4.5): the DJB
+    hash, with ASCII upper case letters folded to lower
+    case first as producers do. */
+static Dwarf_Unsigned
+dnames_hash(const char *name)
+{
+    Dwarf_Unsigned h = 5381;
+
+    for ( ; *name; ++name) {
+        unsigned int c = (unsigned char)*name;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = ((h << 5) + h + c) & 0xffffffff;
+    }
+    return h;
+}
+
+static int
+dnames_read_word(Dwarf_Dnames_Head dn,
+    Dwarf_Small    *array,
+    Dwarf_Unsigned  index,
+    Dwarf_Unsigned  count,
+    Dwarf_Unsigned  size,
+    Dwarf_Unsigned *val_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned val = 0;
+    Dwarf_Small *ptr = 0;
+    Dwarf_Small *endptr = 0;
+
+    if (index >= count) {
+        _dwarf_error_string(dbg,error,DW_DLE_DEBUG_NAMES_OFF_END,
+            "DW_DLE_DEBUG_NAMES_OFF_END: a .debug_names bucket "
+            "or name index is out of range");
+        return DW_DLV_ERROR;
+    }
+    ptr = array + index*size;
+    endptr = array + count*size;
+    READ_UNALIGNED_CK(dbg, val, Dwarf_Unsigned,
+        ptr, (unsigned long)size,
+        error,endptr);
+    *val_out = val;
+    return DW_DLV_OK;
+}
+
+/*  The .debug_str string for name table entry
+    name_index (starting at one). */
+static int
+dnames_entry_string(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned name_index,
+    const char   **str_out,
+    Dwarf_Error   *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned stroffset = 0;
+    Dwarf_Small *secdata = 0;
+    Dwarf_Small *secend = 0;
+    int res = 0;
+
+    res = dnames_read_word(dn,dn->dn_string_offsets,
+        name_index-1,dn->dn_name_count,dn->dn_offset_size,
+        &stroffset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    secdata = (Dwarf_Small *)dbg->de_debug_str.dss_data;
+    if (!secdata || stroffset >= dbg->de_debug_str.dss_size) {
+        _dwarf_error_string(dbg,error,DW_DLE_DEBUG_NAMES_OFF_END,
+            "DW_DLE_DEBUG_NAMES_OFF_END: a .debug_names string "
+            "offset is outside .debug_str");
+        return DW_DLV_ERROR;
+    }
+    secend = secdata + dbg->de_debug_str.dss_size;
+    res = _dwarf_check_string_valid(dbg,secdata,
+        secdata+stroffset,secend,
+        DW_DLE_FORM_STRING_BAD_STRING,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *str_out = (const char *)(secdata+stroffset);
+    return DW_DLV_OK;
+}
+
+/*  Adds the DIEs of the entry pool series at
+    entrypooloffset to the caller's arrays,
+    counting in *count_io even past array_size.
+    Entries in foreign type units are skipped as they
+    have no offset in this object. */
+static int
+dnames_add_entries(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned  entrypooloffset,
+    Dwarf_Unsigned  array_size,
+    Dwarf_Half     *tags,
+    Dwarf_Unsigned *unit_offsets,
+    Dwarf_Unsigned *die_offsets,
+    Dwarf_Unsigned *count_io,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Small *poolptr = 0;
+    Dwarf_Small *endpool = 0;
+
+    if (entrypooloffset >= dn->dn_entry_pool_size) {
+        _dwarf_error(dbg,error,
+            DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET);
+        return DW_DLV_ERROR;
+    }
+    poolptr = dn->dn_entry_pool + entrypooloffset;
+    endpool = dn->dn_entry_pool + dn->dn_entry_pool_size;
+    for (;;) {
+        struct Dwarf_D_Abbrev_s *abbrev = 0;
+        Dwarf_Unsigned code = 0;
+        Dwarf_Unsigned cu_index = 0;
+        Dwarf_Unsigned tu_index = 0;
+        Dwarf_Unsigned die_offset = 0;
+        Dwarf_Unsigned unit_offset = 0;
+        Dwarf_Bool have_cu = FALSE;
+        Dwarf_Bool have_tu = FALSE;
+        Dwarf_Bool have_die = FALSE;
+        Dwarf_Unsigned n = 0;
+        int res = 0;
+
+        if (poolptr >= endpool) {
+            /*  Ran off the pool without the 0 code. */
+            _dwarf_error(dbg,error,
+                DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET);
+            return DW_DLV_ERROR;
+        }
+        res = _dwarf_read_uleb_ck(&poolptr,&code,dbg,error,endpool);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!code) {
+            return DW_DLV_OK;
+        }
+        res = _dwarf_find_abbrev_for_code(dn,code,&abbrev,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        for (n = 0; n < abbrev->da_pairs_count; ++n) {
+            Dwarf_Half idx = abbrev->da_idxattr[n];
+            Dwarf_Half form = abbrev->da_form[n];
             Dwarf_Unsigned val = 0;
-            res = _dwarf_formudata_internal(dbg,0,form,poolptr,
-                endpool,&val,&bytesread,error);
+
+            if (!idx && !form) {
+                break;
+            }
+            res = dnames_read_idx_value(dn,idx,form,&poolptr,
+                endpool,&val,0,error);
             if (res != DW_DLV_OK) {
                 return res;
             }
-            poolptr += bytesread;
-            pooloffset += bytesread;
-
-            array_of_offsets[n] = val;
-            continue;
-        } else if (form == DW_FORM_flag_present) {
-            array_of_offsets[n] = 1;
-            /* No change to poolptr or pooloffset */
+            switch (idx) {
+            case DW_IDX_compile_unit:
+                cu_index = val;
+                have_cu = TRUE;
+                break;
+            case DW_IDX_type_unit:
+                tu_index = val;
+                have_tu = TRUE;
+                break;
+            case DW_IDX_die_offset:
+                die_offset = val;
+                have_die = TRUE;
+                break;
+            default:
+                break;
+            }
+        }
+        if (!have_die) {
             continue;
+        }
+        if (have_tu) {
+            if (tu_index >= dn->dn_local_type_unit_count) {
+                continue;
+            }
+            res = dnames_read_word(dn,dn->dn_local_tu_list,
+                tu_index,dn->dn_local_type_unit_count,
+                dn->dn_offset_size,&unit_offset,error);
+        } else if (have_cu) {
+            res = dnames_read_word(dn,dn->dn_cu_list,
+                cu_index,dn->dn_comp_unit_count,
+                dn->dn_offset_size,&unit_offset,error);
+        } else if (dn->dn_single_cu) {
+            unit_offset = dn->dn_single_cu_offset;
         } else {
-            Dwarf_Unsigned val = 0;
-            res =isformrefval(dbg,form,poolptr,
-                endpool,&val,&bytesread,error);
-            if (res == DW_DLV_ERROR) {
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (*count_io < array_size) {
+            Dwarf_Unsigned i = *count_io;
+
+            tags[i] = (Dwarf_Half)abbrev->da_tag;
+            unit_offsets[i] = unit_offset;
+            die_offsets[i] = unit_offset + die_offset;
+        }
+        ++*count_io;
+    }
+}
+
+/*  Finds name in the hash table (or, with no
+    hash table, in the list of names) and
+    adds its entries. */
+static int
+dnames_find(Dwarf_Dnames_Head dn,
+    const char     *name,
+    Dwarf_Unsigned  array_size,
+    Dwarf_Half     *tags,
+    Dwarf_Unsigned *unit_offsets,
+    Dwarf_Unsigned *die_offsets,
+    Dwarf_Unsigned *count_io,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned bucket = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (dn->dn_bucket_count) {
+        hash = dnames_hash(name);
+        bucket = hash % dn->dn_bucket_count;
+        res = dnames_read_word(dn,dn->dn_buckets,bucket,
+            dn->dn_bucket_count,DWARF_32BIT_SIZE,&i,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!i) {
+            /* Empty bucket. */
+            return DW_DLV_OK;
+        }
+    } else {
+        i = 1;
+    }
+    for ( ; i <= dn->dn_name_count; ++i) {
+        const char *str = 0;
+        Dwarf_Unsigned entrypooloffset = 0;
+
+        if (dn->dn_bucket_count) {
+            Dwarf_Unsigned h = 0;
+
+            res = dnames_read_word(dn,dn->dn_hash_table,i-1,
+                dn->dn_name_count,DWARF_32BIT_SIZE,&h,error);
+            if (res != DW_DLV_OK) {
                 return res;
             }
-            if (res == DW_DLV_OK) {
-                poolptr += bytesread;
-                if (poolptr >= endpool) {
-                    _dwarf_error_string(dbg,error,
-                        DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET,
-                        "DW_DLE_DEBUG_NAMES_ENTRYPOOL_OFFSET:"
-                        " a DW_FORM_ref* would read past end"
-                        " of the entrypool");
-                    return DW_DLV_ERROR;
-                }
-                pooloffset += bytesread;
-                array_of_offsets[n] = val;
+            if (h % dn->dn_bucket_count != bucket) {
+                /* Past the end of this bucket. */
+                break;
+            }
+            if (h != hash) {
                 continue;
             }
         }
-        /*  There is some mistake/omission in our code here or in
-            the data. */
-        {
+        res = dnames_entry_string(dn,i,&str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (strcmp(str,name)) {
+            continue;
+        }
+        res = dnames_read_word(dn,dn->dn_entry_offsets,i-1,
+            dn->dn_name_count,dn->dn_offset_size,
+            &entrypooloffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        /*  Each name appears once in a name table. */
+        return dnames_add_entries(dn,entrypooloffset,
+            array_size,tags,unit_offsets,die_offsets,
+            count_io,error);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+dnames_check_find_args(Dwarf_Dnames_Head dn,
+    const char     *fname,
+    Dwarf_Unsigned  array_size,
+    Dwarf_Half     *tags,
+    Dwarf_Unsigned *unit_offsets,
+    Dwarf_Unsigned *die_offsets,
+    Dwarf_Error    *error)
+{
+    if (!dn || dn->dn_magic != DWARF_DNAMES_MAGIC) {
         dwarfstring m;
-        const char *name = "<unexpected form>";
 
         dwarfstring_constructor(&m);
-        dwarfstring_append_printf_u(&m,
-            "DW_DLE_DEBUG_NAMES_UNHANDLED_FORM: Form 0x%x",
-            form);
-        dwarf_get_FORM_name(form,&name);
         dwarfstring_append_printf_s(&m,
-            " %s is not currently supported for .debug_names ",
-            (char *)name);
-        _dwarf_error_string(dbg,error,
-            DW_DLE_DEBUG_NAMES_UNHANDLED_FORM,
+            "DW_DLE_DBG_NULL: bad Head argument to %s",
+            (char *)fname);
+        _dwarf_error_string(NULL,error,DW_DLE_DBG_NULL,
             dwarfstring_string(&m));
         dwarfstring_destructor(&m);
-        }
         return DW_DLV_ERROR;
     }
-    if ( dn->dn_single_cu) {
-        if (single_cu && single_cu_offset) {
-            *single_cu = dn->dn_single_cu;
-            *single_cu_offset = dn->dn_single_cu_offset;
+    if (array_size && (!tags || !unit_offsets || !die_offsets)) {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_s(&m,
+            "DW_DLE_IA: a NULL array passed to %s",
+            (char *)fname);
+        _dwarf_error_string(dn->dn_dbg,error,DW_DLE_IA,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dnames_find_name(Dwarf_Dnames_Head dn,
+    const char     *name,
+    Dwarf_Unsigned  array_size,
+    Dwarf_Half     *tags,
+    Dwarf_Unsigned *unit_offsets,
+    Dwarf_Unsigned *die_offsets,
+    Dwarf_Unsigned *entry_count,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned count = 0;
+    int res = 0;
+
+    res = dnames_check_find_args(dn,"dwarf_dnames_find_name()",
+        array_size,tags,unit_offsets,die_offsets,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!name || !entry_count) {
+        _dwarf_error_string(dn->dn_dbg,error,DW_DLE_IA,
+            "DW_DLE_IA: a NULL argument passed to "
+            "dwarf_dnames_find_name()");
+        return DW_DLV_ERROR;
+    }
+    res = dnames_find(dn,name,array_size,tags,unit_offsets,
+        die_offsets,&count,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *entry_count = count;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dnames_find_names(Dwarf_Dnames_Head dn,
+    const char    **names,
+    Dwarf_Unsigned  name_count,
+    Dwarf_Unsigned *first_entry,
+    Dwarf_Unsigned  array_size,
+    Dwarf_Half     *tags,
+    Dwarf_Unsigned *unit_offsets,
+    Dwarf_Unsigned *die_offsets,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dnames_check_find_args(dn,"dwarf_dnames_find_names()",
+        array_size,tags,unit_offsets,die_offsets,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!first_entry || (name_count && !names)) {
+        _dwarf_error_string(dn->dn_dbg,error,DW_DLE_IA,
+            "DW_DLE_IA: a NULL argument passed to "
+            "dwarf_dnames_find_names()");
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < name_count; ++i) {
+        first_entry[i] = count;
+        if (!names[i]) {
+            continue;
+        }
+        res = dnames_find(dn,names[i],array_size,tags,
+            unit_offsets,die_offsets,&count,error);
+        if (res != DW_DLV_OK) {
+            return res;
         }
     }
-    *offset_of_next_entrypool = pooloffset;
+    first_entry[name_count] = count;
     return DW_DLV_OK;
 }
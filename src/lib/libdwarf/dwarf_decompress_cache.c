@@ -0,0 +1,275 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+*/
+
+#include <config.h>
+
+#include <stdlib.h> /* free() malloc() */
+#include <string.h> /* memcmp() memcpy() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dwarf_local_malloc.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_decompress_cache.h"
+
+/*  Entries are on a doubly linked list, most recently
+    used first. An entry with a non-zero
+    dc_refcount is the dss_data of a section of some
+    open Dwarf_Debug and is never evicted.
+    Unused entries are evicted oldest first whenever
+    the total exceeds the budget.
+    Each entry keeps a copy of the compressed bytes:
+    the key only selects candidates, a hit requires
+    the bytes to match exactly.
+
+    The list and counters are process-wide and, like
+    the other global settings in libdwarf, not
+    protected by a lock. The cache is single-threaded:
+    it must not be used by Dwarf_Debug instances in
+    more than one thread at a time. */
+struct Dwarf_Dcache_Entry_s {
+    Dwarf_Unsigned dc_key;
+    Dwarf_Unsigned dc_compressed_len;
+    Dwarf_Unsigned dc_uncompressed_len;
+    Dwarf_Small   *dc_compressed;
+    Dwarf_Small   *dc_data;
+    Dwarf_Unsigned dc_refcount;
+    struct Dwarf_Dcache_Entry_s *dc_prev;
+    struct Dwarf_Dcache_Entry_s *dc_next;
+};
+
+static struct Dwarf_Dcache_Entry_s *dcache_head;
+static struct Dwarf_Dcache_Entry_s *dcache_tail;
+static Dwarf_Unsigned dcache_limit;
+static Dwarf_Unsigned dcache_bytes;
+static Dwarf_Unsigned dcache_entries;
+static Dwarf_Unsigned dcache_hits;
+static Dwarf_Unsigned dcache_misses;
+static Dwarf_Unsigned dcache_evictions;
+
+static void
+dcache_unlink(struct Dwarf_Dcache_Entry_s *e)
+{
+    if (e->dc_prev) {
+        e->dc_prev->dc_next = e->dc_next;
+    } else {
+        dcache_head = e->dc_next;
+    }
+    if (e->dc_next) {
+        e->dc_next->dc_prev = e->dc_prev;
+    } else {
+        dcache_tail = e->dc_prev;
+    }
+    e->dc_prev = 0;
+    e->dc_next = 0;
+}
+
+static void
+dcache_push_front(struct Dwarf_Dcache_Entry_s *e)
+{
+    e->dc_prev = 0;
+    e->dc_next = dcache_head;
+    if (dcache_head) {
+        dcache_head->dc_prev = e;
+    } else {
+        dcache_tail = e;
+    }
+    dcache_head = e;
+}
+
+/*  Bytes an entry counts against the budget. */
+static Dwarf_Unsigned
+dcache_entry_bytes(struct Dwarf_Dcache_Entry_s *e)
+{
+    return e->dc_uncompressed_len + e->dc_compressed_len;
+}
+
+/*  Evict unreferenced entries, least recently
+    used first, until the total fits the budget.
+    Referenced entries are skipped, so the budget
+    is not a hard bound: dcache_bytes stays above
+    dcache_limit while sections in use account for
+    the excess. _dwarf_dcache_release() trims again
+    as each is released. */
+static void
+dcache_trim(void)
+{
+    struct Dwarf_Dcache_Entry_s *e = dcache_tail;
+
+    while (e && dcache_bytes > dcache_limit) {
+        struct Dwarf_Dcache_Entry_s *prev = e->dc_prev;
+
+        if (!e->dc_refcount) {
+            dcache_unlink(e);
+            dcache_bytes -= dcache_entry_bytes(e);
+            --dcache_entries;
+            ++dcache_evictions;
+            free(e->dc_compressed);
+            free(e->dc_data);
+            free(e);
+        }
+        e = prev;
+    }
+}
+
+int
+_dwarf_dcache_enabled(void)
+{
+    return dcache_limit != 0;
+}
+
+/*  64 bit FNV-1a of the compressed bytes. Used to
+    skip most entries cheaply, it does not by itself
+    identify the content. */
+Dwarf_Unsigned
+_dwarf_dcache_key(Dwarf_Small *src, Dwarf_Unsigned srclen)
+{
+    Dwarf_Unsigned h = 0xcbf29ce484222325ULL;
+    Dwarf_Small   *end = src + srclen;
+
+    for ( ; src < end; ++src) {
+        h ^= *src;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+struct Dwarf_Dcache_Entry_s *
+_dwarf_dcache_lookup(Dwarf_Unsigned key,
+    Dwarf_Small   *compressed,
+    Dwarf_Unsigned compressed_len,
+    Dwarf_Unsigned uncompressed_len,
+    Dwarf_Small  **data_out)
+{
+    struct Dwarf_Dcache_Entry_s *e = dcache_head;
+
+    for ( ; e; e = e->dc_next) {
+        if (e->dc_key == key &&
+            e->dc_compressed_len == compressed_len &&
+            e->dc_uncompressed_len == uncompressed_len &&
+            !memcmp(e->dc_compressed,compressed,
+                (size_t)compressed_len)) {
+            if (e != dcache_head) {
+                dcache_unlink(e);
+                dcache_push_front(e);
+            }
+            ++e->dc_refcount;
+            ++dcache_hits;
+            *data_out = e->dc_data;
+            return e;
+        }
+    }
+    ++dcache_misses;
+    return 0;
+}
+
+struct Dwarf_Dcache_Entry_s *
+_dwarf_dcache_insert(Dwarf_Unsigned key,
+    Dwarf_Small   *compressed,
+    Dwarf_Unsigned compressed_len,
+    Dwarf_Unsigned uncompressed_len,
+    Dwarf_Small   *data)
+{
+    struct Dwarf_Dcache_Entry_s *e = 0;
+
+    if (!dcache_limit || !compressed_len ||
+        uncompressed_len > dcache_limit ||
+        compressed_len > dcache_limit - uncompressed_len) {
+        return 0;
+    }
+    e = (struct Dwarf_Dcache_Entry_s *)malloc(sizeof(*e));
+    if (!e) {
+        return 0;
+    }
+    e->dc_compressed = (Dwarf_Small *)malloc(
+        (size_t)compressed_len);
+    if (!e->dc_compressed) {
+        free(e);
+        return 0;
+    }
+    memcpy(e->dc_compressed,compressed,(size_t)compressed_len);
+    e->dc_key = key;
+    e->dc_compressed_len = compressed_len;
+    e->dc_uncompressed_len = uncompressed_len;
+    e->dc_data = data;
+    e->dc_refcount = 1;
+    dcache_push_front(e);
+    dcache_bytes += dcache_entry_bytes(e);
+    ++dcache_entries;
+    dcache_trim();
+    return e;
+}
+
+void
+_dwarf_dcache_release(struct Dwarf_Dcache_Entry_s *e)
+{
+    if (!e) {
+        return;
+    }
+    if (e->dc_refcount) {
+        --e->dc_refcount;
+    }
+    if (!e->dc_refcount) {
+        dcache_trim();
+    }
+}
+
+Dwarf_Unsigned
+dwarf_set_decompressed_section_cache_size(Dwarf_Unsigned max_bytes)
+{
+    Dwarf_Unsigned prev = dcache_limit;
+
+    dcache_limit = max_bytes;
+    dcache_trim();
+    return prev;
+}
+
+void
+dwarf_get_decompressed_section_cache_stats(
+    Dwarf_Unsigned *bytes_cached,
+    Dwarf_Unsigned *entry_count,
+    Dwarf_Unsigned *hits,
+    Dwarf_Unsigned *misses,
+    Dwarf_Unsigned *evictions)
+{
+    if (bytes_cached) {
+        *bytes_cached = dcache_bytes;
+    }
+    if (entry_count) {
+        *entry_count = dcache_entries;
+    }
+    if (hits) {
+        *hits = dcache_hits;
+    }
+    if (misses) {
+        *misses = dcache_misses;
+    }
+    if (evictions) {
+        *evictions = dcache_evictions;
+    }
+}
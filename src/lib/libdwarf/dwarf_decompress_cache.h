@@ -0,0 +1,75 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+*/
+
+#ifndef DWARF_DECOMPRESS_CACHE_H
+#define DWARF_DECOMPRESS_CACHE_H
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  A process-wide cache of decompressed section
+    contents, keyed by the compressed bytes, so that
+    opening the same object (or another object with
+    an identical compressed section) again does not
+    inflate again.  Only enabled once
+    dwarf_set_decompressed_section_cache_size()
+    sets a non-zero byte budget.
+    Single-threaded: there is no lock. */
+struct Dwarf_Dcache_Entry_s;
+
+int  _dwarf_dcache_enabled(void);
+Dwarf_Unsigned _dwarf_dcache_key(Dwarf_Small *src,
+    Dwarf_Unsigned srclen);
+
+/*  On a hit returns the entry (now referenced
+    by the caller) and its data. A hit needs
+    the compressed bytes to match, not just key. */
+struct Dwarf_Dcache_Entry_s * _dwarf_dcache_lookup(
+    Dwarf_Unsigned key,
+    Dwarf_Small   *compressed,
+    Dwarf_Unsigned compressed_len,
+    Dwarf_Unsigned uncompressed_len,
+    Dwarf_Small  **data_out);
+
+/*  Gives ownership of data (from malloc) to the
+    cache, which keeps its own copy of the compressed
+    bytes. Returns the entry, referenced by the caller,
+    or NULL if the data does not fit the budget,
+    in which case the caller still owns data. */
+struct Dwarf_Dcache_Entry_s * _dwarf_dcache_insert(
+    Dwarf_Unsigned key,
+    Dwarf_Small   *compressed,
+    Dwarf_Unsigned compressed_len,
+    Dwarf_Unsigned uncompressed_len,
+    Dwarf_Small   *data);
+
+void _dwarf_dcache_release(struct Dwarf_Dcache_Entry_s *entry);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DWARF_DECOMPRESS_CACHE_H */
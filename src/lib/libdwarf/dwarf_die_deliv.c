@@ -161,6 +161,7 @@ static int _dwarf_siblingof_internal(Dwarf_Debug dbg,
     Dwarf_Die die,
     Dwarf_CU_Context context,
     Dwarf_Bool is_info,
+    Dwarf_Bool reuse,
     Dwarf_Die * caller_ret_die, Dwarf_Error * error);
 
 /*  see cuandunit.txt for an overview of the
@@ -203,7 +204,8 @@ dwarf_get_die_infotypes_flag(Dwarf_Die die)
     internal routine, it is assumed that a valid dbg
     is passed.
 
-    **This is a sequential search.  May be too slow.
+    A binary search of de_cu_context_index, which
+    insert_into_cu_context_list() keeps sorted.
 
     If debug_info and debug_abbrev not loaded, this will
     wind up returning NULL. So no need to load before calling
@@ -217,6 +219,8 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
     Dwarf_CU_Context cu_context = 0;
     Dwarf_Debug_InfoTypes dis = is_info? &dbg->de_info_reading:
         &dbg->de_types_reading;
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = 0;
 
     if (offset >= dis->de_last_offset){
         return NULL;
@@ -226,28 +230,25 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
         dis->de_cu_context->cc_next->cc_debug_offset == offset) {
         return dis->de_cu_context->cc_next;
     }
-    if (dis->de_cu_context != NULL &&
-        dis->de_cu_context->cc_debug_offset <= offset) {
-        for (cu_context = dis->de_cu_context;
-            cu_context != NULL;
-            cu_context = cu_context->cc_next) {
-            if (offset >= cu_context->cc_debug_offset &&
-                offset < cu_context->cc_debug_offset +
-                cu_context->cc_length + cu_context->cc_length_size
-                + cu_context->cc_extension_size) {
-                return cu_context;
-            }
+    /*  Find the last context starting at or before offset. */
+    high = dis->de_cu_context_index_count;
+    while (low < high) {
+        Dwarf_Unsigned mid = low + (high - low)/2;
+
+        if (dis->de_cu_context_index[mid]->cc_debug_offset <=
+            offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
-    for (cu_context = dis->de_cu_context_list;
-        cu_context != NULL;
-        cu_context = cu_context->cc_next) {
-        if (offset >= cu_context->cc_debug_offset &&
-            offset < cu_context->cc_debug_offset +
-            cu_context->cc_length + cu_context->cc_length_size
-            + cu_context->cc_extension_size) {
-            return cu_context;
-        }
+    if (!low) {
+        return NULL;
+    }
+    cu_context = dis->de_cu_context_index[low-1];
+    if (offset < _dwarf_calculate_next_cu_context_offset(
+        cu_context)) {
+        return cu_context;
     }
     return NULL;
 }
@@ -688,7 +689,7 @@ finish_cu_context_via_cudie_inner(
         Safe because we know the correct cu_context.  */
     resdwo = _dwarf_siblingof_internal(dbg,NULL,
         cu_context,
-        cu_context->cc_is_info,
+        cu_context->cc_is_info,FALSE,
         &cudie, error);
     if (resdwo == DW_DLV_OK) {
         Dwarf_Half cutag = 0;
@@ -741,19 +742,12 @@ static void
 local_dealloc_cu_context(Dwarf_Debug dbg,
     Dwarf_CU_Context context)
 {
-    Dwarf_Hash_Table hash_table = 0;
-
     if (!context) {
         return;
     }
-    hash_table = context->cc_abbrev_hash_table;
-    if (hash_table) {
-        _dwarf_free_abbrev_hash_table_contents(hash_table,
-            FALSE);
-        hash_table->tb_entries = 0;
-        free(hash_table);
-        context->cc_abbrev_hash_table = 0;
-    }
+    /*  The abbrev table, if any, is shared and
+        owned by dbg->de_abbrev_tables. */
+    context->cc_abbrev_hash_table = 0;
     dwarf_dealloc(dbg, context, DW_DLA_CU_CONTEXT);
 }
 
@@ -1030,14 +1024,8 @@ _dwarf_make_CU_Context(Dwarf_Debug dbg,
         return DW_DLV_ERROR;
         }
     }
-    cu_context->cc_abbrev_hash_table =
-        (Dwarf_Hash_Table) calloc(1,
-        sizeof(struct Dwarf_Hash_Table_s));
-    if (!cu_context->cc_abbrev_hash_table) {
-        local_dealloc_cu_context(dbg,cu_context);
-        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
+    /*  cc_abbrev_hash_table is found (shared by
+        cc_abbrev_offset) at the first abbrev lookup. */
     cu_context->cc_debug_offset = offset;
 
     /*  This is recording an overall section value for later
@@ -1806,6 +1794,173 @@ finish_up_cu_context_from_cudie(Dwarf_Debug dbg,
     }
     return DW_DLV_OK;
 }
+
+static Dwarf_Unsigned
+sig_hash_slot(Dwarf_Sig8 *sig, Dwarf_Unsigned size)
+{
+    Dwarf_Unsigned v = 0;
+
+    /*  Signatures are already hash values, the
+        multiply just spreads them over the mask. */
+    memcpy(&v,sig->signature,sizeof(v));
+    v *= 0x9e3779b97f4a7c15ULL;
+    return (v >> 32) & (size - 1);
+}
+
+static void
+add_to_sig_hash(Dwarf_CU_Context *table, Dwarf_Unsigned size,
+    Dwarf_CU_Context context)
+{
+    Dwarf_Unsigned slot = sig_hash_slot(&context->cc_signature,
+        size);
+
+    while (table[slot]) {
+        slot = (slot + 1) & (size - 1);
+    }
+    table[slot] = context;
+}
+
+/*  Makes room in de_sig_hash for one more
+    entry, keeping it at most half full.
+    Returns DW_DLV_ERROR only if out of memory. */
+static int
+grow_sig_hash(Dwarf_Debug_InfoTypes dis)
+{
+    Dwarf_Unsigned newsize = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_CU_Context *newtable = 0;
+
+    if ((dis->de_sig_hash_count+1)*2 <= dis->de_sig_hash_size) {
+        return DW_DLV_OK;
+    }
+    newsize = dis->de_sig_hash_size?
+        dis->de_sig_hash_size*2 : 64;
+    newtable = (Dwarf_CU_Context *)calloc((size_t)newsize,
+        sizeof(Dwarf_CU_Context));
+    if (!newtable) {
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < dis->de_sig_hash_size; ++i) {
+        if (dis->de_sig_hash[i]) {
+            add_to_sig_hash(newtable,newsize,dis->de_sig_hash[i]);
+        }
+    }
+    free(dis->de_sig_hash);
+    dis->de_sig_hash = newtable;
+    dis->de_sig_hash_size = newsize;
+    return DW_DLV_OK;
+}
+
+/*  Returns the type unit (DW_UT_type or DW_UT_split_type)
+    with the signature, or NULL. Where several have
+    the signature returns the one at the lowest
+    offset, as a walk of de_cu_context_list would. */
+Dwarf_CU_Context
+_dwarf_find_type_unit_given_sig(Dwarf_Debug_InfoTypes dis,
+    Dwarf_Sig8 *sig)
+{
+    Dwarf_Unsigned slot = 0;
+    Dwarf_CU_Context found = 0;
+    Dwarf_CU_Context cur = 0;
+
+    if (!dis->de_sig_hash_count) {
+        return 0;
+    }
+    slot = sig_hash_slot(sig,dis->de_sig_hash_size);
+    for ( ; (cur = dis->de_sig_hash[slot]) != 0;
+        slot = (slot + 1) & (dis->de_sig_hash_size - 1)) {
+        if (memcmp(sig,&cur->cc_signature,sizeof(Dwarf_Sig8))) {
+            continue;
+        }
+        if (cur->cc_unit_type != DW_UT_split_type &&
+            cur->cc_unit_type != DW_UT_type) {
+            continue;
+        }
+        if (!found ||
+            cur->cc_debug_offset < found->cc_debug_offset) {
+            found = cur;
+        }
+    }
+    return found;
+}
+
+/*  Makes room in de_cu_context_index for
+    one more entry.
+    Returns DW_DLV_ERROR only if out of memory. */
+static int
+grow_cu_context_index(Dwarf_Debug_InfoTypes dis)
+{
+    Dwarf_Unsigned newsize = 0;
+    Dwarf_CU_Context *newindex = 0;
+
+    if (dis->de_cu_context_index_count <
+        dis->de_cu_context_index_size) {
+        return DW_DLV_OK;
+    }
+    newsize = dis->de_cu_context_index_size?
+        dis->de_cu_context_index_size*2 : 64;
+    newindex = (Dwarf_CU_Context *)realloc(
+        dis->de_cu_context_index,
+        (size_t)(newsize*sizeof(Dwarf_CU_Context)));
+    if (!newindex) {
+        return DW_DLV_ERROR;
+    }
+    dis->de_cu_context_index = newindex;
+    dis->de_cu_context_index_size = newsize;
+    return DW_DLV_OK;
+}
+
+/*  Records a signature-bearing context in de_sig_hash.
+    grow_sig_hash() has made room. */
+static void
+insert_into_sig_hash(Dwarf_Debug_InfoTypes dis,
+    Dwarf_CU_Context icu_context)
+{
+    if (!icu_context->cc_signature_present) {
+        return;
+    }
+    add_to_sig_hash(dis->de_sig_hash,dis->de_sig_hash_size,
+        icu_context);
+    ++dis->de_sig_hash_count;
+}
+
+/*  Keeps de_cu_context_index in step with
+    de_cu_context_list.
+    Usually an append.
+    grow_cu_context_index() has made room. */
+static void
+insert_into_cu_context_index(Dwarf_Debug_InfoTypes dis,
+    Dwarf_CU_Context icu_context)
+{
+    Dwarf_Unsigned ioffset = icu_context->cc_debug_offset;
+    Dwarf_Unsigned count = dis->de_cu_context_index_count;
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = count;
+
+    if (!count || dis->de_cu_context_index[count-1]->
+        cc_debug_offset < ioffset) {
+        /* Normal case, add at end. */
+        dis->de_cu_context_index[count] = icu_context;
+        dis->de_cu_context_index_count = count+1;
+        return;
+    }
+    while (low < high) {
+        Dwarf_Unsigned mid = low + (high - low)/2;
+
+        if (dis->de_cu_context_index[mid]->cc_debug_offset <
+            ioffset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    memmove(dis->de_cu_context_index+low+1,
+        dis->de_cu_context_index+low,
+        (size_t)((count-low)*sizeof(Dwarf_CU_Context)));
+    dis->de_cu_context_index[low] = icu_context;
+    dis->de_cu_context_index_count = count+1;
+}
+
 /*
     CU_Contexts do not overlap.
     cu_context we see here is not in the list we
@@ -1827,6 +1982,13 @@ insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
     Dwarf_CU_Context past = 0;
     Dwarf_CU_Context cur = 0;
 
+    if (grow_cu_context_index(dis) != DW_DLV_OK) {
+        return DW_DLV_ERROR;
+    }
+    if (icu_context->cc_signature_present &&
+        grow_sig_hash(dis) != DW_DLV_OK) {
+        return DW_DLV_ERROR;
+    }
     /*  Add the context into the section context list.
         This is the one and only place where it is
         saved for re-use and eventual dealloc. */
@@ -1834,6 +1996,8 @@ insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
         /*  First cu encountered. */
         dis->de_cu_context_list = icu_context;
         dis->de_cu_context_list_end = icu_context;
+        insert_into_cu_context_index(dis,icu_context);
+        insert_into_sig_hash(dis,icu_context);
         return DW_DLV_OK;
     }
     if (!dis->de_cu_context_list_end) {
@@ -1844,6 +2008,8 @@ insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
         /* Normal case, add at end. */
         dis->de_cu_context_list_end->cc_next = icu_context;
         dis->de_cu_context_list_end = icu_context;
+        insert_into_cu_context_index(dis,icu_context);
+        insert_into_sig_hash(dis,icu_context);
         return DW_DLV_OK;
     }
     hoffset = dis->de_cu_context_list->cc_debug_offset;
@@ -1853,6 +2019,8 @@ insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
         dis->de_cu_context_list = icu_context;
         dis->de_cu_context_list->cc_next = next;
         /*  No need to touch de_cu_context_list_end */
+        insert_into_cu_context_index(dis,icu_context);
+        insert_into_sig_hash(dis,icu_context);
         return DW_DLV_OK;
     }
     cur = dis->de_cu_context_list;
@@ -1871,6 +2039,8 @@ insert_into_cu_context_list(Dwarf_Debug_InfoTypes dis,
                 ASSERT: past non-null  */
             past->cc_next = icu_context;
             icu_context->cc_next = cur;
+            insert_into_cu_context_index(dis,icu_context);
+            insert_into_sig_hash(dis,icu_context);
             return DW_DLV_OK;
         }
         past = cur;
@@ -2176,7 +2346,7 @@ _dwarf_next_cu_header_internal(Dwarf_Debug dbg,
             /*  This is safe since we know the
                 correct cu_context */
             res = _dwarf_siblingof_internal(dbg,NULL,
-                cu_context, is_info,&local_cudie,error);
+                cu_context, is_info,FALSE,&local_cudie,error);
             if (res != DW_DLV_OK) {
                 return res;
             }
@@ -2412,6 +2582,368 @@ dwarf_validate_die_sibling(Dwarf_Die sibling,Dwarf_Off *offset)
     return DW_DLV_ERROR;
 }
 
+/*  Returns the size of a fixed size FORM in *size_out
+    and DW_DLV_OK, or DW_DLV_NO_ENTRY with the op
+    to use in *op_out for variable size FORMs.
+    DW_DLV_ERROR means the FORM cannot be planned
+    (DW_FORM_indirect, or unknown) and no error
+    is recorded: the caller must use the
+    general code, which reports any error. */
+static int
+skip_plan_form(Dwarf_Half form,
+    Dwarf_CU_Context cu_context,
+    Dwarf_Unsigned *size_out,
+    Dwarf_Small *op_out)
+{
+    Dwarf_Unsigned size = 0;
+
+    switch (form) {
+    case 0:
+    case DW_FORM_flag_present:
+    case DW_FORM_implicit_const:
+        size = 0; break;
+    case DW_FORM_data1: case DW_FORM_ref1: case DW_FORM_flag:
+    case DW_FORM_addrx1: case DW_FORM_strx1:
+        size = 1; break;
+    case DW_FORM_data2: case DW_FORM_ref2:
+    case DW_FORM_addrx2: case DW_FORM_strx2:
+        size = 2; break;
+    case DW_FORM_addrx3: case DW_FORM_strx3:
+        size = 3; break;
+    case DW_FORM_data4: case DW_FORM_ref4: case DW_FORM_ref_sup4:
+    case DW_FORM_addrx4: case DW_FORM_strx4:
+        size = 4; break;
+    case DW_FORM_data8: case DW_FORM_ref8: case DW_FORM_ref_sup8:
+    case DW_FORM_ref_sig8:
+        size = 8; break;
+    case DW_FORM_data16:
+        size = 16; break;
+    case DW_FORM_addr:
+        size = cu_context->cc_address_size?
+            cu_context->cc_address_size:
+            cu_context->cc_dbg->de_pointer_size;
+        break;
+    case DW_FORM_ref_addr:
+        size = (cu_context->cc_version_stamp == DW_CU_VERSION2)?
+            cu_context->cc_address_size:
+            cu_context->cc_length_size;
+        break;
+    case DW_FORM_GNU_ref_alt: case DW_FORM_GNU_strp_alt:
+    case DW_FORM_strp_sup: case DW_FORM_sec_offset:
+    case DW_FORM_line_strp: case DW_FORM_strp:
+        size = cu_context->cc_length_size; break;
+    case DW_FORM_udata: case DW_FORM_sdata: case DW_FORM_ref_udata:
+    case DW_FORM_loclistx: case DW_FORM_rnglistx:
+    case DW_FORM_addrx: case DW_FORM_GNU_addr_index:
+    case DW_FORM_strx: case DW_FORM_GNU_str_index:
+        *op_out = ABL_SKIP_OP_LEB;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_block1:
+        *op_out = ABL_SKIP_OP_BLOCK1;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_block2:
+        *op_out = ABL_SKIP_OP_BLOCK2;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_block4:
+        *op_out = ABL_SKIP_OP_BLOCK4;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_block: case DW_FORM_exprloc:
+        *op_out = ABL_SKIP_OP_BLOCK;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_string:
+        *op_out = ABL_SKIP_OP_STRING;
+        return DW_DLV_NO_ENTRY;
+    case DW_FORM_LLVM_addrx_offset:
+        *op_out = ABL_SKIP_OP_LEB_4;
+        return DW_DLV_NO_ENTRY;
+    default:
+        return DW_DLV_ERROR;
+    }
+    *size_out = size;
+    return DW_DLV_OK;
+}
+
+/*  Fills in the abl_skip_* fields and abl_attr_place.
+    Only a malloc failure is an error. */
+static int
+build_abbrev_skip_plan(Dwarf_CU_Context cu_context,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned opcount = 0;
+    Dwarf_Unsigned fixed = 0;
+    struct Dwarf_Skip_Op_s *ops = 0;
+    struct Dwarf_Attr_Place_s *place = 0;
+
+    free(abl->abl_skip_ops);
+    abl->abl_skip_ops = 0;
+    free(abl->abl_attr_place);
+    abl->abl_attr_place = 0;
+    abl->abl_skip_op_count = 0;
+    abl->abl_skip_tail = 0;
+    abl->abl_has_sibling = FALSE;
+    abl->abl_skip_version = cu_context->cc_version_stamp;
+    abl->abl_skip_address_size = cu_context->cc_address_size;
+    abl->abl_skip_length_size = cu_context->cc_length_size;
+    abl->abl_skip_state = ABL_SKIP_UNUSABLE;
+    for (i = 0; i < abl->abl_abbrev_count; ++i) {
+        Dwarf_Unsigned size = 0;
+        Dwarf_Small op = 0;
+        int res = 0;
+
+        if (abl->abl_attr[i] == DW_AT_sibling) {
+            abl->abl_has_sibling = TRUE;
+        }
+        res = skip_plan_form(abl->abl_form[i],cu_context,
+            &size,&op);
+        if (res == DW_DLV_ERROR) {
+            return DW_DLV_OK;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            ++opcount;
+        }
+    }
+    if (opcount) {
+        ops = (struct Dwarf_Skip_Op_s *)calloc(opcount,
+            sizeof(struct Dwarf_Skip_Op_s));
+        if (!ops) {
+            _dwarf_error_string(cu_context->cc_dbg, error,
+                DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: Allocating an "
+                "abbrev skip plan");
+            return DW_DLV_ERROR;
+        }
+    }
+    if (abl->abl_abbrev_count) {
+        place = (struct Dwarf_Attr_Place_s *)calloc(
+            abl->abl_abbrev_count,
+            sizeof(struct Dwarf_Attr_Place_s));
+        if (!place) {
+            free(ops);
+            _dwarf_error_string(cu_context->cc_dbg, error,
+                DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: Allocating an "
+                "abbrev attribute place table");
+            return DW_DLV_ERROR;
+        }
+    }
+    opcount = 0;
+    for (i = 0; i < abl->abl_abbrev_count; ++i) {
+        Dwarf_Unsigned size = 0;
+        Dwarf_Small op = 0;
+        int res = 0;
+
+        place[i].ap_ops = opcount;
+        place[i].ap_fixed = fixed;
+        res = skip_plan_form(abl->abl_form[i],cu_context,
+            &size,&op);
+        if (res == DW_DLV_OK) {
+            fixed += size;
+            continue;
+        }
+        ops[opcount].so_fixed = fixed;
+        ops[opcount].so_op = op;
+        ++opcount;
+        fixed = 0;
+    }
+    abl->abl_skip_ops = ops;
+    abl->abl_skip_op_count = opcount;
+    abl->abl_skip_tail = fixed;
+    abl->abl_attr_place = place;
+    abl->abl_skip_state = ABL_SKIP_READY;
+    return DW_DLV_OK;
+}
+
+/*  Builds the skip plan if it is missing or was
+    built for a CU of a different version, address
+    size or offset size. */
+static int
+ensure_abbrev_skip_plan(Dwarf_CU_Context cu_context,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Error *error)
+{
+    if (abl->abl_skip_state == ABL_SKIP_NOT_BUILT ||
+        abl->abl_skip_version !=
+            cu_context->cc_version_stamp ||
+        abl->abl_skip_address_size !=
+            cu_context->cc_address_size ||
+        abl->abl_skip_length_size !=
+            cu_context->cc_length_size) {
+        return build_abbrev_skip_plan(cu_context,abl,error);
+    }
+    return DW_DLV_OK;
+}
+
+/*  Steps over the first opcount ops of the abbrev
+    skip plan, leaving *ptr_out just past the
+    variable size value of the last of them.
+    Returns DW_DLV_NO_ENTRY for anything that would
+    leave the CU: the caller then uses the general
+    code, which reports the error. */
+static int
+skip_plan_ops(Dwarf_Debug dbg,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Unsigned opcount,
+    Dwarf_Byte_Ptr info_ptr,
+    Dwarf_Byte_Ptr die_info_end,
+    Dwarf_Byte_Ptr *ptr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned left = 0;
+
+    for (i = 0; i < opcount; ++i) {
+        struct Dwarf_Skip_Op_s *op = abl->abl_skip_ops + i;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned leblen = 0;
+
+        left = (Dwarf_Unsigned)(die_info_end - info_ptr);
+        if (op->so_fixed > left) {
+            return DW_DLV_NO_ENTRY;
+        }
+        info_ptr += op->so_fixed;
+        left -= op->so_fixed;
+        switch (op->so_op) {
+        case ABL_SKIP_OP_LEB:
+        case ABL_SKIP_OP_LEB_4:
+            if (left && !(*info_ptr & 0x80)) {
+                leblen = 1;
+            } else if (_dwarf_skip_leb128((char *)info_ptr,
+                &leblen,(char *)die_info_end) != DW_DLV_OK) {
+                return DW_DLV_NO_ENTRY;
+            }
+            len = leblen;
+            if (op->so_op == ABL_SKIP_OP_LEB_4) {
+                len += SIZEOFT32;
+            }
+            break;
+        case ABL_SKIP_OP_BLOCK1:
+            if (!left) {
+                return DW_DLV_NO_ENTRY;
+            }
+            len = 1 + *info_ptr;
+            break;
+        case ABL_SKIP_OP_BLOCK2:
+        case ABL_SKIP_OP_BLOCK4: {
+            unsigned int lsize = (op->so_op == ABL_SKIP_OP_BLOCK2)?
+                DWARF_HALF_SIZE:DWARF_32BIT_SIZE;
+
+            if (left < lsize) {
+                return DW_DLV_NO_ENTRY;
+            }
+            READ_UNALIGNED_CK(dbg,len,Dwarf_Unsigned,
+                info_ptr,lsize,error,die_info_end);
+            len += lsize;
+            }
+            break;
+        case ABL_SKIP_OP_BLOCK:
+            if (dwarf_decode_leb128((char *)info_ptr,&leblen,
+                &len,(char *)die_info_end) != DW_DLV_OK) {
+                return DW_DLV_NO_ENTRY;
+            }
+            if (len > left) {
+                return DW_DLV_NO_ENTRY;
+            }
+            len += leblen;
+            break;
+        case ABL_SKIP_OP_STRING: {
+            Dwarf_Byte_Ptr nul = (Dwarf_Byte_Ptr)memchr(info_ptr,
+                0,(size_t)left);
+
+            if (!nul) {
+                return DW_DLV_NO_ENTRY;
+            }
+            len = (nul - info_ptr) + 1;
+            }
+            break;
+        default:
+            return DW_DLV_NO_ENTRY;
+        }
+        if (len > left) {
+            return DW_DLV_NO_ENTRY;
+        }
+        info_ptr += len;
+    }
+    *ptr_out = info_ptr;
+    return DW_DLV_OK;
+}
+
+/*  Steps over the attribute values of a DIE per
+    the abbrev skip plan. Returns DW_DLV_NO_ENTRY
+    as skip_plan_ops() does. */
+static int
+skip_die_by_plan(Dwarf_Debug dbg,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Byte_Ptr info_ptr,
+    Dwarf_Byte_Ptr die_info_end,
+    Dwarf_Byte_Ptr *next_die_ptr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned left = 0;
+    int res = 0;
+
+    res = skip_plan_ops(dbg,abl,abl->abl_skip_op_count,
+        info_ptr,die_info_end,&info_ptr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    left = (Dwarf_Unsigned)(die_info_end - info_ptr);
+    if (abl->abl_skip_tail > left) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *next_die_ptr_out = info_ptr + abl->abl_skip_tail;
+    return DW_DLV_OK;
+}
+
+/*  Finds the value of attribute attr_index of abl
+    in a DIE whose attribute values start at info_ptr,
+    using abl_attr_place: only variable size values
+    ahead of it are looked at, and when there are none
+    the value is at a fixed offset.
+    Returns DW_DLV_NO_ENTRY if the abbrev cannot be
+    planned (DW_FORM_indirect, unknown FORMs) or the
+    value would be outside the CU: the caller then
+    uses the general code, which reports any error. */
+int
+_dwarf_abbrev_attr_value_ptr(Dwarf_CU_Context cu_context,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Unsigned    attr_index,
+    Dwarf_Byte_Ptr    info_ptr,
+    Dwarf_Byte_Ptr    die_info_end,
+    Dwarf_Byte_Ptr   *value_ptr_out,
+    Dwarf_Error      *error)
+{
+    struct Dwarf_Attr_Place_s *place = 0;
+    Dwarf_Unsigned left = 0;
+    int res = 0;
+
+    if (!abl->abl_attr || attr_index >= abl->abl_abbrev_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = ensure_abbrev_skip_plan(cu_context,abl,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (abl->abl_skip_state != ABL_SKIP_READY) {
+        return DW_DLV_NO_ENTRY;
+    }
+    place = abl->abl_attr_place + attr_index;
+    if (place->ap_ops) {
+        res = skip_plan_ops(cu_context->cc_dbg,abl,place->ap_ops,
+            info_ptr,die_info_end,&info_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    left = (Dwarf_Unsigned)(die_info_end - info_ptr);
+    if (place->ap_fixed > left) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *value_ptr_out = info_ptr + place->ap_fixed;
+    return DW_DLV_OK;
+}
+
 /*  This function does two slightly different things
     depending on the input flag want_AT_sibling.  If
     this flag is TRUE, it checks if the input die has
@@ -2512,6 +3044,21 @@ _dwarf_next_die_info_ptr(Dwarf_Byte_Ptr die_info_ptr,
         are non-null and if  list->abl_implicit_const_count > 0
         list->abl_implicit_const is non-null. */
 
+    lres = ensure_abbrev_skip_plan(cu_context,abbrev_list,error);
+    if (lres != DW_DLV_OK) {
+        return lres;
+    }
+    if (abbrev_list->abl_skip_state == ABL_SKIP_READY &&
+        !(want_AT_sibling && abbrev_list->abl_has_sibling)) {
+        lres = skip_die_by_plan(dbg,abbrev_list,info_ptr,
+            die_info_end,next_die_ptr_out,error);
+        if (lres != DW_DLV_NO_ENTRY) {
+            return lres;
+        }
+        /*  Off the end of the CU. Let the code
+            below find and report exactly what is wrong. */
+    }
+
     for ( i = 0; i <abbrev_list->abl_abbrev_count; ++i) {
         /* Dwarf_Signed implicit_const = 0; */
         Dwarf_Half   attr = 0;
@@ -2774,7 +3321,7 @@ dwarf_siblingof_b(Dwarf_Debug dbg,
             dbg->de_types_reading.de_cu_context;
     }
     res = _dwarf_siblingof_internal(dbg,die,
-        context, is_info,caller_ret_die,error);
+        context, is_info,FALSE,caller_ret_die,error);
     return res;
 }
 
@@ -2790,11 +3337,84 @@ dwarf_siblingof_c(Dwarf_Die die,
     dbg =  die->di_cu_context->cc_dbg;
     is_info =  die->di_cu_context->cc_is_info;
     res = _dwarf_siblingof_internal(dbg,die,
-        die->di_cu_context, is_info,
+        die->di_cu_context, is_info,FALSE,
         caller_ret_die,error);
     return res;
 }
 
+/*  For the *_reuse() DIE functions.
+    A Dwarf_Die passed in to be overwritten must belong
+    to dbg, as dwarf_dealloc_die() will later find
+    the Dwarf_Debug through it. */
+static int
+check_reuse_die(Dwarf_Debug dbg,
+    Dwarf_Die *die_inout,
+    Dwarf_Error *error)
+{
+    if (!die_inout) {
+        _dwarf_error_string(dbg, error, DW_DLE_IA,
+            "DW_DLE_IA: a *_reuse() DIE function "
+            "was passed a NULL Dwarf_Die pointer");
+        return DW_DLV_ERROR;
+    }
+    if (*die_inout) {
+        CHECK_DIE(*die_inout,DW_DLV_ERROR);
+        if ((*die_inout)->di_cu_context->cc_dbg != dbg) {
+            _dwarf_error_string(dbg, error, DW_DLE_IA,
+                "DW_DLE_IA: a *_reuse() DIE function "
+                "was passed a Dwarf_Die to overwrite "
+                "that belongs to a different Dwarf_Debug");
+            return DW_DLV_ERROR;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  The DIE functions build a DIE in local_die and
+    only here copy it to a new Dwarf_Die or,
+    when reusing, over the caller's Dwarf_Die. */
+static int
+deliver_die(Dwarf_Debug dbg,
+    struct Dwarf_Die_s *local_die,
+    Dwarf_Bool reuse,
+    Dwarf_Die *die_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Die ret_die = 0;
+
+    if (reuse && *die_out) {
+        ret_die = *die_out;
+    } else {
+        ret_die = (Dwarf_Die) _dwarf_get_alloc(dbg, DW_DLA_DIE, 1);
+        if (!ret_die) {
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+    }
+    *ret_die = *local_die;
+    *die_out = ret_die;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_siblingof_reuse(Dwarf_Die die,
+    Dwarf_Die * die_inout, Dwarf_Error * error)
+{
+    int res = 0;
+    Dwarf_Debug dbg = 0;
+
+    CHECK_DIE(die,DW_DLV_ERROR);
+    dbg =  die->di_cu_context->cc_dbg;
+    res = check_reuse_die(dbg,die_inout,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_siblingof_internal(dbg,die,
+        die->di_cu_context, die->di_cu_context->cc_is_info,
+        TRUE,die_inout,error);
+    return res;
+}
+
 static int
 dw_start_load_root_die(Dwarf_Debug dbg,
     Dwarf_CU_Context context,
@@ -2846,9 +3466,11 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
     Dwarf_Die die,
     Dwarf_CU_Context context,
     Dwarf_Bool is_info,
+    Dwarf_Bool reuse,
     Dwarf_Die * caller_ret_die, Dwarf_Error * error)
 {
-    Dwarf_Die ret_die = 0;
+    struct Dwarf_Die_s local_die;
+    Dwarf_Die ret_die = &local_die;
     Dwarf_Byte_Ptr die_info_ptr = 0;
     Dwarf_Byte_Ptr cu_info_start = 0;
 
@@ -2866,6 +3488,7 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
         _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
         return DW_DLV_ERROR;
     }
+    memset(&local_die,0,sizeof(local_die));
     dataptr = is_info? dbg->de_debug_info.dss_data:
         dbg->de_debug_types.dss_data;
     if (!dataptr) {
@@ -3047,12 +3670,6 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
             later if actually reading DIEs*/
         return DW_DLV_NO_ENTRY;
     }
-    ret_die = (Dwarf_Die) _dwarf_get_alloc(dbg, DW_DLA_DIE, 1);
-    if (!ret_die) {
-        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
-
     ret_die->di_is_info = is_info;
     ret_die->di_debug_ptr = die_info_ptr;
     ret_die->di_cu_context =
@@ -3060,20 +3677,17 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
     dieres = _dwarf_leb128_uword_wrapper(dbg,
         &die_info_ptr,die_info_end,&utmp,error);
     if (dieres == DW_DLV_ERROR) {
-        dwarf_dealloc_die(ret_die);
         return dieres;
     }
     if (die_info_ptr > die_info_end) {
         /*  We managed to go past the end of the CU!.
             Something is badly wrong. */
-        dwarf_dealloc_die(ret_die);
         _dwarf_error(dbg, error, DW_DLE_ABBREV_DECODE_ERROR);
         return DW_DLV_ERROR;
     }
     abbrev_code = utmp;
     if (abbrev_code == 0) {
         /* Zero means a null DIE */
-        dwarf_dealloc_die(ret_die);
         return DW_DLV_NO_ENTRY;
     }
     ret_die->di_abbrev_code = abbrev_code;
@@ -3082,7 +3696,6 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
         &ret_die->di_abbrev_list,
         &highest_code,error);
     if (lres == DW_DLV_ERROR) {
-        dwarf_dealloc_die(ret_die);
         return lres;
     }
     if (lres == DW_DLV_NO_ENTRY) {
@@ -3091,7 +3704,6 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
 
         buf[0] = 0;
         dwarfstring_constructor_static(&m,buf,sizeof(buf));
-        dwarf_dealloc_die(ret_die);
         dwarfstring_append_printf_u(&m,
             "DW_DLE_DIE_ABBREV_LIST_NULL: "
             "There is no abbrev present for code %u"
@@ -3120,22 +3732,20 @@ _dwarf_siblingof_internal(Dwarf_Debug dbg,
             ret_die->di_abbrev_list,
             error);
         if (bres != DW_DLV_OK) {
-            dwarf_dealloc_die(ret_die);
             return bres;
         }
     }
 
     if (die == NULL && !is_cu_tag(ret_die->di_abbrev_list->abl_tag)) {
-        dwarf_dealloc_die(ret_die);
         _dwarf_error(dbg, error, DW_DLE_FIRST_DIE_NOT_CU);
         return DW_DLV_ERROR;
     }
-    *caller_ret_die = ret_die;
-    return DW_DLV_OK;
+    return deliver_die(dbg,&local_die,reuse,caller_ret_die,error);
 }
 
-int
-dwarf_child(Dwarf_Die die,
+static int
+_dwarf_child_internal(Dwarf_Die die,
+    Dwarf_Bool reuse,
     Dwarf_Die * caller_ret_die,
     Dwarf_Error * error)
 {
@@ -3144,7 +3754,8 @@ dwarf_child(Dwarf_Die die,
 
     /* die_info_end points one-past-end of die area. */
     Dwarf_Byte_Ptr die_info_end = 0;
-    Dwarf_Die ret_die = 0;
+    struct Dwarf_Die_s local_die;
+    Dwarf_Die ret_die = &local_die;
     Dwarf_Bool has_die_child = 0;
     Dwarf_Debug dbg;
     Dwarf_Unsigned abbrev_code = 0;
@@ -3156,6 +3767,7 @@ dwarf_child(Dwarf_Die die,
     Dwarf_Unsigned highest_code = 0;
 
     CHECK_DIE(die, DW_DLV_ERROR);
+    memset(&local_die,0,sizeof(local_die));
     dbg = die->di_cu_context->cc_dbg;
     dis = die->di_is_info? &dbg->de_info_reading:
         &dbg->de_types_reading;
@@ -3201,11 +3813,6 @@ dwarf_child(Dwarf_Die die,
         return DW_DLV_NO_ENTRY;
     }
 
-    ret_die = (Dwarf_Die) _dwarf_get_alloc(dbg, DW_DLA_DIE, 1);
-    if (!ret_die) {
-        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
     ret_die->di_debug_ptr = die_info_ptr;
     ret_die->di_cu_context = die->di_cu_context;
     ret_die->di_is_info = die->di_is_info;
@@ -3213,7 +3820,6 @@ dwarf_child(Dwarf_Die die,
     res =  _dwarf_leb128_uword_wrapper(dbg,&die_info_ptr,
         die_info_end, &utmp,error);
     if (res != DW_DLV_OK) {
-        dwarf_dealloc_die(ret_die);
         return res;
     }
     abbrev_code = (Dwarf_Unsigned) utmp;
@@ -3232,9 +3838,9 @@ dwarf_child(Dwarf_Die die,
         /*  We have arrived at a null DIE,
             at the end of a CU or the end
             of a list of siblings. */
-        *caller_ret_die = 0;
-        dwarf_dealloc(dbg, ret_die, DW_DLA_DIE);
-        ret_die = 0;
+        if (!reuse) {
+            *caller_ret_die = 0;
+        }
         return DW_DLV_NO_ENTRY;
     }
     ret_die->di_abbrev_code = abbrev_code;
@@ -3243,16 +3849,12 @@ dwarf_child(Dwarf_Die die,
         &ret_die->di_abbrev_list,
         &highest_code,error);
     if (lres == DW_DLV_ERROR) {
-        dwarf_dealloc(dbg, ret_die, DW_DLA_DIE);
-        ret_die = 0;
         return lres;
     }
     if (lres == DW_DLV_NO_ENTRY) {
         dwarfstring m;
 
         dwarfstring_constructor(&m);
-        dwarf_dealloc_die(ret_die);
-        ret_die = 0;
         dwarfstring_append_printf_u(&m,
             "DW_DLE_ABBREV_MISSING: the abbrev code not found "
             " in dwarf_child() is %u. ",abbrev_code);
@@ -3279,12 +3881,34 @@ dwarf_child(Dwarf_Die die,
             ret_die->di_abbrev_list,
             error);
         if (bres != DW_DLV_OK) {
-            dwarf_dealloc_die(ret_die);
             return bres;
         }
     }
-    *caller_ret_die = ret_die;
-    return DW_DLV_OK;
+    return deliver_die(dbg,&local_die,reuse,caller_ret_die,error);
+}
+
+int
+dwarf_child(Dwarf_Die die,
+    Dwarf_Die * caller_ret_die,
+    Dwarf_Error * error)
+{
+    return _dwarf_child_internal(die,FALSE,caller_ret_die,error);
+}
+
+int
+dwarf_child_reuse(Dwarf_Die die,
+    Dwarf_Die * die_inout,
+    Dwarf_Error * error)
+{
+    int res = 0;
+
+    CHECK_DIE(die,DW_DLV_ERROR);
+    res = check_reuse_die(die->di_cu_context->cc_dbg,
+        die_inout,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_child_internal(die,TRUE,die_inout,error);
 }
 
 /*  Given a (global, not cu_relative) die offset, this returns
@@ -3295,15 +3919,17 @@ dwarf_child(Dwarf_Die die,
     The new _b form works with debug_info or debug_types.
 
     */
-int
-dwarf_offdie_b(Dwarf_Debug dbg,
+static int
+_dwarf_offdie_internal(Dwarf_Debug dbg,
     Dwarf_Off offset, Dwarf_Bool is_info,
+    Dwarf_Bool reuse,
     Dwarf_Die * new_die, Dwarf_Error * error)
 {
     Dwarf_CU_Context cu_context = 0;
     Dwarf_Small     *dataptr = 0;
     Dwarf_Off        new_cu_offset = 0;
-    Dwarf_Die        die = 0;
+    struct Dwarf_Die_s local_die;
+    Dwarf_Die        die = &local_die;
     Dwarf_Byte_Ptr   info_ptr = 0;
     Dwarf_Unsigned   abbrev_code = 0;
     Dwarf_Unsigned   utmp = 0;
@@ -3313,7 +3939,7 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     Dwarf_Unsigned   highest_code = 0;
     struct Dwarf_Section_s * secdp = 0;
 
-    CHECK_DBG(dbg,error,"dwarf_offdie_b()");
+    memset(&local_die,0,sizeof(local_die));
     if (is_info) {
         dis =&dbg->de_info_reading;
         secdp = &dbg->de_debug_info;
@@ -3359,11 +3985,6 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     }
     /*  We have a cu_context for this offset. */
     die_info_end = _dwarf_calculate_info_section_end_ptr(cu_context);
-    die = (Dwarf_Die) _dwarf_get_alloc(dbg, DW_DLA_DIE, 1);
-    if (!die) {
-        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
     die->di_cu_context = cu_context;
     die->di_is_info = is_info;
     /*  dataptr above might be stale if we loaded a section
@@ -3377,14 +3998,11 @@ dwarf_offdie_b(Dwarf_Debug dbg,
     lres = _dwarf_leb128_uword_wrapper(dbg,&info_ptr,die_info_end,
         &utmp,error);
     if (lres != DW_DLV_OK) {
-        dwarf_dealloc_die(die);
         return lres;
     }
     abbrev_code = utmp;
     if (abbrev_code == 0) {
         /* we are at a null DIE (or there is a bug). */
-        dwarf_dealloc_die(die);
-        die = 0;
         return DW_DLV_NO_ENTRY;
     }
     die->di_abbrev_code = abbrev_code;
@@ -3392,15 +4010,11 @@ dwarf_offdie_b(Dwarf_Debug dbg,
         &die->di_abbrev_list,
         &highest_code,error);
     if (lres == DW_DLV_ERROR) {
-        dwarf_dealloc_die(die);
-        die = 0;
         return lres;
     }
     if (lres == DW_DLV_NO_ENTRY) {
         dwarfstring m;
 
-        dwarf_dealloc_die(die);
-        die = 0;
         dwarfstring_constructor(&m);
         dwarfstring_append_printf_u(&m,
             "DW_DLE_DIE_ABBREV_LIST_NULL: "
@@ -3432,12 +4046,36 @@ dwarf_offdie_b(Dwarf_Debug dbg,
             die->di_abbrev_list,
             error);
         if (bres != DW_DLV_OK) {
-            dwarf_dealloc_die(die);
             return bres;
         }
     }
-    *new_die = die;
-    return DW_DLV_OK;
+    return deliver_die(dbg,&local_die,reuse,new_die,error);
+}
+
+int
+dwarf_offdie_b(Dwarf_Debug dbg,
+    Dwarf_Off offset, Dwarf_Bool is_info,
+    Dwarf_Die * new_die, Dwarf_Error * error)
+{
+    CHECK_DBG(dbg,error,"dwarf_offdie_b()");
+    return _dwarf_offdie_internal(dbg,offset,is_info,
+        FALSE,new_die,error);
+}
+
+int
+dwarf_offdie_reuse(Dwarf_Debug dbg,
+    Dwarf_Off offset, Dwarf_Bool is_info,
+    Dwarf_Die * die_inout, Dwarf_Error * error)
+{
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_offdie_reuse()");
+    res = check_reuse_die(dbg,die_inout,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_offdie_internal(dbg,offset,is_info,
+        TRUE,die_inout,error);
 }
 
 /*  New March 2016.
@@ -3585,3 +4223,290 @@ dwarf_get_die_section_name_b(Dwarf_Die die,
     is_info = context->cc_is_info;
     return dwarf_get_die_section_name(dbg,is_info,sec_name,error);
 }
+
+int
+dwarf_make_die_cursor(Dwarf_Die die,
+    Dwarf_Die_Cursor *cursor_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Die_Cursor cursor = 0;
+    Dwarf_CU_Context context = 0;
+    Dwarf_Debug dbg = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    context = die->di_cu_context;
+    dbg = context->cc_dbg;
+    if (!cursor_out) {
+        _dwarf_error_string(dbg, error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_make_die_cursor() "
+            "was passed a NULL Dwarf_Die_Cursor pointer");
+        return DW_DLV_ERROR;
+    }
+    cursor = (Dwarf_Die_Cursor)calloc(1,
+        sizeof(struct Dwarf_Die_Cursor_s));
+    if (!cursor) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating a Dwarf_Die_Cursor");
+        return DW_DLV_ERROR;
+    }
+    cursor->dc_dbg = dbg;
+    cursor->dc_cu_context = context;
+    cursor->dc_is_info = die->di_is_info;
+    cursor->dc_section_data = die->di_is_info?
+        dbg->de_debug_info.dss_data:
+        dbg->de_debug_types.dss_data;
+    cursor->dc_cu_info_start = cursor->dc_section_data +
+        context->cc_debug_offset;
+    cursor->dc_die_info_end =
+        _dwarf_calculate_info_section_end_ptr(context);
+    cursor->dc_next_known = TRUE;
+    cursor->dc_next_ptr = die->di_debug_ptr;
+    cursor->dc_next_depth = 0;
+    *cursor_out = cursor;
+    return DW_DLV_OK;
+}
+
+/*  Step over the DIE at die_ptr, following DW_AT_sibling
+    if want_AT_sibling. */
+static int
+cursor_step(Dwarf_Die_Cursor cursor,
+    Dwarf_Byte_Ptr die_ptr,
+    Dwarf_Bool want_AT_sibling,
+    Dwarf_Bool *has_child,
+    Dwarf_Byte_Ptr *next_ptr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Byte_Ptr next_ptr = 0;
+    int res = 0;
+
+    res = _dwarf_next_die_info_ptr(die_ptr,
+        cursor->dc_cu_context, cursor->dc_die_info_end,
+        cursor->dc_cu_info_start, want_AT_sibling,
+        has_child, &next_ptr, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (next_ptr <= die_ptr) {
+        _dwarf_error_string(cursor->dc_dbg, error,
+            DW_DLE_NEXT_DIE_LOW_ERROR,
+            "DW_DLE_NEXT_DIE_LOW_ERROR: "
+            "the next DIE pointer of a Dwarf_Die_Cursor "
+            "does not follow the current one. Corrupt DWARF");
+        return DW_DLV_ERROR;
+    }
+    if (next_ptr > cursor->dc_die_info_end) {
+        _dwarf_error_string(cursor->dc_dbg, error,
+            DW_DLE_NEXT_DIE_PAST_END,
+            "DW_DLE_NEXT_DIE_PAST_END: "
+            "the next DIE of a Dwarf_Die_Cursor would be "
+            "past the end of the CU. Corrupt DWARF");
+        return DW_DLV_ERROR;
+    }
+    *next_ptr_out = next_ptr;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_cursor_next(Dwarf_Die_Cursor cursor,
+    Dwarf_Off      *offset_out,
+    Dwarf_Unsigned *depth_out,
+    Dwarf_Half     *tag_out,
+    Dwarf_Unsigned *abbrev_code_out,
+    Dwarf_Die      *die_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Byte_Ptr info_ptr = 0;
+    Dwarf_Byte_Ptr die_ptr = 0;
+    Dwarf_Unsigned depth = 0;
+    Dwarf_Unsigned abbrev_code = 0;
+    Dwarf_Unsigned highest_code = 0;
+    Dwarf_Abbrev_List abbrev_list = 0;
+    int res = 0;
+
+    if (!cursor) {
+        _dwarf_error_string(NULL, error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_die_cursor_next() "
+            "was passed a NULL Dwarf_Die_Cursor");
+        return DW_DLV_ERROR;
+    }
+    if (cursor->dc_done) {
+        return DW_DLV_NO_ENTRY;
+    }
+    dbg = cursor->dc_dbg;
+    if (!cursor->dc_next_known) {
+        Dwarf_Bool has_child = FALSE;
+
+        res = cursor_step(cursor,cursor->dc_die_ptr,FALSE,
+            &has_child,&cursor->dc_next_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        cursor->dc_next_depth = cursor->dc_has_child?
+            cursor->dc_depth+1:cursor->dc_depth;
+        cursor->dc_next_known = TRUE;
+    }
+    info_ptr = cursor->dc_next_ptr;
+    depth = cursor->dc_next_depth;
+    if (cursor->dc_die_ptr && !depth) {
+        /*  The top DIE has no (more) children. */
+        cursor->dc_done = TRUE;
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  A NUL byte ends a sibling list, moving out
+        one level. Running off the end of the CU
+        means the lists were not all terminated,
+        we treat that as the end, as
+        _dwarf_siblingof_internal() does. */
+    for (;;) {
+        if (info_ptr >= cursor->dc_die_info_end) {
+            cursor->dc_done = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+        if (*info_ptr) {
+            break;
+        }
+        ++info_ptr;
+        --depth;
+        if (!depth) {
+            cursor->dc_done = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    die_ptr = info_ptr;
+    res = _dwarf_leb128_uword_wrapper(dbg,
+        &info_ptr,cursor->dc_die_info_end,&abbrev_code,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_get_abbrev_for_code(cursor->dc_cu_context,
+        abbrev_code,&abbrev_list,&highest_code,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_u(&m,
+            "DW_DLE_DIE_ABBREV_LIST_NULL: "
+            "There is no abbrev present for code %u"
+            " in this compilation unit. ",
+            abbrev_code);
+        _dwarf_error_string(dbg, error,
+            DW_DLE_DIE_ABBREV_LIST_NULL,dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        return DW_DLV_ERROR;
+    }
+    if (!abbrev_list->abl_attr) {
+        res = _dwarf_fill_in_attr_form_abtable(
+            cursor->dc_cu_context,
+            abbrev_list->abl_abbrev_ptr,
+            _dwarf_calculate_abbrev_section_end_ptr(
+                cursor->dc_cu_context),
+            abbrev_list,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (die_out) {
+        struct Dwarf_Die_s local_die;
+
+        memset(&local_die,0,sizeof(local_die));
+        local_die.di_debug_ptr = die_ptr;
+        local_die.di_abbrev_list = abbrev_list;
+        local_die.di_cu_context = cursor->dc_cu_context;
+        local_die.di_abbrev_code = abbrev_code;
+        local_die.di_is_info = cursor->dc_is_info;
+        res = deliver_die(dbg,&local_die,TRUE,
+            &cursor->dc_die,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        *die_out = cursor->dc_die;
+    }
+    cursor->dc_die_ptr = die_ptr;
+    cursor->dc_depth = depth;
+    cursor->dc_has_child = abbrev_list->abl_has_child;
+    cursor->dc_next_known = FALSE;
+    if (offset_out) {
+        *offset_out = die_ptr - cursor->dc_section_data;
+    }
+    if (depth_out) {
+        *depth_out = depth;
+    }
+    if (tag_out) {
+        *tag_out = abbrev_list->abl_tag;
+    }
+    if (abbrev_code_out) {
+        *abbrev_code_out = abbrev_code;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_cursor_skip_children(Dwarf_Die_Cursor cursor,
+    Dwarf_Error *error)
+{
+    Dwarf_Bool has_child = FALSE;
+    Dwarf_Byte_Ptr info_ptr = 0;
+    Dwarf_Unsigned level = 0;
+    int res = 0;
+
+    if (!cursor || !cursor->dc_die_ptr) {
+        _dwarf_error_string(cursor?cursor->dc_dbg:NULL,
+            error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_die_cursor_skip_children() "
+            "needs a Dwarf_Die_Cursor that has returned a DIE");
+        return DW_DLV_ERROR;
+    }
+    if (cursor->dc_done || cursor->dc_next_known ||
+        !cursor->dc_has_child) {
+        return DW_DLV_OK;
+    }
+    res = cursor_step(cursor,cursor->dc_die_ptr,TRUE,
+        &has_child,&info_ptr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    /*  has_child is FALSE if DW_AT_sibling took us
+        straight to the sibling. Otherwise step over
+        the children, themselves using DW_AT_sibling
+        where they have it. */
+    level = has_child? 1:0;
+    while (level) {
+        if (info_ptr >= cursor->dc_die_info_end) {
+            break;
+        }
+        if (!*info_ptr) {
+            ++info_ptr;
+            --level;
+            continue;
+        }
+        res = cursor_step(cursor,info_ptr,TRUE,
+            &has_child,&info_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (has_child) {
+            ++level;
+        }
+    }
+    cursor->dc_next_ptr = info_ptr;
+    cursor->dc_next_depth = cursor->dc_depth;
+    cursor->dc_next_known = TRUE;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_die_cursor(Dwarf_Die_Cursor cursor)
+{
+    if (!cursor) {
+        return;
+    }
+    if (cursor->dc_die) {
+        dwarf_dealloc_die(cursor->dc_die);
+        cursor->dc_die = 0;
+    }
+    free(cursor);
+}
@@ -28,6 +28,35 @@ Portions Copyright (C) 2008-2023  David Anderson. All Rights Reserved.
 
 */
 
+/*  One step of an abbrev skip plan: advance so_fixed
+    bytes (the fixed size FORMs preceding), then step
+    over one variable size FORM value per so_op. */
+#define ABL_SKIP_OP_LEB      1 /* udata, sdata, strx etc. */
+#define ABL_SKIP_OP_BLOCK1   2
+#define ABL_SKIP_OP_BLOCK2   3
+#define ABL_SKIP_OP_BLOCK4   4
+#define ABL_SKIP_OP_BLOCK    5 /* block, exprloc: uleb length */
+#define ABL_SKIP_OP_STRING   6
+#define ABL_SKIP_OP_LEB_4    7 /* DW_FORM_LLVM_addrx_offset */
+struct Dwarf_Skip_Op_s {
+    Dwarf_Unsigned so_fixed;
+    Dwarf_Small    so_op;
+};
+
+/*  Where an attribute value starts, per the skip
+    plan: step over the first ap_ops skip ops, then
+    ap_fixed more bytes. With ap_ops zero the offset
+    from the end of the abbrev code is fixed. */
+struct Dwarf_Attr_Place_s {
+    Dwarf_Unsigned ap_ops;
+    Dwarf_Unsigned ap_fixed;
+};
+
+/*  abl_skip_state values. */
+#define ABL_SKIP_NOT_BUILT 0
+#define ABL_SKIP_READY     1
+#define ABL_SKIP_UNUSABLE  2 /* DW_FORM_indirect or unknown */
+
 /*
     This struct holds information about an abbreviation.
     It is put in the hash table for abbreviations for
@@ -75,4 +104,60 @@ struct Dwarf_Abbrev_List_s {
         for an implicit const value. */
     Dwarf_Signed  *abl_implicit_const;
 
+    /*  A skip plan, built on first use by
+        _dwarf_next_die_info_ptr(), so stepping over
+        a DIE does not size each FORM in turn.
+        The FORM sizes depend on the CU version,
+        address size and offset size, so the plan
+        records those and is rebuilt if they differ. */
+    Dwarf_Small    abl_skip_state;
+    Dwarf_Bool     abl_has_sibling;
+    Dwarf_Half     abl_skip_version;
+    Dwarf_Small    abl_skip_address_size;
+    Dwarf_Small    abl_skip_length_size;
+    Dwarf_Unsigned abl_skip_op_count;
+    struct Dwarf_Skip_Op_s *abl_skip_ops;
+    /*  Fixed bytes after the last op (or all of
+        them if no ops). */
+    Dwarf_Unsigned abl_skip_tail;
+    /*  Built with the skip plan, abl_abbrev_count
+        entries, so dwarf_attr() and the like find
+        a value without sizing each FORM before it. */
+    struct Dwarf_Attr_Place_s *abl_attr_place;
+};
+
+int _dwarf_abbrev_attr_value_ptr(Dwarf_CU_Context cu_context,
+    Dwarf_Abbrev_List abl,
+    Dwarf_Unsigned    attr_index,
+    Dwarf_Byte_Ptr    info_ptr,
+    Dwarf_Byte_Ptr    die_info_end,
+    Dwarf_Byte_Ptr   *value_ptr_out,
+    Dwarf_Error      *error);
+
+/*  State of a dwarf_make_die_cursor() walk.
+    dc_die_ptr is the DIE last returned (0 before
+    the first). When dc_next_known the next DIE
+    or NUL byte is at dc_next_ptr at depth
+    dc_next_depth, otherwise it is found by
+    stepping over the dc_die_ptr DIE. */
+struct Dwarf_Die_Cursor_s {
+    Dwarf_Debug      dc_dbg;
+    Dwarf_CU_Context dc_cu_context;
+    Dwarf_Bool       dc_is_info;
+    Dwarf_Small     *dc_section_data;
+    Dwarf_Byte_Ptr   dc_cu_info_start;
+    Dwarf_Byte_Ptr   dc_die_info_end;
+
+    Dwarf_Byte_Ptr   dc_die_ptr;
+    Dwarf_Unsigned   dc_depth;
+    Dwarf_Bool       dc_has_child;
+
+    Dwarf_Bool       dc_next_known;
+    Dwarf_Byte_Ptr   dc_next_ptr;
+    Dwarf_Unsigned   dc_next_depth;
+    Dwarf_Bool       dc_done;
+
+    /*  Allocated on first request and overwritten
+        for each DIE after that. */
+    Dwarf_Die        dc_die;
 };
@@ -67,9 +67,9 @@ calls
 #include "dwarf_reading.h"
 #include "dwarf_elf_defines.h"
 #include "dwarf_elfstructs.h"
+#include "dwarf_object_read_common.h"
 #include "dwarf_elfread.h"
 #include "dwarf_object_detector.h"
-#include "dwarf_object_read_common.h"
 #include "dwarf_util.h"
 #include "dwarf_secname_ck.h"
 
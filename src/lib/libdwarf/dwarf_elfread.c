@@ -199,7 +199,31 @@ static int elf_get_nolibelf_section_info(void *obj,
     return DW_DLV_NO_ENTRY;
 }
 
-/*  This interface does not support mmap. It is malloc only */
+/*  With Dwarf_Alloc_Mmap_Whole the section is simply
+    a pointer into the single mapping of the object.
+    Returns DW_DLV_NO_ENTRY if the caller should
+    load the section itself. */
+static int
+elf_load_from_whole_map(dwarf_elf_object_access_internals_t *elf,
+    struct generic_shdr *sp)
+{
+    Dwarf_Small *data = 0;
+    int res = 0;
+
+    res = _dwarf_whole_object_section(&elf->f_whole_map,
+        elf->f_fd,0,elf->f_filesize,
+        sp->gh_offset,sp->gh_size,&data);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    sp->gh_content = (char *)data;
+    sp->gh_was_alloc = FALSE;
+    sp->gh_load_type = Dwarf_Alloc_Mmap;
+    return DW_DLV_OK;
+}
+
+/*  This interface does not support mmap
+    other than Dwarf_Alloc_Mmap_Whole. It is malloc only */
 static int
 elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
     Dwarf_Small **return_data, int *errorc)
@@ -237,6 +261,11 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             *errorc = DW_DLE_ELF_SECTION_ERROR;
             return DW_DLV_ERROR;
         }
+        res = elf_load_from_whole_map(elf,sp);
+        if (res == DW_DLV_OK) {
+            *return_data = (Dwarf_Small *)sp->gh_content;
+            return DW_DLV_OK;
+        }
         sp->gh_load_type = Dwarf_Alloc_Malloc;
         sp->gh_content = malloc((size_t)sp->gh_size);
         if (!sp->gh_content) {
@@ -431,6 +460,17 @@ elf_load_nolibelf_section_a (void* obj,
                 return DW_DLV_NO_ENTRY;
             }
             secoffset = sp->gh_offset;
+            if (elf_load_from_whole_map(elf,sp) == DW_DLV_OK) {
+                *return_data_ptr = (Dwarf_Small *)sp->gh_content;
+                *dw_alloc_type = Dwarf_Alloc_Mmap;
+                *return_data_len = seclen;
+                /*  No per-section munmap: the mapping
+                    belongs to elf->f_whole_map. */
+                *return_mmap_base_ptr = 0;
+                *return_mmap_offset = 0;
+                *return_mmap_len = 0;
+                return DW_DLV_OK;
+            }
             res = _dwarf_mmap_calc(baseoff,secoffset,
                 seclen,elf->f_filesize,
                 &pageoff,&computed_mmaplen,
@@ -808,6 +848,7 @@ _dwarf_destruct_elf_nlaccess(void * obj)
         shp->gh_sht_group_array = 0;
         shp->gh_sht_group_array_count = 0;
     }
+    _dwarf_whole_object_unmap(&ep->f_whole_map);
     free(ep->f_shdr);
     ep->f_shdr = 0;
     ep->f_loc_shdr.g_count = 0;
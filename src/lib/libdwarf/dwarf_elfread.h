@@ -251,6 +251,9 @@ typedef struct elf_filedata_s {
     Dwarf_Unsigned f_sht_group_type_section_count;
     Dwarf_Unsigned f_shf_group_flag_section_count;
     Dwarf_Unsigned f_dwo_group_section_count;
+
+    /*  Used only with Dwarf_Alloc_Mmap_Whole. */
+    struct Dwarf_Whole_Object_Map_s f_whole_map;
 } dwarf_elf_object_access_internals_t;
 
 int dwarf_construct_elf_access(int fd,
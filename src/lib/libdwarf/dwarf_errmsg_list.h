@@ -696,6 +696,8 @@ static const char _dwarf_errmsgs[DW_DLE_LAST+1][DW_MAX_MSG_LEN] = {
 {"DW_DLE_DUPLICATE_NOTE_GNU_BUILD_ID(508) Duplicated section "},
 {"DW_DLE_SYSCONF_VALUE_UNUSABLE(509) sysconf() return is < 200 "
     "or greater than 100million"},
-{"DW_DLE_FRAME_ITERATOR_ERR(510) Error creating frame data"}
+{"DW_DLE_FRAME_ITERATOR_ERR(510) Error creating frame data"},
+{"DW_DLE_SECTION_WRITE_ERR(511) The producer section write "
+    "callback returned an error"}
 };
 #endif /* DWARF_ERRMSG_LIST_H */
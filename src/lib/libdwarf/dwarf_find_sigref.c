@@ -98,21 +98,14 @@ _dwarf_find_CU_Context_given_sig(Dwarf_Debug dbg,
         if (lres == DW_DLV_NO_ENTRY ) {
             continue;
         }
-        /* Lets see if we already have the CU we need. */
-        for (cu_context = dis->de_cu_context_list;
-            cu_context; cu_context = cu_context->cc_next) {
-            prev_cu_context = cu_context;
-
-            if (memcmp(sig_in,&cu_context->cc_signature,
-                sizeof(Dwarf_Sig8))) {
-                continue;
-            }
-            if (cu_context->cc_unit_type == DW_UT_split_type||
-                cu_context->cc_unit_type == DW_UT_type) {
-                *cu_context_out = cu_context;
-                *is_info_out = cu_context->cc_is_info;
-                return DW_DLV_OK;
-            }
+        /*  Lets see if we already have the CU we need.
+            Every context on the list is in the
+            signature hash. */
+        cu_context = _dwarf_find_type_unit_given_sig(dis,sig_in);
+        if (cu_context) {
+            *cu_context_out = cu_context;
+            *is_info_out = cu_context->cc_is_info;
+            return DW_DLV_OK;
         }
         if (context_level > 0) {
             /*  Make no attempt to create new context,
@@ -122,6 +115,8 @@ _dwarf_find_CU_Context_given_sig(Dwarf_Debug dbg,
                 DWARF4 debug_types  */
             continue;
         }
+        /*  Read on from the highest-offset context. */
+        prev_cu_context = dis->de_cu_context_list_end;
         if (prev_cu_context) {
             Dwarf_CU_Context lcu_context = prev_cu_context;
             new_cu_offset =
@@ -2380,3 +2380,183 @@ dwarf_formexprloc(Dwarf_Attribute attr,
     }
     return DW_DLV_ERROR;
 }
+
+/*  For dwarf_get_die_attr_values().
+    Decodes one attribute value with no Dwarf_Attribute
+    involved. value_size is the size
+    _dwarf_get_size_of_val() found for the value, already
+    known to fit before section_end.
+    Strings that cannot be found in this object
+    leave av_string NULL, that is not an error here. */
+int
+_dwarf_decode_attr_value(Dwarf_Debug dbg,
+    Dwarf_CU_Context cu_context,
+    Dwarf_Half       form,
+    Dwarf_Signed     implicit_const,
+    Dwarf_Byte_Ptr   data,
+    Dwarf_Unsigned   value_size,
+    Dwarf_Byte_Ptr   section_end,
+    Dwarf_Attr_Value *out,
+    Dwarf_Error     *error)
+{
+    Dwarf_Unsigned uval = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Unsigned lenlen = 0;
+    char          *str = 0;
+    int            res = 0;
+
+    out->av_form = form;
+    out->av_uvalue = 0;
+    out->av_svalue = 0;
+    out->av_string = 0;
+    out->av_data = data;
+    out->av_len = value_size;
+    switch (form) {
+    case DW_FORM_data1:
+    case DW_FORM_data2:
+    case DW_FORM_data4:
+    case DW_FORM_data8:
+    case DW_FORM_udata:
+    case DW_FORM_flag:
+    case DW_FORM_flag_present:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+        res = _dwarf_formudata_internal(dbg,0,form,data,
+            section_end,&out->av_uvalue,&lenlen,error);
+        return res;
+    case DW_FORM_sdata: {
+        Dwarf_Signed sval = 0;
+        Dwarf_Byte_Ptr tmp = data;
+
+        DECODE_LEB128_SWORD_CK(tmp,sval,
+            dbg,error,section_end);
+        out->av_svalue = sval;
+        out->av_uvalue = (Dwarf_Unsigned)sval;
+        return DW_DLV_OK;
+        }
+    case DW_FORM_implicit_const:
+        out->av_svalue = implicit_const;
+        out->av_uvalue = (Dwarf_Unsigned)implicit_const;
+        out->av_data = 0;
+        out->av_len = 0;
+        return DW_DLV_OK;
+    case DW_FORM_addr:
+        READ_UNALIGNED_CK(dbg,out->av_uvalue,Dwarf_Unsigned,
+            data,cu_context->cc_address_size,
+            error,section_end);
+        return DW_DLV_OK;
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index:
+        return _dwarf_get_addr_index_itself(form,data,dbg,
+            cu_context,&out->av_uvalue,error);
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+        if (form == DW_FORM_ref_udata) {
+            Dwarf_Byte_Ptr tmp = data;
+
+            DECODE_LEB128_UWORD_CK(tmp,uval,
+                dbg,error,section_end);
+        } else {
+            READ_UNALIGNED_CK(dbg,uval,Dwarf_Unsigned,
+                data,value_size,error,section_end);
+        }
+        if (uval >= cu_context->cc_length +
+            cu_context->cc_length_size +
+            cu_context->cc_extension_size) {
+            _dwarf_error(dbg, error, DW_DLE_ATTR_FORM_OFFSET_BAD);
+            return DW_DLV_ERROR;
+        }
+        out->av_uvalue = uval + cu_context->cc_debug_offset;
+        return DW_DLV_OK;
+    case DW_FORM_ref_addr:
+    case DW_FORM_sec_offset:
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_strp_sup:
+    case DW_FORM_ref_sup4:
+    case DW_FORM_ref_sup8:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_GNU_strp_alt:
+        if (value_size > sizeof(Dwarf_Unsigned)) {
+            _dwarf_error(dbg, error,
+                DW_DLE_FORM_SEC_OFFSET_LENGTH_BAD);
+            return DW_DLV_ERROR;
+        }
+        READ_UNALIGNED_CK(dbg,offset,Dwarf_Unsigned,
+            data,value_size,error,section_end);
+        out->av_uvalue = offset;
+        if (form != DW_FORM_strp && form != DW_FORM_line_strp) {
+            return DW_DLV_OK;
+        }
+        break;
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index:
+        res = _dwarf_read_str_index_val_itself(dbg,form,data,
+            section_end,&out->av_uvalue,0,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = _dwarf_extract_string_offset_via_str_offsets(dbg,
+            data,section_end,form,cu_context,&offset,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        break;
+    case DW_FORM_string:
+        out->av_string = (const char *)data;
+        return DW_DLV_OK;
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4:
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+        if (form == DW_FORM_block1) {
+            lenlen = 1;
+        } else if (form == DW_FORM_block2) {
+            lenlen = DWARF_HALF_SIZE;
+        } else if (form == DW_FORM_block4) {
+            lenlen = DWARF_32BIT_SIZE;
+        } else {
+            Dwarf_Byte_Ptr tmp = data;
+
+            DECODE_LEB128_UWORD_LEN_CK(tmp,uval,lenlen,
+                dbg,error,section_end);
+        }
+        if (lenlen > value_size) {
+            _dwarf_error(dbg, error,
+                DW_DLE_FORM_BLOCK_LENGTH_ERROR);
+            return DW_DLV_ERROR;
+        }
+        out->av_data = data + lenlen;
+        out->av_len = value_size - lenlen;
+        out->av_uvalue = out->av_len;
+        return DW_DLV_OK;
+    default:
+        /*  DW_FORM_data16, DW_FORM_ref_sig8 and the like:
+            the bytes are all there is. */
+        return DW_DLV_OK;
+    }
+    /*  The string forms with an offset in hand. */
+    res = _dwarf_extract_local_debug_str_string_given_offset(dbg,
+        form,offset,&str,error);
+    if (res == DW_DLV_OK) {
+        out->av_string = str;
+    } else if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    return DW_DLV_OK;
+}
@@ -663,10 +663,314 @@ dwarf_get_cie_info_b(Dwarf_Cie cie,
     return DW_DLV_OK;
 }
 
+/*  Run the CIE initial instructions, once per CIE,
+    into ci_initial_table. */
+static int
+make_cie_initial_table(Dwarf_Debug dbg,
+    Dwarf_Cie cie,
+    Dwarf_Unsigned cfa_reg_col_num,
+    Dwarf_Bool * has_more_rows,
+    Dwarf_Addr * subsequent_pc,
+    Dwarf_Error * error)
+{
+    Dwarf_Small *instrstart = cie->ci_cie_instr_start;
+    Dwarf_Small *instrend = instrstart +cie->ci_length +
+        cie->ci_length_size +
+        cie->ci_extension_size -
+        (cie->ci_cie_instr_start -
+        cie->ci_cie_start);
+    int res = 0;
+
+    if (instrend > cie->ci_cie_end) {
+        _dwarf_error(dbg, error,DW_DLE_CIE_INSTR_PTR_ERROR);
+        return DW_DLV_ERROR;
+    }
+    cie->ci_initial_table = (Dwarf_Frame)_dwarf_get_alloc(dbg,
+        DW_DLA_FRAME, 1);
+
+    if (cie->ci_initial_table == NULL) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    _dwarf_init_reg_rules_ru(cie->ci_initial_table->fr_reg,
+        0, cie->ci_initial_table->fr_reg_count,
+        dbg->de_frame_rule_initial_value);
+    _dwarf_init_reg_rules_ru(&cie->ci_initial_table->fr_cfa_rule,
+        0,1,dbg->de_frame_rule_initial_value);
+    res = _dwarf_exec_frame_instr( /* make_instr= */ FALSE,
+        /* search_pc */ FALSE,
+        /* search_pc_val */ 0,
+        /* location */ 0,
+        instrstart,
+        instrend,
+        cie->ci_initial_table,
+        cie, dbg,
+        cfa_reg_col_num,
+        has_more_rows,
+        subsequent_pc,
+        NULL,NULL,
+        NULL /* no iterator data, no callback here*/,
+        error);
+    return res;
+}
+
+static void
+fde_free_rows(Dwarf_Fde fde)
+{
+    free(fde->fd_rows);
+    fde->fd_rows = 0;
+    fde->fd_row_count = 0;
+    fde->fd_row_alloc = 0;
+    free(fde->fd_row_regs);
+    fde->fd_row_regs = 0;
+    fde->fd_row_reg_count = 0;
+    fde->fd_row_reg_alloc = 0;
+}
+
+static Dwarf_Bool
+same_reg_rule(struct Dwarf_Reg_Rule_s *l,
+    struct Dwarf_Reg_Rule_s *r)
+{
+    if (l->ru_is_offset != r->ru_is_offset ||
+        l->ru_value_type != r->ru_value_type ||
+        l->ru_register != r->ru_register ||
+        l->ru_offset != r->ru_offset ||
+        l->ru_args_size != r->ru_args_size ||
+        l->ru_block.bl_len != r->ru_block.bl_len ||
+        l->ru_block.bl_data != r->ru_block.bl_data ||
+        l->ru_block.bl_from_loclist !=
+            r->ru_block.bl_from_loclist ||
+        l->ru_block.bl_section_offset !=
+            r->ru_block.bl_section_offset) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+struct fde_rows_build_s {
+    Dwarf_Fde   rb_fde;
+    Dwarf_Frame rb_table;
+    Dwarf_Frame rb_initial;
+    Dwarf_Bool  rb_unordered;
+};
+
+/*  The dwarf_iterate_fde_callback_function_type
+    callback used to record each row. It reads the
+    internal rules (rb_table), not the Dwarf_Regtable3. */
+static int
+fde_rows_callback(Dwarf_Regtable3 *reg_table,
+    Dwarf_Addr row_pc,
+    Dwarf_Bool has_more_rows,
+    Dwarf_Addr subsequent_pc,
+    void *user_data)
+{
+    struct fde_rows_build_s *rb = user_data;
+    Dwarf_Fde   fde = rb->rb_fde;
+    Dwarf_Frame table = rb->rb_table;
+    Dwarf_Frame initial = rb->rb_initial;
+    struct Dwarf_Frame_Row_s *row = 0;
+    Dwarf_Unsigned r = 0;
+
+    (void)reg_table;
+    (void)has_more_rows;
+    (void)subsequent_pc;
+    if (fde->fd_row_count == fde->fd_row_alloc) {
+        Dwarf_Unsigned newalloc = fde->fd_row_alloc?
+            fde->fd_row_alloc*2: 16;
+        struct Dwarf_Frame_Row_s *newrows =
+            (struct Dwarf_Frame_Row_s *)realloc(fde->fd_rows,
+            newalloc*sizeof(struct Dwarf_Frame_Row_s));
+
+        if (!newrows) {
+            return DW_DLV_ERROR;
+        }
+        fde->fd_rows = newrows;
+        fde->fd_row_alloc = newalloc;
+    }
+    if (fde->fd_row_count &&
+        row_pc < fde->fd_rows[fde->fd_row_count-1].fw_loc) {
+        rb->rb_unordered = TRUE;
+    }
+    row = &fde->fd_rows[fde->fd_row_count];
+    row->fw_loc = row_pc;
+    row->fw_cfa_rule = table->fr_cfa_rule;
+    row->fw_first_reg = fde->fd_row_reg_count;
+    for (r = 0; r < table->fr_reg_count; ++r) {
+        struct Dwarf_Frame_Row_Reg_s *rr = 0;
+
+        if (r < initial->fr_reg_count &&
+            same_reg_rule(&table->fr_reg[r],&initial->fr_reg[r])) {
+            continue;
+        }
+        if (fde->fd_row_reg_count == fde->fd_row_reg_alloc) {
+            Dwarf_Unsigned newalloc = fde->fd_row_reg_alloc?
+                fde->fd_row_reg_alloc*2: 32;
+            struct Dwarf_Frame_Row_Reg_s *newregs =
+                (struct Dwarf_Frame_Row_Reg_s *)realloc(
+                fde->fd_row_regs,
+                newalloc*sizeof(struct Dwarf_Frame_Row_Reg_s));
+
+            if (!newregs) {
+                return DW_DLV_ERROR;
+            }
+            fde->fd_row_regs = newregs;
+            fde->fd_row_reg_alloc = newalloc;
+        }
+        rr = &fde->fd_row_regs[fde->fd_row_reg_count];
+        rr->rr_regnum = r;
+        rr->rr_rule = table->fr_reg[r];
+        ++fde->fd_row_reg_count;
+    }
+    row->fw_reg_count = fde->fd_row_reg_count - row->fw_first_reg;
+    ++fde->fd_row_count;
+    return DW_DLV_OK;
+}
+
+/*  Run the FDE instructions once, recording every row
+    through the iterator callback. Any failure just
+    leaves the rows unusable: lookups then run the
+    instructions per pc as before and report
+    any error there. */
+static void
+fde_build_rows(Dwarf_Debug dbg,
+    Dwarf_Fde fde,
+    Dwarf_Small *instr_end,
+    Dwarf_Unsigned cfa_reg_col_num)
+{
+    struct Dwarf_Frame_s table;
+    Dwarf_Regtable3 reg_table;
+    struct Dwarf_Allreg_Args_s allreg_data;
+    struct fde_rows_build_s rb;
+    Dwarf_Unsigned reg_count = dbg->de_frame_reg_rules_entry_count;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    fde->fd_rows_state = FDE_ROWS_UNUSABLE;
+    memset(&reg_table,0,sizeof(reg_table));
+    memset(&allreg_data,0,sizeof(allreg_data));
+    memset(&rb,0,sizeof(rb));
+    res = _dwarf_initialize_fde_frame_table(dbg, &table,
+        reg_count, &err);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,err);
+        }
+        return;
+    }
+    /*  _dwarf_rule_copy() fills reg_count rules
+        of the Dwarf_Regtable3 for each row, unused here. */
+    reg_table.rt3_reg_table_size = (Dwarf_Half)reg_count;
+    reg_table.rt3_rules = (struct Dwarf_Regtable_Entry3_s *)
+        calloc(reg_count,sizeof(struct Dwarf_Regtable_Entry3_s));
+    if (!reg_table.rt3_rules) {
+        _dwarf_empty_fde_frame_table(&table);
+        return;
+    }
+    rb.rb_fde = fde;
+    rb.rb_table = &table;
+    rb.rb_initial = fde->fd_cie->ci_initial_table;
+    allreg_data.aa_dbg = dbg;
+    allreg_data.aa_callback = fde_rows_callback;
+    allreg_data.aa_user_data = &rb;
+    allreg_data.aa_regtab3 = &reg_table;
+    allreg_data.aa_frameregtable = &table;
+    table.fr_loc = fde->fd_initial_location;
+    res = _dwarf_exec_frame_instr( /* make_instr= */ FALSE,
+        /* search_pc */ FALSE,
+        /* search_pc_val */ 0,
+        fde->fd_initial_location,
+        fde->fd_fde_instr_start,
+        instr_end,
+        &table,
+        fde->fd_cie,dbg,
+        cfa_reg_col_num,
+        NULL,NULL,
+        NULL,NULL,
+        &allreg_data,
+        &err);
+    free(reg_table.rt3_rules);
+    _dwarf_empty_fde_frame_table(&table);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    if (res != DW_DLV_OK || rb.rb_unordered || !fde->fd_row_count) {
+        fde_free_rows(fde);
+        return;
+    }
+    fde->fd_rows_reg_count = reg_count;
+    fde->fd_rows_cfa_col = cfa_reg_col_num;
+    fde->fd_rows_state = FDE_ROWS_READY;
+}
+
+/*  Fill table with the row for pc_requested from the
+    row cache, just as searching the instructions
+    would: the last row starting at or before the pc. */
+static int
+fde_row_for_pc(Dwarf_Fde fde,
+    Dwarf_Addr pc_requested,
+    Dwarf_Frame table,
+    Dwarf_Bool * has_more_rows,
+    Dwarf_Addr * subsequent_pc)
+{
+    Dwarf_Frame initial = fde->fd_cie->ci_initial_table;
+    struct Dwarf_Frame_Row_s *row = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = fde->fd_row_count;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned r = 0;
+
+    /*  Find the first row starting after pc_requested. */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (fde->fd_rows[mid].fw_loc <= pc_requested) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo) {
+        return DW_DLV_NO_ENTRY;
+    }
+    row = &fde->fd_rows[lo-1];
+    count = MIN(table->fr_reg_count, initial->fr_reg_count);
+    for (r = 0; r < count; ++r) {
+        table->fr_reg[r] = initial->fr_reg[r];
+    }
+    for (r = 0; r < row->fw_reg_count; ++r) {
+        struct Dwarf_Frame_Row_Reg_s *rr =
+            &fde->fd_row_regs[row->fw_first_reg + r];
+
+        if (rr->rr_regnum < count) {
+            table->fr_reg[rr->rr_regnum] = rr->rr_rule;
+        }
+    }
+    table->fr_cfa_rule = row->fw_cfa_rule;
+    table->fr_loc = row->fw_loc;
+    if (lo < fde->fd_row_count) {
+        if (has_more_rows) {
+            *has_more_rows = TRUE;
+        }
+        if (subsequent_pc) {
+            *subsequent_pc = fde->fd_rows[lo].fw_loc;
+        }
+    } else {
+        if (has_more_rows) {
+            *has_more_rows = FALSE;
+        }
+        if (subsequent_pc) {
+            *subsequent_pc = 0;
+        }
+    }
+    return DW_DLV_OK;
+}
+
 /* Return the register rules for all registers at
    a given pc. If iterator_data is non-null
    we will be calling this just once using
    the iterator_data and its callback pointer.
+   Otherwise, from the second call for an fde on,
+   the answer comes from the fde row cache.
 */
 int
 _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
@@ -701,42 +1005,8 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
 
     cie = fde->fd_cie;
     if (cie->ci_initial_table == NULL) {
-        Dwarf_Small *instrstart = cie->ci_cie_instr_start;
-        Dwarf_Small *instrend = instrstart +cie->ci_length +
-            cie->ci_length_size +
-            cie->ci_extension_size -
-            (cie->ci_cie_instr_start -
-            cie->ci_cie_start);
-        if (instrend > cie->ci_cie_end) {
-            _dwarf_error(dbg, error,DW_DLE_CIE_INSTR_PTR_ERROR);
-            return DW_DLV_ERROR;
-        }
-        cie->ci_initial_table = (Dwarf_Frame)_dwarf_get_alloc(dbg,
-            DW_DLA_FRAME, 1);
-
-        if (cie->ci_initial_table == NULL) {
-            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-            return DW_DLV_ERROR;
-        }
-        _dwarf_init_reg_rules_ru(cie->ci_initial_table->fr_reg,
-            0, cie->ci_initial_table->fr_reg_count,
-            dbg->de_frame_rule_initial_value);
-        _dwarf_init_reg_rules_ru(&cie->ci_initial_table->fr_cfa_rule,
-            0,1,dbg->de_frame_rule_initial_value);
-        res = _dwarf_exec_frame_instr( /* make_instr= */ FALSE,
-            /* search_pc */ FALSE,
-            /* search_pc_val */ 0,
-            /* location */ 0,
-            instrstart,
-            instrend,
-            cie->ci_initial_table,
-            cie, dbg,
-            cfa_reg_col_num,
-            has_more_rows,
-            subsequent_pc,
-            NULL,NULL,
-            NULL /* no iterator data, no callback here*/,
-            error);
+        res = make_cie_initial_table(dbg,cie,cfa_reg_col_num,
+            has_more_rows,subsequent_pc,error);
         if (res != DW_DLV_OK) {
             return res;
         }
@@ -750,6 +1020,30 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
             _dwarf_error(dbg, error,DW_DLE_FDE_INSTR_PTR_ERROR);
             return DW_DLV_ERROR;
         }
+        if (!iterator_data) {
+            if (fde->fd_rows_state == FDE_ROWS_READY &&
+                (fde->fd_rows_reg_count !=
+                dbg->de_frame_reg_rules_entry_count ||
+                fde->fd_rows_cfa_col != cfa_reg_col_num)) {
+                /*  The frame table settings changed. */
+                fde_free_rows(fde);
+                fde->fd_rows_state = FDE_ROWS_NOT_BUILT;
+                fde->fd_rows_lookups = 0;
+            }
+            /*  A single lookup per fde is cheaper done by
+                running the instructions up to the pc. */
+            if (fde->fd_rows_state == FDE_ROWS_NOT_BUILT &&
+                ++fde->fd_rows_lookups > 1) {
+                fde_build_rows(dbg,fde,instr_end,cfa_reg_col_num);
+            }
+            if (fde->fd_rows_state == FDE_ROWS_READY) {
+                res = fde_row_for_pc(fde,pc_requested,table,
+                    has_more_rows,subsequent_pc);
+                if (res == DW_DLV_OK) {
+                    return res;
+                }
+            }
+        }
         res = _dwarf_exec_frame_instr( /* make_instr= */ FALSE,
             /* search_pc */ TRUE,
             pc_requested,
@@ -1775,6 +2069,7 @@ _dwarf_fde_destructor(void *f)
         _dwarf_empty_fde_frame_table(&fde->fd_fde_frame_table);
         fde->fd_have_fde_tab = FALSE;
     }
+    fde_free_rows(fde);
 }
 void
 _dwarf_frame_instr_destructor(void *f)
@@ -316,6 +316,27 @@ struct Dwarf_Cie_s {
     points to the start of the instructions for this Fde.  Fd_dbg
     points to the associated Dwarf_Debug structure.
 */
+/*  One row of an FDE's frame table as kept in
+    the Dwarf_Fde row cache. Only the register rules
+    differing from the CIE ci_initial_table are kept:
+    the fw_reg_count entries of fd_row_regs starting
+    at fw_first_reg. */
+struct Dwarf_Frame_Row_s {
+    Dwarf_Addr              fw_loc;
+    struct Dwarf_Reg_Rule_s fw_cfa_rule;
+    Dwarf_Unsigned          fw_first_reg;
+    Dwarf_Unsigned          fw_reg_count;
+};
+struct Dwarf_Frame_Row_Reg_s {
+    Dwarf_Unsigned          rr_regnum;
+    struct Dwarf_Reg_Rule_s rr_rule;
+};
+
+/*  Values of fd_rows_state */
+#define FDE_ROWS_NOT_BUILT 0
+#define FDE_ROWS_READY     1
+#define FDE_ROWS_UNUSABLE  2
+
 struct Dwarf_Fde_s {
     Dwarf_Unsigned fd_length;
     Dwarf_Addr     fd_cie_offset;
@@ -368,6 +389,24 @@ struct Dwarf_Fde_s {
 
     /*  Set by dwarf_get_fde_for_die() */
     Dwarf_Bool     fd_fde_owns_cie;
+
+    /*  The whole frame table of the FDE, built by
+        running the CIE and FDE instructions once
+        when a second row is asked for, so walking
+        all the rows is not quadratic.
+        See fde_build_rows() in dwarf_frame.c.
+        Built for fd_rows_reg_count registers
+        and CFA column fd_rows_cfa_col. */
+    Dwarf_Small    fd_rows_state;
+    Dwarf_Unsigned fd_rows_lookups;
+    Dwarf_Unsigned fd_rows_reg_count;
+    Dwarf_Unsigned fd_rows_cfa_col;
+    Dwarf_Unsigned fd_row_count;
+    Dwarf_Unsigned fd_row_alloc;
+    struct Dwarf_Frame_Row_s *fd_rows;
+    Dwarf_Unsigned fd_row_reg_count;
+    Dwarf_Unsigned fd_row_reg_alloc;
+    struct Dwarf_Frame_Row_Reg_s *fd_row_regs;
 };
 
 int
@@ -541,6 +580,29 @@ _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
     }                                                  \
     } while (0)
 
+/*  The header of a table from dwarf_make_unwind_table().
+    Followed by uh_row_count row pcs (Dwarf_Addr)
+    at uh_pc_offset then uh_row_count times
+    uh_rules_per_row Dwarf_Unwind_Rule at
+    uh_rules_offset. Every part is 8 byte aligned.
+    uh_byte_order is UNWIND_TABLE_BYTE_ORDER as
+    written, so a table from a host of the other
+    byte order is recognized and rejected. */
+#define UNWIND_TABLE_MAGIC      "DWUNWTAB"
+#define UNWIND_TABLE_MAGIC_LEN  8
+#define UNWIND_TABLE_VERSION    1
+#define UNWIND_TABLE_BYTE_ORDER 0x0102030405060708ULL
+struct Dwarf_Unwind_Table_Header_s {
+    char           uh_magic[UNWIND_TABLE_MAGIC_LEN];
+    Dwarf_Unsigned uh_byte_order;
+    Dwarf_Unsigned uh_version;
+    Dwarf_Unsigned uh_table_size;
+    Dwarf_Unsigned uh_row_count;
+    Dwarf_Unsigned uh_rules_per_row;
+    Dwarf_Unsigned uh_pc_offset;
+    Dwarf_Unsigned uh_rules_offset;
+};
+
 int _dwarf_frame_constructor(Dwarf_Debug dbg,void * );
 void _dwarf_frame_destructor (void *);
 void _dwarf_fde_destructor (void *);
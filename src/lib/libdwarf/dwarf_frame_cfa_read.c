@@ -630,6 +630,9 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
                     SER(DW_DLE_DF_NEW_LOC_LESS_OLD_LOC);
                 }
             }
+            /*  The iterator needs the new location too,
+                not the one from an earlier advance. */
+            possible_subsequent_pc =  new_loc;
             if (iter_data && instr_ptr > start_instr_ptr) {
                 int errcode = 0;
                 local_has_more_rows =
@@ -649,7 +652,6 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
             }
             search_over = search_pc && (new_loc > search_pc_val);
             /* If gone past pc needed, retain old pc.  */
-            possible_subsequent_pc =  new_loc;
             if (!search_over) {
                 current_loc = possible_subsequent_pc;
             }
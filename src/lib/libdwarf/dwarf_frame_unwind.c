@@ -0,0 +1,577 @@
+/*
+  Copyright (C) 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Flattens the frame rows of a list of FDEs into
+    one sorted table of precomputed rules so an
+    unwinder can find the rules for a pc with a
+    binary search and no CFA interpretation.
+    The table has no pointers and so can be
+    saved to a file and mapped in later. */
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() malloc() realloc() */
+#include <string.h> /* memcmp() memcpy() memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dwarf_local_malloc.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_frame.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+
+#define UNWIND_INITIAL_ROWS 64
+
+/*  The rows being built. */
+struct unwind_build_s {
+    Dwarf_Unsigned     ub_rules_per_row;
+    Dwarf_Unsigned     ub_row_count;
+    Dwarf_Unsigned     ub_row_alloc;
+    Dwarf_Addr        *ub_pcs;
+    Dwarf_Unwind_Rule *ub_rules;
+    /*  Scratch for the rules of the row being added. */
+    Dwarf_Unwind_Rule *ub_new_rules;
+};
+
+static void
+ub_free(struct unwind_build_s *ub)
+{
+    free(ub->ub_pcs);
+    ub->ub_pcs = 0;
+    free(ub->ub_rules);
+    ub->ub_rules = 0;
+    free(ub->ub_new_rules);
+    ub->ub_new_rules = 0;
+}
+
+/*  Appends ub_new_rules as a row at pc, unless
+    the previous row has the same rules, which
+    makes the new row redundant. A row at the same
+    pc as the previous row replaces it. */
+static int
+ub_add_row(struct unwind_build_s *ub, Dwarf_Addr pc)
+{
+    Dwarf_Unsigned rpr = ub->ub_rules_per_row;
+    size_t rowbytes = (size_t)rpr * sizeof(Dwarf_Unwind_Rule);
+
+    if (ub->ub_row_count) {
+        Dwarf_Unsigned last = ub->ub_row_count - 1;
+        Dwarf_Unwind_Rule *lastrules = ub->ub_rules + last*rpr;
+
+        if (ub->ub_pcs[last] == pc) {
+            ub->ub_row_count = last;
+            if (last && !memcmp(lastrules - rpr,
+                ub->ub_new_rules,rowbytes)) {
+                return DW_DLV_OK;
+            }
+        } else if (!memcmp(lastrules,ub->ub_new_rules,rowbytes)) {
+            return DW_DLV_OK;
+        }
+    }
+    if (ub->ub_row_count >= ub->ub_row_alloc) {
+        Dwarf_Unsigned newalloc = ub->ub_row_alloc?
+            ub->ub_row_alloc*2:UNWIND_INITIAL_ROWS;
+        Dwarf_Addr *newpcs = 0;
+        Dwarf_Unwind_Rule *newrules = 0;
+
+        if (newalloc <= ub->ub_row_alloc ||
+            (newalloc*rpr)/rpr != newalloc) {
+            return DW_DLV_ERROR;
+        }
+        newpcs = (Dwarf_Addr *)realloc(ub->ub_pcs,
+            (size_t)newalloc*sizeof(Dwarf_Addr));
+        if (!newpcs) {
+            return DW_DLV_ERROR;
+        }
+        ub->ub_pcs = newpcs;
+        newrules = (Dwarf_Unwind_Rule *)realloc(ub->ub_rules,
+            (size_t)(newalloc*rpr)*sizeof(Dwarf_Unwind_Rule));
+        if (!newrules) {
+            return DW_DLV_ERROR;
+        }
+        ub->ub_rules = newrules;
+        ub->ub_row_alloc = newalloc;
+    }
+    ub->ub_pcs[ub->ub_row_count] = pc;
+    memcpy(ub->ub_rules + ub->ub_row_count*rpr,
+        ub->ub_new_rules,rowbytes);
+    ++ub->ub_row_count;
+    return DW_DLV_OK;
+}
+
+/*  A row with every rule undefined: no FDE
+    covers the pcs from here to the next row. */
+static int
+ub_add_gap_row(struct unwind_build_s *ub, Dwarf_Addr pc)
+{
+    memset(ub->ub_new_rules,0,
+        (size_t)ub->ub_rules_per_row*sizeof(Dwarf_Unwind_Rule));
+    return ub_add_row(ub,pc);
+}
+
+static void
+convert_rule(Dwarf_Debug dbg,
+    Dwarf_Regtable_Entry3 *entry,
+    Dwarf_Half column,
+    Dwarf_Unwind_Rule *out)
+{
+    memset(out,0,sizeof(*out));
+    out->ur_column = column;
+    switch (entry->dw_value_type) {
+    case DW_EXPR_OFFSET:
+        if (entry->dw_offset_relevant) {
+            out->ur_kind = DW_UNWIND_OFFSET;
+            out->ur_offset = (Dwarf_Signed)entry->dw_offset;
+        } else if (entry->dw_regnum ==
+            dbg->de_frame_same_value_number) {
+            out->ur_kind = DW_UNWIND_SAME_VALUE;
+        } else if (entry->dw_regnum ==
+            dbg->de_frame_undefined_value_number) {
+            out->ur_kind = DW_UNWIND_UNDEFINED;
+        } else {
+            out->ur_kind = DW_UNWIND_REGISTER;
+            out->ur_register = entry->dw_regnum;
+        }
+        break;
+    case DW_EXPR_VAL_OFFSET:
+        out->ur_kind = DW_UNWIND_VAL_OFFSET;
+        out->ur_offset = (Dwarf_Signed)entry->dw_offset;
+        break;
+    case DW_EXPR_VAL_EXPRESSION:
+        out->ur_kind = DW_UNWIND_VAL_EXPRESSION;
+        break;
+    default:
+        out->ur_kind = DW_UNWIND_EXPRESSION;
+        break;
+    }
+}
+
+static void
+convert_cfa_rule(Dwarf_Debug dbg,
+    Dwarf_Regtable_Entry3 *entry,
+    Dwarf_Unwind_Rule *out)
+{
+    memset(out,0,sizeof(*out));
+    out->ur_column = (Dwarf_Half)dbg->de_frame_cfa_col_number;
+    if (entry->dw_value_type == DW_EXPR_OFFSET) {
+        if (entry->dw_regnum ==
+            dbg->de_frame_undefined_value_number ||
+            entry->dw_regnum == dbg->de_frame_same_value_number) {
+            out->ur_kind = DW_UNWIND_UNDEFINED;
+            return;
+        }
+        out->ur_kind = DW_UNWIND_CFA_REG_OFFSET;
+        out->ur_register = entry->dw_regnum;
+        out->ur_offset = (Dwarf_Signed)entry->dw_offset;
+        return;
+    }
+    out->ur_kind = DW_UNWIND_EXPRESSION;
+}
+
+/*  Adds the rows of one FDE. On DW_DLV_ERROR
+    *error is set, on DW_DLV_NO_ENTRY the FDE
+    could not be evaluated and the caller drops
+    whatever rows it added. */
+static int
+add_fde_rows(Dwarf_Debug dbg,
+    Dwarf_Fde fde,
+    Dwarf_Addr low,
+    Dwarf_Addr high,
+    Dwarf_Regtable3 *regtab,
+    Dwarf_Half *columns,
+    Dwarf_Unsigned column_count,
+    struct unwind_build_s *ub,
+    Dwarf_Error *error)
+{
+    Dwarf_Addr pc = low;
+    Dwarf_Unsigned ra = fde->fd_cie->ci_return_address_register;
+
+    for (;;) {
+        Dwarf_Addr row_pc = 0;
+        Dwarf_Bool has_more = FALSE;
+        Dwarf_Addr subsequent_pc = 0;
+        Dwarf_Error lerr = 0;
+        Dwarf_Unsigned i = 0;
+        int res = 0;
+
+        res = dwarf_get_fde_info_for_all_regs3_b(fde,pc,regtab,
+            &row_pc,&has_more,&subsequent_pc,&lerr);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,lerr);
+            return DW_DLV_NO_ENTRY;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_NO_ENTRY;
+        }
+        convert_cfa_rule(dbg,&regtab->rt3_cfa_rule,
+            &ub->ub_new_rules[0]);
+        if (ra < regtab->rt3_reg_table_size) {
+            convert_rule(dbg,&regtab->rt3_rules[ra],
+                (Dwarf_Half)ra,&ub->ub_new_rules[1]);
+        } else {
+            memset(&ub->ub_new_rules[1],0,
+                sizeof(Dwarf_Unwind_Rule));
+            ub->ub_new_rules[1].ur_column = (Dwarf_Half)ra;
+        }
+        for (i = 0; i < column_count; ++i) {
+            convert_rule(dbg,&regtab->rt3_rules[columns[i]],
+                columns[i],&ub->ub_new_rules[2+i]);
+        }
+        if (row_pc < low) {
+            row_pc = low;
+        }
+        if (ub_add_row(ub,row_pc) != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the unwind table");
+            return DW_DLV_ERROR;
+        }
+        if (!has_more || subsequent_pc <= pc ||
+            subsequent_pc >= high) {
+            break;
+        }
+        pc = subsequent_pc;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+build_rows(Dwarf_Debug dbg,
+    Dwarf_Fde *fde_data,
+    Dwarf_Signed fde_count,
+    Dwarf_Regtable3 *regtab,
+    Dwarf_Half *columns,
+    Dwarf_Unsigned column_count,
+    struct unwind_build_s *ub,
+    Dwarf_Error *error)
+{
+    Dwarf_Signed i = 0;
+    Dwarf_Bool have_end = FALSE;
+    Dwarf_Addr last_end = 0;
+
+    for (i = 0; i < fde_count; ++i) {
+        Dwarf_Fde fde = fde_data[i];
+        Dwarf_Addr low = 0;
+        Dwarf_Addr high = 0;
+        Dwarf_Unsigned rows_before = ub->ub_row_count;
+        int res = 0;
+
+        if (!fde || fde->fd_dbg != dbg || !fde->fd_cie) {
+            _dwarf_error_string(dbg,error,DW_DLE_FDE_NULL,
+                "DW_DLE_FDE_NULL: an FDE passed to "
+                "dwarf_make_unwind_table() is NULL or from "
+                "another Dwarf_Debug");
+            return DW_DLV_ERROR;
+        }
+        low = fde->fd_initial_location;
+        high = low + fde->fd_address_range;
+        if (high <= low) {
+            /* Empty, or wraps around the address space. */
+            continue;
+        }
+        if (have_end && low < last_end) {
+            /*  Overlaps an FDE already in the table,
+                the earlier one wins. */
+            continue;
+        }
+        if (have_end && low > last_end) {
+            if (ub_add_gap_row(ub,last_end) != DW_DLV_OK) {
+                _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                    "DW_DLE_ALLOC_FAIL: growing the unwind table");
+                return DW_DLV_ERROR;
+            }
+        }
+        res = add_fde_rows(dbg,fde,low,high,regtab,
+            columns,column_count,ub,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            /*  Leave this FDE out. rows_before was taken
+                before ub_add_gap_row(), so this drops
+                the gap row too. last_end is unchanged,
+                so the next FDE or the final gap row
+                re-adds it. */
+            ub->ub_row_count = rows_before;
+            continue;
+        }
+        have_end = TRUE;
+        last_end = high;
+    }
+    if (have_end) {
+        if (ub_add_gap_row(ub,last_end) != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the unwind table");
+            return DW_DLV_ERROR;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_make_unwind_table(Dwarf_Fde *fde_data,
+    Dwarf_Signed      fde_count,
+    Dwarf_Half       *columns,
+    Dwarf_Unsigned    column_count,
+    void            **table_out,
+    Dwarf_Unsigned   *table_size_out,
+    Dwarf_Error      *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Regtable3 regtab;
+    struct unwind_build_s ub;
+    struct Dwarf_Unwind_Table_Header_s *hdr = 0;
+    Dwarf_Unsigned rules_per_row = 0;
+    Dwarf_Unsigned pc_offset = 0;
+    Dwarf_Unsigned rules_offset = 0;
+    Dwarf_Unsigned table_size = 0;
+    Dwarf_Unsigned i = 0;
+    char *table = 0;
+    int res = 0;
+
+    if (!table_out || !table_size_out ||
+        (column_count && !columns) ||
+        fde_count < 0 || (fde_count && !fde_data)) {
+        _dwarf_error_string(NULL,error,DW_DLE_FDE_NULL,
+            "DW_DLE_FDE_NULL: a NULL or negative argument "
+            "passed to dwarf_make_unwind_table()");
+        return DW_DLV_ERROR;
+    }
+    if (fde_count) {
+        if (!fde_data[0]) {
+            _dwarf_error(NULL,error,DW_DLE_FDE_NULL);
+            return DW_DLV_ERROR;
+        }
+        dbg = fde_data[0]->fd_dbg;
+        if (IS_INVALID_DBG(dbg)) {
+            _dwarf_error_string(NULL,error,DW_DLE_FDE_DBG_NULL,
+                "DW_DLE_FDE_DBG_NULL: An fde contains a stale "
+                "Dwarf_Debug ");
+            return DW_DLV_ERROR;
+        }
+        for (i = 0; i < column_count; ++i) {
+            if (columns[i] >= dbg->de_frame_reg_rules_entry_count) {
+                _dwarf_error_string(dbg,error,
+                    DW_DLE_FRAME_TABLE_COL_BAD,
+                    "DW_DLE_FRAME_TABLE_COL_BAD: a register "
+                    "passed to dwarf_make_unwind_table() is not "
+                    "below the frame register table size");
+                return DW_DLV_ERROR;
+            }
+        }
+    }
+    rules_per_row = 2 + column_count;
+    if (rules_per_row < column_count ||
+        rules_per_row > 0xffff) {
+        _dwarf_error_string(dbg,error,DW_DLE_FRAME_TABLE_COL_BAD,
+            "DW_DLE_FRAME_TABLE_COL_BAD: too many registers "
+            "passed to dwarf_make_unwind_table()");
+        return DW_DLV_ERROR;
+    }
+    memset(&ub,0,sizeof(ub));
+    ub.ub_rules_per_row = rules_per_row;
+    ub.ub_new_rules = (Dwarf_Unwind_Rule *)calloc(
+        (size_t)rules_per_row,sizeof(Dwarf_Unwind_Rule));
+    if (!ub.ub_new_rules) {
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating unwind table rules");
+        return DW_DLV_ERROR;
+    }
+    if (fde_count) {
+        memset(&regtab,0,sizeof(regtab));
+        regtab.rt3_reg_table_size =
+            (Dwarf_Half)dbg->de_frame_reg_rules_entry_count;
+        regtab.rt3_rules = (Dwarf_Regtable_Entry3 *)calloc(
+            regtab.rt3_reg_table_size,
+            sizeof(Dwarf_Regtable_Entry3));
+        if (!regtab.rt3_rules) {
+            ub_free(&ub);
+            _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: allocating a register table");
+            return DW_DLV_ERROR;
+        }
+        res = build_rows(dbg,fde_data,fde_count,&regtab,
+            columns,column_count,&ub,error);
+        free(regtab.rt3_rules);
+        if (res != DW_DLV_OK) {
+            ub_free(&ub);
+            return res;
+        }
+    }
+    /*  Everything in the table is a multiple of
+        8 bytes, so each part stays 8 byte aligned. */
+    pc_offset = sizeof(struct Dwarf_Unwind_Table_Header_s);
+    rules_offset = pc_offset + ub.ub_row_count*sizeof(Dwarf_Addr);
+    table_size = rules_offset + ub.ub_row_count*rules_per_row*
+        sizeof(Dwarf_Unwind_Rule);
+    table = (char *)calloc(1,(size_t)table_size);
+    if (!table) {
+        ub_free(&ub);
+        _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the unwind table");
+        return DW_DLV_ERROR;
+    }
+    hdr = (struct Dwarf_Unwind_Table_Header_s *)table;
+    memcpy(hdr->uh_magic,UNWIND_TABLE_MAGIC,UNWIND_TABLE_MAGIC_LEN);
+    hdr->uh_byte_order = UNWIND_TABLE_BYTE_ORDER;
+    hdr->uh_version = UNWIND_TABLE_VERSION;
+    hdr->uh_table_size = table_size;
+    hdr->uh_row_count = ub.ub_row_count;
+    hdr->uh_rules_per_row = rules_per_row;
+    hdr->uh_pc_offset = pc_offset;
+    hdr->uh_rules_offset = rules_offset;
+    if (ub.ub_row_count) {
+        memcpy(table + pc_offset,ub.ub_pcs,
+            (size_t)ub.ub_row_count*sizeof(Dwarf_Addr));
+        memcpy(table + rules_offset,ub.ub_rules,
+            (size_t)(ub.ub_row_count*rules_per_row)*
+            sizeof(Dwarf_Unwind_Rule));
+    }
+    ub_free(&ub);
+    *table_out = table;
+    *table_size_out = table_size;
+    return DW_DLV_OK;
+}
+
+static int
+unwind_table_bad(Dwarf_Error *error,const char *msg)
+{
+    _dwarf_error_string(NULL,error,DW_DLE_DEBUGFRAME_ERROR,
+        (char *)msg);
+    return DW_DLV_ERROR;
+}
+
+int
+dwarf_lookup_unwind_table(const void *table,
+    Dwarf_Unsigned       table_size,
+    Dwarf_Addr           pc,
+    Dwarf_Addr          *row_pc,
+    Dwarf_Addr          *next_row_pc,
+    const Dwarf_Unwind_Rule **rules_out,
+    Dwarf_Unsigned      *rule_count,
+    Dwarf_Error         *error)
+{
+    const struct Dwarf_Unwind_Table_Header_s *hdr = 0;
+    const char *base = (const char *)table;
+    const Dwarf_Addr *pcs = 0;
+    const Dwarf_Unwind_Rule *rules = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned rpr = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+
+    if (!table || !rules_out) {
+        return unwind_table_bad(error,
+            "DW_DLE_DEBUGFRAME_ERROR: NULL argument to "
+            "dwarf_lookup_unwind_table()");
+    }
+    if ((uintptr_t)table & 7) {
+        return unwind_table_bad(error,
+            "DW_DLE_DEBUGFRAME_ERROR: unwind table is not "
+            "8 byte aligned");
+    }
+    hdr = (const struct Dwarf_Unwind_Table_Header_s *)table;
+    if (table_size < sizeof(*hdr) ||
+        memcmp(hdr->uh_magic,UNWIND_TABLE_MAGIC,
+            UNWIND_TABLE_MAGIC_LEN) ||
+        hdr->uh_byte_order != UNWIND_TABLE_BYTE_ORDER ||
+        hdr->uh_version != UNWIND_TABLE_VERSION ||
+        hdr->uh_table_size > table_size) {
+        return unwind_table_bad(error,
+            "DW_DLE_DEBUGFRAME_ERROR: not an unwind table "
+            "for this host, or truncated");
+    }
+    count = hdr->uh_row_count;
+    rpr = hdr->uh_rules_per_row;
+    table_size = hdr->uh_table_size;
+    if (rpr < 2 || rpr > 0xffff ||
+        (hdr->uh_pc_offset & 7) || (hdr->uh_rules_offset & 7) ||
+        hdr->uh_pc_offset > table_size ||
+        hdr->uh_rules_offset > table_size ||
+        count > (table_size - hdr->uh_pc_offset)/
+            sizeof(Dwarf_Addr) ||
+        count > (table_size - hdr->uh_rules_offset)/
+            (rpr*sizeof(Dwarf_Unwind_Rule))) {
+        return unwind_table_bad(error,
+            "DW_DLE_DEBUGFRAME_ERROR: unwind table header "
+            "is corrupt");
+    }
+    pcs = (const Dwarf_Addr *)(base + hdr->uh_pc_offset);
+    rules = (const Dwarf_Unwind_Rule *)(base +
+        hdr->uh_rules_offset);
+    /*  Find the last row starting at or below pc. */
+    lo = 0;
+    hi = count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (pcs[mid] <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo) {
+        return DW_DLV_NO_ENTRY;
+    }
+    --lo;
+    rules += lo*rpr;
+    if (rules[0].ur_kind == DW_UNWIND_UNDEFINED) {
+        /* A gap between FDEs, or past the end. */
+        return DW_DLV_NO_ENTRY;
+    }
+    if (row_pc) {
+        *row_pc = pcs[lo];
+    }
+    if (next_row_pc) {
+        /*  The table always ends with a gap row
+            so a defined row has a next row. */
+        *next_row_pc = (lo + 1 < count)? pcs[lo+1]:pcs[lo];
+    }
+    *rules_out = rules;
+    if (rule_count) {
+        *rule_count = rpr;
+    }
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_unwind_table(void *table)
+{
+    free(table);
+}
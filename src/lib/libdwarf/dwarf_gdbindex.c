@@ -32,7 +32,7 @@ Index-Section-Format.html#Index-Section-Format
 
 #include <config.h>
 
-#include <string.h>  /* memcpy() */
+#include <string.h>  /* memcpy() strcmp() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -845,6 +845,225 @@ dwarf_gdbindex_string_by_offset(Dwarf_Gdbindex gdbindexptr,
     return DW_DLV_OK;
 }
 
+/*  gdb's mapped_index_string_hash() as for index
+    versions 5 and later, which fold ASCII letters
+    to lower case. */
+static Dwarf_Unsigned
+gdbindex_string_hash(const char *name)
+{
+    Dwarf_Unsigned r = 0;
+
+    for ( ; *name; ++name) {
+        unsigned int c = (unsigned char)*name;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        r = (r*67 + c - 113) & 0xffffffff;
+    }
+    return r;
+}
+
+/*  Probes the symbol table hash as gdb does,
+    so only the slots on name's probe sequence
+    are read. */
+int
+dwarf_gdbindex_lookup(Dwarf_Gdbindex gdbindexptr,
+    const char     * name,
+    Dwarf_Unsigned * symtab_index,
+    Dwarf_Unsigned * cu_vector_offset,
+    Dwarf_Error    * error)
+{
+    Dwarf_Unsigned slots = 0;
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned step = 0;
+    Dwarf_Unsigned probes = 0;
+
+    if (!gdbindexptr || !gdbindexptr->gi_dbg) {
+        _dwarf_error_string(NULL, error,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " passed in NULL indexptr to"
+            " dwarf_gdbindex_lookup");
+        return DW_DLV_ERROR;
+    }
+    if (!name) {
+        _dwarf_error_string(gdbindexptr->gi_dbg, error,
+            DW_DLE_IA,
+            "DW_DLE_IA: passed in NULL name to"
+            " dwarf_gdbindex_lookup");
+        return DW_DLV_ERROR;
+    }
+    slots = gdbindexptr->gi_symboltablehdr.dg_count;
+    if (!slots) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (slots & (slots-1)) {
+        emit_one_value_msg(gdbindexptr->gi_dbg,
+            DW_DLE_GDB_INDEX_COUNT_ERROR,
+            "DW_DLE_GDB_INDEX_COUNT_ERROR:"
+            " the symbol table has %u slots,"
+            " not a power of two so it cannot be searched",
+            slots,error);
+        return DW_DLV_ERROR;
+    }
+    hash = gdbindex_string_hash(name);
+    index = hash & (slots-1);
+    step = ((hash*17) & (slots-1)) | 1;
+    /*  step is odd so slots probes visit every slot. */
+    for (probes = 0; probes < slots; ++probes) {
+        Dwarf_Unsigned stroffset = 0;
+        Dwarf_Unsigned cuvecoffset = 0;
+        const char *str = 0;
+        int res = 0;
+
+        res = dwarf_gdbindex_symboltable_entry(gdbindexptr,
+            index,&stroffset,&cuvecoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!stroffset && !cuvecoffset) {
+            /* An empty slot ends the search. */
+            return DW_DLV_NO_ENTRY;
+        }
+        res = dwarf_gdbindex_string_by_offset(gdbindexptr,
+            stroffset,&str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!strcmp(str,name)) {
+            if (symtab_index) {
+                *symtab_index = index;
+            }
+            if (cu_vector_offset) {
+                *cu_vector_offset = cuvecoffset;
+            }
+            return DW_DLV_OK;
+        }
+        index = (index + step) & (slots-1);
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+static int
+gdbindex_check_address_order(Dwarf_Gdbindex gdbindexptr,
+    Dwarf_Error * error)
+{
+    Dwarf_Unsigned count = gdbindexptr->gi_addressareahdr.dg_count;
+    Dwarf_Unsigned prevhigh = 0;
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+        Dwarf_Unsigned cuindex = 0;
+        int res = 0;
+
+        res = dwarf_gdbindex_addressarea_entry(gdbindexptr,i,
+            &low,&high,&cuindex,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (low > high || (i && low < prevhigh)) {
+            gdbindexptr->gi_address_order = GDBINDEX_ADDR_UNSORTED;
+            return DW_DLV_OK;
+        }
+        prevhigh = high;
+    }
+    gdbindexptr->gi_address_order = GDBINDEX_ADDR_SORTED;
+    return DW_DLV_OK;
+}
+
+/*  gdb writes the address area in address order,
+    so this is a binary search. An area that turns out
+    not to be in order is searched entry by entry. */
+int
+dwarf_gdbindex_addressarea_lookup(Dwarf_Gdbindex gdbindexptr,
+    Dwarf_Addr       pc,
+    Dwarf_Unsigned * entry_index,
+    Dwarf_Unsigned * cu_index,
+    Dwarf_Error    * error)
+{
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned low = 0;
+    Dwarf_Unsigned high = 0;
+    Dwarf_Unsigned cuindex = 0;
+    int res = 0;
+
+    if (!gdbindexptr || !gdbindexptr->gi_dbg) {
+        _dwarf_error_string(NULL, error,
+            DW_DLE_GDB_INDEX_INDEX_ERROR,
+            "DW_DLE_GDB_INDEX_INDEX_ERROR:"
+            " passed in NULL indexptr to"
+            " dwarf_gdbindex_addressarea_lookup");
+        return DW_DLV_ERROR;
+    }
+    count = gdbindexptr->gi_addressareahdr.dg_count;
+    if (!count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (gdbindexptr->gi_address_order == GDBINDEX_ADDR_UNCHECKED) {
+        res = gdbindex_check_address_order(gdbindexptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (gdbindexptr->gi_address_order == GDBINDEX_ADDR_UNSORTED) {
+        for (lo = 0; lo < count; ++lo) {
+            res = dwarf_gdbindex_addressarea_entry(gdbindexptr,lo,
+                &low,&high,&cuindex,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (low <= pc && pc < high) {
+                break;
+            }
+        }
+        if (lo >= count) {
+            return DW_DLV_NO_ENTRY;
+        }
+    } else {
+        /*  Find the last entry with low <= pc. */
+        hi = count;
+        while (lo < hi) {
+            Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+            res = dwarf_gdbindex_addressarea_entry(gdbindexptr,mid,
+                &low,&high,&cuindex,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (low <= pc) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (!lo) {
+            return DW_DLV_NO_ENTRY;
+        }
+        --lo;
+        res = dwarf_gdbindex_addressarea_entry(gdbindexptr,lo,
+            &low,&high,&cuindex,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (pc >= high) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    if (entry_index) {
+        *entry_index = lo;
+    }
+    if (cu_index) {
+        *cu_index = cuindex;
+    }
+    return DW_DLV_OK;
+}
+
 void
 dwarf_dealloc_gdbindex(Dwarf_Gdbindex indexptr)
 {
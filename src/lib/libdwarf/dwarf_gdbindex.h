@@ -81,4 +81,14 @@ struct Dwarf_Gdbindex_s {
     struct Dwarf_Gdbindex_array_instance_s  gi_addressareahdr;
     struct Dwarf_Gdbindex_array_instance_s  gi_symboltablehdr;
     struct Dwarf_Gdbindex_array_instance_s  gi_cuvectorhdr;
+
+    /*  Whether the address area is in address order
+        without overlaps, found on the first
+        dwarf_gdbindex_addressarea_lookup(). */
+    Dwarf_Small      gi_address_order;
 };
+
+/*  gi_address_order values. */
+#define GDBINDEX_ADDR_UNCHECKED 0
+#define GDBINDEX_ADDR_SORTED    1
+#define GDBINDEX_ADDR_UNSORTED  2
@@ -53,6 +53,7 @@
 #include "dwarf_string.h"
 #include "dwarf_secname_ck.h"
 #include "dwarf_setup_sections.h"
+#include "dwarf_decompress_cache.h"
 
 #ifdef HAVE_ZLIB_H
 #include "zlib.h"
@@ -60,6 +61,9 @@
 #ifdef HAVE_ZSTD_H
 #include "zstd.h"
 #endif
+#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD) && defined(HAVE_PTHREAD)
+#include <pthread.h>
+#endif
 
 #ifndef ELFCOMPRESS_ZLIB
 #define ELFCOMPRESS_ZLIB 1
@@ -1304,15 +1308,37 @@ check_uncompr_inflation(Dwarf_Debug dbg,
 #define ALLOWED_ZSTD_INFLATION 32
 #endif /* 0 */
 
+/*  A decompression split in three steps so
+    dwarf_preload_sections() can run the middle one
+    (the inflate itself) on several threads at once.
+    decompress_prepare() and decompress_finish() touch
+    the Dwarf_Debug and the decompressed-section cache
+    so they always run on the calling thread. */
+struct Dwarf_Decompress_Job_s {
+    struct Dwarf_Section_s *dj_section;
+    Dwarf_Small   *dj_src;
+    Dwarf_Unsigned dj_srclen;
+    Dwarf_Small   *dj_dest;
+    Dwarf_Unsigned dj_destlen;
+    int            dj_zstd;
+    int            dj_use_dcache;
+    Dwarf_Unsigned dj_dckey;
+    /*  0 on success, else a DW_DLE error code
+        set by decompress_run(). */
+    int            dj_errcode;
+};
+
+/*  Returns DW_DLV_NO_ENTRY if the decompressed
+    data was found in the cache and is already
+    installed in the section: nothing left to do. */
 static int
-do_decompress(Dwarf_Debug dbg,
+decompress_prepare(Dwarf_Debug dbg,
     struct Dwarf_Section_s *section,
+    struct Dwarf_Decompress_Job_s *job,
     Dwarf_Error * error)
 {
     Dwarf_Small *basesrc = section->dss_data;
     Dwarf_Small *src = basesrc;
-    Dwarf_Small *dest = 0;
-    Dwarf_Unsigned destlen = 0;
     Dwarf_Unsigned srclen = section->dss_size;
     Dwarf_Unsigned flags = section->dss_flags;
     Dwarf_Small *endsection = 0;
@@ -1438,9 +1464,34 @@ do_decompress(Dwarf_Debug dbg,
             " length. So corrupt dwarf");
         return DW_DLV_ERROR;
     }
-    destlen = uncompressed_len;
-    dest = malloc(destlen);
-    if (!dest) {
+    job->dj_section = section;
+    job->dj_src = src;
+    job->dj_srclen = srclen;
+    job->dj_zstd = zstdcompress;
+    /*  Relocations are applied to the decompressed
+        data in place, so such sections are never
+        shared through the cache. */
+    if (_dwarf_dcache_enabled() && !section->dss_reloc_size) {
+        struct Dwarf_Dcache_Entry_s *dcentry = 0;
+        Dwarf_Small *cached = 0;
+
+        job->dj_dckey = _dwarf_dcache_key(src,srclen);
+        dcentry = _dwarf_dcache_lookup(job->dj_dckey,src,
+            srclen,uncompressed_len,&cached);
+        if (dcentry) {
+            _dwarf_malloc_section_free(section);
+            section->dss_data = cached;
+            section->dss_size = uncompressed_len;
+            section->dss_dcache_entry = dcentry;
+            section->dss_actual_load_type= Dwarf_Alloc_Malloc;
+            section->dss_did_decompress = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+        job->dj_use_dcache = TRUE;
+    }
+    job->dj_destlen = uncompressed_len;
+    job->dj_dest = malloc(job->dj_destlen);
+    if (!job->dj_dest) {
         _dwarf_error_string(dbg, error,
             DW_DLE_ALLOC_FAIL,
             "DW_DLE_ALLOC_FAIL"
@@ -1448,55 +1499,106 @@ do_decompress(Dwarf_Debug dbg,
             " malloc failed: out of memory");
         return DW_DLV_ERROR;
     }
+    return DW_DLV_OK;
+}
+
+/*  Touches nothing but the job itself, so is safe
+    to call from any thread. */
+static void
+decompress_run(struct Dwarf_Decompress_Job_s *job)
+{
     /*  uncompress is a zlib function. */
-    if (!zstdcompress) {
+    if (!job->dj_zstd) {
         int res = 0;
-        uLongf dlen = destlen;
+        uLongf dlen = job->dj_destlen;
 
-        res = uncompress(dest,&dlen,src,srclen);
+        res = uncompress(job->dj_dest,&dlen,
+            job->dj_src,job->dj_srclen);
         if (res == Z_BUF_ERROR) {
-            free(dest);
-            DWARF_DBG_ERROR(dbg, DW_DLE_ZLIB_BUF_ERROR, DW_DLV_ERROR);
+            job->dj_errcode = DW_DLE_ZLIB_BUF_ERROR;
         } else if (res == Z_MEM_ERROR) {
-            free(dest);
-            DWARF_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+            job->dj_errcode = DW_DLE_ALLOC_FAIL;
         } else if (res != Z_OK) {
-            free(dest);
             /* Probably Z_DATA_ERROR. */
-            DWARF_DBG_ERROR(dbg, DW_DLE_ZLIB_DATA_ERROR,
-                DW_DLV_ERROR);
+            job->dj_errcode = DW_DLE_ZLIB_DATA_ERROR;
+        }
+    } else {
+        size_t zsize = ZSTD_decompress(job->dj_dest,
+            job->dj_destlen,job->dj_src,job->dj_srclen);
+        if (zsize != job->dj_destlen) {
+            job->dj_errcode = DW_DLE_ZLIB_DATA_ERROR;
         }
     }
-    if (zstdcompress) {
-        size_t zsize =
-            ZSTD_decompress(dest,destlen,src,srclen);
-        if (zsize != destlen) {
-            free(dest);
+    if (job->dj_errcode) {
+        free(job->dj_dest);
+        job->dj_dest = 0;
+    }
+}
+
+static int
+decompress_finish(Dwarf_Debug dbg,
+    struct Dwarf_Decompress_Job_s *job,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Section_s *section = job->dj_section;
+    struct Dwarf_Dcache_Entry_s *dcentry = 0;
+
+    if (job->dj_errcode) {
+        if (job->dj_zstd) {
             _dwarf_error_string(dbg, error,
                 DW_DLE_ZLIB_DATA_ERROR,
                 "DW_DLE_ZLIB_DATA_ERROR"
                 " The zstd ZSTD_decompress() failed.");
             return DW_DLV_ERROR;
         }
+        DWARF_DBG_ERROR(dbg, job->dj_errcode, DW_DLV_ERROR);
     }
     /* Z_OK */
+    if (job->dj_use_dcache) {
+        /*  Before the free below: dj_src points
+            into the compressed section data. */
+        dcentry = _dwarf_dcache_insert(job->dj_dckey,
+            job->dj_src,job->dj_srclen,job->dj_destlen,
+            job->dj_dest);
+    }
     _dwarf_malloc_section_free(section);
-    section->dss_data = dest;
-    section->dss_size = destlen;
+    section->dss_data = job->dj_dest;
+    section->dss_size = job->dj_destlen;
     section->dss_was_alloc= TRUE;
     section->dss_actual_load_type= Dwarf_Alloc_Malloc;
     section->dss_did_decompress = TRUE;
+    section->dss_dcache_entry = dcentry;
+    job->dj_dest = 0;
     return DW_DLV_OK;
 }
+
+static int
+do_decompress(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *section,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Decompress_Job_s job;
+    int res = 0;
+
+    memset(&job,0,sizeof(job));
+    res = decompress_prepare(dbg,section,&job,error);
+    if (res == DW_DLV_NO_ENTRY) {
+        /* Cache hit, section already set up. */
+        return DW_DLV_OK;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    decompress_run(&job);
+    return decompress_finish(dbg,&job,error);
+}
 #endif /* HAVE_ZLIB && HAVE_ZSTD */
 
-/*  Load the ELF section with the specified index and set its
-    dss_data pointer to the memory where it was loaded.
-    This is problematic for mmap use, as more needs
-    to be recorded in the section data to munmap.
-*/
-int
-_dwarf_load_section(Dwarf_Debug dbg,
+/*  Bring the section bytes, exactly as they are
+    in the object file, into memory.
+    Neither decompression nor relocation is done here. */
+static int
+load_section_raw(Dwarf_Debug dbg,
     Dwarf_Section section,
     Dwarf_Error  *error)
 {
@@ -1512,10 +1614,6 @@ _dwarf_load_section(Dwarf_Debug dbg,
         _dwarf_determine_section_allocation_type();
     enum Dwarf_Sec_Alloc_Pref finaltype = pref;
 
-    /* check to see if the section is already loaded */
-    if (section->dss_data !=  NULL) {
-        return DW_DLV_OK;
-    }
     o = dbg->de_obj_file;
     /*  There is an elf convention that section index 0
         is reserved, and that section is always empty.
@@ -1530,6 +1628,14 @@ _dwarf_load_section(Dwarf_Debug dbg,
         and its like sections have no data but do have a size.
         That is never true of DWARF sections  */
     data_len = section->dss_size;
+    if (finaltype == Dwarf_Alloc_Mmap_Whole) {
+        /*  The object readers notice the whole-object
+            preference themselves; what they are
+            passed stays one of the original values
+            so other om_load_section_a
+            implementations see nothing new. */
+        finaltype = Dwarf_Alloc_Mmap;
+    }
 #ifdef HAVE_FULL_MMAP
     if (o->ai_methods->om_load_section_a) {
         res = o->ai_methods->om_load_section_a(o->ai_object,
@@ -1589,15 +1695,78 @@ Hold off on this, keep old error for the moment
     section->dss_data = data_ptr;
     section->dss_load_preference = pref;
     section->dss_actual_load_type = finaltype;
+    return res;
+}
 
+static int
+section_needs_decompress(Dwarf_Section section)
+{
     if (section->dss_ignore_reloc_group_sec) {
         /* Neither zdebug nor reloc apply to .group sections. */
-        return res;
+        return FALSE;
     }
     if ((section->dss_zdebug_requires_decompress ||
         section->dss_shf_compressed ||
         section->dss_ZLIB_compressed) &&
         !section->dss_did_decompress) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*  Applies relocations, if any, to a loaded (and
+    if need be decompressed) section. */
+static int
+relocate_loaded_section(Dwarf_Debug dbg,
+    Dwarf_Section section,
+    Dwarf_Error  *error)
+{
+    int res = DW_DLV_OK;
+    int errc = 0;
+    struct Dwarf_Obj_Access_Interface_a_s *o = dbg->de_obj_file;
+
+    if (section->dss_ignore_reloc_group_sec) {
+        return res;
+    }
+    if (_dwarf_apply_relocs == 0) {
+        return res;
+    }
+    if (section->dss_reloc_size == 0) {
+        return res;
+    }
+    if (!o->ai_methods->om_relocate_a_section) {
+        return res;
+    }
+    /*apply relocations */
+    res = o->ai_methods->om_relocate_a_section(o->ai_object,
+        section->dss_index, dbg, &errc);
+    if (res == DW_DLV_ERROR) {
+        DWARF_DBG_ERROR(dbg, errc, DW_DLV_ERROR);
+    }
+    return res;
+}
+
+/*  Load the ELF section with the specified index and set its
+    dss_data pointer to the memory where it was loaded.
+    This is problematic for mmap use, as more needs
+    to be recorded in the section data to munmap.
+*/
+int
+_dwarf_load_section(Dwarf_Debug dbg,
+    Dwarf_Section section,
+    Dwarf_Error  *error)
+{
+    int res  = DW_DLV_ERROR;
+
+    /* check to see if the section is already loaded */
+    if (section->dss_data !=  NULL) {
+        return DW_DLV_OK;
+    }
+    res = load_section_raw(dbg,section,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (section_needs_decompress(section)) {
         if (!section->dss_data) {
             /*  Impossible. This makes no sense.
                 Corrupt object. */
@@ -1625,21 +1794,238 @@ Hold off on this, keep old error for the moment
         section->dss_actual_load_type = Dwarf_Alloc_Malloc;
         section->dss_was_alloc = TRUE;
     }
-    if (_dwarf_apply_relocs == 0) {
-        return res;
+    return relocate_loaded_section(dbg,section,error);
+}
+
+#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
+#ifdef HAVE_PTHREAD
+/*  A cap on dw_thread_count. */
+#define DW_PRELOAD_MAX_THREADS 16
+
+/*  Jobs are handed out one at a time from pp_next
+    so a large section does not hold up the rest. */
+struct Dwarf_Preload_Pool_s {
+    pthread_mutex_t pp_lock;
+    struct Dwarf_Decompress_Job_s *pp_jobs;
+    unsigned int pp_count;
+    unsigned int pp_next;
+};
+
+static void *
+preload_worker(void *arg)
+{
+    struct Dwarf_Preload_Pool_s *pool =
+        (struct Dwarf_Preload_Pool_s *)arg;
+
+    for (;;) {
+        unsigned int i = 0;
+
+        pthread_mutex_lock(&pool->pp_lock);
+        i = pool->pp_next;
+        if (i < pool->pp_count) {
+            pool->pp_next++;
+        }
+        pthread_mutex_unlock(&pool->pp_lock);
+        if (i >= pool->pp_count) {
+            break;
+        }
+        decompress_run(&pool->pp_jobs[i]);
     }
-    if (section->dss_reloc_size == 0) {
-        return res;
+    return 0;
+}
+#endif /* HAVE_PTHREAD */
+
+/*  Runs every job. Falls back to doing them all
+    on the calling thread if threads are unavailable
+    or cannot be started. */
+static void
+run_decompress_jobs(struct Dwarf_Decompress_Job_s *jobs,
+    unsigned int count,
+    unsigned int thread_count)
+{
+    unsigned int i = 0;
+
+#ifdef HAVE_PTHREAD
+    if (thread_count > count) {
+        thread_count = count;
+    }
+    if (thread_count > DW_PRELOAD_MAX_THREADS) {
+        thread_count = DW_PRELOAD_MAX_THREADS;
+    }
+    if (thread_count > 1) {
+        struct Dwarf_Preload_Pool_s pool;
+        pthread_t tids[DW_PRELOAD_MAX_THREADS];
+        unsigned int started = 0;
+
+        memset(&pool,0,sizeof(pool));
+        pool.pp_jobs = jobs;
+        pool.pp_count = count;
+        if (!pthread_mutex_init(&pool.pp_lock,0)) {
+            /*  The calling thread is one of the workers. */
+            for ( ; started < thread_count-1; ++started) {
+                if (pthread_create(&tids[started],0,
+                    preload_worker,&pool)) {
+                    break;
+                }
+            }
+            preload_worker(&pool);
+            for (i = 0; i < started; ++i) {
+                pthread_join(tids[i],0);
+            }
+            pthread_mutex_destroy(&pool.pp_lock);
+            return;
+        }
     }
-    if (!o->ai_methods->om_relocate_a_section) {
-        return res;
+#else /* !HAVE_PTHREAD */
+    (void)thread_count;
+#endif /* HAVE_PTHREAD */
+    for (i = 0; i < count; ++i) {
+        decompress_run(&jobs[i]);
     }
-    /*apply relocations */
-    res = o->ai_methods->om_relocate_a_section(o->ai_object,
-        section->dss_index, dbg, &errc);
-    if (res == DW_DLV_ERROR) {
-        DWARF_DBG_ERROR(dbg, errc, DW_DLV_ERROR);
+}
+#endif /* HAVE_ZLIB && HAVE_ZSTD */
+
+#define DW_PRELOAD_SECTION_MAX 9
+
+/*  Returns the number of sections selected by
+    dw_which, filling in secs[]. */
+static unsigned int
+preload_section_list(Dwarf_Debug dbg, unsigned int which,
+    struct Dwarf_Section_s **secs)
+{
+    unsigned int n = 0;
+
+    if (which & DW_PRELOAD_INFO) {
+        secs[n++] = &dbg->de_debug_info;
+        secs[n++] = &dbg->de_debug_types;
+    }
+    if (which & DW_PRELOAD_ABBREV) {
+        secs[n++] = &dbg->de_debug_abbrev;
+    }
+    if (which & DW_PRELOAD_LINE) {
+        secs[n++] = &dbg->de_debug_line;
+    }
+    if (which & DW_PRELOAD_STR) {
+        secs[n++] = &dbg->de_debug_str;
+        secs[n++] = &dbg->de_debug_line_str;
+        secs[n++] = &dbg->de_debug_str_offsets;
+    }
+    if (which & DW_PRELOAD_RNGLISTS) {
+        secs[n++] = &dbg->de_debug_rnglists;
+    }
+    if (which & DW_PRELOAD_LOCLISTS) {
+        secs[n++] = &dbg->de_debug_loclists;
     }
+    return n;
+}
+
+int
+dwarf_preload_sections(Dwarf_Debug dbg,
+    unsigned int which,
+    unsigned int thread_count,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *secs[DW_PRELOAD_SECTION_MAX];
+    unsigned int count = 0;
+    unsigned int i = 0;
+    int res = DW_DLV_OK;
+#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
+    struct Dwarf_Decompress_Job_s jobs[DW_PRELOAD_SECTION_MAX];
+    unsigned int jobcount = 0;
+    unsigned int j = 0;
+#endif /* HAVE_ZLIB && HAVE_ZSTD */
+
+    CHECK_DBG(dbg,error,"dwarf_preload_sections()");
+    count = preload_section_list(dbg,which,secs);
+#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
+    memset(jobs,0,sizeof(jobs));
+    /*  Reading the object file stays serial: the
+        object readers share one file descriptor. */
+    for (i = 0; i < count; ++i) {
+        struct Dwarf_Section_s *sec = secs[i];
+
+        if (!sec->dss_size || sec->dss_data) {
+            continue;
+        }
+        res = load_section_raw(dbg,sec,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!section_needs_decompress(sec)) {
+            res = relocate_loaded_section(dbg,sec,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+            res = DW_DLV_OK;
+            continue;
+        }
+        if (!sec->dss_data) {
+            _dwarf_error(dbg, error,
+                DW_DLE_COMPRESSED_EMPTY_SECTION);
+            res = DW_DLV_ERROR;
+            break;
+        }
+        res = decompress_prepare(dbg,sec,&jobs[jobcount],error);
+        if (res == DW_DLV_ERROR) {
+            _dwarf_malloc_section_free(sec);
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            /*  Cache hit. */
+            res = relocate_loaded_section(dbg,sec,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+            res = DW_DLV_OK;
+            continue;
+        }
+        ++jobcount;
+    }
+    if (res == DW_DLV_OK && jobcount) {
+        if (!thread_count) {
+            thread_count = jobcount;
+        }
+        run_decompress_jobs(jobs,jobcount,thread_count);
+    }
+    for (j = 0; j < jobcount; ++j) {
+        struct Dwarf_Section_s *sec = jobs[j].dj_section;
+
+        if (res == DW_DLV_OK) {
+            res = decompress_finish(dbg,&jobs[j],error);
+            if (res == DW_DLV_OK) {
+                res = relocate_loaded_section(dbg,sec,error);
+                if (res != DW_DLV_ERROR) {
+                    res = DW_DLV_OK;
+                }
+                continue;
+            }
+        }
+        /*  After an error drop whatever is left so a
+            later _dwarf_load_section() starts over
+            rather than finding compressed bytes. */
+        free(jobs[j].dj_dest);
+        jobs[j].dj_dest = 0;
+        if (!sec->dss_did_decompress) {
+            _dwarf_malloc_section_free(sec);
+        }
+    }
+#else /* !HAVE_ZLIB || !HAVE_ZSTD */
+    (void)thread_count;
+    for (i = 0; i < count; ++i) {
+        if (!secs[i]->dss_size) {
+            continue;
+        }
+        res = _dwarf_load_section(dbg,secs[i],error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = DW_DLV_OK;
+    }
+#endif /* HAVE_ZLIB && HAVE_ZSTD */
     return res;
 }
 
@@ -30,6 +30,7 @@
 #include <config.h>
 
 #include <stddef.h> /* size_t */
+#include <string.h> /* memcpy() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -82,6 +83,61 @@
 #define BYTESLEBMAX 24
 #define BITSPERBYTE 8
 
+/*  With at least 8 bytes left before endptr an leb
+    of up to 8 bytes is decoded from a single 8 byte
+    load: the terminating byte is found from the
+    zero high bits and the 7 bit groups are packed
+    together with three mask and shift steps.
+    Longer lebs (and lebs near endptr) go through
+    the byte at a time code, so results, including
+    errors, are unchanged.
+    The load is little-endian and needs a count
+    trailing zeros, so this is limited to where
+    both are simple. */
+#if !defined(WORDS_BIGENDIAN) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define LEB_WORD_FAST_PATH 1
+
+#define LEB_HIGH_BITS 0x8080808080808080ULL
+
+/*  Returns the length (1-8) of the leb starting
+    at leb128, or 0 if it is longer than 8 bytes.
+    Sets *word to the 8 bytes.
+    Caller guarantees 8 readable bytes. */
+static unsigned int
+leb_word_length(const char *leb128, Dwarf_Unsigned *word)
+{
+    Dwarf_Unsigned w = 0;
+    Dwarf_Unsigned stops = 0;
+
+    memcpy(&w,leb128,sizeof(w));
+    *word = w;
+    stops = ~w & LEB_HIGH_BITS;
+    if (!stops) {
+        return 0;
+    }
+    return (unsigned int)(__builtin_ctzll(stops) >> 3) + 1;
+}
+
+/*  Packs the 7 bit groups of the first len bytes
+    of word into a value of 7*len bits. */
+static Dwarf_Unsigned
+leb_word_value(Dwarf_Unsigned w, unsigned int len)
+{
+    if (len < 8) {
+        w &= (((Dwarf_Unsigned)1) << (len*8)) - 1;
+    }
+    w &= 0x7f7f7f7f7f7f7f7fULL;
+    w = ((w & 0x7f007f007f007f00ULL) >> 1) |
+        (w & 0x007f007f007f007fULL);
+    w = ((w & 0x3fff00003fff0000ULL) >> 2) |
+        (w & 0x00003fff00003fffULL);
+    w = ((w & 0x0fffffff00000000ULL) >> 4) |
+        (w & 0x000000000fffffffULL);
+    return w;
+}
+#endif /* LEB_WORD_FAST_PATH */
+
 /*  When an leb value needs to reveal its length,
     but the value is not needed  */
 int
@@ -114,6 +170,17 @@ _dwarf_skip_leb128(char * leb128,
         /*  Gets messy to hand-inline more byte checking.
             One or two byte leb is very frequent. */
     }
+#ifdef LEB_WORD_FAST_PATH
+    if ((endptr - leb128) >= 8) {
+        Dwarf_Unsigned w = 0;
+        unsigned int len = leb_word_length(leb128,&w);
+
+        if (len) {
+            *leb128_length = len;
+            return DW_DLV_OK;
+        }
+    }
+#endif /* LEB_WORD_FAST_PATH */
 
     ++byte_length;
     ++leb128;
@@ -187,6 +254,22 @@ dwarf_decode_leb128(char * leb128,
         }
         /* Gets messy to hand-inline more byte checking. */
     }
+#ifdef LEB_WORD_FAST_PATH
+    if ((endptr - leb128) >= 8) {
+        Dwarf_Unsigned w = 0;
+        unsigned int len = leb_word_length(leb128,&w);
+
+        if (len) {
+            if (leb128_length) {
+                *leb128_length = len;
+            }
+            if (outval) {
+                *outval = leb_word_value(w,len);
+            }
+            return DW_DLV_OK;
+        }
+    }
+#endif /* LEB_WORD_FAST_PATH */
 
     /*  The rest handles long numbers. Because the 'number'
         may be larger than the default int/unsigned,
@@ -288,6 +371,26 @@ dwarf_decode_signed_leb128(char * leb128,
     if (leb128 >= endptr) {
         return DW_DLV_ERROR;
     }
+#ifdef LEB_WORD_FAST_PATH
+    if ((endptr - leb128) >= 8) {
+        Dwarf_Unsigned w = 0;
+        unsigned int len = leb_word_length(leb128,&w);
+
+        if (len) {
+            /*  At most 56 bits, so the sign extension
+                shift is well defined. */
+            number = (Dwarf_Signed)leb_word_value(w,len);
+            if (number & (((Dwarf_Signed)1) << (len*7 - 1))) {
+                number |= -(((Dwarf_Signed)1) << (len*7));
+            }
+            if (leb128_length) {
+                *leb128_length = len;
+            }
+            *outval = number;
+            return DW_DLV_OK;
+        }
+    }
+#endif /* LEB_WORD_FAST_PATH */
     byte   = *(unsigned char *)leb128;
     for (;;) {
         b = byte & 0x7f;
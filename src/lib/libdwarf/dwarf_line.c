@@ -2153,6 +2153,10 @@ delete_line_context_itself(Dwarf_Line_Context context)
     context->lc_directory_format_values = 0;
     free(context->lc_file_format_values);
     context->lc_file_format_values = 0;
+    free(context->lc_linerows_logicals);
+    context->lc_linerows_logicals = 0;
+    free(context->lc_linerows_actuals);
+    context->lc_linerows_actuals = 0;
     if (context->lc_include_directories) {
         free(context->lc_include_directories);
         context->lc_include_directories = 0;
@@ -2181,8 +2185,6 @@ void
 dwarf_srclines_dealloc_b(Dwarf_Line_Context line_context)
 {
     Dwarf_Line *linestable = 0;
-    Dwarf_Signed linescount = 0;
-    Dwarf_Signed i = 0;
     Dwarf_Debug dbg = 0;
 
     if (!line_context) {
@@ -2193,14 +2195,11 @@ dwarf_srclines_dealloc_b(Dwarf_Line_Context line_context)
         return;
     }
     dbg = line_context->lc_dbg;
+    /*  The lines themselves are in lc_linerows_logicals
+        and lc_linerows_actuals, freed with the
+        context. */
     linestable = line_context->lc_linebuf_logicals;
     if (linestable) {
-        linescount = line_context->lc_linecount_logicals;
-        if (linescount >= 0) {
-            for (i = 0; i < linescount ; ++i) {
-                dwarf_dealloc(dbg, linestable[i], DW_DLA_LINE);
-            }
-        } /* else bogus negative count. do not dealloc things. */
         dwarf_dealloc(dbg, linestable, DW_DLA_LIST);
     }
     line_context->lc_linebuf_logicals = 0;
@@ -2208,12 +2207,6 @@ dwarf_srclines_dealloc_b(Dwarf_Line_Context line_context)
 
     linestable = line_context->lc_linebuf_actuals;
     if (linestable) {
-        linescount = line_context->lc_linecount_actuals;
-        if (linescount >= 0) {
-            for (i = 0; i <linescount ; ++i) {
-                dwarf_dealloc(dbg, linestable[i], DW_DLA_LINE);
-            }
-        } /* else bogus negative count. do not dealloc things. */
         dwarf_dealloc(dbg, linestable, DW_DLA_LIST);
     }
     line_context->lc_linebuf_actuals = 0;
@@ -2580,36 +2573,47 @@ _dwarf_decode_line_udata_form(Dwarf_Debug dbg,
     return DW_DLV_ERROR;
 }
 
-void
-_dwarf_update_chain_list( Dwarf_Chain chain_line,
-    Dwarf_Chain *head_chain, Dwarf_Chain *curr_chain)
+/*  Add a zeroed row to the contiguous array of rows
+    the line table program fills in, doubling the
+    array as needed. Pointers to earlier rows
+    are stale once this returns. On error
+    *rows is still valid (and still the
+    caller's to free). */
+int
+_dwarf_add_line_row(Dwarf_Debug dbg,
+    struct Dwarf_Line_s **rows,
+    Dwarf_Unsigned *rows_cap,
+    Dwarf_Unsigned  rows_count,
+    struct Dwarf_Line_s **row_out,
+    Dwarf_Error *error)
 {
-    if (*head_chain == NULL) {
-        *head_chain = chain_line;
-    } else {
-        (*curr_chain)->ch_next = chain_line;
-    }
-    *curr_chain = chain_line;
-}
+    struct Dwarf_Line_s *row = 0;
 
-void
-_dwarf_free_chain_entries(Dwarf_Debug dbg,Dwarf_Chain head,
-    Dwarf_Unsigned count)
-{
-    Dwarf_Unsigned i = 0;
-    Dwarf_Chain curr_chain = head;
-    for (i = 0; i < count; i++) {
-        Dwarf_Chain t = curr_chain;
-        void *item = t->ch_item;
-        int itype = t->ch_itemtype;
+    if (rows_count >= *rows_cap) {
+        Dwarf_Unsigned newcap = *rows_cap? *rows_cap*2 : 64;
+        struct Dwarf_Line_s *newrows = 0;
 
-        if (item && itype) { /* valid DW_DLA types are never 0 */
-            dwarf_dealloc(dbg,item,itype);
-            t->ch_item = 0;
+        if (newcap <= *rows_cap || newcap >
+            ((Dwarf_Unsigned)(size_t)-1)/
+            sizeof(struct Dwarf_Line_s)) {
+            _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: too many line table rows");
+            return DW_DLV_ERROR;
         }
-        curr_chain = curr_chain->ch_next;
-        dwarf_dealloc(dbg, t, DW_DLA_CHAIN);
+        newrows = (struct Dwarf_Line_s *)realloc(*rows,
+            (size_t)newcap*sizeof(struct Dwarf_Line_s));
+        if (!newrows) {
+            _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: growing the line table rows");
+            return DW_DLV_ERROR;
+        }
+        *rows = newrows;
+        *rows_cap = newcap;
     }
+    row = *rows + rows_count;
+    memset(row,0,sizeof(*row));
+    *row_out = row;
+    return DW_DLV_OK;
 }
 
 int
@@ -2693,6 +2697,10 @@ _dwarf_line_context_destructor(void *m)
     free(line_context->lc_file_format_values);
     line_context->lc_file_format_values = 0;
 
+    free(line_context->lc_linerows_logicals);
+    line_context->lc_linerows_logicals = 0;
+    free(line_context->lc_linerows_actuals);
+    line_context->lc_linerows_actuals = 0;
     if (line_context->lc_subprogs) {
         free(line_context->lc_subprogs);
         line_context->lc_subprogs = 0;
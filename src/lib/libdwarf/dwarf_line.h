@@ -264,6 +264,12 @@ struct Dwarf_Line_Context_s {
     /* Non-zero only if two-level table with actuals */
     Dwarf_Line   *lc_linebuf_actuals;
     Dwarf_Unsigned lc_linecount_actuals;
+
+    /*  The Dwarf_Line pointers in lc_linebuf_logicals
+        and lc_linebuf_actuals point into these,
+        one malloc'd array of rows per table. */
+    struct Dwarf_Line_s *lc_linerows_logicals;
+    struct Dwarf_Line_s *lc_linerows_actuals;
 };
 
 /*  The line table set of registers.
@@ -474,10 +480,12 @@ void _dwarf_report_bad_lnct( Dwarf_Debug dbg,
     const char * dlename,
     Dwarf_Error *err);
 
-void _dwarf_update_chain_list( Dwarf_Chain chain_line,
-    Dwarf_Chain *head_chain, Dwarf_Chain *curr_chain);
-void _dwarf_free_chain_entries(Dwarf_Debug dbg,Dwarf_Chain head,
-    Dwarf_Unsigned count);
+int _dwarf_add_line_row(Dwarf_Debug dbg,
+    struct Dwarf_Line_s **rows,
+    Dwarf_Unsigned *rows_cap,
+    Dwarf_Unsigned  rows_count,
+    struct Dwarf_Line_s **row_out,
+    Dwarf_Error *error);
 
 int _dwarf_line_context_constructor(Dwarf_Debug dbg, void *m);
 void _dwarf_line_context_destructor(void *m);
@@ -487,3 +495,46 @@ void _dwarf_print_line_context_record(Dwarf_Debug dbg,
 void _dwarf_context_src_files_destroy(Dwarf_Line_Context context);
 int _dwarf_add_to_files_list(Dwarf_Line_Context context,
     Dwarf_File_Entry fe);
+
+/*  The header of a table from dwarf_make_line_index().
+    Followed, each part 8 byte aligned, by
+    lh_seq_count struct Dwarf_Line_Index_Seq_s
+    at lh_seq_offset, lh_row_count row addresses
+    (Dwarf_Addr), lines and file numbers (unsigned int)
+    and columns (Dwarf_Half), lh_file_count string
+    offsets (Dwarf_Unsigned) and the NUL terminated
+    file names. lh_byte_order is LINE_INDEX_BYTE_ORDER
+    as written, so a table from a host of the other
+    byte order is recognized and rejected. */
+#define LINE_INDEX_MAGIC      "DWLINIDX"
+#define LINE_INDEX_MAGIC_LEN  8
+#define LINE_INDEX_VERSION    1
+#define LINE_INDEX_BYTE_ORDER 0x0102030405060708ULL
+struct Dwarf_Line_Index_Header_s {
+    char           lh_magic[LINE_INDEX_MAGIC_LEN];
+    Dwarf_Unsigned lh_byte_order;
+    Dwarf_Unsigned lh_version;
+    Dwarf_Unsigned lh_table_size;
+    Dwarf_Unsigned lh_seq_count;
+    Dwarf_Unsigned lh_row_count;
+    Dwarf_Unsigned lh_file_count;
+    Dwarf_Unsigned lh_strings_size;
+    Dwarf_Unsigned lh_seq_offset;
+    Dwarf_Unsigned lh_addr_offset;
+    Dwarf_Unsigned lh_line_offset;
+    Dwarf_Unsigned lh_file_offset;
+    Dwarf_Unsigned lh_column_offset;
+    Dwarf_Unsigned lh_filetab_offset;
+    Dwarf_Unsigned lh_strings_offset;
+};
+
+/*  One sequence, in order of ls_start.
+    ls_max_end is the highest ls_end of this and
+    all earlier sequences. */
+struct Dwarf_Line_Index_Seq_s {
+    Dwarf_Addr     ls_start;
+    Dwarf_Addr     ls_end;
+    Dwarf_Addr     ls_max_end;
+    Dwarf_Unsigned ls_first_row;
+    Dwarf_Unsigned ls_row_count;
+};
@@ -0,0 +1,558 @@
+/*
+  Copyright (C) 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  A compact, column per field, copy of the rows of a
+    line table, with the sequences sorted by address so
+    a pc can be found by binary search. Once built it
+    needs neither the Dwarf_Line_Context nor the
+    Dwarf_Debug. */
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() qsort() */
+#include <string.h> /* memset() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dwarf_local_malloc.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_line.h"
+
+/*  Row values beyond 32 bits are stored as this. */
+#define LCOL_MAX32 0xffffffffU
+
+#define LCOL_FLAG_COUNT 5
+
+/*  All the arrays are carved from lcol_block,
+    in this order so each is aligned. */
+struct Dwarf_Line_Columns_s {
+    Dwarf_Unsigned  lcol_row_count;
+    Dwarf_Unsigned  lcol_seq_count;
+
+    /*  Per sequence, in order of lcol_seq_start. */
+    Dwarf_Addr     *lcol_seq_start;
+    Dwarf_Addr     *lcol_seq_end;
+    /*  The highest lcol_seq_end of this and all
+        earlier sequences, so a lookup knows when
+        to stop looking back through overlapping
+        sequences. */
+    Dwarf_Addr     *lcol_seq_max_end;
+    /*  lcol_seq_count+1 entries. The rows of
+        sequence i are lcol_seq_first_row[i]
+        up to lcol_seq_first_row[i+1]. */
+    Dwarf_Unsigned *lcol_seq_first_row;
+
+    /*  Row addresses. Normally as the offset from the
+        start of the row's sequence in lcol_addr_offset.
+        If some sequence spans 4GB or more then
+        lcol_addr_wide is set and the addresses
+        are in lcol_addr instead. */
+    Dwarf_Bool      lcol_addr_wide;
+    Dwarf_Addr     *lcol_addr;
+    unsigned int   *lcol_addr_offset;
+
+    unsigned int   *lcol_line;
+    unsigned int   *lcol_file;
+    unsigned int   *lcol_discriminator;
+    Dwarf_Half     *lcol_column;
+    /*  One bitset per DW_LINE_COLUMNS_ flag,
+        (lcol_row_count+7)/8 bytes each. */
+    Dwarf_Small    *lcol_flags[LCOL_FLAG_COUNT];
+
+    void           *lcol_block;
+};
+
+/*  Used while building: where a sequence is in the
+    Dwarf_Line array. */
+struct lcol_seq_s {
+    Dwarf_Addr     ls_start;
+    Dwarf_Addr     ls_end;
+    Dwarf_Unsigned ls_first;
+    Dwarf_Unsigned ls_count;
+};
+
+static int
+lcol_seq_compare(const void *l, const void *r)
+{
+    const struct lcol_seq_s *ls = (const struct lcol_seq_s *)l;
+    const struct lcol_seq_s *rs = (const struct lcol_seq_s *)r;
+
+    if (ls->ls_start < rs->ls_start) {
+        return -1;
+    }
+    if (ls->ls_start > rs->ls_start) {
+        return 1;
+    }
+    /*  Keep the table order for sequences starting
+        at the same address. */
+    if (ls->ls_first < rs->ls_first) {
+        return -1;
+    }
+    if (ls->ls_first > rs->ls_first) {
+        return 1;
+    }
+    return 0;
+}
+
+static unsigned int
+lcol_clamp32(Dwarf_Unsigned v)
+{
+    if (v > LCOL_MAX32) {
+        return LCOL_MAX32;
+    }
+    return (unsigned int)v;
+}
+
+static Dwarf_Unsigned
+lcol_align8(Dwarf_Unsigned v)
+{
+    return (v + 7) & ~(Dwarf_Unsigned)7;
+}
+
+/*  Split the rows into sequences, each ending with
+    an end_sequence row (or the last row).
+    A sequence whose addresses go backwards cannot
+    be searched, it is kept for its rows but made
+    empty so lookups never find it. */
+static int
+lcol_find_sequences(Dwarf_Line *lines,
+    Dwarf_Unsigned line_count,
+    struct lcol_seq_s **seqs_out,
+    Dwarf_Unsigned *seq_count_out,
+    Dwarf_Bool *wide_out)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned seq_count = 0;
+    Dwarf_Unsigned first = 0;
+    struct lcol_seq_s *seqs = 0;
+    Dwarf_Bool wide = FALSE;
+
+    for (i = 0; i < line_count; ++i) {
+        if (lines[i]->li_l_data.li_end_sequence ||
+            i+1 == line_count) {
+            ++seq_count;
+        }
+    }
+    seqs = (struct lcol_seq_s *)calloc(
+        (size_t)(seq_count? seq_count:1),
+        sizeof(struct lcol_seq_s));
+    if (!seqs) {
+        return DW_DLV_ERROR;
+    }
+    seq_count = 0;
+    for (i = 0; i < line_count; ++i) {
+        struct lcol_seq_s *s = 0;
+        Dwarf_Unsigned k = 0;
+
+        if (!lines[i]->li_l_data.li_end_sequence &&
+            i+1 < line_count) {
+            continue;
+        }
+        s = seqs + seq_count;
+        s->ls_first = first;
+        s->ls_count = i + 1 - first;
+        s->ls_start = lines[first]->li_address;
+        s->ls_end = lines[i]->li_address;
+        for (k = first; k <= i; ++k) {
+            Dwarf_Addr a = lines[k]->li_address;
+
+            if (a < s->ls_start || a - s->ls_start > LCOL_MAX32) {
+                wide = TRUE;
+            }
+            if (k > first && a < lines[k-1]->li_address) {
+                s->ls_end = s->ls_start;
+            }
+        }
+        ++seq_count;
+        first = i + 1;
+    }
+    *seqs_out = seqs;
+    *seq_count_out = seq_count;
+    *wide_out = wide;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_make_line_columns(Dwarf_Line_Context line_context,
+    Dwarf_Line_Columns *columns_out,
+    Dwarf_Unsigned *row_count_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Line *logicals = 0;
+    Dwarf_Unsigned line_count = 0;
+    Dwarf_Unsigned logicals_count = 0;
+    struct lcol_seq_s *seqs = 0;
+    Dwarf_Unsigned seq_count = 0;
+    Dwarf_Bool wide = FALSE;
+    Dwarf_Line_Columns cols = 0;
+    Dwarf_Unsigned flagbytes = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned row = 0;
+    char *block = 0;
+    int res = 0;
+
+    if (!line_context ||
+        line_context->lc_magic != DW_CONTEXT_MAGIC) {
+        _dwarf_error(NULL, error, DW_DLE_LINE_CONTEXT_BOTCH);
+        return DW_DLV_ERROR;
+    }
+    dbg = line_context->lc_dbg;
+    if (!columns_out) {
+        _dwarf_error_string(dbg, error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_make_line_columns() "
+            "was passed a NULL Dwarf_Line_Columns pointer");
+        return DW_DLV_ERROR;
+    }
+    logicals = line_context->lc_linebuf_logicals;
+    logicals_count = line_context->lc_linecount_logicals;
+    if (line_context->lc_linecount_actuals) {
+        /*  Two-level table: the actuals have the
+            addresses and refer to the logicals for
+            the rest. */
+        lines = line_context->lc_linebuf_actuals;
+        line_count = line_context->lc_linecount_actuals;
+    } else {
+        lines = logicals;
+        line_count = logicals_count;
+    }
+    res = lcol_find_sequences(lines,line_count,
+        &seqs,&seq_count,&wide);
+    if (res != DW_DLV_OK) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: dwarf_make_line_columns() "
+            "sequence list");
+        return DW_DLV_ERROR;
+    }
+    qsort(seqs,(size_t)seq_count,sizeof(struct lcol_seq_s),
+        lcol_seq_compare);
+
+    flagbytes = (line_count + 7)/8;
+    size = lcol_align8(sizeof(struct Dwarf_Line_Columns_s));
+    size += 3*seq_count*sizeof(Dwarf_Addr);
+    size += (seq_count+1)*sizeof(Dwarf_Unsigned);
+    if (wide) {
+        size += line_count*sizeof(Dwarf_Addr);
+    } else {
+        size += line_count*sizeof(unsigned int);
+    }
+    size += 3*line_count*sizeof(unsigned int);
+    size += line_count*sizeof(Dwarf_Half);
+    size += LCOL_FLAG_COUNT*flagbytes;
+    block = (char *)calloc(1,(size_t)size);
+    if (!block) {
+        free(seqs);
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: dwarf_make_line_columns() "
+            "table");
+        return DW_DLV_ERROR;
+    }
+    cols = (Dwarf_Line_Columns)block;
+    cols->lcol_block = block;
+    cols->lcol_row_count = line_count;
+    cols->lcol_seq_count = seq_count;
+    cols->lcol_addr_wide = wide;
+    block += lcol_align8(sizeof(struct Dwarf_Line_Columns_s));
+    cols->lcol_seq_start = (Dwarf_Addr *)block;
+    block += seq_count*sizeof(Dwarf_Addr);
+    cols->lcol_seq_end = (Dwarf_Addr *)block;
+    block += seq_count*sizeof(Dwarf_Addr);
+    cols->lcol_seq_max_end = (Dwarf_Addr *)block;
+    block += seq_count*sizeof(Dwarf_Addr);
+    cols->lcol_seq_first_row = (Dwarf_Unsigned *)block;
+    block += (seq_count+1)*sizeof(Dwarf_Unsigned);
+    if (wide) {
+        cols->lcol_addr = (Dwarf_Addr *)block;
+        block += line_count*sizeof(Dwarf_Addr);
+    } else {
+        cols->lcol_addr_offset = (unsigned int *)block;
+        block += line_count*sizeof(unsigned int);
+    }
+    cols->lcol_line = (unsigned int *)block;
+    block += line_count*sizeof(unsigned int);
+    cols->lcol_file = (unsigned int *)block;
+    block += line_count*sizeof(unsigned int);
+    cols->lcol_discriminator = (unsigned int *)block;
+    block += line_count*sizeof(unsigned int);
+    cols->lcol_column = (Dwarf_Half *)block;
+    block += line_count*sizeof(Dwarf_Half);
+    for (i = 0; i < LCOL_FLAG_COUNT; ++i) {
+        cols->lcol_flags[i] = (Dwarf_Small *)block;
+        block += flagbytes;
+    }
+
+    for (i = 0; i < seq_count; ++i) {
+        struct lcol_seq_s *s = seqs + i;
+        Dwarf_Unsigned k = 0;
+
+        cols->lcol_seq_start[i] = s->ls_start;
+        cols->lcol_seq_end[i] = s->ls_end;
+        cols->lcol_seq_max_end[i] = s->ls_end;
+        if (i && cols->lcol_seq_max_end[i-1] > s->ls_end) {
+            cols->lcol_seq_max_end[i] =
+                cols->lcol_seq_max_end[i-1];
+        }
+        cols->lcol_seq_first_row[i] = row;
+        for (k = 0; k < s->ls_count; ++k,++row) {
+            Dwarf_Line l = lines[s->ls_first + k];
+            Dwarf_Line src = l;
+            Dwarf_Unsigned byte = row/8;
+            Dwarf_Small bit = (Dwarf_Small)(1 << (row%8));
+
+            if (wide) {
+                cols->lcol_addr[row] = l->li_address;
+            } else {
+                cols->lcol_addr_offset[row] = (unsigned int)
+                    (l->li_address - s->ls_start);
+            }
+            if (l->li_is_actuals_table) {
+                /*  li_line is the 1-based logicals
+                    row holding the source position. */
+                Dwarf_Unsigned li = l->li_l_data.li_line;
+
+                src = 0;
+                if (li >= 1 && li <= logicals_count) {
+                    src = logicals[li-1];
+                }
+            }
+            if (src) {
+                cols->lcol_line[row] =
+                    lcol_clamp32(src->li_l_data.li_line);
+                cols->lcol_file[row] =
+                    lcol_clamp32(src->li_l_data.li_file);
+                cols->lcol_column[row] =
+                    src->li_l_data.li_column;
+            }
+            cols->lcol_discriminator[row] =
+                lcol_clamp32(l->li_l_data.li_discriminator);
+            if (l->li_l_data.li_is_stmt) {
+                cols->lcol_flags[0][byte] |= bit;
+            }
+            if (l->li_l_data.li_basic_block) {
+                cols->lcol_flags[1][byte] |= bit;
+            }
+            if (l->li_l_data.li_end_sequence) {
+                cols->lcol_flags[2][byte] |= bit;
+            }
+            if (l->li_l_data.li_prologue_end) {
+                cols->lcol_flags[3][byte] |= bit;
+            }
+            if (l->li_l_data.li_epilogue_begin) {
+                cols->lcol_flags[4][byte] |= bit;
+            }
+        }
+    }
+    cols->lcol_seq_first_row[seq_count] = row;
+    free(seqs);
+    *columns_out = cols;
+    if (row_count_out) {
+        *row_count_out = line_count;
+    }
+    return DW_DLV_OK;
+}
+
+/*  The sequence holding row, by binary search. */
+static Dwarf_Unsigned
+lcol_row_sequence(Dwarf_Line_Columns cols,
+    Dwarf_Unsigned row)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = cols->lcol_seq_count;
+
+    /*  Last sequence whose first row is <= row. */
+    while (hi - lo > 1) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (cols->lcol_seq_first_row[mid] <= row) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static Dwarf_Addr
+lcol_row_addr(Dwarf_Line_Columns cols,
+    Dwarf_Unsigned seq,
+    Dwarf_Unsigned row)
+{
+    if (cols->lcol_addr_wide) {
+        return cols->lcol_addr[row];
+    }
+    return cols->lcol_seq_start[seq] +
+        cols->lcol_addr_offset[row];
+}
+
+int
+dwarf_lookup_line_columns(Dwarf_Line_Columns cols,
+    Dwarf_Addr pc,
+    Dwarf_Unsigned *row_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned s = 0;
+
+    if (!cols || !row_out) {
+        _dwarf_error_string(NULL, error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_lookup_line_columns() "
+            "was passed a NULL pointer");
+        return DW_DLV_ERROR;
+    }
+    /*  hi is the count of sequences starting at
+        or before pc. */
+    hi = cols->lcol_seq_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (cols->lcol_seq_start[mid] <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /*  Look back from the latest starting sequence
+        for one that covers pc. */
+    for (s = lo; s > 0; --s) {
+        Dwarf_Unsigned seq = s - 1;
+        Dwarf_Unsigned first = 0;
+        Dwarf_Unsigned last = 0;
+
+        if (cols->lcol_seq_max_end[seq] <= pc) {
+            break;
+        }
+        if (pc >= cols->lcol_seq_end[seq]) {
+            continue;
+        }
+        /*  The last row with address <= pc.
+            The end_sequence row is at or past
+            the end so is never the one. */
+        first = cols->lcol_seq_first_row[seq];
+        last = cols->lcol_seq_first_row[seq+1];
+        lo = first;
+        hi = last;
+        while (lo < hi) {
+            Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+            if (lcol_row_addr(cols,seq,mid) <= pc) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        /*  lo > first since the first row is at
+            the sequence start. */
+        *row_out = lo - 1;
+        return DW_DLV_OK;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+int
+dwarf_line_columns_row(Dwarf_Line_Columns cols,
+    Dwarf_Unsigned  row,
+    Dwarf_Addr     *address_out,
+    Dwarf_Unsigned *line_out,
+    Dwarf_Unsigned *file_out,
+    Dwarf_Unsigned *column_out,
+    Dwarf_Unsigned *discriminator_out,
+    Dwarf_Unsigned *flags_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Unsigned byte = 0;
+    Dwarf_Small bit = 0;
+
+    if (!cols) {
+        _dwarf_error_string(NULL, error, DW_DLE_IA,
+            "DW_DLE_IA: dwarf_line_columns_row() "
+            "was passed a NULL Dwarf_Line_Columns");
+        return DW_DLV_ERROR;
+    }
+    if (row >= cols->lcol_row_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (address_out) {
+        *address_out = lcol_row_addr(cols,
+            lcol_row_sequence(cols,row),row);
+    }
+    if (line_out) {
+        *line_out = cols->lcol_line[row];
+    }
+    if (file_out) {
+        *file_out = cols->lcol_file[row];
+    }
+    if (column_out) {
+        *column_out = cols->lcol_column[row];
+    }
+    if (discriminator_out) {
+        *discriminator_out = cols->lcol_discriminator[row];
+    }
+    if (flags_out) {
+        Dwarf_Unsigned flags = 0;
+
+        byte = row/8;
+        bit = (Dwarf_Small)(1 << (row%8));
+        if (cols->lcol_flags[0][byte] & bit) {
+            flags |= DW_LINE_COLUMNS_IS_STMT;
+        }
+        if (cols->lcol_flags[1][byte] & bit) {
+            flags |= DW_LINE_COLUMNS_BASIC_BLOCK;
+        }
+        if (cols->lcol_flags[2][byte] & bit) {
+            flags |= DW_LINE_COLUMNS_END_SEQUENCE;
+        }
+        if (cols->lcol_flags[3][byte] & bit) {
+            flags |= DW_LINE_COLUMNS_PROLOGUE_END;
+        }
+        if (cols->lcol_flags[4][byte] & bit) {
+            flags |= DW_LINE_COLUMNS_EPILOGUE_BEGIN;
+        }
+        *flags_out = flags;
+    }
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_line_columns(Dwarf_Line_Columns cols)
+{
+    if (!cols) {
+        return;
+    }
+    free(cols->lcol_block);
+}
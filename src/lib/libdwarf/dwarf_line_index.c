@@ -0,0 +1,958 @@
+/*
+  Copyright (C) 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds one address sorted index of the line table
+    sequences of every CU, with the file names in a
+    string table, so a pc can be turned into a file
+    and line with a binary search. The index has no
+    pointers and so can be saved to a file and mapped
+    in later, with no Dwarf_Debug needed to use it. */
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() qsort() realloc() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp() strlen() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dwarf_local_malloc.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_line.h"
+
+#define LINE_INDEX_INITIAL_ROWS  1024
+#define LINE_INDEX_INITIAL_SEQS  64
+#define LINE_INDEX_INITIAL_FILES 64
+#define LINE_INDEX_MAX32         0xffffffffU
+#define LINE_INDEX_NO_FILE       ((Dwarf_Unsigned)-1)
+
+/*  A sequence as built, its rows are lb_first
+    onward in the build arrays. */
+struct lb_seq_s {
+    Dwarf_Addr     bs_start;
+    Dwarf_Addr     bs_end;
+    Dwarf_Unsigned bs_first;
+    Dwarf_Unsigned bs_count;
+};
+
+/*  The index being built. */
+struct line_index_build_s {
+    Dwarf_Unsigned  lb_row_count;
+    Dwarf_Unsigned  lb_row_alloc;
+    Dwarf_Addr     *lb_addr;
+    unsigned int   *lb_line;
+    unsigned int   *lb_file;
+    Dwarf_Half     *lb_column;
+
+    Dwarf_Unsigned  lb_seq_count;
+    Dwarf_Unsigned  lb_seq_alloc;
+    struct lb_seq_s *lb_seqs;
+
+    /*  File names, each once, in lb_strings, with
+        an open addressing hash (of file number+1)
+        to find them. */
+    Dwarf_Unsigned  lb_file_count;
+    Dwarf_Unsigned  lb_file_alloc;
+    Dwarf_Unsigned *lb_file_stroff;
+    char           *lb_strings;
+    Dwarf_Unsigned  lb_strings_size;
+    Dwarf_Unsigned  lb_strings_alloc;
+    Dwarf_Unsigned *lb_hash;
+    Dwarf_Unsigned  lb_hash_size;
+
+    /*  Set when a new file name would not fit the
+        32 bit file numbers of the index. */
+    Dwarf_Bool      lb_too_many_files;
+};
+
+static void
+lb_free(struct line_index_build_s *lb)
+{
+    free(lb->lb_addr);
+    free(lb->lb_line);
+    free(lb->lb_file);
+    free(lb->lb_column);
+    free(lb->lb_seqs);
+    free(lb->lb_file_stroff);
+    free(lb->lb_strings);
+    free(lb->lb_hash);
+    memset(lb,0,sizeof(*lb));
+}
+
+static int
+lb_grow_rows(struct line_index_build_s *lb)
+{
+    Dwarf_Unsigned n = lb->lb_row_alloc?
+        lb->lb_row_alloc*2:LINE_INDEX_INITIAL_ROWS;
+    Dwarf_Addr *addr = 0;
+    unsigned int *line = 0;
+    unsigned int *file = 0;
+    Dwarf_Half *column = 0;
+
+    if (n <= lb->lb_row_alloc ||
+        n > ((Dwarf_Unsigned)(size_t)-1)/sizeof(Dwarf_Addr)) {
+        return DW_DLV_ERROR;
+    }
+    addr = (Dwarf_Addr *)realloc(lb->lb_addr,
+        (size_t)n*sizeof(Dwarf_Addr));
+    if (!addr) {
+        return DW_DLV_ERROR;
+    }
+    lb->lb_addr = addr;
+    line = (unsigned int *)realloc(lb->lb_line,
+        (size_t)n*sizeof(unsigned int));
+    if (!line) {
+        return DW_DLV_ERROR;
+    }
+    lb->lb_line = line;
+    file = (unsigned int *)realloc(lb->lb_file,
+        (size_t)n*sizeof(unsigned int));
+    if (!file) {
+        return DW_DLV_ERROR;
+    }
+    lb->lb_file = file;
+    column = (Dwarf_Half *)realloc(lb->lb_column,
+        (size_t)n*sizeof(Dwarf_Half));
+    if (!column) {
+        return DW_DLV_ERROR;
+    }
+    lb->lb_column = column;
+    lb->lb_row_alloc = n;
+    return DW_DLV_OK;
+}
+
+static int
+lb_add_seq(struct line_index_build_s *lb,
+    Dwarf_Addr start, Dwarf_Addr end,
+    Dwarf_Unsigned first, Dwarf_Unsigned count)
+{
+    struct lb_seq_s *s = 0;
+
+    if (lb->lb_seq_count >= lb->lb_seq_alloc) {
+        Dwarf_Unsigned n = lb->lb_seq_alloc?
+            lb->lb_seq_alloc*2:LINE_INDEX_INITIAL_SEQS;
+        struct lb_seq_s *seqs = 0;
+
+        if (n <= lb->lb_seq_alloc) {
+            return DW_DLV_ERROR;
+        }
+        seqs = (struct lb_seq_s *)realloc(lb->lb_seqs,
+            (size_t)n*sizeof(struct lb_seq_s));
+        if (!seqs) {
+            return DW_DLV_ERROR;
+        }
+        lb->lb_seqs = seqs;
+        lb->lb_seq_alloc = n;
+    }
+    s = lb->lb_seqs + lb->lb_seq_count;
+    s->bs_start = start;
+    s->bs_end = end;
+    s->bs_first = first;
+    s->bs_count = count;
+    ++lb->lb_seq_count;
+    return DW_DLV_OK;
+}
+
+static Dwarf_Unsigned
+lb_hash_string(const char *s)
+{
+    /* FNV-1a */
+    Dwarf_Unsigned h = 0xcbf29ce484222325ULL;
+
+    for ( ; *s; ++s) {
+        h ^= (unsigned char)*s;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static int
+lb_rehash(struct line_index_build_s *lb)
+{
+    Dwarf_Unsigned n = lb->lb_hash_size?
+        lb->lb_hash_size*2:LINE_INDEX_INITIAL_FILES*2;
+    Dwarf_Unsigned *hash = 0;
+    Dwarf_Unsigned i = 0;
+
+    hash = (Dwarf_Unsigned *)calloc((size_t)n,
+        sizeof(Dwarf_Unsigned));
+    if (!hash) {
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < lb->lb_file_count; ++i) {
+        Dwarf_Unsigned h = lb_hash_string(lb->lb_strings +
+            lb->lb_file_stroff[i]) & (n-1);
+
+        while (hash[h]) {
+            h = (h+1) & (n-1);
+        }
+        hash[h] = i+1;
+    }
+    free(lb->lb_hash);
+    lb->lb_hash = hash;
+    lb->lb_hash_size = n;
+    return DW_DLV_OK;
+}
+
+/*  The file number of name in the index, adding
+    it if new. */
+static int
+lb_file_index(struct line_index_build_s *lb,
+    const char *name,
+    Dwarf_Unsigned *index_out)
+{
+    Dwarf_Unsigned h = 0;
+    Dwarf_Unsigned len = 0;
+
+    if ((lb->lb_file_count+1)*2 > lb->lb_hash_size) {
+        if (lb_rehash(lb) != DW_DLV_OK) {
+            return DW_DLV_ERROR;
+        }
+    }
+    h = lb_hash_string(name) & (lb->lb_hash_size-1);
+    while (lb->lb_hash[h]) {
+        Dwarf_Unsigned fi = lb->lb_hash[h] - 1;
+
+        if (!strcmp(lb->lb_strings + lb->lb_file_stroff[fi],
+            name)) {
+            *index_out = fi;
+            return DW_DLV_OK;
+        }
+        h = (h+1) & (lb->lb_hash_size-1);
+    }
+    if (lb->lb_file_count >= LINE_INDEX_MAX32) {
+        lb->lb_too_many_files = TRUE;
+        return DW_DLV_ERROR;
+    }
+    if (lb->lb_file_count >= lb->lb_file_alloc) {
+        Dwarf_Unsigned n = lb->lb_file_alloc?
+            lb->lb_file_alloc*2:LINE_INDEX_INITIAL_FILES;
+        Dwarf_Unsigned *offs = (Dwarf_Unsigned *)realloc(
+            lb->lb_file_stroff,(size_t)n*sizeof(Dwarf_Unsigned));
+
+        if (!offs) {
+            return DW_DLV_ERROR;
+        }
+        lb->lb_file_stroff = offs;
+        lb->lb_file_alloc = n;
+    }
+    len = strlen(name) + 1;
+    if (lb->lb_strings_size + len > lb->lb_strings_alloc) {
+        Dwarf_Unsigned n = lb->lb_strings_alloc?
+            lb->lb_strings_alloc*2:4096;
+        char *strs = 0;
+
+        while (n < lb->lb_strings_size + len) {
+            n *= 2;
+        }
+        strs = (char *)realloc(lb->lb_strings,(size_t)n);
+        if (!strs) {
+            return DW_DLV_ERROR;
+        }
+        lb->lb_strings = strs;
+        lb->lb_strings_alloc = n;
+    }
+    memcpy(lb->lb_strings + lb->lb_strings_size,name,(size_t)len);
+    lb->lb_file_stroff[lb->lb_file_count] = lb->lb_strings_size;
+    lb->lb_strings_size += len;
+    lb->lb_hash[h] = lb->lb_file_count + 1;
+    *index_out = lb->lb_file_count;
+    ++lb->lb_file_count;
+    return DW_DLV_OK;
+}
+
+/*  The index file number for a line table file number,
+    found through dwarf_linesrc() the first time.
+    filemap has endindex entries. */
+static int
+lb_line_file(Dwarf_Debug dbg,
+    struct line_index_build_s *lb,
+    Dwarf_Line line,
+    Dwarf_Unsigned *filemap,
+    Dwarf_Unsigned endindex,
+    Dwarf_Unsigned *index_out)
+{
+    Dwarf_Unsigned fileno = 0;
+    char *name = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_line_srcfileno(line,&fileno,&err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        err = 0;
+        fileno = endindex;
+    }
+    if (fileno < endindex &&
+        filemap[fileno] != LINE_INDEX_NO_FILE) {
+        *index_out = filemap[fileno];
+        return DW_DLV_OK;
+    }
+    res = dwarf_linesrc(line,&name,&err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        err = 0;
+    }
+    res = lb_file_index(lb,(res == DW_DLV_OK)?name:"",
+        index_out);
+    if (name) {
+        dwarf_dealloc(dbg,name,DW_DLA_STRING);
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (fileno < endindex) {
+        filemap[fileno] = *index_out;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Adds the complete sequences of a CU's line table.
+    CUs without a usable line table are left out. */
+static int
+lb_add_cu(Dwarf_Debug dbg,
+    struct line_index_build_s *lb,
+    Dwarf_Die cu_die)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed line_count = 0;
+    Dwarf_Signed baseindex = 0;
+    Dwarf_Signed file_count = 0;
+    Dwarf_Signed endindex = 0;
+    Dwarf_Unsigned *filemap = 0;
+    Dwarf_Unsigned seq_first = 0;
+    Dwarf_Bool seq_ok = TRUE;
+    Dwarf_Error err = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cu_die,&version,&table_count,
+        &context,&err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+        return DW_DLV_OK;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    if (table_count != 1) {
+        /*  No lines, or an experimental two-level table. */
+        dwarf_srclines_dealloc_b(context);
+        return DW_DLV_OK;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &line_count,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_srclines_files_indexes(context,&baseindex,
+            &file_count,&endindex,&err);
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    if (res != DW_DLV_OK || endindex < 0) {
+        dwarf_srclines_dealloc_b(context);
+        return DW_DLV_OK;
+    }
+    filemap = (Dwarf_Unsigned *)malloc(
+        (size_t)(endindex+1)*sizeof(Dwarf_Unsigned));
+    if (!filemap) {
+        dwarf_srclines_dealloc_b(context);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i <= endindex; ++i) {
+        filemap[i] = LINE_INDEX_NO_FILE;
+    }
+    seq_first = lb->lb_row_count;
+    for (i = 0; i < line_count; ++i) {
+        Dwarf_Line l = lines[i];
+        Dwarf_Unsigned r = lb->lb_row_count;
+        Dwarf_Unsigned fi = 0;
+
+        if (r >= lb->lb_row_alloc && lb_grow_rows(lb)) {
+            res = DW_DLV_ERROR;
+            break;
+        }
+        res = lb_line_file(dbg,lb,l,filemap,
+            (Dwarf_Unsigned)endindex,&fi);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        lb->lb_addr[r] = l->li_address;
+        lb->lb_line[r] = (l->li_l_data.li_line > LINE_INDEX_MAX32)?
+            LINE_INDEX_MAX32:(unsigned int)l->li_l_data.li_line;
+        lb->lb_file[r] = (unsigned int)fi;
+        lb->lb_column[r] = l->li_l_data.li_column;
+        if (r > seq_first && l->li_address < lb->lb_addr[r-1]) {
+            /*  Addresses going back, the sequence
+                cannot be searched. */
+            seq_ok = FALSE;
+        }
+        lb->lb_row_count = r+1;
+        if (!l->li_l_data.li_end_sequence) {
+            continue;
+        }
+        if (seq_ok && l->li_address > lb->lb_addr[seq_first]) {
+            res = lb_add_seq(lb,lb->lb_addr[seq_first],
+                l->li_address,seq_first,r+1-seq_first);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+        } else {
+            /*  Drop an empty or unusable sequence. */
+            lb->lb_row_count = seq_first;
+        }
+        seq_first = lb->lb_row_count;
+        seq_ok = TRUE;
+    }
+    /*  Rows after the last end_sequence are not
+        a complete sequence. */
+    lb->lb_row_count = seq_first;
+    free(filemap);
+    dwarf_srclines_dealloc_b(context);
+    return res;
+}
+
+static int
+lb_seq_compare(const void *l, const void *r)
+{
+    const struct lb_seq_s *ls = (const struct lb_seq_s *)l;
+    const struct lb_seq_s *rs = (const struct lb_seq_s *)r;
+
+    if (ls->bs_start != rs->bs_start) {
+        return (ls->bs_start < rs->bs_start)? -1:1;
+    }
+    if (ls->bs_end != rs->bs_end) {
+        return (ls->bs_end < rs->bs_end)? -1:1;
+    }
+    if (ls->bs_first != rs->bs_first) {
+        return (ls->bs_first < rs->bs_first)? -1:1;
+    }
+    return 0;
+}
+
+/*  TRUE if two sequences have the same rows, as
+    when the same code is described by more than
+    one CU. */
+static Dwarf_Bool
+lb_seq_same(struct line_index_build_s *lb,
+    struct lb_seq_s *a, struct lb_seq_s *b)
+{
+    Dwarf_Unsigned fa = a->bs_first;
+    Dwarf_Unsigned fb = b->bs_first;
+    size_t n = (size_t)a->bs_count;
+
+    if (a->bs_start != b->bs_start || a->bs_end != b->bs_end ||
+        a->bs_count != b->bs_count) {
+        return FALSE;
+    }
+    if (memcmp(lb->lb_addr+fa,lb->lb_addr+fb,
+            n*sizeof(Dwarf_Addr)) ||
+        memcmp(lb->lb_line+fa,lb->lb_line+fb,
+            n*sizeof(unsigned int)) ||
+        memcmp(lb->lb_file+fa,lb->lb_file+fb,
+            n*sizeof(unsigned int)) ||
+        memcmp(lb->lb_column+fa,lb->lb_column+fb,
+            n*sizeof(Dwarf_Half))) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static Dwarf_Unsigned
+li_align8(Dwarf_Unsigned v)
+{
+    return (v + 7) & ~(Dwarf_Unsigned)7;
+}
+
+static int
+line_index_alloc_fail(Dwarf_Debug dbg,
+    struct line_index_build_s *lb,
+    Dwarf_Error *error)
+{
+    lb_free(lb);
+    _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory building "
+        "the dwarf_make_line_index() table");
+    return DW_DLV_ERROR;
+}
+
+int
+dwarf_make_line_index(Dwarf_Debug dbg,
+    void           **table_out,
+    Dwarf_Unsigned  *table_size_out,
+    Dwarf_Error     *error)
+{
+    struct line_index_build_s lb;
+    struct Dwarf_Line_Index_Header_s *hdr = 0;
+    struct Dwarf_Line_Index_Seq_s *seqs = 0;
+    Dwarf_Addr *addr = 0;
+    unsigned int *line = 0;
+    unsigned int *file = 0;
+    Dwarf_Half *column = 0;
+    Dwarf_Unsigned kept = 0;
+    Dwarf_Unsigned rows = 0;
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned i = 0;
+    char *table = 0;
+    int res = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_make_line_index()");
+    if (!table_out || !table_size_out) {
+        _dwarf_error_string(dbg,error,DW_DLE_IA,
+            "DW_DLE_IA: a NULL argument passed to "
+            "dwarf_make_line_index()");
+        return DW_DLV_ERROR;
+    }
+    memset(&lb,0,sizeof(lb));
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            &cu_header_length,&version_stamp,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_header,
+            &header_cu_type,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res == DW_DLV_ERROR) {
+            lb_free(&lb);
+            return res;
+        }
+        res = lb_add_cu(dbg,&lb,cu_die);
+        dwarf_dealloc_die(cu_die);
+        if (res != DW_DLV_OK && lb.lb_too_many_files) {
+            lb_free(&lb);
+            _dwarf_error_string(dbg,error,
+                DW_DLE_ARITHMETIC_OVERFLOW,
+                "DW_DLE_ARITHMETIC_OVERFLOW: more file names "
+                "than the 32 bit file numbers of "
+                "dwarf_make_line_index() can hold");
+            return DW_DLV_ERROR;
+        }
+        if (res != DW_DLV_OK) {
+            return line_index_alloc_fail(dbg,&lb,error);
+        }
+    }
+
+    if (lb.lb_seq_count > 1) {
+        qsort(lb.lb_seqs,(size_t)lb.lb_seq_count,
+            sizeof(struct lb_seq_s),lb_seq_compare);
+    }
+    for (i = 0; i < lb.lb_seq_count; ++i) {
+        if (kept && lb_seq_same(&lb,lb.lb_seqs+kept-1,
+            lb.lb_seqs+i)) {
+            continue;
+        }
+        lb.lb_seqs[kept] = lb.lb_seqs[i];
+        rows += lb.lb_seqs[i].bs_count;
+        ++kept;
+    }
+
+    off = li_align8(sizeof(struct Dwarf_Line_Index_Header_s));
+    {
+        Dwarf_Unsigned seq_offset = off;
+        Dwarf_Unsigned addr_offset = 0;
+        Dwarf_Unsigned line_offset = 0;
+        Dwarf_Unsigned file_offset = 0;
+        Dwarf_Unsigned column_offset = 0;
+        Dwarf_Unsigned filetab_offset = 0;
+        Dwarf_Unsigned strings_offset = 0;
+
+        off += kept*sizeof(struct Dwarf_Line_Index_Seq_s);
+        addr_offset = off = li_align8(off);
+        off += rows*sizeof(Dwarf_Addr);
+        line_offset = off = li_align8(off);
+        off += rows*sizeof(unsigned int);
+        file_offset = off = li_align8(off);
+        off += rows*sizeof(unsigned int);
+        column_offset = off = li_align8(off);
+        off += rows*sizeof(Dwarf_Half);
+        filetab_offset = off = li_align8(off);
+        off += lb.lb_file_count*sizeof(Dwarf_Unsigned);
+        strings_offset = off = li_align8(off);
+        off += lb.lb_strings_size? lb.lb_strings_size:1;
+        off = li_align8(off);
+
+        table = (char *)calloc(1,(size_t)off);
+        if (!table) {
+            return line_index_alloc_fail(dbg,&lb,error);
+        }
+        hdr = (struct Dwarf_Line_Index_Header_s *)table;
+        memcpy(hdr->lh_magic,LINE_INDEX_MAGIC,
+            LINE_INDEX_MAGIC_LEN);
+        hdr->lh_byte_order = LINE_INDEX_BYTE_ORDER;
+        hdr->lh_version = LINE_INDEX_VERSION;
+        hdr->lh_table_size = off;
+        hdr->lh_seq_count = kept;
+        hdr->lh_row_count = rows;
+        hdr->lh_file_count = lb.lb_file_count;
+        hdr->lh_strings_size = lb.lb_strings_size?
+            lb.lb_strings_size:1;
+        hdr->lh_seq_offset = seq_offset;
+        hdr->lh_addr_offset = addr_offset;
+        hdr->lh_line_offset = line_offset;
+        hdr->lh_file_offset = file_offset;
+        hdr->lh_column_offset = column_offset;
+        hdr->lh_filetab_offset = filetab_offset;
+        hdr->lh_strings_offset = strings_offset;
+    }
+    seqs = (struct Dwarf_Line_Index_Seq_s *)(table +
+        hdr->lh_seq_offset);
+    addr = (Dwarf_Addr *)(table + hdr->lh_addr_offset);
+    line = (unsigned int *)(table + hdr->lh_line_offset);
+    file = (unsigned int *)(table + hdr->lh_file_offset);
+    column = (Dwarf_Half *)(table + hdr->lh_column_offset);
+    rows = 0;
+    for (i = 0; i < kept; ++i) {
+        struct lb_seq_s *s = lb.lb_seqs + i;
+        size_t n = (size_t)s->bs_count;
+
+        seqs[i].ls_start = s->bs_start;
+        seqs[i].ls_end = s->bs_end;
+        seqs[i].ls_max_end = s->bs_end;
+        if (i && seqs[i-1].ls_max_end > s->bs_end) {
+            seqs[i].ls_max_end = seqs[i-1].ls_max_end;
+        }
+        seqs[i].ls_first_row = rows;
+        seqs[i].ls_row_count = s->bs_count;
+        memcpy(addr+rows,lb.lb_addr+s->bs_first,
+            n*sizeof(Dwarf_Addr));
+        memcpy(line+rows,lb.lb_line+s->bs_first,
+            n*sizeof(unsigned int));
+        memcpy(file+rows,lb.lb_file+s->bs_first,
+            n*sizeof(unsigned int));
+        memcpy(column+rows,lb.lb_column+s->bs_first,
+            n*sizeof(Dwarf_Half));
+        rows += s->bs_count;
+    }
+    if (lb.lb_file_count) {
+        memcpy(table + hdr->lh_filetab_offset,lb.lb_file_stroff,
+            (size_t)lb.lb_file_count*sizeof(Dwarf_Unsigned));
+    }
+    if (lb.lb_strings_size) {
+        memcpy(table + hdr->lh_strings_offset,lb.lb_strings,
+            (size_t)lb.lb_strings_size);
+    }
+    lb_free(&lb);
+    *table_out = table;
+    *table_size_out = hdr->lh_table_size;
+    return DW_DLV_OK;
+}
+
+/*  A checked view of a table. */
+struct line_index_view_s {
+    const struct Dwarf_Line_Index_Header_s *lv_hdr;
+    const struct Dwarf_Line_Index_Seq_s *lv_seqs;
+    const Dwarf_Addr   *lv_addr;
+    const unsigned int *lv_line;
+    const unsigned int *lv_file;
+    const Dwarf_Half   *lv_column;
+    const Dwarf_Unsigned *lv_filetab;
+    const char         *lv_strings;
+};
+
+static int
+line_index_bad(Dwarf_Error *error,const char *msg)
+{
+    _dwarf_error_string(NULL,error,DW_DLE_LINE_TABLE_BAD,
+        (char *)msg);
+    return DW_DLV_ERROR;
+}
+
+/*  TRUE if count items of size at offset fit
+    in the table. */
+static Dwarf_Bool
+line_index_fits(Dwarf_Unsigned table_size,
+    Dwarf_Unsigned offset,
+    Dwarf_Unsigned count,
+    Dwarf_Unsigned size)
+{
+    if ((offset & 7) || offset > table_size) {
+        return FALSE;
+    }
+    if (count > (table_size - offset)/size) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static int
+line_index_view(const void *table,
+    Dwarf_Unsigned table_size,
+    struct line_index_view_s *v,
+    Dwarf_Error *error)
+{
+    const struct Dwarf_Line_Index_Header_s *hdr = 0;
+    const char *base = (const char *)table;
+    Dwarf_Unsigned rows = 0;
+
+    if (!table) {
+        _dwarf_error_string(NULL,error,DW_DLE_IA,
+            "DW_DLE_IA: NULL line index passed "
+            "to a dwarf_lookup_line_index function");
+        return DW_DLV_ERROR;
+    }
+    if ((uintptr_t)table & 7) {
+        return line_index_bad(error,
+            "DW_DLE_LINE_TABLE_BAD: line index is not "
+            "8 byte aligned");
+    }
+    hdr = (const struct Dwarf_Line_Index_Header_s *)table;
+    if (table_size < sizeof(*hdr) ||
+        memcmp(hdr->lh_magic,LINE_INDEX_MAGIC,
+            LINE_INDEX_MAGIC_LEN) ||
+        hdr->lh_byte_order != LINE_INDEX_BYTE_ORDER ||
+        hdr->lh_version != LINE_INDEX_VERSION ||
+        hdr->lh_table_size > table_size) {
+        return line_index_bad(error,
+            "DW_DLE_LINE_TABLE_BAD: not a line index "
+            "for this host, or truncated");
+    }
+    table_size = hdr->lh_table_size;
+    rows = hdr->lh_row_count;
+    if (!line_index_fits(table_size,hdr->lh_seq_offset,
+            hdr->lh_seq_count,
+            sizeof(struct Dwarf_Line_Index_Seq_s)) ||
+        !line_index_fits(table_size,hdr->lh_addr_offset,
+            rows,sizeof(Dwarf_Addr)) ||
+        !line_index_fits(table_size,hdr->lh_line_offset,
+            rows,sizeof(unsigned int)) ||
+        !line_index_fits(table_size,hdr->lh_file_offset,
+            rows,sizeof(unsigned int)) ||
+        !line_index_fits(table_size,hdr->lh_column_offset,
+            rows,sizeof(Dwarf_Half)) ||
+        !line_index_fits(table_size,hdr->lh_filetab_offset,
+            hdr->lh_file_count,sizeof(Dwarf_Unsigned)) ||
+        !line_index_fits(table_size,hdr->lh_strings_offset,
+            hdr->lh_strings_size,1) ||
+        !hdr->lh_strings_size ||
+        base[hdr->lh_strings_offset +
+            hdr->lh_strings_size - 1]) {
+        return line_index_bad(error,
+            "DW_DLE_LINE_TABLE_BAD: line index header "
+            "is corrupt");
+    }
+    v->lv_hdr = hdr;
+    v->lv_seqs = (const struct Dwarf_Line_Index_Seq_s *)
+        (base + hdr->lh_seq_offset);
+    v->lv_addr = (const Dwarf_Addr *)(base + hdr->lh_addr_offset);
+    v->lv_line = (const unsigned int *)
+        (base + hdr->lh_line_offset);
+    v->lv_file = (const unsigned int *)
+        (base + hdr->lh_file_offset);
+    v->lv_column = (const Dwarf_Half *)
+        (base + hdr->lh_column_offset);
+    v->lv_filetab = (const Dwarf_Unsigned *)
+        (base + hdr->lh_filetab_offset);
+    v->lv_strings = base + hdr->lh_strings_offset;
+    return DW_DLV_OK;
+}
+
+/*  Finds the row for pc: the last row at or below pc
+    in the covering sequence that starts nearest
+    below pc. */
+static int
+line_index_find(struct line_index_view_s *v,
+    Dwarf_Addr pc,
+    Dwarf_Unsigned *row_out,
+    Dwarf_Error *error)
+{
+    const struct Dwarf_Line_Index_Header_s *hdr = v->lv_hdr;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = hdr->lh_seq_count;
+    Dwarf_Unsigned s = 0;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (v->lv_seqs[mid].ls_start <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (s = lo; s > 0; --s) {
+        const struct Dwarf_Line_Index_Seq_s *seq =
+            v->lv_seqs + s - 1;
+        Dwarf_Unsigned first = seq->ls_first_row;
+        Dwarf_Unsigned fi = 0;
+
+        if (seq->ls_max_end <= pc) {
+            break;
+        }
+        if (pc >= seq->ls_end) {
+            continue;
+        }
+        if (!seq->ls_row_count ||
+            first > hdr->lh_row_count ||
+            seq->ls_row_count > hdr->lh_row_count - first) {
+            return line_index_bad(error,
+                "DW_DLE_LINE_TABLE_BAD: line index sequence "
+                "is corrupt");
+        }
+        lo = first;
+        hi = first + seq->ls_row_count;
+        while (lo < hi) {
+            Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+            if (v->lv_addr[mid] <= pc) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == first) {
+            /*  Corrupt: the first row is after the
+                sequence start. */
+            return line_index_bad(error,
+                "DW_DLE_LINE_TABLE_BAD: line index sequence "
+                "is corrupt");
+        }
+        fi = v->lv_file[lo-1];
+        if (fi >= hdr->lh_file_count ||
+            v->lv_filetab[fi] >= hdr->lh_strings_size) {
+            return line_index_bad(error,
+                "DW_DLE_LINE_TABLE_BAD: line index file "
+                "number is corrupt");
+        }
+        *row_out = lo - 1;
+        return DW_DLV_OK;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+int
+dwarf_lookup_line_index(const void *table,
+    Dwarf_Unsigned  table_size,
+    Dwarf_Addr      pc,
+    const char    **file_out,
+    Dwarf_Unsigned *line_out,
+    Dwarf_Unsigned *column_out,
+    Dwarf_Error    *error)
+{
+    struct line_index_view_s v;
+    Dwarf_Unsigned row = 0;
+    int res = 0;
+
+    res = line_index_view(table,table_size,&v,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = line_index_find(&v,pc,&row,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (file_out) {
+        *file_out = v.lv_strings + v.lv_filetab[v.lv_file[row]];
+    }
+    if (line_out) {
+        *line_out = v.lv_line[row];
+    }
+    if (column_out) {
+        *column_out = v.lv_column[row];
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_lookup_line_index_batch(const void *table,
+    Dwarf_Unsigned    table_size,
+    const Dwarf_Addr *pcs,
+    Dwarf_Unsigned    pc_count,
+    const char      **files_out,
+    Dwarf_Unsigned   *lines_out,
+    Dwarf_Unsigned   *found_count_out,
+    Dwarf_Error      *error)
+{
+    struct line_index_view_s v;
+    Dwarf_Unsigned found = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (pc_count && (!pcs || !files_out || !lines_out)) {
+        _dwarf_error_string(NULL,error,DW_DLE_IA,
+            "DW_DLE_IA: a NULL argument passed to "
+            "dwarf_lookup_line_index_batch()");
+        return DW_DLV_ERROR;
+    }
+    res = line_index_view(table,table_size,&v,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < pc_count; ++i) {
+        Dwarf_Unsigned row = 0;
+
+        res = line_index_find(&v,pcs[i],&row,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            files_out[i] = 0;
+            lines_out[i] = 0;
+            continue;
+        }
+        files_out[i] = v.lv_strings + v.lv_filetab[v.lv_file[row]];
+        lines_out[i] = v.lv_line[row];
+        ++found;
+    }
+    if (found_count_out) {
+        *found_count_out = found;
+    }
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_line_index(void *table)
+{
+    free(table);
+}
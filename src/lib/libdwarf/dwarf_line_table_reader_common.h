@@ -1398,11 +1398,13 @@ read_line_table_program(Dwarf_Debug dbg,
     /*  This is the length of an extended opcode instr.  */
     Dwarf_Unsigned instr_length = 0;
 
-    /*  Used to chain together pointers to line table entries that are
-        later used to create a block of Dwarf_Line entries. */
-    Dwarf_Chain chain_line = NULL;
-    Dwarf_Chain head_chain = NULL;
-    Dwarf_Chain curr_chain = NULL;
+    /*  The rows of the line table, one contiguous array
+        grown by _dwarf_add_line_row(). Only at the end
+        is block_line pointed into it, as growing it
+        moves the rows. */
+    struct Dwarf_Line_s *line_rows = 0;
+    Dwarf_Unsigned line_rows_cap = 0;
+    int rowres = 0;
 
     /*  This points to a block of Dwarf_Lines, a pointer to which is
         returned in linebuf. */
@@ -1472,12 +1474,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 ocres =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (ocres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        curr_line = 0;
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 
@@ -1545,12 +1542,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     dwarfstring_string(&m));
                 dwarfstring_destructor(&m);
                 regs.lr_line = 0;
-                _dwarf_free_chain_entries(dbg,head_chain,
-                    line_count);
-                if (curr_line) {
-                    dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    curr_line = 0;
-                }
+                free(line_rows);
                 return DW_DLV_ERROR;
             }
 #ifdef PRINTING_DETAILS
@@ -1573,13 +1565,11 @@ read_line_table_program(Dwarf_Debug dbg,
 #endif /* PRINTING_DETAILS */
 
             if (dolines) {
-                curr_line =
-                    (Dwarf_Line) _dwarf_get_alloc(dbg,DW_DLA_LINE,1);
-                if (curr_line == NULL) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                    return DW_DLV_ERROR;
+                rowres = _dwarf_add_line_row(dbg,&line_rows,
+                    &line_rows_cap,line_count,&curr_line,error);
+                if (rowres != DW_DLV_OK) {
+                    free(line_rows);
+                    return rowres;
                 }
 
                 /* Mark a line record as being DW_LNS_set_address */
@@ -1598,8 +1588,9 @@ read_line_table_program(Dwarf_Debug dbg,
                 curr_line->li_l_data.li_basic_block =
                     regs.lr_basic_block;
                 curr_line->li_l_data.li_end_sequence =
-                    curr_line->li_l_data.
-                    li_epilogue_begin = regs.lr_epilogue_begin;
+                    regs.lr_end_sequence;
+                curr_line->li_l_data.li_epilogue_begin =
+                    regs.lr_epilogue_begin;
                 curr_line->li_l_data.li_prologue_end =
                     regs.lr_prologue_end;
                 curr_line->li_l_data.li_isa =
@@ -1614,21 +1605,6 @@ read_line_table_program(Dwarf_Debug dbg,
                 curr_line->li_is_actuals_table = is_actuals_table;
                 line_count++;
 
-                chain_line = (Dwarf_Chain)
-                    _dwarf_get_alloc(dbg, DW_DLA_CHAIN, 1);
-                if (chain_line == NULL) {
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                    return DW_DLV_ERROR;
-                }
-                chain_line->ch_itemtype = DW_DLA_LINE;
-                chain_line->ch_item = curr_line;
-                _dwarf_update_chain_list(chain_line,&head_chain,
-                    &curr_chain);
                 curr_line = 0;
             }
 
@@ -1653,13 +1629,11 @@ read_line_table_program(Dwarf_Debug dbg,
                     is_actuals_table);
 #endif /* PRINTING_DETAILS */
                 if (dolines) {
-                    curr_line = (Dwarf_Line) _dwarf_get_alloc(dbg,
-                        DW_DLA_LINE, 1);
-                    if (curr_line == NULL) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
+                    rowres = _dwarf_add_line_row(dbg,&line_rows,
+                        &line_rows_cap,line_count,&curr_line,error);
+                    if (rowres != DW_DLV_OK) {
+                        free(line_rows);
+                        return rowres;
                     }
 
                     /* Mark a line record as DW_LNS_set_address */
@@ -1696,19 +1670,6 @@ read_line_table_program(Dwarf_Debug dbg,
                         regs.lr_subprogram;
                     line_count++;
 
-                    chain_line = (Dwarf_Chain)
-                        _dwarf_get_alloc(dbg, DW_DLA_CHAIN, 1);
-                    if (chain_line == NULL) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
-                    }
-                    chain_line->ch_itemtype = DW_DLA_LINE;
-                    chain_line->ch_item = curr_line;
-                    _dwarf_update_chain_list(chain_line,&head_chain,
-                        &curr_chain);
                     curr_line = 0;
                 }
 
@@ -1725,11 +1686,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 advres =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (advres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 
@@ -1757,11 +1714,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 alres =  read_sword_de( &line_ptr,&stmp,
                     dbg,error,line_ptr_end);
                 if (alres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 advance_line = (Dwarf_Signed) stmp;
@@ -1796,11 +1749,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         dwarfstring_string(&m));
                     dwarfstring_destructor(&m);
                     regs.lr_line = 0;
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 }
@@ -1812,21 +1761,13 @@ read_line_table_program(Dwarf_Debug dbg,
                 sfres =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (sfres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 {
                     Dwarf_Signed fno = (Dwarf_Signed)utmp2;
                     if (fno < 0) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         _dwarf_error_string(dbg,error,
                             DW_DLE_LINE_INDEX_WRONG,
                             "DW_DLE_LINE_INDEX_WRONG "
@@ -1855,21 +1796,13 @@ read_line_table_program(Dwarf_Debug dbg,
                 scres =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (scres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 {
                     Dwarf_Signed cno = (Dwarf_Signed)utmp2;
                     if (cno < 0) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         _dwarf_error_string(dbg,error,
                             DW_DLE_LINE_INDEX_WRONG,
                             "DW_DLE_LINE_INDEX_WRONG "
@@ -1951,11 +1884,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     error);
                 fixed_advance_pc = fpc;
                 if (apres == DW_DLV_ERROR) {
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return apres;
                 }
                 line_ptr += DWARF_HALF_SIZE;
@@ -1977,11 +1906,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         DW_DLE_LINE_TABLE_BAD,
                         dwarfstring_string(&g));
                     dwarfstring_destructor(&g);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 {   Dwarf_Unsigned oldad = regs.lr_address;
@@ -2039,11 +1964,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 sires =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (sires == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 
@@ -2063,11 +1984,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         not fit in our
                         local so we record it wrong.
                         declare an error. */
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,
-                        head_chain,line_count);
+                    free(line_rows);
                     _dwarf_error(dbg, error,
                         DW_DLE_LINE_NUM_OPERANDS_BAD);
                     return DW_DLV_ERROR;
@@ -2090,11 +2007,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     atres =  read_sword_de( &line_ptr,&stmp,
                         dbg,error,line_ptr_end);
                     if (atres == DW_DLV_ERROR) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     advance_line = (Dwarf_Signed) stmp;
@@ -2117,11 +2030,7 @@ read_line_table_program(Dwarf_Debug dbg,
                             dwarfstring_string(&m));
                         dwarfstring_destructor(&m);
                         regs.lr_line = 0;
-                        _dwarf_free_chain_entries(dbg,
-                            head_chain,line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
 
                     }
@@ -2173,11 +2082,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     spres =  read_uword_de( &line_ptr,&utmp2,
                         dbg,error,line_ptr_end);
                     if (spres == DW_DLV_ERROR) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     regs.lr_subprogram = utmp2;
@@ -2205,11 +2110,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 icres =  read_sword_de( &line_ptr,&stmp,
                     dbg,error,line_ptr_end);
                 if (icres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 regs.lr_call_context = line_count + stmp;
@@ -2217,11 +2118,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     dbg,error,line_ptr_end);
                 regs.lr_subprogram = ilcuw;
                 if (icres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 
@@ -2255,15 +2152,11 @@ read_line_table_program(Dwarf_Debug dbg,
                 /* Experimental two-level line tables */
             case DW_LNS_pop_context: {
                 Dwarf_Unsigned logical_num = regs.lr_call_context;
-                Dwarf_Chain logical_chain = head_chain;
                 Dwarf_Line logical_line = 0;
 
-                if (logical_num > 0 && logical_num <= line_count) {
-                    for (i = 1; i < logical_num; i++) {
-                        logical_chain = logical_chain->ch_next;
-                    }
-                    logical_line =
-                        (Dwarf_Line) logical_chain->ch_item;
+                if (logical_num > 0 && logical_num <= line_count &&
+                    line_rows) {
+                    logical_line = line_rows + (logical_num-1);
                     regs.lr_file =
                         logical_line->li_l_data.li_file;
                     regs.lr_line =
@@ -2330,11 +2223,7 @@ read_line_table_program(Dwarf_Debug dbg,
             leres =  read_uword_de( &line_ptr,&utmp3,
                 dbg,error,line_ptr_end);
             if (leres == DW_DLV_ERROR) {
-                _dwarf_free_chain_entries(dbg,head_chain,
-                    line_count);
-                if (curr_line) {
-                    dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                }
+                free(line_rows);
                 return DW_DLV_ERROR;
             }
 
@@ -2360,10 +2249,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     DW_DLE_LINE_TABLE_BAD,
                     dwarfstring_string(&g));
                 dwarfstring_destructor(&g);
-                if (curr_line) {
-                    dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                }
-                _dwarf_free_chain_entries(dbg,head_chain,line_count);
+                free(line_rows);
                 return DW_DLV_ERROR;
             }
             ext_opcode = *(Dwarf_Small *) line_ptr;
@@ -2386,10 +2272,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     DW_DLE_LINE_TABLE_BAD,
                     dwarfstring_string(&g));
                 dwarfstring_destructor(&g);
-                _dwarf_free_chain_entries(dbg,head_chain,line_count);
-                if (curr_line) {
-                    dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                }
+                free(line_rows);
                 return DW_DLV_ERROR;
             }
             switch (ext_opcode) {
@@ -2397,13 +2280,11 @@ read_line_table_program(Dwarf_Debug dbg,
             case DW_LNE_end_sequence:{
                 regs.lr_end_sequence = TRUE;
                 if (dolines) {
-                    curr_line = (Dwarf_Line)
-                        _dwarf_get_alloc(dbg, DW_DLA_LINE, 1);
-                    if (!curr_line) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
+                    rowres = _dwarf_add_line_row(dbg,&line_rows,
+                        &line_rows_cap,line_count,&curr_line,error);
+                    if (rowres != DW_DLV_OK) {
+                        free(line_rows);
+                        return rowres;
                     }
 
 #ifdef PRINTING_DETAILS
@@ -2441,19 +2322,6 @@ read_line_table_program(Dwarf_Debug dbg,
                     curr_line->li_l_data.li_subprogram =
                         regs.lr_subprogram;
                     line_count++;
-                    chain_line = (Dwarf_Chain)
-                        _dwarf_get_alloc(dbg, DW_DLA_CHAIN, 1);
-                    if (chain_line == NULL) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
-                    }
-                    chain_line->ch_itemtype = DW_DLA_LINE;
-                    chain_line->ch_item = curr_line;
-                    _dwarf_update_chain_list(chain_line,
-                        &head_chain,&curr_chain);
                     curr_line = 0;
                 }
                 _dwarf_set_line_table_regs_default_values(&regs,
@@ -2472,11 +2340,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     address_size,line_ptr_end,
                     error);
                 if (sares == DW_DLV_ERROR) {
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return sares;
                 }
 
@@ -2496,13 +2360,11 @@ read_line_table_program(Dwarf_Debug dbg,
 #endif /* PRINTING_DETAILS */
                 if (doaddrs) {
                     /* SGI IRIX rqs processing only. */
-                    curr_line = (Dwarf_Line) _dwarf_get_alloc(dbg,
-                        DW_DLA_LINE, 1);
-                    if (!curr_line) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
+                    rowres = _dwarf_add_line_row(dbg,&line_rows,
+                        &line_rows_cap,line_count,&curr_line,error);
+                    if (rowres != DW_DLV_OK) {
+                        free(line_rows);
+                        return rowres;
                     }
                     /*  Mark a line record as being
                         DW_LNS_set_address */
@@ -2516,19 +2378,6 @@ read_line_table_program(Dwarf_Debug dbg,
                         line_ptr - dbg->de_debug_line.dss_data;
 #endif /* __sgi */
                     line_count++;
-                    chain_line = (Dwarf_Chain)
-                        _dwarf_get_alloc(dbg, DW_DLA_CHAIN, 1);
-                    if (chain_line == NULL) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        return DW_DLV_ERROR;
-                    }
-                    chain_line->ch_itemtype = DW_DLA_LINE;
-                    chain_line->ch_item = curr_line;
-                    _dwarf_update_chain_list(chain_line,
-                        &head_chain,&curr_chain);
                     curr_line = 0;
                 }
                 regs.lr_op_index = 0;
@@ -2551,11 +2400,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         DW_DLE_LINE_TABLE_BAD,
                         dwarfstring_string(&g));
                     dwarfstring_destructor(&g);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 }
@@ -2570,11 +2415,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         malloc(sizeof(struct Dwarf_File_Entry_s));
                     if (cur_file_entry == NULL) {
                         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     memset(cur_file_entry,0,
@@ -2587,11 +2428,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         line_ptr,line_ptr,line_ptr_end,
                         DW_DLE_DEFINE_FILE_STRING_BAD,error);
                     if (dlres != DW_DLV_OK) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return dlres;
                     }
                     line_ptr = line_ptr + strlen((char *) line_ptr)
@@ -2599,11 +2436,7 @@ read_line_table_program(Dwarf_Debug dbg,
                     dlres =  read_uword_de( &line_ptr,&value,
                         dbg,error,line_ptr_end);
                     if (dlres == DW_DLV_ERROR) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     cur_file_entry->fi_dir_index =
@@ -2612,22 +2445,14 @@ read_line_table_program(Dwarf_Debug dbg,
                     dlres =  read_uword_de( &line_ptr,&value,
                         dbg,error,line_ptr_end);
                     if (dlres == DW_DLV_ERROR) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     cur_file_entry->fi_time_last_mod = value;
                     dlres =  read_uword_de( &line_ptr,&value,
                         dbg,error,line_ptr_end);
                     if (dlres == DW_DLV_ERROR) {
-                        _dwarf_free_chain_entries(dbg,head_chain,
-                            line_count);
-                        if (curr_line) {
-                            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                        }
+                        free(line_rows);
                         return DW_DLV_ERROR;
                     }
                     cur_file_entry->fi_file_length = value;
@@ -2677,11 +2502,7 @@ read_line_table_program(Dwarf_Debug dbg,
                 sdres =  read_uword_de( &line_ptr,&utmp2,
                     dbg,error,line_ptr_end);
                 if (sdres == DW_DLV_ERROR) {
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
                 regs.lr_discriminator = utmp2;
@@ -2741,11 +2562,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         DW_DLE_LINE_TABLE_BAD,
                         dwarfstring_string(&g));
                     dwarfstring_destructor(&g);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 
@@ -2794,12 +2611,7 @@ read_line_table_program(Dwarf_Debug dbg,
                                 dwarfstring_string(&g));
                             dwarfstring_destructor(&g);
                             dwarfstring_destructor(&m9d);
-                            if (curr_line) {
-                                dwarf_dealloc(dbg,curr_line,
-                                    DW_DLA_LINE);
-                            }
-                            _dwarf_free_chain_entries(dbg,
-                                head_chain,line_count);
+                            free(line_rows);
                             return DW_DLV_ERROR;
                         }
 #endif
@@ -2830,11 +2642,7 @@ read_line_table_program(Dwarf_Debug dbg,
                         DW_DLE_LINE_TABLE_BAD,
                         dwarfstring_string(&g));
                     dwarfstring_destructor(&g);
-                    if (curr_line) {
-                        dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-                    }
-                    _dwarf_free_chain_entries(dbg,head_chain,
-                        line_count);
+                    free(line_rows);
                     return DW_DLV_ERROR;
                 }
 #endif /* PRINTING_DETAILS */
@@ -2844,8 +2652,7 @@ read_line_table_program(Dwarf_Debug dbg,
             } /* End switch. */
         } else {
             /* ASSERT: impossible, see the macro definition */
-            _dwarf_free_chain_entries(dbg,head_chain,
-                line_count);
+            free(line_rows);
             _dwarf_error_string(dbg,error,
                 DW_DLE_LINE_TABLE_BAD,
                 "DW_DLE_LINE_TABLE_BAD: Actually is "
@@ -2856,33 +2663,23 @@ read_line_table_program(Dwarf_Debug dbg,
     block_line = (Dwarf_Line *)
         _dwarf_get_alloc(dbg, DW_DLA_LIST, line_count);
     if (block_line == NULL) {
-        curr_chain = head_chain;
-        _dwarf_free_chain_entries(dbg,head_chain,line_count);
-        if (curr_line) {
-            dwarf_dealloc(dbg,curr_line,DW_DLA_LINE);
-            curr_line = 0;
-        }
+        free(line_rows);
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
 
-    curr_chain = head_chain;
     for (i = 0; i < line_count; i++) {
-        Dwarf_Chain t = 0;
-        *(block_line + i) = curr_chain->ch_item;
-        curr_chain->ch_item = 0;
-        curr_chain->ch_itemtype = 0;
-        t = curr_chain;
-        curr_chain = curr_chain->ch_next;
-        dwarf_dealloc(dbg, t, DW_DLA_CHAIN);
+        *(block_line + i) = line_rows + i;
     }
 
     if (is_single_table || !is_actuals_table) {
         line_context->lc_linebuf_logicals = block_line;
         line_context->lc_linecount_logicals = line_count;
+        line_context->lc_linerows_logicals = line_rows;
     } else {
         line_context->lc_linebuf_actuals = block_line;
         line_context->lc_linecount_actuals = line_count;
+        line_context->lc_linerows_actuals = line_rows;
     }
 #ifdef PRINTING_DETAILS
     {
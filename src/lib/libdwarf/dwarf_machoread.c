@@ -291,6 +291,60 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
     return DW_DLV_NO_ENTRY;
 }
 
+#ifdef HAVE_FULL_MMAP
+/*  Only Dwarf_Alloc_Mmap_Whole is done with mmap,
+    where the section is a pointer into the single
+    mapping of the (possibly universal inner) object.
+    Otherwise calls macho_load_section(). */
+static int
+macho_load_section_a (void *obj, Dwarf_Unsigned section_index,
+    enum Dwarf_Sec_Alloc_Pref *alloc_type,
+    Dwarf_Small   **return_data_ptr,
+    Dwarf_Unsigned *return_data_len,
+    Dwarf_Small   **return_mmap_base_ptr,
+    Dwarf_Unsigned *return_mmap_offset,
+    Dwarf_Unsigned *return_mmap_len,
+    int            *error)
+{
+    dwarf_macho_object_access_internals_t *macho =
+        (dwarf_macho_object_access_internals_t*)(obj);
+
+    *return_mmap_base_ptr = 0;
+    *return_mmap_offset = 0;
+    *return_mmap_len = 0;
+    if (0 < section_index &&
+        section_index < macho->mo_dwarf_sectioncount) {
+        struct generic_macho_section *sp =
+            macho->mo_dwarf_sections + section_index;
+
+        if (!sp->loaded_data && sp->size) {
+            Dwarf_Small *data = 0;
+            int res = 0;
+
+            res = _dwarf_whole_object_section(
+                &macho->mo_whole_map,macho->mo_fd,
+                macho->mo_inner_offset,macho->mo_filesize,
+                sp->offset,sp->size,&data);
+            if (res == DW_DLV_OK) {
+                sp->loaded_data = data;
+            }
+        }
+        if (sp->loaded_data &&
+            _dwarf_whole_object_contains(&macho->mo_whole_map,
+            sp->loaded_data)) {
+            *return_data_ptr = sp->loaded_data;
+            *return_data_len = sp->size;
+            *alloc_type = Dwarf_Alloc_Mmap;
+            return DW_DLV_OK;
+        }
+    }
+    /* Does NOT alter *return_data_len */
+    *alloc_type = Dwarf_Alloc_Malloc;
+    return macho_load_section(obj,section_index,
+        return_data_ptr,error);
+}
+#endif /* HAVE_FULL_MMAP */
+
 static void
 _dwarf_destruct_macho_internals(
     dwarf_macho_object_access_internals_t *mp)
@@ -315,14 +369,17 @@ _dwarf_destruct_macho_internals(
 
         sp = mp->mo_dwarf_sections;
         for ( i=0; i < mp->mo_dwarf_sectioncount; ++i,++sp) {
-            if (sp->loaded_data) {
+            if (sp->loaded_data &&
+                !_dwarf_whole_object_contains(&mp->mo_whole_map,
+                sp->loaded_data)) {
                 free(sp->loaded_data);
-                sp->loaded_data = 0;
             }
+            sp->loaded_data = 0;
         }
         free(mp->mo_dwarf_sections);
         mp->mo_dwarf_sections = 0;
     }
+    _dwarf_whole_object_unmap(&mp->mo_whole_map);
     free(mp);
     return;
 }
@@ -910,8 +967,11 @@ static Dwarf_Obj_Access_Methods_a const macho_methods = {
     /*  We do not do macho relocations.
         dsym files do not require it. */
     0,
-    /*Not handling mmap yet. */
+#ifdef HAVE_FULL_MMAP
+    macho_load_section_a,
+#else
     0,
+#endif /* HAVE_FULL_MMAP */
     _dwarf_destruct_macho_access
 
 };
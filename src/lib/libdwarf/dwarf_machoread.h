@@ -131,6 +131,8 @@ typedef struct dwarf_macho_filedata_s {
     Dwarf_Unsigned   mo_machine;
     Dwarf_Unsigned   mo_flags;
     Dwarf_Unsigned   mo_inner_offset; /* for universal inner */
+    /*  Used only with Dwarf_Alloc_Mmap_Whole. */
+    struct Dwarf_Whole_Object_Map_s mo_whole_map;
     Dwarf_Small      mo_offsetsize; /* 32 or 64 section data */
     Dwarf_Small      mo_pointersize;
     int              mo_ftype;
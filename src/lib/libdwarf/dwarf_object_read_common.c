@@ -32,7 +32,10 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <config.h>
 #include <stddef.h> /* size_t */
-#include <stdio.h>  /* SEEK_END SEEK_SET */
+#ifdef HAVE_FULL_MMAP
+#include <unistd.h> /* sysconf() */
+#include <sys/mman.h> /* mmap() munmap() madvise() */
+#endif /* HAVE_FULL_MMAP */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -43,19 +46,11 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "dwarf_safe_strcpy.h"
 #include "dwarf_object_read_common.h"
 
-/*  Neither off_t nor ssize_t is in C90.
-    However, both are in Posix:
-    IEEE Std 1003.1-1990, aka
-    ISO/IEC 9954-1:1990.
-    This gets asked to read large sections sometimes.
-    The Linux kernel allows at most 0x7ffff000
-    bytes in a read()*/
-int
-_dwarf_object_read_random(int fd, char *out_buf, Dwarf_Unsigned loc,
+static int
+check_read_in_file(Dwarf_Unsigned loc,
     Dwarf_Unsigned size, Dwarf_Unsigned filesize, int *errc)
 {
     Dwarf_Unsigned endpoint = 0;
-    int res = 0;
 
     if (loc >= filesize) {
         /*  Seek can seek off the end. Lets not allow that.
@@ -75,15 +70,164 @@ _dwarf_object_read_random(int fd, char *out_buf, Dwarf_Unsigned loc,
         *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    return DW_DLV_OK;
+}
+
+/*  Neither off_t nor ssize_t is in C90.
+    However, both are in Posix:
+    IEEE Std 1003.1-1990, aka
+    ISO/IEC 9954-1:1990.
+    This gets asked to read large sections sometimes.
+    The Linux kernel allows at most 0x7ffff000
+    bytes in a read().
+    Uses pread() where available so this is one
+    system call and does not depend on or change
+    the file offset of fd. */
+int
+_dwarf_object_read_random(int fd, char *out_buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size, Dwarf_Unsigned filesize, int *errc)
+{
+    int res = 0;
+
+    res = check_read_in_file(loc,size,filesize,errc);
     if (res != DW_DLV_OK) {
-        *errc = DW_DLE_SEEK_ERROR;
-        return DW_DLV_ERROR;
+        return res;
     }
-    res = _dwarf_readr(fd,out_buf,size,0);
+    res = _dwarf_preadr(fd,out_buf,loc,size);
     if (res != DW_DLV_OK) {
         *errc = DW_DLE_READ_ERROR;
         return DW_DLV_ERROR;
     }
     return DW_DLV_OK;
 }
+
+/*  With Dwarf_Alloc_Mmap_Whole preferred, the first
+    section request maps all of the object
+    (objsize bytes at file offset objoffset,
+    objoffset being non-zero for a Mach-O
+    universal binary inner object) and every request
+    returns a pointer into that single mapping.
+
+    MAP_POPULATE is deliberately not used, it would
+    fault in the entire file.  Instead each section
+    handed out gets an madvise() hint so the kernel
+    reads ahead just the sections actually used.
+
+    Returns DW_DLV_NO_ENTRY if the mode is not
+    in effect or the mapping failed or the
+    section lies outside the object: the caller
+    then loads the section the ordinary way.
+    Never returns DW_DLV_ERROR. */
+int
+_dwarf_whole_object_section(
+    struct Dwarf_Whole_Object_Map_s *map,
+    int fd,
+    Dwarf_Unsigned objoffset,
+    Dwarf_Unsigned objsize,
+    Dwarf_Unsigned secoffset,
+    Dwarf_Unsigned secsize,
+    Dwarf_Small  **data_out)
+{
+#ifdef HAVE_FULL_MMAP
+    Dwarf_Unsigned secend = secoffset+secsize;
+
+    if (!map->wo_tried) {
+        long           pagesize = sysconf(_SC_PAGESIZE);
+        Dwarf_Unsigned pageoff = 0;
+        Dwarf_Unsigned reallen = 0;
+        void          *mmptr = 0;
+
+        map->wo_tried = TRUE;
+        if (_dwarf_determine_section_allocation_type() !=
+            Dwarf_Alloc_Mmap_Whole) {
+            return DW_DLV_NO_ENTRY;
+        }
+        if (pagesize < 200L || pagesize > (128L*1024L*1024L)) {
+            return DW_DLV_NO_ENTRY;
+        }
+        pageoff = objoffset & ~((Dwarf_Unsigned)pagesize - 1);
+        reallen = objsize + (objoffset - pageoff);
+        if (!objsize || reallen < objsize ||
+            reallen != (Dwarf_Unsigned)(size_t)reallen) {
+            return DW_DLV_NO_ENTRY;
+        }
+        /*  Private and writable as relocations
+            of .o sections are applied in place. */
+        mmptr = mmap(0,(size_t)reallen,
+            PROT_READ|PROT_WRITE, MAP_PRIVATE,
+            fd,(off_t)pageoff);
+        if (mmptr == (void *)-1) {
+            return DW_DLV_NO_ENTRY;
+        }
+        map->wo_realarea = mmptr;
+        map->wo_reallen = reallen;
+        map->wo_base = (Dwarf_Small *)mmptr + (objoffset - pageoff);
+        map->wo_size = objsize;
+    }
+    if (!map->wo_base) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (secend < secoffset || secend > map->wo_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *data_out = map->wo_base + secoffset;
+#ifdef MADV_WILLNEED
+    {
+        Dwarf_Unsigned pagemask = (Dwarf_Unsigned)
+            sysconf(_SC_PAGESIZE) - 1;
+        Dwarf_Small *start = (Dwarf_Small *)map->wo_realarea;
+        Dwarf_Unsigned relstart = (Dwarf_Unsigned)
+            (*data_out - start) & ~pagemask;
+        Dwarf_Unsigned relend = (Dwarf_Unsigned)
+            (*data_out - start) + secsize;
+
+        /*  Only a hint, so the result does not matter. */
+        (void)madvise(start + relstart,
+            (size_t)(relend - relstart), MADV_WILLNEED);
+    }
+#endif /* MADV_WILLNEED */
+    return DW_DLV_OK;
+#else /* !HAVE_FULL_MMAP */
+    (void)map;
+    (void)fd;
+    (void)objoffset;
+    (void)objsize;
+    (void)secoffset;
+    (void)secsize;
+    (void)data_out;
+    return DW_DLV_NO_ENTRY;
+#endif /* HAVE_FULL_MMAP */
+}
+
+/*  So object readers know not to free() section
+    data that points into the mapping. */
+int
+_dwarf_whole_object_contains(
+    struct Dwarf_Whole_Object_Map_s *map,
+    void *ptr)
+{
+    Dwarf_Small *p = (Dwarf_Small *)ptr;
+
+    if (!map->wo_base || !p) {
+        return FALSE;
+    }
+    if (p >= map->wo_base && p < map->wo_base + map->wo_size) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+void
+_dwarf_whole_object_unmap(
+    struct Dwarf_Whole_Object_Map_s *map)
+{
+#ifdef HAVE_FULL_MMAP
+    if (map->wo_realarea) {
+        munmap(map->wo_realarea,(size_t)map->wo_reallen);
+    }
+#endif /* HAVE_FULL_MMAP */
+    map->wo_realarea = 0;
+    map->wo_reallen = 0;
+    map->wo_base = 0;
+    map->wo_size = 0;
+}
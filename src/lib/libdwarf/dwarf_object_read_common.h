@@ -40,6 +40,36 @@ extern "C" {
 int _dwarf_object_read_random(int fd,char *buf,Dwarf_Unsigned loc,
     Dwarf_Unsigned size,Dwarf_Unsigned filesize,int *errc);
 
+/*  For Dwarf_Alloc_Mmap_Whole: one mapping of
+    an entire object from which the object readers
+    hand out uncompressed section contents directly.
+    Each reader keeps one of these, zeroed at creation. */
+struct Dwarf_Whole_Object_Map_s {
+    /*  Points to object offset zero inside the mapping. */
+    Dwarf_Small   *wo_base;
+    Dwarf_Unsigned wo_size;
+    /*  What mmap() returned, page aligned, for munmap(). */
+    void          *wo_realarea;
+    Dwarf_Unsigned wo_reallen;
+    /*  Set once the first section is requested, so
+        the mapping is attempted just once. */
+    Dwarf_Small    wo_tried;
+};
+
+int _dwarf_whole_object_section(
+    struct Dwarf_Whole_Object_Map_s *map,
+    int fd,
+    Dwarf_Unsigned objoffset,
+    Dwarf_Unsigned objsize,
+    Dwarf_Unsigned secoffset,
+    Dwarf_Unsigned secsize,
+    Dwarf_Small  **data_out);
+int _dwarf_whole_object_contains(
+    struct Dwarf_Whole_Object_Map_s *map,
+    void *ptr);
+void _dwarf_whole_object_unmap(
+    struct Dwarf_Whole_Object_Map_s *map);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -99,6 +99,8 @@ struct Dwarf_Rnglists_Context_s;
 typedef struct Dwarf_Rnglists_Context_s *Dwarf_Rnglists_Context;
 struct Dwarf_Loclists_Context_s;
 typedef struct Dwarf_Loclists_Context_s *Dwarf_Loclists_Context;
+/* Private to dwarf_alloc.c */
+struct Dwarf_Alloc_Type_s;
 
 struct Dwarf_Die_s {
     Dwarf_Byte_Ptr    di_debug_ptr;
@@ -381,10 +383,10 @@ struct Dwarf_CU_Context_s {
         Set when the CU die is accessed by dwarf_siblingof_b(). */
     Dwarf_Unsigned cc_cu_die_global_sec_offset;
 
-    Dwarf_Byte_Ptr   cc_last_abbrev_ptr;
-    Dwarf_Byte_Ptr   cc_last_abbrev_endptr;
+    /*  Shared with other contexts having the same
+        cc_abbrev_offset, owned by de_abbrev_tables.
+        Null till the first abbrev lookup. */
     Dwarf_Hash_Table cc_abbrev_hash_table;
-    Dwarf_Unsigned   cc_highest_known_code;
     Dwarf_CU_Context cc_next;
 
     Dwarf_Bool cc_is_info;    /* TRUE means context is
@@ -470,6 +472,9 @@ struct Dwarf_Section_s {
 
     /* Section compression starts with ZLIB chars*/
     Dwarf_Small dss_ZLIB_compressed;
+    /*  Non-null if dss_data is decompressed data
+        owned by the decompressed-section cache. */
+    struct Dwarf_Dcache_Entry_s *dss_dcache_entry;
 
     /*  For non-elf, leaving the following fields zero
         will mean they are ignored. */
@@ -542,6 +547,21 @@ struct Dwarf_Debug_InfoTypes_s {
     /*  Points to the last CU Context added to the list by
         dwarf_next_cu_header(). */
     Dwarf_CU_Context de_cu_context_list_end;
+    /*  The same CU Contexts as de_cu_context_list,
+        in the same ascending cc_debug_offset order,
+        so _dwarf_find_CU_Context() can do a binary search.
+        de_cu_context_index_size is the number of
+        entries allocated. */
+    Dwarf_CU_Context *de_cu_context_index;
+    Dwarf_Unsigned    de_cu_context_index_count;
+    Dwarf_Unsigned    de_cu_context_index_size;
+    /*  The CU Contexts with a signature, hashed
+        by signature so _dwarf_find_CU_Context_given_sig()
+        need not scan the list. Open addressing,
+        de_sig_hash_size is zero or a power of two. */
+    Dwarf_CU_Context *de_sig_hash;
+    Dwarf_Unsigned    de_sig_hash_count;
+    Dwarf_Unsigned    de_sig_hash_size;
 
     /*  Offset of last byte of last CU read.
         Actually one-past that last byte.  So
@@ -644,6 +664,19 @@ struct Dwarf_Group_Data_s {
     void *gd_map;
 };
 
+/*  The DIE is identified by its di_debug_ptr.
+    dac_form and dac_offset (from di_debug_ptr)
+    have an entry per attribute of dac_abbrev,
+    with room for dac_size. */
+struct Dwarf_Die_Attr_Cache_s {
+    Dwarf_Bool        dac_on;
+    Dwarf_Byte_Ptr    dac_die_ptr;
+    Dwarf_Abbrev_List dac_abbrev;
+    Dwarf_Unsigned    dac_size;
+    Dwarf_Half       *dac_form;
+    Dwarf_Unsigned   *dac_offset;
+};
+
 struct Dwarf_Debug_s {
     Dwarf_Unsigned de_magic;
     /*  All file access methods and support data
@@ -745,6 +778,24 @@ struct Dwarf_Debug_s {
         Null till a tree is created */
     void * de_alloc_tree;
 
+    /*  The Dwarf_Hash_Table abbrev tables, keyed by
+        .debug_abbrev offset. See dwarf_util.c */
+    void * de_abbrev_tables;
+
+    /*  Where each attribute value of the DIE last
+        queried by dwarf_attr() and the like starts.
+        Off unless dwarf_set_die_attr_offset_cache().
+        See dwarf_query.c */
+    struct Dwarf_Die_Attr_Cache_s de_die_attr_cache;
+
+    /*  Per DW_DLA type allocation counts and, if
+        de_alloc_arena_on, the slabs fixed-size
+        records are carved from.
+        ALLOC_AREA_INDEX_TABLE_MAX entries.
+        See dwarf_alloc.c */
+    struct Dwarf_Alloc_Type_s *de_alloc_types;
+    Dwarf_Small de_alloc_arena_on;
+
     /*  These fields are used to process debug_frame section.
         Updated
         by dwarf_get_fde_list in dwarf_frame.h */
@@ -1027,6 +1078,9 @@ int _dwarf_create_a_new_cu_context_record_on_list(
     Dwarf_Error *error);
 Dwarf_Unsigned _dwarf_calculate_next_cu_context_offset(
     Dwarf_CU_Context cu_context);
+Dwarf_CU_Context _dwarf_find_type_unit_given_sig(
+    Dwarf_Debug_InfoTypes dis,
+    Dwarf_Sig8 *sig);
 
 int _dwarf_search_for_signature(Dwarf_Debug dbg,
     Dwarf_Sig8 sig,
@@ -1174,6 +1228,15 @@ extern int _dwarf_formudata_internal(Dwarf_Debug dbg,
     Dwarf_Unsigned *return_uval,
     Dwarf_Unsigned *bytes_read,
     Dwarf_Error *error);
+int _dwarf_decode_attr_value(Dwarf_Debug dbg,
+    Dwarf_CU_Context cu_context,
+    Dwarf_Half       form,
+    Dwarf_Signed     implicit_const,
+    Dwarf_Byte_Ptr   data,
+    Dwarf_Unsigned   value_size,
+    Dwarf_Byte_Ptr   section_end,
+    Dwarf_Attr_Value *out,
+    Dwarf_Error     *error);
 
 Dwarf_Byte_Ptr _dwarf_calculate_info_section_start_ptr(
     Dwarf_CU_Context context,
@@ -1189,6 +1252,8 @@ int  _dwarf_readr(int fd, char *buf, Dwarf_Unsigned size,
     Dwarf_Unsigned *sizeread);
 int  _dwarf_seekr(int fd, Dwarf_Unsigned loc, int seektype,
     Dwarf_Unsigned *out_loc);
+int  _dwarf_preadr(int fd, char *buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size);
 int  _dwarf_openr(const char *name);
 
 /*   This does free or munmap as appropriate. */
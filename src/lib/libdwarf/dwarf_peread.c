@@ -426,6 +426,66 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
     return DW_DLV_NO_ENTRY;
 }
 
+#ifdef HAVE_FULL_MMAP
+/*  Only Dwarf_Alloc_Mmap_Whole is done with mmap,
+    where the section is a pointer into the single
+    mapping of the object.  A section whose trailing
+    zeros were not written to disk (VirtualSize >
+    SizeOfRawData) must be padded so is always
+    loaded by pe_load_section(). */
+static int
+pe_load_section_a (void *obj, Dwarf_Unsigned section_index,
+    enum Dwarf_Sec_Alloc_Pref *alloc_type,
+    Dwarf_Small   **return_data_ptr,
+    Dwarf_Unsigned *return_data_len,
+    Dwarf_Small   **return_mmap_base_ptr,
+    Dwarf_Unsigned *return_mmap_offset,
+    Dwarf_Unsigned *return_mmap_len,
+    int            *error)
+{
+    dwarf_pe_object_access_internals_t *pep =
+        (dwarf_pe_object_access_internals_t*)(obj);
+
+    *return_mmap_base_ptr = 0;
+    *return_mmap_offset = 0;
+    *return_mmap_len = 0;
+    if (0 < section_index &&
+        section_index < pep->pe_section_count) {
+        struct dwarf_pe_generic_image_section_header *sp =
+            pep->pe_sectionptr + section_index;
+
+        if (!sp->loaded_data &&
+            !sp->section_irrelevant_to_dwarf &&
+            sp->VirtualSize &&
+            sp->VirtualSize <= sp->SizeOfRawData &&
+            sp->SizeOfRawData < pep->pe_filesize) {
+            Dwarf_Small *data = 0;
+            int res = 0;
+
+            res = _dwarf_whole_object_section(
+                &pep->pe_whole_map,pep->pe_fd,
+                0,pep->pe_filesize,
+                sp->PointerToRawData,sp->VirtualSize,&data);
+            if (res == DW_DLV_OK) {
+                sp->loaded_data = data;
+            }
+        }
+        if (sp->loaded_data &&
+            _dwarf_whole_object_contains(&pep->pe_whole_map,
+            sp->loaded_data)) {
+            *return_data_ptr = sp->loaded_data;
+            *return_data_len = sp->VirtualSize;
+            *alloc_type = Dwarf_Alloc_Mmap;
+            return DW_DLV_OK;
+        }
+    }
+    /* Does NOT alter *return_data_len */
+    *alloc_type = Dwarf_Alloc_Malloc;
+    return pe_load_section(obj,section_index,
+        return_data_ptr,error);
+}
+#endif /* HAVE_FULL_MMAP */
+
 static void
 _dwarf_destruct_pe_access(void* obj)
 {
@@ -449,10 +509,12 @@ _dwarf_destruct_pe_access(void* obj)
 
         sp = pep->pe_sectionptr;
         for (i=0; i < pep->pe_section_count; ++i,++sp) {
-            if (sp->loaded_data) {
+            if (sp->loaded_data &&
+                !_dwarf_whole_object_contains(&pep->pe_whole_map,
+                sp->loaded_data)) {
                 free(sp->loaded_data);
-                sp->loaded_data = 0;
             }
+            sp->loaded_data = 0;
             free(sp->name);
             sp->name = 0;
             free(sp->dwarfsectname);
@@ -463,66 +525,38 @@ _dwarf_destruct_pe_access(void* obj)
     }
     free(pep->pe_string_table);
     pep->pe_string_table = 0;
+    _dwarf_whole_object_unmap(&pep->pe_whole_map);
     free(pep);
     free(aip);
     return;
 }
 
+/*  Fills in pep->pe_sectionptr (after its null initial
+    section) from the input_count section headers
+    in filesects, read from offset_in_input. */
 static int
-_dwarf_pe_load_dwarf_section_headers(
-    dwarf_pe_object_access_internals_t *pep,int *errcode)
+pe_decode_section_headers(
+    dwarf_pe_object_access_internals_t *pep,
+    IMAGE_SECTION_HEADER_dw *filesects,
+    Dwarf_Unsigned input_count,
+    Dwarf_Unsigned offset_in_input,
+    int *errcode)
 {
     Dwarf_Unsigned i = 0;
-    Dwarf_Unsigned input_count =
-        pep->pe_FileHeader.NumberOfSections;
-    Dwarf_Unsigned offset_in_input = pep->pe_section_table_offset;
     Dwarf_Unsigned section_hdr_size = sizeof(IMAGE_SECTION_HEADER_dw);
-    struct dwarf_pe_generic_image_section_header *sec_outp = 0;
+    struct dwarf_pe_generic_image_section_header *sec_outp =
+        pep->pe_sectionptr+1;
     Dwarf_Unsigned cur_offset = offset_in_input;
-    Dwarf_Unsigned past_end_hdrs = offset_in_input +
-        section_hdr_size*input_count;
-
-    /* internal sections include null initial section */
-    pep->pe_section_count = input_count+1;
 
-    if (past_end_hdrs > pep->pe_filesize) {
-        *errcode = DW_DLE_FILE_TOO_SMALL;
-        return DW_DLV_ERROR;
-    }
-
-    if (!offset_in_input) {
-        *errcode = DW_DLE_PE_OFFSET_BAD;
-        return DW_DLV_ERROR;
-    }
-    pep->pe_sectionptr =
-        (struct dwarf_pe_generic_image_section_header * )
-        calloc((size_t)pep->pe_section_count,
-        sizeof(struct dwarf_pe_generic_image_section_header));
-    if (!pep->pe_sectionptr) {
-        *errcode = DW_DLE_ALLOC_FAIL;
-        return DW_DLV_ERROR;
-    }
-    sec_outp = pep->pe_sectionptr;
-    sec_outp->name = strdup("");
-    sec_outp->dwarfsectname = strdup("");
-    sec_outp++;
     for ( ;  i < input_count;
         ++i, cur_offset += section_hdr_size, sec_outp++) {
 
         int res = 0;
-        IMAGE_SECTION_HEADER_dw filesect;
+        IMAGE_SECTION_HEADER_dw filesect = filesects[i];
         char        safe_name[IMAGE_SIZEOF_SHORT_NAME +1];
         const char *expname = 0;
         int irrelevant = 0;
 
-        res =  _dwarf_object_read_random(pep->pe_fd,
-            (char *)&filesect,cur_offset,
-            sizeof(filesect),
-            pep->pe_filesize,
-            errcode);
-        if (res != DW_DLV_OK) {
-            return res;
-        }
         /*  The following is safe. filesect.Name is
             IMAGE_SIZEOF_SHORT_NAME bytes long and may
             not (not sure) have a NUL terminator. */
@@ -613,6 +647,69 @@ _dwarf_pe_load_dwarf_section_headers(
     return DW_DLV_OK;
 }
 
+static int
+_dwarf_pe_load_dwarf_section_headers(
+    dwarf_pe_object_access_internals_t *pep,int *errcode)
+{
+    Dwarf_Unsigned input_count =
+        pep->pe_FileHeader.NumberOfSections;
+    Dwarf_Unsigned offset_in_input = pep->pe_section_table_offset;
+    Dwarf_Unsigned section_hdr_size = sizeof(IMAGE_SECTION_HEADER_dw);
+    struct dwarf_pe_generic_image_section_header *sec_outp = 0;
+    Dwarf_Unsigned past_end_hdrs = offset_in_input +
+        section_hdr_size*input_count;
+    IMAGE_SECTION_HEADER_dw *filesects = 0;
+    int res = 0;
+
+    /* internal sections include null initial section */
+    pep->pe_section_count = input_count+1;
+
+    if (past_end_hdrs > pep->pe_filesize) {
+        *errcode = DW_DLE_FILE_TOO_SMALL;
+        return DW_DLV_ERROR;
+    }
+
+    if (!offset_in_input) {
+        *errcode = DW_DLE_PE_OFFSET_BAD;
+        return DW_DLV_ERROR;
+    }
+    pep->pe_sectionptr =
+        (struct dwarf_pe_generic_image_section_header * )
+        calloc((size_t)pep->pe_section_count,
+        sizeof(struct dwarf_pe_generic_image_section_header));
+    if (!pep->pe_sectionptr) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    sec_outp = pep->pe_sectionptr;
+    sec_outp->name = strdup("");
+    sec_outp->dwarfsectname = strdup("");
+    if (!input_count) {
+        return DW_DLV_OK;
+    }
+    /*  The section headers are adjacent in the file
+        (and checked above to be inside it), so read
+        them all with one read rather than one read
+        per header. */
+    filesects = (IMAGE_SECTION_HEADER_dw *)
+        malloc((size_t)(section_hdr_size*input_count));
+    if (!filesects) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_object_read_random(pep->pe_fd,
+        (char *)filesects,offset_in_input,
+        section_hdr_size*input_count,
+        pep->pe_filesize,
+        errcode);
+    if (res == DW_DLV_OK) {
+        res = pe_decode_section_headers(pep,filesects,
+            input_count,offset_in_input,errcode);
+    }
+    free(filesects);
+    return res;
+}
+
 static int
 _dwarf_load_pe_sections(
     dwarf_pe_object_access_internals_t *pep,int *errcode)
@@ -877,7 +974,11 @@ static Dwarf_Obj_Access_Methods_a pe_methods = {
     pe_get_section_count,
     pe_load_section,
     0 /* ignore pe relocations. */,
+#ifdef HAVE_FULL_MMAP
+    pe_load_section_a /* mmap only for Dwarf_Alloc_Mmap_Whole */,
+#else
     0 /* Not allowing use of mmap */,
+#endif /* HAVE_FULL_MMAP */
     _dwarf_destruct_pe_access
 };
 
@@ -124,6 +124,8 @@ typedef struct pe_filedata_s {
     int              pe_destruct_close_fd; /*aka: lib owns fd */
     int              pe_is_64bit;
     Dwarf_Unsigned   pe_filesize;
+    /*  Used only with Dwarf_Alloc_Mmap_Whole. */
+    struct Dwarf_Whole_Object_Map_s pe_whole_map;
     Dwarf_Unsigned   pe_flags;
     Dwarf_Unsigned   pe_machine;
     Dwarf_Small      pe_offsetsize; /* 32 or 64 section data */
@@ -33,6 +33,7 @@
 
 #include <stddef.h> /* NULL size_t */
 #include <stdio.h> /* debugging printf */
+#include <stdlib.h> /* malloc() free() */
 
 #if defined(_WIN32) && defined(HAVE_STDAFX_H)
 #include "stdafx.h"
@@ -634,38 +635,217 @@ build_alloc_qu_error(Dwarf_Debug dbg,
     dwarfstring_destructor(&m);
 }
 
-/*
-    This function takes a die, and an attr, and returns
-    a pointer to the start of the value of that attr in
-    the given die in the .debug_info section.  The form
-    is returned in *attr_form.
+/*  The general search through the attribute values
+    of a DIE, sizing each in turn from info_ptr
+    (just past the abbrev code).
+    Finds the first attribute attrnum_in or, with
+    a non-NULL cache, records the FORM and value
+    offset of every attribute there and
+    ignores attrnum_in. */
+static int
+walk_die_attrs(Dwarf_Die die,
+    Dwarf_Abbrev_List abbrev_list,
+    Dwarf_Byte_Ptr  info_ptr,
+    Dwarf_Byte_Ptr  die_info_end,
+    Dwarf_Half      attrnum_in,
+    struct Dwarf_Die_Attr_Cache_s *cache,
+    Dwarf_Half     *attr_form,
+    Dwarf_Byte_Ptr *ptr_to_value,
+    Dwarf_Signed   *implicit_const_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Debug    dbg = die->di_cu_context->cc_dbg;
+    Dwarf_Unsigned i = 0;
 
-    If the attr_form is DW_FORM_implicit_const
-    (known signed, so most callers)
-    that is fine, but in that case we do not
-    need to actually set the *ptr_to_value.
+    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+        Dwarf_Unsigned curr_attr_form = 0;
+        Dwarf_Unsigned curr_attr = 0;
+        Dwarf_Unsigned value_size=0;
+        Dwarf_Signed implicit_const = 0;
+        int res = 0;
 
-    Returns NULL on error, or if attr is not found.
-    However, *attr_form is 0 on error, and positive
-    otherwise.
-*/
+        curr_attr = abbrev_list->abl_attr[i];
+        curr_attr_form = abbrev_list->abl_form[i];
+        if (curr_attr_form == DW_FORM_indirect) {
+            Dwarf_Unsigned utmp6;
+
+            /* DECODE_LEB128_UWORD updates info_ptr */
+            DECODE_LEB128_UWORD_CK(info_ptr, utmp6,dbg,
+                error,die_info_end);
+            curr_attr_form = (Dwarf_Half) utmp6;
+        }
+        if (curr_attr_form == DW_FORM_indirect) {
+            _dwarf_error_string(dbg,error,DW_DLE_ATTR_FORM_BAD,
+                "DW_DLE_ATTR_FORM_BAD: "
+                "A DW_FORM_indirect in an abbreviation "
+                " indirects to another "
+                "DW_FORM_indirect, which is inappropriate.");
+            return DW_DLV_ERROR;
+        }
+        if (curr_attr_form == DW_FORM_implicit_const) {
+            if (!abbrev_list->abl_implicit_const) {
+                _dwarf_error_string(dbg,error,DW_DLE_ATTR_FORM_BAD,
+                    "DW_DLE_ATTR_FORM_BAD: "
+                    "A DW_FORM_implicit_const in an abbreviation "
+                    "has no implicit const value. Corrupt dwarf.");
+                return DW_DLV_ERROR;
+            }
+            implicit_const = abbrev_list->abl_implicit_const[i];
+        }
+        if (cache) {
+            cache->dac_form[i] = (Dwarf_Half)curr_attr_form;
+            cache->dac_offset[i] = (Dwarf_Unsigned)
+                (info_ptr - die->di_debug_ptr);
+        } else if (curr_attr == attrnum_in) {
+            *attr_form = (Dwarf_Half)curr_attr_form;
+            if (implicit_const_out) {
+                *implicit_const_out = implicit_const;
+            }
+            *ptr_to_value = info_ptr;
+            return DW_DLV_OK;
+        }
+        res = _dwarf_get_size_of_val(dbg,
+            curr_attr_form,
+            die->di_cu_context->cc_version_stamp,
+            die->di_cu_context->cc_address_size,
+            info_ptr,
+            die->di_cu_context->cc_length_size,
+            &value_size,
+            die_info_end,
+            error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        {
+            Dwarf_Unsigned len  = 0;
+
+            /*  ptrdiff_t is generated but not named */
+            len = (die_info_end >= info_ptr)?
+                (die_info_end - info_ptr):0;
+            if (value_size > len) {
+                /*  Something badly wrong. We point past end
+                    of debug_info or debug_types or a
+                    section is unreasonably sized or we are
+                    pointing to two different sections? */
+                _dwarf_error_string(dbg,error,
+                    DW_DLE_DIE_ABBREV_BAD,
+                    "DW_DLE_DIE_ABBREV_BAD: in calculating the "
+                    "size of a value based on abbreviation data "
+                    "we find there is not enough room in "
+                    "the .debug_info "
+                    "section to contain the attribute value.");
+                return DW_DLV_ERROR;
+            }
+        }
+        info_ptr+= value_size;
+    }
+    if (cache) {
+        return DW_DLV_OK;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+
+/*  Opt-in, see dwarf_set_die_attr_offset_cache().
+    The first query of a DIE walks all its attributes
+    once and records where each value is. Later
+    queries of the same DIE just look up the offset.
+    If the walk fails *cached_out is set FALSE
+    and the caller searches as usual, so any
+    error is reported just as without the cache. */
 static int
-_dwarf_get_value_ptr(Dwarf_Die die,
+die_attr_cache_value_ptr(Dwarf_Die die,
+    Dwarf_Abbrev_List abbrev_list,
+    Dwarf_Byte_Ptr  info_ptr,
+    Dwarf_Byte_Ptr  die_info_end,
     Dwarf_Half      attrnum_in,
     Dwarf_Half     *attr_form,
     Dwarf_Byte_Ptr *ptr_to_value,
     Dwarf_Signed   *implicit_const_out,
+    Dwarf_Bool     *cached_out,
     Dwarf_Error    *error)
+{
+    Dwarf_Debug    dbg = die->di_cu_context->cc_dbg;
+    struct Dwarf_Die_Attr_Cache_s *cache = &dbg->de_die_attr_cache;
+    Dwarf_Unsigned count = abbrev_list->abl_abbrev_count;
+    Dwarf_Unsigned i = 0;
+
+    *cached_out = TRUE;
+    if (cache->dac_die_ptr != die->di_debug_ptr ||
+        cache->dac_abbrev != abbrev_list) {
+        Dwarf_Error lerr = 0;
+        int res = 0;
+
+        cache->dac_die_ptr = 0;
+        cache->dac_abbrev = 0;
+        if (count > cache->dac_size) {
+            Dwarf_Half *newform = 0;
+            Dwarf_Unsigned *newoffset = 0;
+
+            newform = (Dwarf_Half *)malloc(
+                count*sizeof(Dwarf_Half));
+            newoffset = (Dwarf_Unsigned *)malloc(
+                count*sizeof(Dwarf_Unsigned));
+            if (!newform || !newoffset) {
+                free(newform);
+                free(newoffset);
+                build_alloc_qu_error(dbg,"the DIE attribute"
+                    " offset cache", error);
+                return DW_DLV_ERROR;
+            }
+            free(cache->dac_form);
+            free(cache->dac_offset);
+            cache->dac_form = newform;
+            cache->dac_offset = newoffset;
+            cache->dac_size = count;
+        }
+        res = walk_die_attrs(die,abbrev_list,info_ptr,
+            die_info_end,0,cache,0,0,0,&lerr);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,lerr);
+            }
+            *cached_out = FALSE;
+            return DW_DLV_NO_ENTRY;
+        }
+        cache->dac_die_ptr = die->di_debug_ptr;
+        cache->dac_abbrev = abbrev_list;
+    }
+    for (i = 0; i < count; ++i) {
+        if (abbrev_list->abl_attr[i] == attrnum_in) {
+            *attr_form = cache->dac_form[i];
+            if (implicit_const_out) {
+                *implicit_const_out =
+                    (*attr_form == DW_FORM_implicit_const)?
+                    abbrev_list->abl_implicit_const[i]:0;
+            }
+            *ptr_to_value = die->di_debug_ptr +
+                cache->dac_offset[i];
+            return DW_DLV_OK;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Finds the abbreviation of a DIE, with its attribute
+    and FORM arrays filled in, and sets *info_ptr_out
+    to the first attribute value (just past the
+    abbrev code). */
+static int
+die_attr_setup(Dwarf_Die die,
+    Dwarf_Abbrev_List *abbrev_list_out,
+    Dwarf_Byte_Ptr    *info_ptr_out,
+    Dwarf_Byte_Ptr    *die_info_end_out,
+    Dwarf_Error       *error)
 {
     Dwarf_Byte_Ptr abbrev_ptr = 0;
     Dwarf_Byte_Ptr abbrev_end = 0;
-    Dwarf_Abbrev_List abbrev_list;
+    Dwarf_Abbrev_List abbrev_list = 0;
     Dwarf_Byte_Ptr info_ptr = 0;
     Dwarf_CU_Context context = die->di_cu_context;
     Dwarf_Byte_Ptr die_info_end = 0;
     Dwarf_Debug    dbg = 0;
     int            lres = 0;
-    Dwarf_Unsigned i = 0;
     Dwarf_Unsigned highest_code = 0;
 
     if (!context) {
@@ -741,93 +921,102 @@ _dwarf_get_value_ptr(Dwarf_Die die,
     }
     if (!abbrev_list->abl_form) {
         build_alloc_qu_error(dbg,"abbrev_list->abl_form"
-            " in _dwarf_get_value_ptr()", error);
+            " in die_attr_setup()", error);
         return DW_DLV_ERROR;
     }
     if (!abbrev_list->abl_attr) {
         build_alloc_qu_error(dbg,"abbrev_list->abl_attr"
-            " in _dwarf_get_value_ptr()", error);
+            " in die_attr_setup()", error);
         return DW_DLV_ERROR;
     }
-    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
-        Dwarf_Unsigned curr_attr_form = 0;
-        Dwarf_Unsigned curr_attr = 0;
-        Dwarf_Unsigned value_size=0;
-        Dwarf_Signed implicit_const = 0;
-        int res = 0;
+    *abbrev_list_out = abbrev_list;
+    *info_ptr_out = info_ptr;
+    *die_info_end_out = die_info_end;
+    return DW_DLV_OK;
+}
 
-        curr_attr = abbrev_list->abl_attr[i];
-        curr_attr_form = abbrev_list->abl_form[i];
-        if (curr_attr_form == DW_FORM_indirect) {
-            Dwarf_Unsigned utmp6;
+/*
+    This function takes a die, and an attr, and returns
+    a pointer to the start of the value of that attr in
+    the given die in the .debug_info section.  The form
+    is returned in *attr_form.
 
-            /* DECODE_LEB128_UWORD updates info_ptr */
-            DECODE_LEB128_UWORD_CK(info_ptr, utmp6,dbg,
-                error,die_info_end);
-            curr_attr_form = (Dwarf_Half) utmp6;
-        }
-        if (curr_attr_form == DW_FORM_indirect) {
-            _dwarf_error_string(dbg,error,DW_DLE_ATTR_FORM_BAD,
-                "DW_DLE_ATTR_FORM_BAD: "
-                "A DW_FORM_indirect in an abbreviation "
-                " indirects to another "
-                "DW_FORM_indirect, which is inappropriate.");
-            return DW_DLV_ERROR;
-        }
-        if (curr_attr_form == DW_FORM_implicit_const) {
-            if (!abbrev_list->abl_implicit_const) {
-                _dwarf_error_string(dbg,error,DW_DLE_ATTR_FORM_BAD,
-                    "DW_DLE_ATTR_FORM_BAD: "
-                    "A DW_FORM_implicit_const in an abbreviation "
-                    "has no implicit const value. Corrupt dwarf.");
-                return DW_DLV_ERROR;
-            }
-            implicit_const = abbrev_list->abl_implicit_const[i];
+    If the attr_form is DW_FORM_implicit_const
+    (known signed, so most callers)
+    that is fine, but in that case we do not
+    need to actually set the *ptr_to_value.
+
+    Returns NULL on error, or if attr is not found.
+    However, *attr_form is 0 on error, and positive
+    otherwise.
+*/
+static int
+_dwarf_get_value_ptr(Dwarf_Die die,
+    Dwarf_Half      attrnum_in,
+    Dwarf_Half     *attr_form,
+    Dwarf_Byte_Ptr *ptr_to_value,
+    Dwarf_Signed   *implicit_const_out,
+    Dwarf_Error    *error)
+{
+    Dwarf_Abbrev_List abbrev_list = 0;
+    Dwarf_Byte_Ptr info_ptr = 0;
+    Dwarf_CU_Context context = die->di_cu_context;
+    Dwarf_Byte_Ptr die_info_end = 0;
+    Dwarf_Debug    dbg = 0;
+    int            lres = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Byte_Ptr value_ptr = 0;
+
+    lres = die_attr_setup(die,&abbrev_list,&info_ptr,
+        &die_info_end,error);
+    if (lres != DW_DLV_OK) {
+        return lres;
+    }
+    dbg = context->cc_dbg;
+    if (dbg->de_die_attr_cache.dac_on) {
+        Dwarf_Bool cached = FALSE;
+
+        lres = die_attr_cache_value_ptr(die,abbrev_list,
+            info_ptr,die_info_end,attrnum_in,attr_form,
+            ptr_to_value,implicit_const_out,&cached,error);
+        if (cached || lres == DW_DLV_ERROR) {
+            return lres;
         }
-        if (curr_attr == attrnum_in) {
-            *attr_form = (Dwarf_Half)curr_attr_form;
-            if (implicit_const_out) {
-                *implicit_const_out = implicit_const;
+        /* Fall through to report what is wrong. */
+    } else {
+        for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+            if (abbrev_list->abl_attr[i] == attrnum_in) {
+                break;
             }
-            *ptr_to_value = info_ptr;
-            return DW_DLV_OK;
         }
-        res = _dwarf_get_size_of_val(dbg,
-            curr_attr_form,
-            die->di_cu_context->cc_version_stamp,
-            die->di_cu_context->cc_address_size,
-            info_ptr,
-            die->di_cu_context->cc_length_size,
-            &value_size,
-            die_info_end,
-            error);
-        if (res != DW_DLV_OK) {
-            return res;
+        if (i >= abbrev_list->abl_abbrev_count) {
+            return DW_DLV_NO_ENTRY;
         }
-        {
-            Dwarf_Unsigned len  = 0;
-
-            /*  ptrdiff_t is generated but not named */
-            len = (die_info_end >= info_ptr)?
-                (die_info_end - info_ptr):0;
-            if (value_size > len) {
-                /*  Something badly wrong. We point past end
-                    of debug_info or debug_types or a
-                    section is unreasonably sized or we are
-                    pointing to two different sections? */
-                _dwarf_error_string(dbg,error,
-                    DW_DLE_DIE_ABBREV_BAD,
-                    "DW_DLE_DIE_ABBREV_BAD: in calculating the "
-                    "size of a value based on abbreviation data "
-                    "we find there is not enough room in "
-                    "the .debug_info "
-                    "section to contain the attribute value.");
-                return DW_DLV_ERROR;
+        if (abbrev_list->abl_form[i] != DW_FORM_implicit_const ||
+            abbrev_list->abl_implicit_const) {
+            lres = _dwarf_abbrev_attr_value_ptr(context,
+                abbrev_list,i,info_ptr,die_info_end,
+                &value_ptr,error);
+            if (lres == DW_DLV_ERROR) {
+                return lres;
+            }
+            if (lres == DW_DLV_OK) {
+                *attr_form = abbrev_list->abl_form[i];
+                if (implicit_const_out) {
+                    *implicit_const_out =
+                        (*attr_form == DW_FORM_implicit_const)?
+                        abbrev_list->abl_implicit_const[i]:0;
+                }
+                *ptr_to_value = value_ptr;
+                return DW_DLV_OK;
             }
         }
-        info_ptr+= value_size;
+        /*  DW_FORM_indirect or something wrong.
+            Search as usual. */
     }
-    return DW_DLV_NO_ENTRY;
+    return walk_die_attrs(die,abbrev_list,info_ptr,die_info_end,
+        attrnum_in,0,attr_form,ptr_to_value,implicit_const_out,
+        error);
 }
 
 int
@@ -892,6 +1081,21 @@ dwarf_hasattr(Dwarf_Die die,
     return DW_DLV_OK;
 }
 
+int
+dwarf_set_die_attr_offset_cache(Dwarf_Debug dbg, int v)
+{
+    int orig = 0;
+
+    if (IS_INVALID_DBG(dbg)) {
+        return 0;
+    }
+    orig = dbg->de_die_attr_cache.dac_on;
+    dbg->de_die_attr_cache.dac_on = v?TRUE:FALSE;
+    dbg->de_die_attr_cache.dac_die_ptr = 0;
+    dbg->de_die_attr_cache.dac_abbrev = 0;
+    return orig;
+}
+
 int
 dwarf_attr(Dwarf_Die die,
     Dwarf_Half attr,
@@ -970,6 +1174,144 @@ dwarf_attr(Dwarf_Die die,
     return DW_DLV_OK;
 }
 
+/*  Steps through the attribute values of the DIE
+    once, as walk_die_attrs() does, decoding each one
+    wanted straight into the caller's array. */
+int
+dwarf_get_die_attr_values(Dwarf_Die die,
+    const Dwarf_Half *attrnums,
+    Dwarf_Unsigned    attrnum_count,
+    Dwarf_Attr_Value *values,
+    Dwarf_Unsigned    values_count,
+    Dwarf_Unsigned   *returned_count,
+    Dwarf_Error      *error)
+{
+    Dwarf_Abbrev_List abbrev_list = 0;
+    Dwarf_Byte_Ptr   info_ptr = 0;
+    Dwarf_Byte_Ptr   die_info_end = 0;
+    Dwarf_CU_Context context = 0;
+    Dwarf_Debug      dbg = 0;
+    Dwarf_Unsigned   found = 0;
+    Dwarf_Unsigned   i = 0;
+    Dwarf_Unsigned   j = 0;
+    int              res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    context = die->di_cu_context;
+    dbg = context->cc_dbg;
+    if (!values || !returned_count ||
+        (attrnums && attrnum_count > values_count)) {
+        _dwarf_error_string(dbg,error,DW_DLE_IA,
+            "DW_DLE_IA: dwarf_get_die_attr_values() "
+            "needs a result array at least as large "
+            "as the list of attributes requested");
+        return DW_DLV_ERROR;
+    }
+    if (attrnums) {
+        for (j = 0; j < attrnum_count; ++j) {
+            values[j].av_attrnum = attrnums[j];
+            values[j].av_form = 0;
+        }
+    }
+    res = die_attr_setup(die,&abbrev_list,&info_ptr,
+        &die_info_end,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < abbrev_list->abl_abbrev_count; ++i) {
+        Dwarf_Half       attr = 0;
+        Dwarf_Unsigned   form = 0;
+        Dwarf_Signed     implicit_const = 0;
+        Dwarf_Unsigned   value_size = 0;
+        Dwarf_Attr_Value *out = 0;
+
+        attr = (Dwarf_Half)abbrev_list->abl_attr[i];
+        form = abbrev_list->abl_form[i];
+        if (form == DW_FORM_indirect) {
+            DECODE_LEB128_UWORD_CK(info_ptr,form,
+                dbg,error,die_info_end);
+            if (form == DW_FORM_indirect ||
+                form == DW_FORM_implicit_const) {
+                _dwarf_error_string(dbg,error,
+                    DW_DLE_ATTR_FORM_BAD,
+                    "DW_DLE_ATTR_FORM_BAD: "
+                    "A DW_FORM_indirect in an abbreviation "
+                    "indirects to a form it cannot "
+                    "refer to. Corrupt Dwarf.");
+                return DW_DLV_ERROR;
+            }
+        }
+        if (form == DW_FORM_implicit_const) {
+            if (!abbrev_list->abl_implicit_const) {
+                _dwarf_error_string(dbg,error,
+                    DW_DLE_ATTR_FORM_BAD,
+                    "DW_DLE_ATTR_FORM_BAD: "
+                    "A DW_FORM_implicit_const in an "
+                    "abbreviation "
+                    "has no implicit const value. "
+                    "Corrupt dwarf.");
+                return DW_DLV_ERROR;
+            }
+            implicit_const = abbrev_list->abl_implicit_const[i];
+        }
+        if (!attr) {
+            /* Not a real attribute, as in dwarf_attrlist(). */
+        } else if (!attrnums) {
+            if (found < values_count) {
+                out = &values[found];
+            }
+            ++found;
+        } else {
+            for (j = 0; j < attrnum_count; ++j) {
+                if (attrnums[j] == attr && !values[j].av_form) {
+                    out = &values[j];
+                    ++found;
+                    break;
+                }
+            }
+        }
+        res = _dwarf_get_size_of_val(dbg,form,
+            context->cc_version_stamp,
+            context->cc_address_size,
+            info_ptr,
+            context->cc_length_size,
+            &value_size,
+            die_info_end,
+            error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (value_size > (Dwarf_Unsigned)(die_info_end - info_ptr)) {
+            _dwarf_error_string(dbg,error,
+                DW_DLE_DIE_ABBREV_BAD,
+                "DW_DLE_DIE_ABBREV_BAD: in calculating the "
+                "size of a value based on abbreviation data "
+                "we find there is not enough room in "
+                "the .debug_info "
+                "section to contain the attribute value.");
+            return DW_DLV_ERROR;
+        }
+        if (out) {
+            out->av_attrnum = attr;
+            res = _dwarf_decode_attr_value(dbg,context,
+                (Dwarf_Half)form,implicit_const,
+                info_ptr,value_size,die_info_end,out,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (attrnums && found == attrnum_count) {
+                break;
+            }
+        }
+        info_ptr += value_size;
+    }
+    *returned_count = found;
+    if (!found) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
 /*  A DWP (.dwp) package object never contains .debug_addr,
     only a normal .o or executable object.
     Error returned here is on dbg, not tieddbg.
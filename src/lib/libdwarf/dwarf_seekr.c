@@ -58,7 +58,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif /* _WIN64 */
 
 #ifdef HAVE_UNISTD_H
-#include <unistd.h> /* lseek() off_t */
+#include <unistd.h> /* lseek() off_t pread() */
 #endif /* HAVE_UNISTD_H */
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>  /*  off_t */
@@ -171,6 +171,50 @@ _dwarf_seekr(int fd,
     return DW_DLV_OK;
 }
 
+/*  Read size bytes at file offset loc
+    without using or changing the file offset
+    of fd, so several readers may share one fd.
+    Where pread() is missing this is just
+    _dwarf_seekr() followed by _dwarf_readr(). */
+int
+_dwarf_preadr(int fd,
+    char *buf,
+    Dwarf_Unsigned loc,
+    Dwarf_Unsigned size)
+{
+#ifdef HAVE_PREAD
+    Dwarf_Signed rcode = 0;
+    Dwarf_Unsigned max_single_read = 0x1ffff000;
+    Dwarf_Unsigned remaining_bytes = size;
+
+    if ((Dwarf_Signed)loc < 0) {
+        return DW_DLV_ERROR;
+    }
+    while(remaining_bytes > 0) {
+        size = remaining_bytes;
+        if (size > max_single_read) {
+            size = max_single_read;
+        }
+        rcode = (Dwarf_Signed)pread(fd,buf,(size_t)size,(off_t)loc);
+        if (rcode < 0 || rcode != (Dwarf_Signed)size) {
+            return DW_DLV_ERROR;
+        }
+        remaining_bytes -= size;
+        buf += size;
+        loc += size;
+    }
+    return DW_DLV_OK;
+#else /* !HAVE_PREAD */
+    int res = 0;
+
+    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_readr(fd,buf,size,0);
+#endif /* HAVE_PREAD */
+}
+
 void
 _dwarf_closer( int fd)
 {
@@ -40,6 +40,10 @@
 #include "stdafx.h"
 #endif /* HAVE_STDAFX_H */
 
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t, for DW_TSHASHTYPE */
+#endif /* HAVE_STDINT_H */
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dwarf_local_malloc.h"
@@ -53,6 +57,7 @@
 #include "dwarf_memcpy_swap.h"
 #include "dwarf_die_deliv.h"
 #include "dwarf_string.h"
+#include "dwarf_tsearch.h"
 
 #define MINBUFLEN 1000
 
@@ -764,6 +769,10 @@ _dwarf_get_size_of_val(Dwarf_Debug dbg,
 #define HT_DEFAULT_TABLE_SIZE 128
 #define HT_MULTIPLE 2
 #define HT_MOD_OP &
+/*  A code is put in the dense index only while
+    codes stay below about twice the number of abbrevs
+    seen plus this. */
+#define HT_DENSE_SLACK 64
 
 /*  Copy the old entries, updating each to be in
     a new list.  Don't delete anything. Leave the
@@ -801,6 +810,148 @@ copy_abbrev_table_to_new_table(Dwarf_Hash_Table htin,
     }
 }
 
+/*  Record entry in the dense index if its code
+    is small enough, growing the index as needed.
+    Failing to grow is not an error: the entry
+    is on a hash chain regardless. */
+static void
+add_to_dense_index(Dwarf_Hash_Table ht,
+    Dwarf_Abbrev_List entry)
+{
+    Dwarf_Unsigned code = entry->abl_code;
+
+    if (code >= ht->tb_dense_count) {
+        Dwarf_Unsigned newcount = ht->tb_dense_count;
+        Dwarf_Abbrev_List *newdense = 0;
+
+        if (code > HT_DENSE_SLACK +
+            ht->tb_total_abbrev_count*HT_MULTIPLE) {
+            /* Sparse codes, leave to the hash. */
+            return;
+        }
+        if (!newcount) {
+            newcount = HT_DEFAULT_TABLE_SIZE;
+        }
+        while (newcount <= code) {
+            newcount *= HT_MULTIPLE;
+        }
+        newdense = (Dwarf_Abbrev_List *)realloc(
+            ht->tb_dense_entries,
+            newcount*sizeof(Dwarf_Abbrev_List));
+        if (!newdense) {
+            return;
+        }
+        memset(newdense + ht->tb_dense_count,0,
+            (newcount - ht->tb_dense_count)*
+            sizeof(Dwarf_Abbrev_List));
+        ht->tb_dense_entries = newdense;
+        ht->tb_dense_count = (unsigned long)newcount;
+    }
+    /*  As with the hash chains the most recent
+        of duplicated codes wins. */
+    ht->tb_dense_entries[code] = entry;
+}
+
+static DW_TSHASHTYPE
+abbrev_table_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Hash_Table_s *enp = keyp;
+
+    return (DW_TSHASHTYPE)enp->tb_abbrev_offset;
+}
+
+static int
+abbrev_table_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Hash_Table_s *lp = l;
+    const struct Dwarf_Hash_Table_s *rp = r;
+
+    if (lp->tb_abbrev_offset < rp->tb_abbrev_offset) {
+        return -1;
+    }
+    if (lp->tb_abbrev_offset > rp->tb_abbrev_offset) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+abbrev_table_free_node(void *nodep)
+{
+    Dwarf_Hash_Table ht = (Dwarf_Hash_Table)nodep;
+
+    _dwarf_free_abbrev_hash_table_contents(ht,FALSE);
+    free(ht);
+}
+
+/*  Called from dwarf_finish via
+    _dwarf_free_all_of_one_debug(). Frees every
+    abbrev table, so after the CU contexts are gone. */
+void
+_dwarf_destroy_abbrev_tables(Dwarf_Debug dbg)
+{
+    if (!dbg->de_abbrev_tables) {
+        return;
+    }
+    dwarf_tdestroy(dbg->de_abbrev_tables,abbrev_table_free_node);
+    dbg->de_abbrev_tables = 0;
+}
+
+/*  Point context at the abbrev table for its
+    cc_abbrev_offset, creating the table if this is
+    the first CU context using that offset.
+    Done at first lookup as cc_abbrev_offset is only
+    final (DWP) once the context is set up. */
+static int
+find_shared_abbrev_table(Dwarf_CU_Context context,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = context->cc_dbg;
+    struct Dwarf_Hash_Table_s key;
+    Dwarf_Hash_Table ht = 0;
+    void *found = 0;
+
+    if (!dbg->de_abbrev_tables) {
+        dwarf_initialize_search_hash(&dbg->de_abbrev_tables,
+            abbrev_table_hashfunc,0);
+        if (!dbg->de_abbrev_tables) {
+            _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+                "DW_DLE_ALLOC_FAIL: allocating the "
+                "abbrev table search hash");
+            return DW_DLV_ERROR;
+        }
+    }
+    memset(&key,0,sizeof(key));
+    key.tb_abbrev_offset = context->cc_abbrev_offset;
+    found = dwarf_tfind(&key,&dbg->de_abbrev_tables,
+        abbrev_table_compare);
+    if (found) {
+        context->cc_abbrev_hash_table =
+            *(Dwarf_Hash_Table *)found;
+        return DW_DLV_OK;
+    }
+    ht = (Dwarf_Hash_Table) calloc(1,
+        sizeof(struct Dwarf_Hash_Table_s));
+    if (!ht) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating a "
+            "struct Dwarf_Hash_Table_s");
+        return DW_DLV_ERROR;
+    }
+    ht->tb_abbrev_offset = context->cc_abbrev_offset;
+    found = dwarf_tsearch(ht,&dbg->de_abbrev_tables,
+        abbrev_table_compare);
+    if (!found) {
+        free(ht);
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: adding to the "
+            "abbrev table search hash");
+        return DW_DLV_ERROR;
+    }
+    context->cc_abbrev_hash_table = ht;
+    return DW_DLV_OK;
+}
+
 /*  We allow zero form here, end of list. */
 int
 _dwarf_valid_form_we_know(Dwarf_Unsigned at_form,
@@ -851,7 +1002,9 @@ _dwarf_format_TAG_err_msg(Dwarf_Debug dbg,
     the hash table.  In other words, the .debug_abbrev section
     is scanned sequentially from the top for an abbrev with
     the given code.  All intervening abbrevs are also put
-    into the hash table.
+    into the hash table.  The hash table belongs to the
+    .debug_abbrev offset, not the CU, so CUs sharing an
+    abbrev offset share the table and the scan.
 
     This function hashes the given code, and checks the chain
     at that hash table entry to see if a Dwarf_Abbrev_List_s
@@ -884,8 +1037,7 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context context,
     Dwarf_Error *error)
 {
     Dwarf_Debug dbg =  context->cc_dbg;
-    Dwarf_Hash_Table   hash_table_base =
-        context->cc_abbrev_hash_table;
+    Dwarf_Hash_Table   hash_table_base = 0;
     Dwarf_Abbrev_List *entry_base = 0;
     Dwarf_Abbrev_List  entry_cur  = 0;
     Dwarf_Unsigned     hash_num           = 0;
@@ -899,6 +1051,24 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context context,
         dbg->de_debug_abbrev.dss_data;
     Dwarf_Unsigned     hashable_val             = 0;
 
+    if (!context->cc_abbrev_hash_table) {
+        int res = find_shared_abbrev_table(context,error);
+
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    hash_table_base = context->cc_abbrev_hash_table;
+    if (code < hash_table_base->tb_dense_count &&
+        hash_table_base->tb_dense_entries[code]) {
+        hash_abbrev_entry =
+            hash_table_base->tb_dense_entries[code];
+        *highest_known_code =
+            hash_table_base->tb_highest_known_code;
+        hash_abbrev_entry->abl_reference_count++;
+        *list_out = hash_abbrev_entry;
+        return DW_DLV_OK;
+    }
     if (!hash_table_base->tb_entries) {
         hash_table_base->tb_table_entry_count =
             HT_DEFAULT_TABLE_SIZE;
@@ -912,22 +1082,18 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
                 sizeof(Dwarf_Abbrev_List));
         if (!hash_table_base->tb_entries) {
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return DW_DLV_NO_ENTRY;
         }
     } else if (hash_table_base->tb_total_abbrev_count >
         (hash_table_base->tb_table_entry_count * HT_MULTIPLE)) {
-        struct Dwarf_Hash_Table_s * newht = 0;
-
-        newht = (Dwarf_Hash_Table) calloc(1,
-            sizeof(struct Dwarf_Hash_Table_s));
-        if (!newht) {
-            _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
-                "DW_DLE_ALLOC_FAIL: allocating a "
-                "struct Dwarf_Hash_Table_s");
-            return DW_DLV_ERROR;
-        }
+        struct Dwarf_Hash_Table_s newhts;
+        struct Dwarf_Hash_Table_s * newht = &newhts;
 
+        /*  Only the chains are rebuilt: the table itself
+            may be shared and is in de_abbrev_tables,
+            so it stays where it is. */
+        memset(newht,0,sizeof(newhts));
         /*  This grows  the hash table, likely too much.
             Since abbrev codes are usually assigned
             from 1 and increasing by one the hash usually
@@ -946,25 +1112,27 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
             calloc(newht->tb_table_entry_count,
                 sizeof(Dwarf_Abbrev_List));
         if (!newht->tb_entries) {
-            free(newht);
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return DW_DLV_NO_ENTRY;
         }
         /*  Copy the existing entries to the new table,
             rehashing each.  */
         copy_abbrev_table_to_new_table(hash_table_base, newht);
-        _dwarf_free_abbrev_hash_table_contents(hash_table_base,
-            TRUE /* keep abbrev content */);
-        /*  Now overwrite the existing table pointer
-            the new, newly valid, pointer. */
-        free(context->cc_abbrev_hash_table);
-        context->cc_abbrev_hash_table = newht;
-        hash_table_base = context->cc_abbrev_hash_table;
+        /*  Now overwrite the existing chains with
+            the new, newly valid, chains. */
+        free(hash_table_base->tb_entries);
+        hash_table_base->tb_entries = newht->tb_entries;
+        hash_table_base->tb_table_entry_count =
+            newht->tb_table_entry_count;
+        hash_table_base->tb_total_abbrev_count =
+            newht->tb_total_abbrev_count;
+        hash_table_base->tb_highest_used_entry =
+            newht->tb_highest_used_entry;
     } /* Else is ok as is */
     /*  Now add entry. */
-    if (code > context->cc_highest_known_code) {
-        context->cc_highest_known_code = code;
+    if (code > hash_table_base->tb_highest_known_code) {
+        hash_table_base->tb_highest_known_code = code;
     }
     hashable_val = code;
     hash_num = hashable_val HT_MOD_OP
@@ -984,15 +1152,15 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         /*  This returns a pointer to an abbrev
             list entry, not the list itself. */
         *highest_known_code =
-            context->cc_highest_known_code;
+            hash_table_base->tb_highest_known_code;
         hash_abbrev_entry->abl_reference_count++;
         *list_out = hash_abbrev_entry;
         return DW_DLV_OK;
     }
 
-    if (context->cc_last_abbrev_ptr) {
-        abbrev_ptr = context->cc_last_abbrev_ptr;
-        end_abbrev_ptr = context->cc_last_abbrev_endptr;
+    if (hash_table_base->tb_last_abbrev_ptr) {
+        abbrev_ptr = hash_table_base->tb_last_abbrev_ptr;
+        end_abbrev_ptr = hash_table_base->tb_last_abbrev_endptr;
     } else {
         /*  This is ok because cc_abbrev_offset includes DWP
             offset if appropriate.
@@ -1034,7 +1202,7 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
         is 0. */
     if (*abbrev_ptr == 0) {
         *highest_known_code =
-            context->cc_highest_known_code;
+            hash_table_base->tb_highest_known_code;
         return DW_DLV_NO_ENTRY;
     }
     do {
@@ -1067,28 +1235,12 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
                 "abbrev list entry");
             return DW_DLV_ERROR;
         }
-        new_hashable_val = abbrev_code;
-        if (abbrev_code > context->cc_highest_known_code) {
-            context->cc_highest_known_code = abbrev_code;
-        }
-        hash_num = new_hashable_val HT_MOD_OP
-            (hash_table_base->tb_table_entry_count-1);
-        if (hash_num > hash_table_base->tb_highest_used_entry) {
-            hash_table_base->tb_highest_used_entry =
-                (unsigned long)hash_num;
-        }
-
-        hash_table_base->tb_total_abbrev_count++;
         inner_list_entry->abl_code = abbrev_code;
         inner_list_entry->abl_tag = (Dwarf_Half)abbrev_tag;
         inner_list_entry->abl_has_child = *(abbrev_ptr++);
         inner_list_entry->abl_abbrev_ptr = abbrev_ptr;
         inner_list_entry->abl_goffset =  abb_goff;
 
-        /*  Move_entry_to_new_hash list recording
-            in cu_context. */
-        inner_list_entry->abl_next = entry_base[hash_num];
-        entry_base[hash_num] = inner_list_entry;
         /*  Cycle thru the abbrev content,
             ignoring the content except
             to find the end of the content. */
@@ -1097,20 +1249,45 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
             end_abbrev_ptr,&atcount,&impl_const_count,
             &abbrev_ptr2,error);
         if (res != DW_DLV_OK) {
+            /*  Not yet linked anywhere, so a later
+                retry from tb_last_abbrev_ptr will
+                not see it twice. */
+            free(inner_list_entry);
             *highest_known_code =
-                context->cc_highest_known_code;
+                hash_table_base->tb_highest_known_code;
             return res;
         }
         inner_list_entry->abl_implicit_const_count =
             impl_const_count;
         abbrev_ptr = abbrev_ptr2;
         inner_list_entry->abl_abbrev_count = atcount;
+
+        new_hashable_val = abbrev_code;
+        if (abbrev_code > hash_table_base->tb_highest_known_code) {
+            hash_table_base->tb_highest_known_code = abbrev_code;
+        }
+        hash_num = new_hashable_val HT_MOD_OP
+            (hash_table_base->tb_table_entry_count-1);
+        if (hash_num > hash_table_base->tb_highest_used_entry) {
+            hash_table_base->tb_highest_used_entry =
+                (unsigned long)hash_num;
+        }
+        hash_table_base->tb_total_abbrev_count++;
+
+        /*  Move_entry_to_new_hash list recording
+            in cu_context. */
+        inner_list_entry->abl_next = entry_base[hash_num];
+        entry_base[hash_num] = inner_list_entry;
+        add_to_dense_index(hash_table_base,inner_list_entry);
+        /*  The entry is complete and linked: record
+            progress so a shared table resumes the scan
+            after it. */
+        hash_table_base->tb_last_abbrev_ptr = abbrev_ptr;
+        hash_table_base->tb_last_abbrev_endptr = end_abbrev_ptr;
     } while ((abbrev_ptr < end_abbrev_ptr) &&
         *abbrev_ptr != 0 && abbrev_code != code);
 
-    *highest_known_code = context->cc_highest_known_code;
-    context->cc_last_abbrev_ptr = abbrev_ptr;
-    context->cc_last_abbrev_endptr = end_abbrev_ptr;
+    *highest_known_code = hash_table_base->tb_highest_known_code;
     if (abbrev_code == code) {
         *list_out = inner_list_entry;
         inner_list_entry->abl_reference_count++;
@@ -1420,6 +1597,10 @@ _dwarf_free_abbrev_hash_table_contents(Dwarf_Hash_Table hash_table,
                 abbrev->abl_form = 0;
                 free(abbrev->abl_implicit_const);
                 abbrev->abl_implicit_const = 0;
+                free(abbrev->abl_skip_ops);
+                abbrev->abl_skip_ops = 0;
+                free(abbrev->abl_attr_place);
+                abbrev->abl_attr_place = 0;
                 nextabbrev = abbrev->abl_next;
                 abbrev->abl_next = 0;
                 /*  dealloc single list entry */
@@ -1441,6 +1622,9 @@ printf("debugging: max ref count of any abbrev %lu, \n",
     /* Frees all the pointers at once: an array. */
     free(hash_table->tb_entries);
     hash_table->tb_entries = 0;
+    free(hash_table->tb_dense_entries);
+    hash_table->tb_dense_entries = 0;
+    hash_table->tb_dense_count = 0;
 }
 
 /*
@@ -38,14 +38,19 @@ _dwarf_create_area_len_error(Dwarf_Debug dbg, Dwarf_Error *error,
     do {                                                    \
         Dwarf_Unsigned lu_leblen = 0;                       \
         int lu_res = 0;                                     \
-        lu_res = _dwarf_skip_leb128((char *)(ptr),&lu_leblen, \
-            (char *)(endptr));                              \
-        if (lu_res == DW_DLV_ERROR) {                       \
-            _dwarf_error_string((dbg), (errptr),            \
-                DW_DLE_LEB_IMPROPER,                        \
-                "DW_DLE_LEB_IMPROPER: skipping leb128"      \
-                " runs past allowed area.a");                 \
-            return DW_DLV_ERROR;                            \
+        if ((char *)(ptr) < (char *)(endptr) &&             \
+            !(*(unsigned char *)(ptr) & 0x80)) {            \
+            lu_leblen = 1;                                  \
+        } else {                                            \
+            lu_res = _dwarf_skip_leb128((char *)(ptr),      \
+                &lu_leblen,(char *)(endptr));               \
+            if (lu_res == DW_DLV_ERROR) {                   \
+                _dwarf_error_string((dbg), (errptr),        \
+                    DW_DLE_LEB_IMPROPER,                    \
+                    "DW_DLE_LEB_IMPROPER: skipping leb128"  \
+                    " runs past allowed area.a");           \
+                return DW_DLV_ERROR;                        \
+            }                                               \
         }                                                   \
         (ptr) += lu_leblen;                                 \
     } while (0)
@@ -53,14 +58,19 @@ _dwarf_create_area_len_error(Dwarf_Debug dbg, Dwarf_Error *error,
     do {                                                    \
         Dwarf_Unsigned lu_leblen = 0;                       \
         int lu_res = 0;                                     \
-        lu_res = _dwarf_skip_leb128((char *)(ptr),&lu_leblen, \
-            (char *)(endptr));                              \
-        if (lu_res == DW_DLV_ERROR) {                       \
-            _dwarf_error_string((dbg), (errptr),            \
-                DW_DLE_LEB_IMPROPER,                        \
-                "DW_DLE_LEB_IMPROPER: skipping leb128 w/len" \
-                " runs past allowed area.b");                 \
-            return DW_DLV_ERROR;                            \
+        if ((char *)(ptr) < (char *)(endptr) &&             \
+            !(*(unsigned char *)(ptr) & 0x80)) {            \
+            lu_leblen = 1;                                  \
+        } else {                                            \
+            lu_res = _dwarf_skip_leb128((char *)(ptr),      \
+                &lu_leblen,(char *)(endptr));               \
+            if (lu_res == DW_DLV_ERROR) {                   \
+                _dwarf_error_string((dbg), (errptr),        \
+                    DW_DLE_LEB_IMPROPER,                    \
+                    "DW_DLE_LEB_IMPROPER: skipping leb128 w/len" \
+                    " runs past allowed area.b");           \
+                return DW_DLV_ERROR;                        \
+            }                                               \
         }                                                   \
         (ptr) += lu_leblen;                                 \
         (leblen) = lu_leblen;                               \
@@ -71,14 +81,20 @@ _dwarf_create_area_len_error(Dwarf_Debug dbg, Dwarf_Error *error,
         Dwarf_Unsigned lu_leblen = 0;                       \
         Dwarf_Unsigned lu_local = 0;                        \
         int lu_res = 0;                                     \
-        lu_res = dwarf_decode_leb128((char *)(ptr),&lu_leblen,\
-            &lu_local,(char *)(endptr));                    \
-        if (lu_res == DW_DLV_ERROR) {                       \
-            _dwarf_error_string((dbg), (errptr),            \
-                DW_DLE_LEB_IMPROPER,                        \
-                "DW_DLE_LEB_IMPROPER: decode uleb"          \
-                " runs past allowed area.c");                 \
-            return DW_DLV_ERROR;                            \
+        if ((char *)(ptr) < (char *)(endptr) &&             \
+            !(*(unsigned char *)(ptr) & 0x80)) {            \
+            lu_local = *(unsigned char *)(ptr);             \
+            lu_leblen = 1;                                  \
+        } else {                                            \
+            lu_res = dwarf_decode_leb128((char *)(ptr),     \
+                &lu_leblen,&lu_local,(char *)(endptr));     \
+            if (lu_res == DW_DLV_ERROR) {                   \
+                _dwarf_error_string((dbg), (errptr),        \
+                    DW_DLE_LEB_IMPROPER,                    \
+                    "DW_DLE_LEB_IMPROPER: decode uleb"      \
+                    " runs past allowed area.c");           \
+                return DW_DLV_ERROR;                        \
+            }                                               \
         }                                                   \
         (value) = lu_local;                                 \
         (ptr) += lu_leblen;                                 \
@@ -90,14 +106,20 @@ _dwarf_create_area_len_error(Dwarf_Debug dbg, Dwarf_Error *error,
         Dwarf_Unsigned lu_leblen = 0;                 \
         Dwarf_Unsigned lu_local = 0;                  \
         int lu_res = 0;                               \
-        lu_res = dwarf_decode_leb128((char *)(ptr),   \
-            &lu_leblen,&lu_local,(char *)(endptr));   \
-        if (lu_res == DW_DLV_ERROR) {                 \
-            _dwarf_error_string((dbg), (errptr),      \
-                DW_DLE_LEB_IMPROPER,                  \
-                "DW_DLE_LEB_IMPROPER: decode uleb w/len" \
-                " runs past allowed area.d");           \
-            return DW_DLV_ERROR;                      \
+        if ((char *)(ptr) < (char *)(endptr) &&       \
+            !(*(unsigned char *)(ptr) & 0x80)) {      \
+            lu_local = *(unsigned char *)(ptr);       \
+            lu_leblen = 1;                            \
+        } else {                                      \
+            lu_res = dwarf_decode_leb128((char *)(ptr), \
+                &lu_leblen,&lu_local,(char *)(endptr)); \
+            if (lu_res == DW_DLV_ERROR) {             \
+                _dwarf_error_string((dbg), (errptr),  \
+                    DW_DLE_LEB_IMPROPER,              \
+                    "DW_DLE_LEB_IMPROPER: decode uleb w/len" \
+                    " runs past allowed area.d");     \
+                return DW_DLV_ERROR;                  \
+            }                                         \
         }                                             \
         (value) = lu_local;                           \
         (ptr) += lu_leblen;                           \
@@ -392,7 +414,12 @@ _dwarf_get_size_of_val(Dwarf_Debug dbg,
 
 /*
    Dwarf_Hash_Table_s is the base for the 'hash' table.
-   The table occurs exactly once per CU.
+   The table occurs exactly once per .debug_abbrev
+   offset and is shared by every CU context whose
+   cc_abbrev_offset is that offset (LTO and type units
+   often point thousands of CUs at one abbrev table).
+   The tables are owned by dbg->de_abbrev_tables, not
+   by the CU contexts.
 
    The intent is that once the total_abbrev_count across
    one should build a new Dwarf_Hash_Table_Base_s, rehash
@@ -418,6 +445,22 @@ struct Dwarf_Hash_Table_s {
         and in each singly-linked  list starting
         there points to the entries for one abbrev code. */
     Dwarf_Abbrev_List  *tb_entries;
+
+    /*  Compilers almost always number abbrevs 1..N,
+        so codes below tb_dense_count are also indexed
+        directly here. A code too sparse for this array
+        is found through tb_entries only. Every entry
+        is on a tb_entries chain, this is just an index. */
+    unsigned long       tb_dense_count;
+    Dwarf_Abbrev_List  *tb_dense_entries;
+
+    /*  The key in dbg->de_abbrev_tables. */
+    Dwarf_Unsigned      tb_abbrev_offset;
+    /*  How far .debug_abbrev has been read
+        for this table. */
+    Dwarf_Byte_Ptr      tb_last_abbrev_ptr;
+    Dwarf_Byte_Ptr      tb_last_abbrev_endptr;
+    Dwarf_Unsigned      tb_highest_known_code;
 };
 
 /* Perhaps not actually useful. */
@@ -483,6 +526,7 @@ int  _dwarf_load_debug_types(Dwarf_Debug dbg, Dwarf_Error *error);
 void _dwarf_free_abbrev_hash_table_contents(
     struct Dwarf_Hash_Table_s* hash_table,
     Dwarf_Bool keep_abbrev_content);
+void _dwarf_destroy_abbrev_tables(Dwarf_Debug dbg);
 int _dwarf_get_address_size(Dwarf_Debug dbg, Dwarf_Die die);
 int _dwarf_reference_outside_section(Dwarf_Die die,
     Dwarf_Small * startaddr,
@@ -334,6 +334,51 @@ typedef struct Dwarf_Block_s {
     Dwarf_Unsigned  bl_section_offset;
 } Dwarf_Block;
 
+/*! @typedef Dwarf_Attr_Value
+
+    One attribute of a DIE as decoded by
+    dwarf_get_die_attr_values() into space
+    the caller provides.
+    Nothing here is allocated by libdwarf, pointers
+    refer to section data and remain valid until
+    the Dwarf_Debug is finished.
+
+    @var av_attrnum
+    The attribute number, DW_AT_name for example.
+    @var av_form
+    The FORM with any DW_FORM_indirect resolved.
+    Zero if a requested attribute is not in the DIE.
+    @var av_uvalue
+    The constant, flag, address, index (for
+    DW_FORM_addrx*, DW_FORM_strx*, DW_FORM_loclistx,
+    DW_FORM_rnglistx) or offset. Offsets from
+    DW_FORM_ref1 through DW_FORM_ref_udata are made
+    global, as by dwarf_global_formref(), other
+    offsets are as recorded. For block forms
+    the block length.
+    @var av_svalue
+    The value of DW_FORM_sdata or DW_FORM_implicit_const,
+    otherwise zero.
+    @var av_string
+    For the string forms the string itself if it can
+    be found in this object, otherwise NULL.
+    @var av_data
+    The bytes of the value in the section (for a block
+    form, the block contents). NULL for
+    DW_FORM_implicit_const.
+    @var av_len
+    The number of bytes at av_data.
+*/
+typedef struct Dwarf_Attr_Value_s {
+    Dwarf_Half      av_attrnum;
+    Dwarf_Half      av_form;
+    Dwarf_Unsigned  av_uvalue;
+    Dwarf_Signed    av_svalue;
+    const char     *av_string;
+    Dwarf_Small    *av_data;
+    Dwarf_Unsigned  av_len;
+} Dwarf_Attr_Value;
+
 /*! @typedef Dwarf_Locdesc_c
     Provides access to Dwarf_Locdesc_c, a single
     location description
@@ -598,6 +643,26 @@ typedef struct Dwarf_Regtable3_s {
     struct Dwarf_Regtable_Entry3_s * rt3_rules;
 } Dwarf_Regtable3;
 
+/*! @typedef Dwarf_Unwind_Rule
+    One register rule in a table built by
+    dwarf_make_unwind_table().
+    ur_kind is one of the DW_UNWIND_ values.
+    ur_column is the register (column) the rule
+    applies to. ur_register is the other register
+    in a DW_UNWIND_REGISTER or DW_UNWIND_CFA_REG_OFFSET
+    rule. ur_offset is the offset, where the kind
+    has one.
+    There are no pointers so a table can be
+    written to a file and mapped back in.
+*/
+typedef struct Dwarf_Unwind_Rule_s {
+    Dwarf_Signed   ur_offset;
+    Dwarf_Half     ur_column;
+    Dwarf_Half     ur_register;
+    Dwarf_Small    ur_kind;
+    Dwarf_Small    ur_reserved[3];
+} Dwarf_Unwind_Rule;
+
 /* Opaque types for Consumer Library. */
 /*! @typedef Dwarf_Error
 
@@ -626,6 +691,12 @@ typedef struct Dwarf_Section_s*    Dwarf_Section;
 */
 typedef struct Dwarf_Die_s*        Dwarf_Die;
 
+/*! @typedef Dwarf_Die_Cursor
+    Used to reference a pre-order walk over a DIE
+    and its descendants. See dwarf_make_die_cursor().
+*/
+typedef struct Dwarf_Die_Cursor_s* Dwarf_Die_Cursor;
+
 /*! @typedef Dwarf_Debug_Addr_Table
     Used to reference a table in section .debug_addr
 */
@@ -699,6 +770,11 @@ typedef struct Dwarf_Cie_s*        Dwarf_Cie;
     in a section such as .debug_info.
 */
 typedef struct Dwarf_Arange_s*     Dwarf_Arange;
+/*! @typedef Dwarf_Arange_Index
+    Used to reference a sorted address index
+    built from a Dwarf_Arange array.
+*/
+typedef struct Dwarf_Arange_Index_s* Dwarf_Arange_Index;
 /*! @typedef Dwarf_Gdbindex
     Used to reference .gdb_index section data
     which is a fast-access section by and for gdb.
@@ -715,6 +791,12 @@ typedef struct Dwarf_Xu_Index_Header_s  *Dwarf_Xu_Index_Header;
 */
 typedef struct Dwarf_Line_Context_s     *Dwarf_Line_Context;
 
+/*! @typedef Dwarf_Line_Columns
+    Used to reference a compact copy of a line table
+    with address lookup. See dwarf_make_line_columns().
+*/
+typedef struct Dwarf_Line_Columns_s     *Dwarf_Line_Columns;
+
 /*! @typedef Dwarf_Macro_Context
     Used as the general reference to DWARF5 .debug_macro data.
 */
@@ -814,8 +896,11 @@ struct Dwarf_Obj_Access_Section_a_s {
     This is part of the allowance of mmap for
     loading sections of an object file.
 
-    The option of using mmap() only applies to
+    The option of using mmap() per section only applies to
     Elf object files in this release.
+    Dwarf_Alloc_Mmap_Whole (@since{2.3.0})
+    maps an entire Elf, Mach-O, or PE object
+    once and section data points into that mapping.
 
     @see dwarf_set_load_preference()
 */
@@ -824,7 +909,8 @@ enum Dwarf_Sec_Alloc_Pref {
     Dwarf_Alloc_None=0,
     /* alternative allocations */
     Dwarf_Alloc_Malloc=1,
-    Dwarf_Alloc_Mmap=2};
+    Dwarf_Alloc_Mmap=2,
+    Dwarf_Alloc_Mmap_Whole=3};
 
 /*! @struct Dwarf_Obj_Access_Methods_a_s:
 
@@ -969,6 +1055,17 @@ typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 #define DW_EXPR_VAL_OFFSET     1
 #define DW_EXPR_EXPRESSION     2
 #define DW_EXPR_VAL_EXPRESSION 3
+
+/*  Rule kinds in a Dwarf_Unwind_Rule,
+    see dwarf_make_unwind_table(). */
+#define DW_UNWIND_UNDEFINED      0
+#define DW_UNWIND_SAME_VALUE     1
+#define DW_UNWIND_OFFSET         2 /* saved at CFA+offset */
+#define DW_UNWIND_VAL_OFFSET     3 /* value is CFA+offset */
+#define DW_UNWIND_REGISTER       4 /* saved in ur_register */
+#define DW_UNWIND_CFA_REG_OFFSET 5 /* CFA is ur_register+offset */
+#define DW_UNWIND_EXPRESSION     6 /* Needs the FDE to evaluate */
+#define DW_UNWIND_VAL_EXPRESSION 7 /* Needs the FDE to evaluate */
 /*! @} endgroup framedefines*/
 
 /*! @defgroup dwdla DW_DLA alloc/dealloc typename&number
@@ -1554,9 +1651,10 @@ typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 #define DW_DLE_DUPLICATE_NOTE_GNU_BUILD_ID     508
 #define DW_DLE_SYSCONF_VALUE_UNUSABLE          509
 #define DW_DLE_FRAME_ITERATOR_ERR              510
+#define DW_DLE_SECTION_WRITE_ERR               511
 
 /*! @note DW_DLE_LAST MUST EQUAL LAST ERROR NUMBER */
-#define DW_DLE_LAST        510
+#define DW_DLE_LAST        511
 #define DW_DLE_LO_USER     0x10000
 /*! @} endgroup dw_dle */
 
@@ -2096,6 +2194,45 @@ DW_API int dwarf_siblingof_c(Dwarf_Die    dw_die,
     Dwarf_Die   *dw_return_siblingdie,
     Dwarf_Error *dw_error);
 
+/*! @brief Return the sibling DIE in a Dwarf_Die you own
+
+    Like dwarf_siblingof_c() but, unless
+    *dw_die_inout is NULL, no new Dwarf_Die is
+    allocated: the Dwarf_Die *dw_die_inout is
+    overwritten to be the sibling.
+    It may be dw_die itself, moving a
+    Dwarf_Die along a sibling list in place.
+    So a tree walk can keep one Dwarf_Die per
+    nesting level rather than one per DIE.
+
+    A Dwarf_Attribute (from dwarf_attr(),
+    dwarf_attrlist() and the like) or any other
+    handle obtained from the overwritten Dwarf_Die
+    refers to that Dwarf_Die, not to a copy of it.
+    After this call such handles are invalid and
+    must not be used: deallocate them before
+    this call.
+
+    @param dw_die
+    The DIE whose sibling is wanted.
+    @param dw_die_inout
+    Pass in a pointer to a Dwarf_Die from this
+    Dwarf_Debug, which will be overwritten, or
+    to NULL to have one allocated. On DW_DLV_NO_ENTRY
+    or DW_DLV_ERROR *dw_die_inout and the DIE it
+    refers to are unchanged.
+    The Dwarf_Die is deallocated as usual with
+    dwarf_dealloc_die().
+    @param dw_error
+    The usual error information, if any.
+    @return
+    Returns DW_DLV_OK etc.
+    @since {2.3.0}
+*/
+DW_API int dwarf_siblingof_reuse(Dwarf_Die dw_die,
+    Dwarf_Die   *dw_die_inout,
+    Dwarf_Error *dw_error);
+
 /*! @brief Return the first DIE or the next sibling DIE.
 
     This function follows dwarf_next_cu_header_d()
@@ -2211,6 +2348,147 @@ DW_API int dwarf_child(Dwarf_Die dw_die,
     Dwarf_Die*    dw_return_childdie,
     Dwarf_Error*  dw_error);
 
+/*! @brief Return the child DIE in a Dwarf_Die you own
+
+    Like dwarf_child() but overwrites the Dwarf_Die
+    *dw_die_inout (unless it is NULL) instead of
+    allocating one.
+    Every Dwarf_Attribute or other handle obtained
+    from the overwritten Dwarf_Die is invalid
+    after this call.
+    See dwarf_siblingof_reuse() for the details.
+
+    @param dw_die
+    We will return the first child of this DIE.
+    @param dw_die_inout
+    Pass in a pointer to a Dwarf_Die from this
+    Dwarf_Debug, which will be overwritten, or
+    to NULL to have one allocated.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY
+    if dw_die has no children.
+    @since {2.3.0}
+*/
+DW_API int dwarf_child_reuse(Dwarf_Die dw_die,
+    Dwarf_Die*    dw_die_inout,
+    Dwarf_Error*  dw_error);
+
+/*! @brief Start a flat pre-order walk of a DIE tree
+
+    Walking a tree with dwarf_child() and
+    dwarf_siblingof_c() means recursion or a
+    stack in the caller and, without
+    DW_AT_sibling, stepping over each subtree
+    again to find the next sibling.
+    A cursor instead reads the DIEs once in
+    section order, as they appear, reporting
+    the depth of each.
+    It suits indexers and the like that visit
+    every DIE.
+
+    The walk covers dw_die and its descendants
+    (the whole CU when dw_die is a CU DIE).
+
+    @param dw_die
+    Pass in the DIE at the top of the walk.
+    The cursor does not refer to dw_die after
+    this returns.
+    @param dw_cursor
+    On success returns the new cursor.
+    Free it with dwarf_dealloc_die_cursor()
+    before calling dwarf_finish().
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_make_die_cursor(Dwarf_Die dw_die,
+    Dwarf_Die_Cursor *dw_cursor,
+    Dwarf_Error      *dw_error);
+
+/*! @brief Step a DIE cursor to the next DIE
+
+    The first call returns the DIE passed to
+    dwarf_make_die_cursor(), at depth zero.
+    After a DIE with children the next call
+    returns its first child, one deeper,
+    unless dwarf_die_cursor_skip_children()
+    was called.
+
+    Any of the return pointers may be NULL if
+    the value is not wanted. No Dwarf_Die is
+    created unless dw_die is non-NULL.
+
+    @param dw_cursor
+    Pass in the cursor.
+    @param dw_offset
+    On success returns the section global
+    offset of the DIE, as dwarf_dieoffset().
+    @param dw_depth
+    On success returns the depth of the DIE
+    below the top DIE.
+    @param dw_tag
+    On success returns the DIE tag.
+    @param dw_abbrev_code
+    On success returns the abbreviation code.
+    @param dw_die
+    On success returns a Dwarf_Die for the DIE,
+    for use with dwarf_get_die_attr_values(),
+    dwarf_attr() and the like.
+    It belongs to the cursor: it is overwritten
+    by the next call and must not be
+    dealloc'd by the caller. Dealloc any
+    Dwarf_Attribute from it before the next call.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY
+    when the walk is finished.
+    @since {2.3.0}
+*/
+DW_API int dwarf_die_cursor_next(Dwarf_Die_Cursor dw_cursor,
+    Dwarf_Off      *dw_offset,
+    Dwarf_Unsigned *dw_depth,
+    Dwarf_Half     *dw_tag,
+    Dwarf_Unsigned *dw_abbrev_code,
+    Dwarf_Die      *dw_die,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Skip the children of the DIE a cursor is on
+
+    The next dwarf_die_cursor_next() then returns
+    the next sibling (or the next DIE further up)
+    of the DIE last returned.
+    Uses DW_AT_sibling where the DIE has it.
+    Does nothing if the DIE has no children.
+
+    @param dw_cursor
+    Pass in a cursor that has returned a DIE.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_die_cursor_skip_children(
+    Dwarf_Die_Cursor dw_cursor,
+    Dwarf_Error     *dw_error);
+
+/*! @brief Free a DIE cursor
+
+    @param dw_cursor
+    The cursor from dwarf_make_die_cursor().
+    Callers should zero the pointer passed in
+    as soon as possible after this returns
+    as the pointer is then stale.
+    @since {2.3.0}
+*/
+DW_API void dwarf_dealloc_die_cursor(
+    Dwarf_Die_Cursor dw_cursor);
+
 /*! @brief Deallocate (free) a DIE.
     @param dw_die
     Frees (deallocs) memory associated with this Dwarf_Die.
@@ -2279,6 +2557,40 @@ DW_API int dwarf_offdie_b(Dwarf_Debug dw_dbg,
     Dwarf_Die*       dw_return_die,
     Dwarf_Error*     dw_error);
 
+/*! @brief Return DIE given global offset in a Dwarf_Die you own
+
+    Like dwarf_offdie_b() but overwrites the Dwarf_Die
+    *dw_die_inout (unless it is NULL) instead of
+    allocating one.
+    Every Dwarf_Attribute or other handle obtained
+    from the overwritten Dwarf_Die is invalid
+    after this call.
+    See dwarf_siblingof_reuse() for the details.
+
+    @param dw_dbg
+    The applicable Dwarf_Debug
+    @param dw_offset
+    The global offset of the DIE in the appropriate
+    section.
+    @param dw_is_info
+    Pass TRUE if the target is .debug_info.
+    Pass FALSE if the target is .debug_types.
+    @param dw_die_inout
+    Pass in a pointer to a Dwarf_Die from dw_dbg,
+    which will be overwritten, or
+    to NULL to have one allocated.
+    @param dw_error
+    The usual Dwarf_Error*.
+    @return
+    Returns DW_DLV_OK etc.
+    @since {2.3.0}
+*/
+DW_API int dwarf_offdie_reuse(Dwarf_Debug dw_dbg,
+    Dwarf_Off        dw_offset,
+    Dwarf_Bool       dw_is_info,
+    Dwarf_Die*       dw_die_inout,
+    Dwarf_Error*     dw_error);
+
 /*! @brief Return a DIE given a Dwarf_Sig8 hash.
 
     Returns DIE and is_info flag if it finds the hash
@@ -2536,6 +2848,37 @@ DW_API int dwarf_attr(Dwarf_Die dw_die,
     Dwarf_Attribute * dw_returned_attr,
     Dwarf_Error*      dw_error);
 
+/*! @brief Remember where each attribute of a DIE is
+
+    Lookups by attribute number (dwarf_attr(),
+    dwarf_hasattr(), dwarf_lowpc(), dwarf_highpc_b(),
+    dwarf_bytesize() and the like) always go straight
+    to the value when every FORM before it in the
+    abbreviation has a fixed size.
+    Otherwise each variable-size value before it
+    is stepped over on every lookup.
+
+    With this set non-zero, the first lookup on a DIE
+    instead walks all its attributes once and records
+    where each value starts, so further lookups on the
+    same DIE take constant time.
+    Only the most recently queried DIE is remembered,
+    so this pays off for callers that fetch several
+    attributes from one DIE before moving to the next.
+    Defaults to zero.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_v
+    Pass in non-zero to turn the cache on, zero to
+    turn it off.
+    @return
+    Returns the previous setting.
+    @since {2.3.0}
+*/
+DW_API int dwarf_set_die_attr_offset_cache(Dwarf_Debug dw_dbg,
+    int dw_v);
+
 /*! @brief Given DIE and attribute number return a string
 
     Returns DW_DLV_NO_ENTRY if the DIE has no attribute dw_attrnum.
@@ -3211,6 +3554,52 @@ DW_API int dwarf_attrlist(Dwarf_Die dw_die,
     Dwarf_Signed * dw_attrcount,
     Dwarf_Error*   dw_error);
 
+/*! @brief Decode attributes into a caller array
+
+    An alternative to dwarf_attrlist() and dwarf_attr()
+    plus the dwarf_form*() calls that
+    allocates nothing (unless there is an error).
+    Nothing returned is to be deallocated.
+
+    @param dw_die
+    The DIE from which to pull attributes.
+    @param dw_attrnums
+    Pass in NULL to get every attribute of the DIE in
+    abbreviation order. Or pass in an array of
+    attribute numbers wanted and dw_values[i] is
+    filled in for dw_attrnums[i].
+    @param dw_attrnum_count
+    The number of entries in dw_attrnums.
+    Ignored if dw_attrnums is NULL.
+    @param dw_values
+    The caller's array of results.
+    @param dw_values_count
+    The number of entries in dw_values.
+    With a non-NULL dw_attrnums this must be
+    at least dw_attrnum_count.
+    @param dw_returned_count
+    With dw_attrnums NULL, returns the number of
+    attributes the DIE has, which may be larger than
+    dw_values_count (only dw_values_count of them are
+    filled in). Otherwise returns how many of the
+    dw_attrnums were found, entries not found have
+    av_form zero.
+    @param dw_error
+    A place to return error details.
+    @return
+    Returns DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if the DIE has no
+    attributes or none of those requested.
+    @since {2.3.0}
+*/
+DW_API int dwarf_get_die_attr_values(Dwarf_Die dw_die,
+    const Dwarf_Half * dw_attrnums,
+    Dwarf_Unsigned     dw_attrnum_count,
+    Dwarf_Attr_Value * dw_values,
+    Dwarf_Unsigned     dw_values_count,
+    Dwarf_Unsigned   * dw_returned_count,
+    Dwarf_Error      * dw_error);
+
 /*! @brief Sets TRUE if a Dwarf_Attribute has the indicated FORM
     @param dw_attr
     The Dwarf_Attribute of interest.
@@ -3974,6 +4363,268 @@ DW_API int dwarf_srclines_two_level_from_linecontext(
 */
 DW_API void dwarf_srclines_dealloc_b(Dwarf_Line_Context dw_context);
 
+/*  Flags of a row from dwarf_line_columns_row(). */
+#define DW_LINE_COLUMNS_IS_STMT        0x01
+#define DW_LINE_COLUMNS_BASIC_BLOCK    0x02
+#define DW_LINE_COLUMNS_END_SEQUENCE   0x04
+#define DW_LINE_COLUMNS_PROLOGUE_END   0x08
+#define DW_LINE_COLUMNS_EPILOGUE_BEGIN 0x10
+
+/*! @brief Make a compact copy of a line table for lookups
+
+    A Dwarf_Line costs over 80 bytes plus its pointer.
+    This copies the rows into one array per field:
+    addresses as 32 bit offsets from the start
+    of their sequence, 32 bit line, file and
+    discriminator, 16 bit column and one bit per flag,
+    around a fifth of the space.
+
+    The sequences are put in address order, keeping
+    the rows of each together, so
+    dwarf_lookup_line_columns() can binary search.
+    The rows are numbered in that order, which is
+    not necessarily the order of the Dwarf_Line array.
+
+    The copy does not refer to dw_context, which
+    may be dealloc'd once this returns. File numbers
+    are as dwarf_line_srcfileno() returns; keep
+    what is needed from dwarf_srclines_files_data_b()
+    to name the files.
+
+    For a two-level line table the rows are the
+    actuals, with line, file and column from the
+    logicals row each refers to.
+
+    @param dw_context
+    Pass in the line context from dwarf_srclines_b().
+    @param dw_columns
+    On success returns the new table.
+    Free it with dwarf_dealloc_line_columns().
+    @param dw_row_count
+    If non-null, on success returns the number of rows.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_make_line_columns(Dwarf_Line_Context dw_context,
+    Dwarf_Line_Columns *dw_columns,
+    Dwarf_Unsigned     *dw_row_count,
+    Dwarf_Error        *dw_error);
+
+/*! @brief Find the line table row for a pc
+
+    Finds the sequence covering dw_pc and in it the
+    last row at or below dw_pc.
+    Where sequences overlap (as in a relocatable object)
+    the one starting nearest below dw_pc is used.
+    Nothing is allocated.
+
+    @param dw_columns
+    Pass in the table from dwarf_make_line_columns().
+    @param dw_pc
+    Pass in the address of interest.
+    @param dw_row
+    On success returns the row number, for
+    dwarf_line_columns_row().
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY if no
+    sequence covers dw_pc.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_line_columns(
+    Dwarf_Line_Columns dw_columns,
+    Dwarf_Addr         dw_pc,
+    Dwarf_Unsigned    *dw_row,
+    Dwarf_Error       *dw_error);
+
+/*! @brief Return the fields of one row of a Dwarf_Line_Columns
+
+    Any of the return pointers may be NULL.
+    Line, file and discriminator values too large
+    for 32 bits are returned as 0xffffffff.
+
+    @param dw_columns
+    Pass in the table from dwarf_make_line_columns().
+    @param dw_row
+    Pass in a row number, zero through the row
+    count less one.
+    @param dw_address
+    On success returns the row address.
+    @param dw_line
+    On success returns the line number.
+    @param dw_file
+    On success returns the file number.
+    @param dw_column
+    On success returns the column number.
+    @param dw_discriminator
+    On success returns the discriminator.
+    @param dw_flags
+    On success returns the DW_LINE_COLUMNS_ flags
+    that are set for the row.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY if
+    dw_row is out of range.
+    @since {2.3.0}
+*/
+DW_API int dwarf_line_columns_row(Dwarf_Line_Columns dw_columns,
+    Dwarf_Unsigned  dw_row,
+    Dwarf_Addr     *dw_address,
+    Dwarf_Unsigned *dw_line,
+    Dwarf_Unsigned *dw_file,
+    Dwarf_Unsigned *dw_column,
+    Dwarf_Unsigned *dw_discriminator,
+    Dwarf_Unsigned *dw_flags,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Free a Dwarf_Line_Columns
+
+    @param dw_columns
+    The table from dwarf_make_line_columns().
+    Callers should zero the pointer passed in
+    as soon as possible after this returns
+    as the pointer is then stale.
+    @since {2.3.0}
+*/
+DW_API void dwarf_dealloc_line_columns(
+    Dwarf_Line_Columns dw_columns);
+
+/*! @brief Build a pc to file and line index of all CUs
+
+    Reads the line table of every CU in .debug_info
+    and makes one address sorted index of all their
+    sequences, with each file name stored once, so
+    dwarf_lookup_line_index() can turn a pc into a
+    file and line with a binary search.
+
+    The table is one block of memory in host byte
+    order with no pointers in it: it can be written to
+    a file and later read or mapped back in (at an
+    8 byte aligned address) and passed to
+    dwarf_lookup_line_index() with no Dwarf_Debug
+    open.
+
+    This walks the CUs with dwarf_next_cu_header_e(),
+    so do not call it in the middle of a loop over
+    the CUs.
+    CUs whose line table cannot be read, two-level
+    line tables, rows after the last end_sequence and
+    sequences whose addresses go backwards are left
+    out. A sequence with exactly the same rows as one
+    already seen is recorded once.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_table
+    On success returns a pointer to the table.
+    Free it with dwarf_dealloc_line_index().
+    @param dw_table_size
+    On success returns the size of the table in bytes.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_make_line_index(Dwarf_Debug dw_dbg,
+    void           **dw_table,
+    Dwarf_Unsigned  *dw_table_size,
+    Dwarf_Error     *dw_error);
+
+/*! @brief Look up a pc in a table from dwarf_make_line_index()
+
+    Checks the table header then finds the sequence
+    covering dw_pc and in it the last row at or below
+    dw_pc. Where sequences overlap the one starting
+    nearest below dw_pc is used.
+    Nothing is allocated.
+    Any of the return pointers may be NULL.
+
+    @param dw_table
+    Pass in the table, which must be 8 byte aligned.
+    @param dw_table_size
+    Pass in the size in bytes of the table.
+    @param dw_pc
+    Pass in the pc of interest.
+    @param dw_file
+    On success returns a pointer into the table
+    to the file name, as dwarf_linesrc() returns it.
+    @param dw_line
+    On success returns the line number.
+    Line numbers too large for 32 bits are
+    returned as 0xffffffff.
+    @param dw_column
+    On success returns the column number.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if no sequence
+    covers dw_pc, or DW_DLV_ERROR if the table is not
+    a valid table.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_line_index(const void *dw_table,
+    Dwarf_Unsigned  dw_table_size,
+    Dwarf_Addr      dw_pc,
+    const char    **dw_file,
+    Dwarf_Unsigned *dw_line,
+    Dwarf_Unsigned *dw_column,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Look up many pcs in a table from dwarf_make_line_index()
+
+    As dwarf_lookup_line_index() for each of dw_pcs,
+    checking the table header just once.
+    The pcs need not be sorted.
+
+    @param dw_table
+    Pass in the table, which must be 8 byte aligned.
+    @param dw_table_size
+    Pass in the size in bytes of the table.
+    @param dw_pcs
+    Pass in the pcs of interest.
+    @param dw_pc_count
+    Pass in the number of pcs.
+    @param dw_files
+    Pass in an array of dw_pc_count entries.
+    On success each entry is set to the file name
+    for that pc, or to NULL if no sequence covers it.
+    @param dw_lines
+    Pass in an array of dw_pc_count entries.
+    On success each entry is set to the line number
+    for that pc, or to 0 if no sequence covers it.
+    @param dw_found_count
+    If non-null, on success returns the number of pcs
+    found.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_ERROR if the table is not
+    a valid table.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_line_index_batch(const void *dw_table,
+    Dwarf_Unsigned    dw_table_size,
+    const Dwarf_Addr *dw_pcs,
+    Dwarf_Unsigned    dw_pc_count,
+    const char      **dw_files,
+    Dwarf_Unsigned   *dw_lines,
+    Dwarf_Unsigned   *dw_found_count,
+    Dwarf_Error      *dw_error);
+
+/*! @brief Free a table from dwarf_make_line_index()
+
+    @param dw_table
+    Pass in the table. Passing in NULL is harmless.
+    @since {2.3.0}
+*/
+DW_API void dwarf_dealloc_line_index(void *dw_table);
+
 /*! @brief Return the srclines table offset
 
     The offset is in the relevant .debug_line or .debug_line.dwo
@@ -6736,6 +7387,111 @@ DW_API Dwarf_Half dwarf_set_frame_same_value(
 DW_API Dwarf_Half dwarf_set_frame_undefined_value(
     Dwarf_Debug dw_dbg,
     Dwarf_Half  dw_value);
+/*! @brief Build a flat unwind table for a list of FDEs
+
+    For each FDE, in address order, records every
+    row as the pc where the row starts and a fixed
+    number of rules: the CFA rule, the return address
+    rule, then one rule per register in dw_columns.
+    Consecutive rows with identical rules are merged
+    and rows marking address gaps between FDEs are
+    added, so a lookup is just a binary search.
+
+    The table is one block of memory in host byte
+    order with no pointers in it: it can be written to
+    a file and later read or mapped back in (at an
+    8 byte aligned address) and passed to
+    dwarf_lookup_unwind_table() with no Dwarf_Debug
+    open.
+
+    FDEs overlapping an earlier FDE and FDEs whose
+    instructions cannot be evaluated are left out.
+    Rules that are DWARF expressions are marked
+    DW_UNWIND_EXPRESSION or DW_UNWIND_VAL_EXPRESSION;
+    for those use dwarf_get_fde_at_pc() and the
+    reg3 calls.
+
+    @param dw_fde_data
+    Pass in the FDE array from dwarf_get_fde_list()
+    or dwarf_get_fde_list_eh().
+    @param dw_fde_count
+    Pass in the count of FDEs in the array.
+    @param dw_columns
+    Pass in the register numbers (frame table columns)
+    to record for each row, typically the callee-saved
+    registers of the ABI. Each must be less than
+    the frame register table size
+    (see dwarf_set_frame_rule_table_size()).
+    @param dw_column_count
+    Pass in the number of entries in dw_columns.
+    May be zero.
+    @param dw_table
+    On success returns a pointer to the table.
+    Free it with dwarf_dealloc_unwind_table().
+    @param dw_table_size
+    On success returns the size of the table in bytes.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_make_unwind_table(Dwarf_Fde *dw_fde_data,
+    Dwarf_Signed      dw_fde_count,
+    Dwarf_Half       *dw_columns,
+    Dwarf_Unsigned    dw_column_count,
+    void            **dw_table,
+    Dwarf_Unsigned   *dw_table_size,
+    Dwarf_Error      *dw_error);
+
+/*! @brief Look up a pc in a table from dwarf_make_unwind_table()
+
+    Checks the table header then does a
+    binary search. Nothing is interpreted
+    and nothing is allocated.
+
+    @param dw_table
+    Pass in the table, which must be 8 byte aligned.
+    @param dw_table_size
+    Pass in the size in bytes of the table.
+    @param dw_pc
+    Pass in the pc of interest.
+    @param dw_row_pc
+    On success returns the pc where the row starts.
+    @param dw_next_row_pc
+    On success returns the pc where the next row
+    starts, so the rules apply to pcs up to but not
+    including this one.
+    @param dw_rules
+    On success returns a pointer into the table
+    to the rules of the row: the CFA rule, the return
+    address rule, then the rules for the registers
+    passed to dwarf_make_unwind_table().
+    @param dw_rule_count
+    On success returns the number of rules in the row.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if no FDE covers dw_pc,
+    or DW_DLV_ERROR if the table is not a valid table.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_unwind_table(const void *dw_table,
+    Dwarf_Unsigned       dw_table_size,
+    Dwarf_Addr           dw_pc,
+    Dwarf_Addr          *dw_row_pc,
+    Dwarf_Addr          *dw_next_row_pc,
+    const Dwarf_Unwind_Rule **dw_rules,
+    Dwarf_Unsigned      *dw_rule_count,
+    Dwarf_Error         *dw_error);
+
+/*! @brief Free a table from dwarf_make_unwind_table()
+
+    @param dw_table
+    Pass in the table. Passing in NULL is harmless.
+    @since {2.3.0}
+*/
+DW_API void dwarf_dealloc_unwind_table(void *dw_table);
 /*! @} endgroup frame */
 
 /*! @defgroup abbrev Abbreviations Section Details
@@ -7179,6 +7935,11 @@ DW_API void dwarf_dealloc_error(Dwarf_Debug dw_dbg,
     @param dw_type
     Must be a correct naming of the DW_DLA type.
     If it is not the dealloc will do nothing.
+
+    An individual Dwarf_Line is part of the rows
+    of its line table and is never deallocated by
+    itself: dwarf_dealloc() with DW_DLA_LINE does
+    nothing.  Use dwarf_srclines_dealloc_b().
 */
 DW_API void dwarf_dealloc(Dwarf_Debug dw_dbg,
     void* dw_space, Dwarf_Unsigned dw_type);
@@ -7216,13 +7977,12 @@ DW_API int dwarf_get_debug_sup(Dwarf_Debug dw_dbg,
     The section is new in DWARF5 and supersedes .debug_pubnames
     and .debug_pubtypes in DWARF2, DWARF3, and DWARF4.
 
-    The functions provide a detailed reporting
+    Most of the functions provide a detailed reporting
     of the content and structure of the table (so one
-    can build one's own search table) but they
-    are not particularly helpful for searching.
+    can build one's own search table).
 
-    A new function (more than one?) would be needed for convenient
-    searching.
+    To search a table by name use dwarf_dnames_find_name()
+    or dwarf_dnames_find_names().
 */
 /*! @brief Open access to a .debug_names table
     @param dw_dbg
@@ -7615,6 +8375,114 @@ DW_API int dwarf_dnames_entrypool_values(Dwarf_Dnames_Head dw_dn,
     Dwarf_Unsigned *dw_cu_offset,
     Dwarf_Unsigned *dw_offset_of_next_entrypool,
     Dwarf_Error    *dw_error);
+/*! @brief Find the DIEs a .debug_names table has for a name
+
+    Hashes dw_name, reads just its bucket of the hash
+    table and compares the .debug_str string only for
+    names with a matching hash, then reads the
+    name's entries from the entry pool.
+    Nothing is allocated.
+
+    A .debug_names section may hold more than one
+    table (see dwarf_dnames_header()), so to search
+    the whole section call this for each table.
+
+    The hash folds only the ASCII letters A-Z to
+    lower case, so a name with other upper case
+    letters is not found if the producer folded
+    them too. Tables without a hash table are searched
+    name by name.
+    Entries in foreign type units (in a split DWARF
+    object) are not returned.
+
+    @param dw_dn
+    Pass in the debug names table of interest.
+    @param dw_name
+    Pass in the name to find, as it is in .debug_str.
+    @param dw_array_size
+    Pass in the number of entries in each of the
+    following three arrays. May be zero.
+    @param dw_tags
+    Pass in an array you allocated.
+    On success the first entries are set to the TAG
+    of each DIE found.
+    @param dw_unit_offsets
+    Pass in an array you allocated.
+    On success the first entries are set to the
+    .debug_info offset of the header of the CU or TU
+    of each DIE.
+    @param dw_die_offsets
+    Pass in an array you allocated.
+    On success the first entries are set to the
+    .debug_info offset of each DIE, as
+    dwarf_offdie_b() takes.
+    @param dw_entry_count
+    On success returns the number of DIEs found.
+    If larger than dw_array_size only the first
+    dw_array_size are in the arrays.
+    @param dw_error
+    The usual error detail record
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the table has
+    no DIEs for dw_name, or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_dnames_find_name(Dwarf_Dnames_Head dw_dn,
+    const char     *dw_name,
+    Dwarf_Unsigned  dw_array_size,
+    Dwarf_Half     *dw_tags,
+    Dwarf_Unsigned *dw_unit_offsets,
+    Dwarf_Unsigned *dw_die_offsets,
+    Dwarf_Unsigned *dw_entry_count,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Find the DIEs a .debug_names table has for many names
+
+    As dwarf_dnames_find_name() for each of dw_names,
+    with all the DIEs found returned in one set
+    of arrays.
+
+    @param dw_dn
+    Pass in the debug names table of interest.
+    @param dw_names
+    Pass in the names to find.
+    NULL entries are allowed and find nothing.
+    @param dw_name_count
+    Pass in the number of names.
+    @param dw_first_entry
+    Pass in an array of dw_name_count+1 entries.
+    On success the DIEs for dw_names[i] are entries
+    dw_first_entry[i] up to (not including)
+    dw_first_entry[i+1] of the other arrays, and
+    dw_first_entry[dw_name_count] is the number of DIEs
+    found for all the names.
+    If that is larger than dw_array_size the DIEs
+    past dw_array_size are not in the arrays.
+    @param dw_array_size
+    Pass in the number of entries in each of the
+    following three arrays. May be zero.
+    @param dw_tags
+    On success the TAGs of the DIEs found.
+    @param dw_unit_offsets
+    On success the .debug_info offsets of the
+    CU or TU headers of the DIEs found.
+    @param dw_die_offsets
+    On success the .debug_info offsets of the DIEs found.
+    @param dw_error
+    The usual error detail record
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_dnames_find_names(Dwarf_Dnames_Head dw_dn,
+    const char    **dw_names,
+    Dwarf_Unsigned  dw_name_count,
+    Dwarf_Unsigned *dw_first_entry,
+    Dwarf_Unsigned  dw_array_size,
+    Dwarf_Half     *dw_tags,
+    Dwarf_Unsigned *dw_unit_offsets,
+    Dwarf_Unsigned *dw_die_offsets,
+    Dwarf_Error    *dw_error);
 
 /*! @} endgroup debugnames */
 
@@ -7736,6 +8604,111 @@ DW_API int dwarf_get_arange_info_b(Dwarf_Arange dw_arange,
     Dwarf_Unsigned*  dw_length,
     Dwarf_Off     *  dw_cu_die_offset,
     Dwarf_Error   *  dw_error );
+
+/*! @brief Build a sorted address index from aranges
+
+    dwarf_get_arange() looks at each arange in turn.
+    For many lookups build this index once and
+    use dwarf_lookup_arange_index() or
+    dwarf_lookup_arange_index_batch(), which
+    do a binary search or a merge.
+
+    Where aranges overlap the index answers with
+    the arange earliest in dw_aranges, as
+    dwarf_get_arange() does.
+
+    The index refers to the Dwarf_Arange entries
+    so dealloc the index before them.
+
+    @param dw_aranges
+    Pass in a pointer to the first entry in the aranges array
+    of pointers, as from dwarf_get_aranges().
+    @param dw_arange_count
+    Pass in the count for the array.
+    @param dw_index
+    On success returns the new index.
+    Free it with dwarf_dealloc_arange_index().
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_make_arange_index(Dwarf_Arange* dw_aranges,
+    Dwarf_Signed         dw_arange_count,
+    Dwarf_Arange_Index * dw_index,
+    Dwarf_Error*         dw_error);
+
+/*! @brief Find a range given a code address, using an index
+
+    The same result as dwarf_get_arange()
+    but by binary search.
+
+    @param dw_index
+    Pass in the index from dwarf_make_arange_index().
+    @param dw_address
+    Pass in the code address of interest.
+    @param dw_returned_arange
+    On success, returns the particular arange that
+    holds that address.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    The usual value: DW_DLV_OK etc.
+    Returns DW_DLV_NO_ENTRY if there is no such code
+    address present in the index.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_arange_index(Dwarf_Arange_Index dw_index,
+    Dwarf_Addr       dw_address,
+    Dwarf_Arange *   dw_returned_arange,
+    Dwarf_Error*     dw_error);
+
+/*! @brief Find the ranges for an array of code addresses
+
+    Looks up every address of dw_addresses.
+    With the addresses in increasing order this is
+    a single pass over the addresses and the index.
+    Unsorted addresses are allowed but slower.
+
+    @param dw_index
+    Pass in the index from dwarf_make_arange_index().
+    @param dw_addresses
+    Pass in the code addresses of interest.
+    @param dw_address_count
+    Pass in the count of dw_addresses.
+    @param dw_returned_aranges
+    Pass in an array of dw_address_count entries.
+    On success entry i is the arange holding
+    address i, or NULL if no arange holds it.
+    @param dw_found_count
+    If non-null, on success returns the count
+    of addresses found.
+    @param dw_error
+    On error dw_error is set to point to the error details.
+    @return
+    DW_DLV_OK or DW_DLV_ERROR.
+    @since {2.3.0}
+*/
+DW_API int dwarf_lookup_arange_index_batch(
+    Dwarf_Arange_Index dw_index,
+    Dwarf_Addr     * dw_addresses,
+    Dwarf_Unsigned   dw_address_count,
+    Dwarf_Arange   * dw_returned_aranges,
+    Dwarf_Unsigned * dw_found_count,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Free an arange index
+
+    @param dw_index
+    The index from dwarf_make_arange_index().
+    Callers should zero the pointer passed in
+    as soon as possible after this returns
+    as the pointer is then stale.
+    @since {2.3.0}
+*/
+DW_API void dwarf_dealloc_arange_index(
+    Dwarf_Arange_Index dw_index);
 /*! @} endgroup aranges */
 
 /*! @defgroup pubnames Fast Access to .debug_pubnames and more.
@@ -8157,8 +9130,10 @@ DW_API int dwarf_get_gnu_index_block_entry(
     cannot be read correctly by the functions here.
 
     The functions here make it possible to
-    print the section content in detail, there
-    is no search function here.
+    print the section content in detail.
+    dwarf_gdbindex_lookup() finds a symbol by name
+    and dwarf_gdbindex_addressarea_lookup() finds
+    the CU for an address.
 
 */
 /*! @brief Open access to the .gdb_index section.
@@ -8486,6 +9461,71 @@ DW_API int dwarf_gdbindex_string_by_offset(
     Dwarf_Unsigned   dw_stringoffset,
     const char    ** dw_string_ptr,
     Dwarf_Error   *  dw_error);
+/*! @brief Look up a symbol name in the symbol table
+
+    Hashes dw_name and probes the symbol table the way
+    gdb does, comparing only the names on its probe
+    sequence. Nothing is allocated.
+
+    As in gdb the hash folds ASCII letters to lower
+    case but the names must match exactly.
+
+    @param dw_gdbindexptr
+    Pass in the Dwarf_Gdbindex pointer of interest.
+    @param dw_name
+    Pass in the symbol name.
+    @param dw_symtab_index
+    If non-null, on success returns the symbol table
+    index, as dwarf_gdbindex_symboltable_entry() takes.
+    @param dw_cu_vector_offset
+    If non-null, on success returns the CU vector
+    offset for dwarf_gdbindex_cuvector_length() and
+    dwarf_gdbindex_cuvector_inner_attributes().
+    @param dw_error
+    The usual pointer to return error details.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY if
+    the name is not in the table.
+    @since {2.3.0}
+*/
+DW_API int dwarf_gdbindex_lookup(
+    Dwarf_Gdbindex   dw_gdbindexptr,
+    const char     * dw_name,
+    Dwarf_Unsigned * dw_symtab_index,
+    Dwarf_Unsigned * dw_cu_vector_offset,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Find the address area entry covering a pc
+
+    Does a binary search of the address area,
+    which gdb writes in address order.
+    If the area turns out not to be in order
+    (checked once per Dwarf_Gdbindex)
+    each entry is checked in turn instead.
+
+    @param dw_gdbindexptr
+    Pass in the Dwarf_Gdbindex pointer of interest.
+    @param dw_pc
+    Pass in the address of interest.
+    @param dw_entryindex
+    If non-null, on success returns the address area
+    index, as dwarf_gdbindex_addressarea_entry() takes.
+    @param dw_cu_index
+    If non-null, on success returns the index of the CU,
+    as dwarf_gdbindex_culist_entry() takes.
+    @param dw_error
+    The usual pointer to return error details.
+    @return
+    Returns DW_DLV_OK etc. Returns DW_DLV_NO_ENTRY if
+    no entry covers dw_pc.
+    @since {2.3.0}
+*/
+DW_API int dwarf_gdbindex_addressarea_lookup(
+    Dwarf_Gdbindex   dw_gdbindexptr,
+    Dwarf_Addr       dw_pc,
+    Dwarf_Unsigned * dw_entryindex,
+    Dwarf_Unsigned * dw_cu_index,
+    Dwarf_Error    * dw_error);
 /*! @} endgroup gdbindex */
 
 /*! @defgroup splitdwarf Fast Access to Split Dwarf (Debug Fission)
@@ -10059,6 +11099,73 @@ DW_API void dwarf_record_cmdline_options(
 */
 DW_API int dwarf_set_de_alloc_flag(int dw_v);
 
+/*!  @brief Carve fixed-size records from per-type slabs
+
+    Independent of any Dwarf_Debug, this sets a
+    global flag in libdwarf that applies to each
+    Dwarf_Debug created by a later dwarf_init*() call.
+    Defaults to zero.
+
+    When non-zero, records of a fixed size
+    (Dwarf_Die, Dwarf_Attribute, Dwarf_Line,
+    CU contexts, and the like) are taken from large
+    per-type slabs rather than one malloc() each,
+    and are not entered in the allocation tracking
+    tree (see dwarf_set_de_alloc_flag()).
+    dwarf_dealloc() of such a record makes it
+    available for reuse and dwarf_finish() frees all
+    the slabs at once whether or not the records
+    were dealloc-ed.
+    Large objects with many DIEs are read noticeably
+    faster this way.
+
+    @param dw_v
+    If non-zero passed in the Dwarf_Debug created by
+    the next dwarf_init*() will use slabs.
+    If zero passed in they will not.
+    @return
+    Returns the previous version of the flag.
+*/
+DW_API int dwarf_set_de_alloc_arena_flag(int dw_v);
+
+/*!  @brief Retrieve allocation counts for one DW_DLA type
+
+    Counts are kept for every Dwarf_Debug whether
+    or not dwarf_set_de_alloc_arena_flag() was used.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_alloc_type
+    One of the DW_DLA values, for example DW_DLA_DIE.
+    @param dw_live_count
+    On success returns the number of records of the type
+    allocated and not yet dealloc-ed.
+    If null passed in the argument is ignored.
+    @param dw_total_count
+    On success returns the number of records of the type
+    allocated since the Dwarf_Debug was created.
+    If null passed in the argument is ignored.
+    @param dw_total_bytes
+    On success returns the total bytes of all those
+    records (not counting libdwarf overhead).
+    If null passed in the argument is ignored.
+    @param dw_arena_bytes
+    On success returns the bytes in slabs for the type.
+    Always zero unless the arena is in use.
+    If null passed in the argument is ignored.
+    @return
+    Returns DW_DLV_OK on success.
+    Returns DW_DLV_NO_ENTRY if dw_alloc_type is not a
+    valid DW_DLA value or no counts are available.
+    Returns DW_DLV_ERROR if dw_dbg is NULL or invalid.
+*/
+DW_API int dwarf_get_alloc_type_counts(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned  dw_alloc_type,
+    Dwarf_Unsigned *dw_live_count,
+    Dwarf_Unsigned *dw_total_count,
+    Dwarf_Unsigned *dw_total_bytes,
+    Dwarf_Unsigned *dw_arena_bytes);
+
 /*!  @brief Eliminate libdwarf checking attribute duplication
 
     Independent of any Dwarf_Debug, this is sets a
@@ -10213,6 +11320,9 @@ DW_API int dwarf_object_detector_fd(int dw_fd,
     is preferred.
     If the value is 'mmap' then use of mmap is
     preferred (Example: 'export DWARF_WHICH_ALLOC=mmap').
+    If the value is 'mmap-whole' then mapping the
+    entire object is preferred (this applies to Elf,
+    Mach-O, and PE objects).
     Otherwise, the environment value is checked and ignored.
 
     If present and valid this environment variable
@@ -10235,9 +11345,31 @@ DW_API int dwarf_object_detector_fd(int dw_fd,
 
     In 0.12.0 mmap() is only usable on Elf object files.
 
+    The preference Dwarf_Alloc_Mmap_Whole maps the
+    entire object file (for a Mach-O universal binary,
+    the entire selected inner object) with a single
+    mmap() the first time a section is loaded.
+    Uncompressed sections are then pointers into
+    that mapping, no section data is copied, and the
+    kernel is advised as each section is first used
+    so pages are read ahead only for sections
+    actually referenced.
+    The mapping is private and writable
+    so relocations in Elf relocatable objects
+    do not alter the file.
+    Compressed sections are still decompressed into
+    malloc space, and a PE section whose trailing
+    zeros are not in the file is still read into
+    malloc space.
+    dwarf_get_mmap_count() counts sections in the
+    whole-object mapping as mmap sections.
+    If the mmap() fails sections are loaded
+    with malloc and read.
+
     dw_load_preference is one of
     Dwarf_Alloc_Malloc      (1)
     Dwarf_Alloc_Mmap        (2)
+    Dwarf_Alloc_Mmap_Whole  (3)
 
     Must be called before calling a dwarf_init*()
     to be effective in a  dwarf_init*().
@@ -10305,6 +11437,144 @@ DW_API int dwarf_get_mmap_count(Dwarf_Debug dw_dbg,
     Dwarf_Unsigned *dw_mmap_size,
     Dwarf_Unsigned *dw_malloc_count,
     Dwarf_Unsigned *dw_malloc_size);
+/*! @brief Set the decompressed-section cache budget
+
+    @since {2.3.0}
+
+    Compressed (SHF_COMPRESSED or .zdebug) sections
+    are normally decompressed into memory belonging
+    to the Dwarf_Debug and freed by dwarf_finish().
+    With a non-zero budget, decompressed section
+    contents are instead kept in a cache shared by
+    all Dwarf_Debug in the process, keyed by the
+    compressed bytes.  Each cached section keeps a
+    copy of its compressed bytes, and is used only
+    when those match exactly.  Opening an object whose
+    compressed section is already in the cache
+    (the same object opened again, typically)
+    uses the cached contents without decompressing.
+
+    While a Dwarf_Debug uses a cached section that
+    section is never evicted.  Unused sections are
+    evicted least recently used first whenever the
+    total cached exceeds dw_max_bytes, so the total
+    may exceed the budget only by what open
+    Dwarf_Debug are using.  A section larger than
+    the budget is never cached.
+    Sections with relocations to apply
+    (relocatable objects) are never cached.
+
+    The cache is global and, like other global
+    settings in libdwarf, is not protected by any
+    lock: do not use it with Dwarf_Debug instances
+    open in different threads at the same time.
+
+    The default budget is zero, which disables
+    the cache.
+    Setting a budget of zero also frees every
+    cached section not in use (do that before exit
+    to keep memory checkers quiet).
+
+    @param dw_max_bytes
+    The maximum number of bytes to retain, counting
+    both the decompressed data and the copy of the
+    compressed bytes of each section.
+    @return
+    Returns the previous budget.
+*/
+DW_API Dwarf_Unsigned dwarf_set_decompressed_section_cache_size(
+    Dwarf_Unsigned dw_max_bytes);
+
+/*! @brief Retrieve decompressed-section cache statistics
+
+    @since {2.3.0}
+
+    Any argument passed as NULL is ignored.
+
+    @param dw_bytes_cached
+    On return the total bytes of the sections in
+    the cache, in use or not, counted as for
+    dwarf_set_decompressed_section_cache_size().
+    @param dw_entry_count
+    On return the number of sections in the cache.
+    @param dw_hits
+    On return the number of section loads that
+    found their contents in the cache.
+    @param dw_misses
+    On return the number of section loads that
+    had to decompress while the cache was enabled.
+    @param dw_evictions
+    On return the number of sections evicted.
+*/
+DW_API void dwarf_get_decompressed_section_cache_stats(
+    Dwarf_Unsigned *dw_bytes_cached,
+    Dwarf_Unsigned *dw_entry_count,
+    Dwarf_Unsigned *dw_hits,
+    Dwarf_Unsigned *dw_misses,
+    Dwarf_Unsigned *dw_evictions);
+
+/*! @defgroup preloadflags Section preload selection
+    Bits for dw_which in dwarf_preload_sections().
+    @{
+*/
+/*! .debug_info and .debug_types */
+#define DW_PRELOAD_INFO      0x01
+/*! .debug_abbrev */
+#define DW_PRELOAD_ABBREV    0x02
+/*! .debug_line */
+#define DW_PRELOAD_LINE      0x04
+/*! .debug_str, .debug_line_str and .debug_str_offsets */
+#define DW_PRELOAD_STR       0x08
+/*! .debug_rnglists */
+#define DW_PRELOAD_RNGLISTS  0x10
+/*! .debug_loclists */
+#define DW_PRELOAD_LOCLISTS  0x20
+/*! All of the above */
+#define DW_PRELOAD_ALL       0x3f
+/*! @} */
+
+/*! @brief Load (and decompress) sections ahead of use
+
+    @since {2.3.0}
+
+    libdwarf normally loads each section the first
+    time it is needed. For objects with compressed
+    DWARF sections that means decompressing them one
+    after another.  This loads the selected sections
+    now, running the decompression of compressed
+    sections on up to dw_thread_count threads.
+    Reading the object file, relocation and all
+    error reporting are done on the calling thread.
+
+    If libdwarf was built without threads support
+    (or without zlib and zstd) the sections are
+    simply loaded one at a time.
+    Sections that are absent or already loaded
+    are skipped.
+
+    On error, any selected compressed section
+    not fully loaded is left unloaded, so a later
+    use of it tries again (and reports its error
+    then).
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_which
+    An OR of DW_PRELOAD_* values.
+    @param dw_thread_count
+    The maximum number of threads to decompress with,
+    including the caller.  Zero means one thread
+    per compressed section.  The count is capped
+    at 16.
+    @param dw_error
+    The usual error pointer.
+    @return
+    Returns DW_DLV_OK or DW_DLV_ERROR.
+*/
+DW_API int dwarf_preload_sections(Dwarf_Debug dw_dbg,
+    unsigned int dw_which,
+    unsigned int dw_thread_count,
+    Dwarf_Error *dw_error);
 /*! @} endgroup sectionallocpref */
 
 #ifdef __cplusplus
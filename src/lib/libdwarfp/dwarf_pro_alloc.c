@@ -182,5 +182,8 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
         _dwarf_str_hashtab_freenode);
     dwarf_tdestroy(dbg->de_debug_line_str_hashtab,
         _dwarf_str_hashtab_freenode);
+    /*  The abbrevs themselves were freed with
+        the rest of the dbg memory above. */
+    dwarf_tdestroy(dbg->de_abbrev_hashtab,0);
     free((void *)base_dbglp);
 }
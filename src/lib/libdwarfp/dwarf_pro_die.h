@@ -45,6 +45,16 @@ struct Dwarf_P_Abbrev_s {
     Dwarf_Signed *abb_implicits;
     int abb_n_attr;           /* num of attrs = # of forms */
     Dwarf_P_Abbrev abb_next;
+
+    /*  Hash of tag, children and the attr/form list,
+        for de_abbrev_hashtab. */
+    Dwarf_Unsigned abb_hash;
+    /*  Non-zero only in a search key made from a die.
+        Then abb_probe_attrs is the die's sorted attribute
+        list, used in place of abb_attrs/abb_forms/
+        abb_implicits. */
+    Dwarf_Ubyte abb_is_probe;
+    Dwarf_P_Attribute abb_probe_attrs;
 };
 
 /* used in pro_section.c */
@@ -138,6 +138,16 @@ static struct Dwarf_P_Section_Data_s init_sect_debug_line_str = {
     MAGIC_SECT_NO, 0, 0, 0, 0
 };
 
+/*  Points the section chunk list at init_sect, as it is
+    before any section data exists. Streaming also uses
+    this once it has written and freed every chunk. */
+void
+_dwarf_pro_reset_sect_list(Dwarf_P_Debug dbg)
+{
+    dbg->de_debug_sects = &init_sect;
+    dbg->de_current_active_section = &init_sect;
+}
+
 /*  New April 2014.
     Replaces all previous producer init functions.
     It adds a string to select the relevant ABI/ISA and
@@ -215,6 +225,21 @@ dwarf_pro_set_default_string_form(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+int
+dwarf_pro_set_section_write_callback(Dwarf_P_Debug dbg,
+    Dwarf_Section_Write_Func func,
+    void *user_data,
+    Dwarf_Error * error)
+{
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        _dwarf_p_error(dbg, error, DW_DLE_IA);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_section_write_func = func;
+    dbg->de_section_write_data = user_data;
+    return DW_DLV_OK;
+}
+
 static int
 set_reloc_numbers(Dwarf_P_Debug dbg,
     Dwarf_Unsigned flags,
@@ -303,10 +328,9 @@ common_init(Dwarf_P_Debug dbg,
 
     dbg->de_version_magic_number = PRO_VERSION_MAGIC;
     dbg->de_n_debug_sect = 0;
-    dbg->de_debug_sects = &init_sect;
+    _dwarf_pro_reset_sect_list(dbg);
     dbg->de_debug_str = &init_sect_debug_str;
     dbg->de_debug_line_str = &init_sect_debug_line_str;
-    dbg->de_current_active_section = &init_sect;
     dbg->de_flags = flags;
 
     /* DW_DLC_POINTER32 assumed. */
@@ -436,12 +436,28 @@ struct Dwarf_P_Debug_s {
     Dwarf_P_Section_Data de_debug_line_str;
     void *de_debug_line_str_hashtab; /* for tsearch */
 
+    /*  The abbreviations made so far by
+        _dwarf_pro_generate_debuginfo(), for tsearch. */
+    void *de_abbrev_hashtab;
+
     /*  Pointer to the 'current active' section */
     Dwarf_P_Section_Data de_current_active_section;
 
     /*  Number of debug data streams globs. */
     Dwarf_Unsigned de_n_debug_sect;
 
+    /*  Streaming output. When de_section_write_func is set
+        the chunks are handed to it and freed as each
+        section is finished, see
+        dwarf_pro_set_section_write_callback().
+        de_stream_nbufs is de_n_debug_sect as of the last
+        hand-off and de_stream_debug_info_size the .debug_info
+        bytes already handed off. */
+    Dwarf_Section_Write_Func de_section_write_func;
+    void *de_section_write_data;
+    Dwarf_Unsigned de_stream_nbufs;
+    Dwarf_Unsigned de_stream_debug_info_size;
+
     /*  File entry information, null terminated singly-linked list */
     Dwarf_P_F_Entry de_file_entries;
     Dwarf_P_F_Entry de_last_file_entry;
@@ -35,6 +35,10 @@
 #include <stdlib.h> /* free() malloc() qsort() */
 #include <string.h> /* memcpy() strcmp() strcpy() strlen() */
 
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t, for DW_TSHASHTYPE */
+#endif
+
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dwarf_base_types.h"
@@ -51,6 +55,7 @@
 #include "dwarf_pro_macinfo.h"
 #include "dwarf_pro_types.h"
 #include "dwarf_pro_dnames.h"
+#include "dwarf_tsearch.h"
 
 struct Dwarf_Sort_Abbrev_s {
     Dwarf_Unsigned dsa_attr;
@@ -305,6 +310,55 @@ dwarf_need_debug_names_section(Dwarf_P_Debug dbg)
     return dbg->de_force_dnames;
 }
 
+/*  When streaming, hand every chunk made since the last
+    call to the caller's write function, in order, and
+    free it. Only call this where no earlier chunk
+    will be written to again.
+    Does nothing if not streaming. */
+static int
+stream_out_sections(Dwarf_P_Debug dbg, Dwarf_Error *error)
+{
+    Dwarf_P_Section_Data cursect = 0;
+
+    if (!dbg->de_section_write_func) {
+        return DW_DLV_OK;
+    }
+    if (dbg->de_current_active_section->ds_elf_sect_no ==
+        MAGIC_SECT_NO) {
+        /* Nothing pending. */
+        return DW_DLV_OK;
+    }
+    cursect = dbg->de_first_debug_sect;
+    while (cursect) {
+        Dwarf_P_Section_Data next = cursect->ds_next;
+        int res = 0;
+
+        if (cursect->ds_elf_sect_no ==
+            dbg->de_elf_sects[DEBUG_INFO]) {
+            dbg->de_stream_debug_info_size += cursect->ds_nbytes;
+        }
+        res = dbg->de_section_write_func(
+            (Dwarf_Unsigned)cursect->ds_elf_sect_no,
+            (Dwarf_Ptr)cursect->ds_data,
+            (Dwarf_Unsigned)cursect->ds_nbytes,
+            dbg->de_section_write_data);
+        if (res != DW_DLV_OK) {
+            /*  Leave what was not written on the list,
+                so it is freed with the dbg. */
+            dbg->de_first_debug_sect = cursect;
+            dbg->de_debug_sects = cursect;
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_SECTION_WRITE_ERR,
+                DW_DLV_ERROR);
+        }
+        _dwarf_p_dealloc((Dwarf_Small *)cursect);
+        cursect = next;
+    }
+    dbg->de_first_debug_sect = 0;
+    _dwarf_pro_reset_sect_list(dbg);
+    dbg->de_stream_nbufs = dbg->de_n_debug_sect;
+    return DW_DLV_OK;
+}
+
 /*  Convert debug information to  a format such that
     it can be written on disk.
     Called exactly once per execution.
@@ -319,7 +373,9 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         count of buffers for
         all the sections.
         dwarf_get_section_bytes() returns pointers to these
-        buffers one at a time. */
+        buffers one at a time, or, with a section write
+        function set, stream_out_sections() hands them
+        off as each generator finishes. */
     Dwarf_Unsigned nbufs = 0;
     int sect = 0;
     int err = 0;
@@ -488,6 +544,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 
     if (dwarf_need_debug_line_section(dbg) == TRUE) {
@@ -495,6 +555,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 
     if (dbg->de_frame_cies) {
@@ -502,6 +566,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
     if (dbg->de_first_macinfo) {
         /* For DWARF 2,3,4 only */
@@ -511,6 +579,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 
     if (dbg->de_dies) {
@@ -518,6 +590,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 
     if (dbg->de_debug_str->ds_data) {
@@ -525,6 +601,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
     if (dbg->de_debug_line_str->ds_data) {
         int res = _dwarf_pro_generate_debug_line_str(dbg,&nbufs,
@@ -532,6 +612,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 
     if (dbg->de_arange) {
@@ -539,6 +623,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
     if (dbg->de_output_version < 5) {
         if (dbg->de_simple_name_headers[dwarf_snk_pubname].sn_head) {
@@ -550,6 +638,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
         if (dbg->de_simple_name_headers[dwarf_snk_pubtype].sn_head) {
             int res = _dwarf_transform_simplename_to_disk(dbg,
@@ -560,6 +652,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
 
         if (dbg->de_simple_name_headers[dwarf_snk_funcname].sn_head) {
@@ -571,6 +667,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
 
         if (dbg->de_simple_name_headers[dwarf_snk_typename].sn_head) {
@@ -582,6 +682,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
 
         if (dbg->de_simple_name_headers[dwarf_snk_varname].sn_head) {
@@ -593,6 +697,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
 
         if (dbg->de_simple_name_headers[dwarf_snk_weakname].sn_head) {
@@ -603,6 +711,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             if (res == DW_DLV_ERROR) {
                 return res;
             }
+            res = stream_out_sections(dbg,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
         }
     }
     if (dwarf_need_debug_names_section(dbg) == TRUE) {
@@ -611,6 +723,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         if (res == DW_DLV_ERROR) {
             return res;
         }
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
     }
 #if 0  /* FIXME: TODO new sections */
     if (dwarf_need_debug_macro_section(dbg) == TRUE) {
@@ -645,6 +761,16 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DW_DLV_ERROR);
         }
         nbufs += new_chunks;
+        res = stream_out_sections(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    if (dbg->de_section_write_func) {
+        /*  Everything went out through the write function,
+            there is nothing left for
+            dwarf_get_section_bytes_a(). */
+        nbufs = 0;
     }
     *count = nbufs;
     return DW_DLV_OK;
@@ -2582,11 +2708,83 @@ abcompare(const void *l_in, const void *r_in)
     return 0;
 }
 
-/*  Handles abbreviations. It takes a die, searches through
-    current list of abbreviations for a matching one. If it
-    finds one, it returns a pointer to the abbrev through
+/*  FNV-1a style mixing of one value into an abbrev hash. */
+static Dwarf_Unsigned
+abbrev_hash_add(Dwarf_Unsigned h, Dwarf_Unsigned v)
+{
+    h ^= v;
+    h *= 0x100000001b3ULL;
+    return h;
+}
+
+/*  The hash of the tag, children flag and sorted
+    attr/form (and implicit_const value) list a die needs. */
+static Dwarf_Unsigned
+abbrev_hash_of_die(Dwarf_P_Die die)
+{
+    Dwarf_Unsigned h = 0xcbf29ce484222325ULL;
+    Dwarf_P_Attribute curattr = die->di_attrs;
+
+    h = abbrev_hash_add(h,die->di_tag);
+    h = abbrev_hash_add(h,die->di_child? DW_CHILDREN_yes:
+        DW_CHILDREN_no);
+    for ( ; curattr; curattr = curattr->ar_next) {
+        h = abbrev_hash_add(h,curattr->ar_attribute);
+        h = abbrev_hash_add(h,curattr->ar_attribute_form);
+        if (curattr->ar_attribute_form == DW_FORM_implicit_const) {
+            h = abbrev_hash_add(h,
+                (Dwarf_Unsigned)curattr->ar_implicit_const);
+        }
+    }
+    return h;
+}
+
+static DW_TSHASHTYPE
+abbrev_hashfunc(const void *keyp)
+{
+    const struct Dwarf_P_Abbrev_s *ab =
+        (const struct Dwarf_P_Abbrev_s *)keyp;
+
+    return (DW_TSHASHTYPE)ab->abb_hash;
+}
+
+/*  For tsearch, which only needs to know equal or not.
+    The abbrevs in the table are all different, so
+    a real match is always a search key made
+    from a die (abb_is_probe set) against
+    a table entry. */
+static int
+abbrev_compare(const void *l_in, const void *r_in)
+{
+    Dwarf_P_Abbrev l = (Dwarf_P_Abbrev)l_in;
+    Dwarf_P_Abbrev r = (Dwarf_P_Abbrev)r_in;
+
+    if (l == r) {
+        return 0;
+    }
+    if (l->abb_hash != r->abb_hash ||
+        l->abb_tag != r->abb_tag ||
+        l->abb_children != r->abb_children ||
+        l->abb_n_attr != r->abb_n_attr) {
+        return 1;
+    }
+    if (l->abb_is_probe) {
+        return !_dwarf_pro_match_attr(l->abb_probe_attrs,
+            r,r->abb_n_attr);
+    }
+    if (r->abb_is_probe) {
+        return !_dwarf_pro_match_attr(r->abb_probe_attrs,
+            l,l->abb_n_attr);
+    }
+    return 1;
+}
+
+/*  Handles abbreviations. It takes a die, looks up
+    dbg->de_abbrev_hashtab for a matching abbreviation.
+    If it finds one, it returns a pointer to the abbrev through
     the ab_out pointer, and if it does not,
-    it returns a new abbrev through the ab_out pointer.
+    it returns a new abbrev through the ab_out pointer
+    and adds the new abbrev to the hash table.
 
     The die->die_attrs are sorted by attribute and the curabbrev
     attrs are too.
@@ -2596,44 +2794,34 @@ abcompare(const void *l_in, const void *r_in)
     abb_idx has 0. */
 static int
 _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
-    Dwarf_P_Die die, Dwarf_P_Abbrev head,
+    Dwarf_P_Die die,
     Dwarf_P_Abbrev*ab_out,Dwarf_Error *error)
 {
     Dwarf_P_Abbrev curabbrev = 0;
     Dwarf_P_Attribute curattr = 0;
-    int match = 0;
     Dwarf_Unsigned *forms = 0;
     Dwarf_Unsigned *attrs = 0;
     Dwarf_Signed *implicits = 0;
     int attrcount = die->di_n_attr;
-
-    curabbrev = head;
-    /*  Loop thru the currently known abbreviations needed
-        to see if we can share an existing abbrev.  */
-    while (curabbrev) {
-        if ((die->di_tag == curabbrev->abb_tag) &&
-            ((die->di_child != NULL &&
-            curabbrev->abb_children == DW_CHILDREN_yes) ||
-            (die->di_child == NULL &&
-            curabbrev->abb_children == DW_CHILDREN_no)) &&
-            (attrcount == curabbrev->abb_n_attr)) {
-
-            /*  There is a chance of a match, basic
-                characterists match. Now Check the attrs and
-                forms. */
-            curattr = die->di_attrs;
-            match = _dwarf_pro_match_attr(curattr,
-                curabbrev,
-                (int) curabbrev->abb_n_attr);
-            if (match == 1) {
-                /*  This tag/children/abbrev-list matches
-                    the incoming die needs exactly. Reuse
-                    this abbreviation. */
-                *ab_out = curabbrev;
-                return DW_DLV_OK;
-            }
-        }
-        curabbrev = curabbrev->abb_next;
+    struct Dwarf_P_Abbrev_s probe;
+    void *retval = 0;
+
+    memset(&probe,0,sizeof(probe));
+    probe.abb_tag = die->di_tag;
+    probe.abb_children = die->di_child? DW_CHILDREN_yes:
+        DW_CHILDREN_no;
+    probe.abb_n_attr = attrcount;
+    probe.abb_hash = abbrev_hash_of_die(die);
+    probe.abb_is_probe = 1;
+    probe.abb_probe_attrs = die->di_attrs;
+    retval = dwarf_tfind(&probe,
+        (void *const*)&dbg->de_abbrev_hashtab,abbrev_compare);
+    if (retval) {
+        /*  This tag/children/abbrev-list matches
+            the incoming die needs exactly. Reuse
+            this abbreviation. */
+        *ab_out = *(Dwarf_P_Abbrev *)retval;
+        return DW_DLV_OK;
     }
     /* no match, create new abbreviation */
     if (attrcount) {
@@ -2715,6 +2903,14 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
     curabbrev->abb_n_attr = attrcount;
     curabbrev->abb_idx = 0;
     curabbrev->abb_next = NULL;
+    curabbrev->abb_hash = probe.abb_hash;
+    curabbrev->abb_is_probe = 0;
+    curabbrev->abb_probe_attrs = 0;
+    retval = dwarf_tsearch(curabbrev,
+        &dbg->de_abbrev_hashtab,abbrev_compare);
+    if (!retval) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+    }
     *ab_out = curabbrev;
     return DW_DLV_OK;
 }
@@ -3183,6 +3379,12 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     /*  Pass 1: create abbrev info, get die offsets,
         calc relocations */
     abbrev_head = abbrev_tail = NULL;
+    dwarf_tdestroy(dbg->de_abbrev_hashtab,0);
+    dbg->de_abbrev_hashtab = 0;
+    if (!dwarf_initialize_search_hash(&dbg->de_abbrev_hashtab,
+        abbrev_hashfunc,0)) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+    }
     marker_count = 0;
     string_attr_count = 0;
     while (curdie != NULL) {
@@ -3205,7 +3407,7 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         /*  Find or create a final abbrev record for the
             debug_abbrev section we will write (below). */
         cres  = _dwarf_pro_getabbrev(dbg,curdie,
-            abbrev_head,&curabbrev,error);
+            &curabbrev,error);
         if (cres != DW_DLV_OK) {
             return cres;
         }
@@ -3333,6 +3535,15 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
     }
 
+    /*  Write out debug_info size, now that we know it
+        from Pass 1. This is back-patching the CU header we
+        created above. Doing it before Pass 2 means no
+        earlier .debug_info chunk is touched again, so
+        streaming output can hand chunks off during Pass 2. */
+    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
+    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
+        (const void *) &du, sizeof(du), offset_size);
+
     /*  Pass 2: Write out the die information Here 'data' is a
         temporary, one block for each GET_CHUNK.
         'data' is overused. */
@@ -3482,15 +3693,16 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
             if (curdie != NULL)
                 curdie = curdie->di_right;
         }
+        if (dbg->de_section_write_func &&
+            (dbg->de_n_debug_sect - dbg->de_stream_nbufs) >=
+            STREAM_CHUNKS) {
+            res = stream_out_sections(dbg,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
     } /* end while (curdir != NULL) */
 
-    /*  Write out debug_info size, now that we know it
-        This is back-patching the CU header we created
-        above. */
-    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
-    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
-        (const void *) &du, sizeof(du), offset_size);
-
     data = 0;                   /* Emphasize not usable now */
 
     res = write_out_debug_abbrev(dbg,
@@ -55,6 +55,10 @@ struct Dwarf_P_Section_Data_s {
 */
 #define MAGIC_SECT_NO -3
 
+/*  Sets the chunk list back to that dummy head,
+    as after dwarf_producer_init(). */
+void _dwarf_pro_reset_sect_list(Dwarf_P_Debug dbg);
+
 /* Size of chunk of data allocated in one alloc
    Not clear if this is the best size.
    Used to be just 4096 for user data, the section data struct
@@ -62,6 +66,11 @@ struct Dwarf_P_Section_Data_s {
 */
 #define CHUNK_SIZE (4096 - sizeof (struct Dwarf_P_Section_Data_s))
 
+/*  When streaming, .debug_info chunks are handed to the
+    caller's write function once about this many are
+    pending, rather than all at the end. About a megabyte. */
+#define STREAM_CHUNKS 256
+
 /*
     chunk alloc routine -
     if chunk->ds_data is nil, it will alloc CHUNK_SIZE bytes,
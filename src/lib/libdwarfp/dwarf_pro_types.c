@@ -164,7 +164,9 @@ _dwarf_transform_simplename_to_disk(Dwarf_P_Debug dbg,
 
     /* ***** BEGIN CODE ***** */
 
-    debug_info_size = 0;
+    /*  When streaming, .debug_info has already been
+        handed off, wholly or in part. */
+    debug_info_size = (Dwarf_Signed)dbg->de_stream_debug_info_size;
     for (debug_sect = dbg->de_debug_sects; debug_sect != NULL;
         debug_sect = debug_sect->ds_next) {
         /*  We want the size of the .debug_info section for this CU
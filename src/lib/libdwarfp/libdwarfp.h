@@ -198,6 +198,37 @@ DWP_API int dwarf_pro_set_default_string_form(Dwarf_P_Debug /*dbg*/,
     int /*desired_form*/,
     Dwarf_Error*     /*error*/);
 
+/*  New October 2026. Called with each finished piece
+    of section data while dwarf_transform_to_disk_form_a()
+    runs. The bytes belong to the library and are freed
+    when the call returns, so copy or write them out.
+    Return DW_DLV_OK, or DW_DLV_ERROR to stop the
+    transform. */
+typedef int (*Dwarf_Section_Write_Func)(
+    Dwarf_Unsigned  /*elf_section_index*/,
+    Dwarf_Ptr       /*section_bytes*/,
+    Dwarf_Unsigned  /*length*/,
+    void *          /*user_data*/);
+
+/*  New October 2026. Returns DW_DLV_OK or DW_DLV_ERROR.
+    Call before dwarf_transform_to_disk_form_a() to
+    stream the section data out through func instead of
+    keeping every section in memory until
+    dwarf_get_section_bytes_a() fetches it.
+    Pieces arrive in the order dwarf_get_section_bytes_a()
+    would return them: each section is complete before
+    the next generated section starts, and a large
+    .debug_info arrives in pieces of about a megabyte.
+    With streaming on, dwarf_transform_to_disk_form_a()
+    returns a buffer count of zero and
+    dwarf_get_section_bytes_a() returns DW_DLV_NO_ENTRY.
+    Pass a NULL func to turn streaming off. */
+DWP_API int dwarf_pro_set_section_write_callback(
+    Dwarf_P_Debug            /*dbg*/,
+    Dwarf_Section_Write_Func /*func*/,
+    void *                   /*user_data*/,
+    Dwarf_Error*             /*error*/);
+
 /*  New September 2016. The preferred interface. */
 DWP_API int dwarf_transform_to_disk_form_a(Dwarf_P_Debug /*dbg*/,
     Dwarf_Unsigned *   /*nbufs_out*/,
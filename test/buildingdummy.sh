@@ -13,6 +13,9 @@ cc -g $d.c -o $d
 objcopy --only-keep-debug  $d $d.debug
 objcopy --strip-debug      $d
 objcopy --add-gnu-debuglink=$d.debug  $d
+# The same DWARF with SHF_COMPRESSED sections,
+# for test_preload.c.
+objcopy --compress-debug-sections=zlib-gabi $d.debug ${d}z.debug
 # by moving the $d.debug we ensure that
 # it can only be found if the proper path is provided
 # to dwdebuglink
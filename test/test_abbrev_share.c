@@ -0,0 +1,377 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks abbrev lookup when CUs share abbrev tables.
+    A .debug_abbrev of three tables is built in memory
+    (as in jitreader.c): one with dense codes 1 to
+    DENSEMAX, one with a few sparse codes in no order,
+    and one with the same codes as the first but other
+    tags.  Six CUs use the tables in turn, their DIEs
+    using the codes in a scrambled order.  Every DIE,
+    in a walk and looked up alone by offset in reverse
+    order, must have the code, tag and byte size it
+    was built with. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+#define DENSEMAX 60
+#define TABLECOUNT 3
+#define CUCOUNT 6
+#define SPARSECOUNT 5
+#define MAXDIES 200
+
+static Dwarf_Unsigned sparsecodes[SPARSECOUNT] =
+    {5000,3,200000,7,90};
+static Dwarf_Half sparsetags[SPARSECOUNT] = {
+    DW_TAG_member,DW_TAG_variable,DW_TAG_enumerator,
+    DW_TAG_subrange_type,DW_TAG_constant};
+
+static Dwarf_Small abbrevbytes[2000];
+static Dwarf_Small infobytes[8000];
+static Dwarf_Unsigned tableoffsets[TABLECOUNT];
+
+#define SECCOUNT 2
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",0,abbrevbytes},
+{".debug_info",0,infobytes}
+};
+static struct testobj_s testobj;
+
+struct die_s {
+    Dwarf_Off      d_offset;
+    Dwarf_Unsigned d_code;
+    Dwarf_Half     d_tag;
+    Dwarf_Unsigned d_bytesize;
+};
+static struct die_s dies[CUCOUNT][MAXDIES];
+static unsigned diecounts[CUCOUNT];
+
+static void
+put_n(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        buf[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+static void
+put_uleb(Dwarf_Small *buf,Dwarf_Unsigned *off,Dwarf_Unsigned v)
+{
+    do {
+        Dwarf_Small b = (Dwarf_Small)(v & 0x7f);
+
+        v >>= 7;
+        if (v) {
+            b |= 0x80;
+        }
+        buf[(*off)++] = b;
+    } while (v);
+}
+
+/*  The tag of a code other than 1 in table t. */
+static Dwarf_Half
+code_tag(unsigned t,Dwarf_Unsigned code)
+{
+    unsigned i = 0;
+
+    if (t == 1) {
+        for (i = 0; i < SPARSECOUNT; ++i) {
+            if (sparsecodes[i] == code) {
+                return sparsetags[i];
+            }
+        }
+        return 0;
+    }
+    if (t == 0) {
+        return (code%2)? DW_TAG_base_type:DW_TAG_typedef;
+    }
+    return (code%2)? DW_TAG_member:DW_TAG_variable;
+}
+
+/*  Code 1 is the CU DIE with children and a name,
+    every other code has no children and a data1
+    DW_AT_byte_size. */
+static void
+put_abbrev(Dwarf_Unsigned *off,Dwarf_Unsigned code,Dwarf_Half tag)
+{
+    put_uleb(abbrevbytes,off,code);
+    put_uleb(abbrevbytes,off,tag);
+    if (code == 1) {
+        put_n(abbrevbytes,off,DW_CHILDREN_yes,1);
+        put_uleb(abbrevbytes,off,DW_AT_name);
+        put_uleb(abbrevbytes,off,DW_FORM_string);
+    } else {
+        put_n(abbrevbytes,off,DW_CHILDREN_no,1);
+        put_uleb(abbrevbytes,off,DW_AT_byte_size);
+        put_uleb(abbrevbytes,off,DW_FORM_data1);
+    }
+    put_n(abbrevbytes,off,0,2);
+}
+
+static void
+build_abbrevs(void)
+{
+    Dwarf_Unsigned off = 0;
+    unsigned t = 0;
+
+    for (t = 0; t < TABLECOUNT; ++t) {
+        unsigned i = 0;
+
+        tableoffsets[t] = off;
+        put_abbrev(&off,1,DW_TAG_compile_unit);
+        if (t == 1) {
+            for (i = 0; i < SPARSECOUNT; ++i) {
+                put_abbrev(&off,sparsecodes[i],sparsetags[i]);
+            }
+        } else {
+            for (i = 2; i <= DENSEMAX; ++i) {
+                put_abbrev(&off,i,code_tag(t,i));
+            }
+        }
+        put_n(abbrevbytes,&off,0,1);
+    }
+    sectiondata[0].ts_size = off;
+}
+
+/*  The code of DIE n of a CU using table t,
+    n counting from 0 for the first child. */
+static Dwarf_Unsigned
+die_code(unsigned t,unsigned n)
+{
+    if (t == 1) {
+        return sparsecodes[(n*3)%SPARSECOUNT];
+    }
+    /*  37 is prime, so every code is used. */
+    return (n*37)%(DENSEMAX-1) + 2;
+}
+
+static void
+build_info(void)
+{
+    Dwarf_Unsigned off = 0;
+    unsigned k = 0;
+
+    for (k = 0; k < CUCOUNT; ++k) {
+        unsigned t = k%TABLECOUNT;
+        Dwarf_Unsigned cuoff = off;
+        struct die_s *d = dies[k];
+        unsigned n = 0;
+        unsigned count = (t == 1)? 2*SPARSECOUNT+1:
+            DENSEMAX+k;
+
+        put_n(infobytes,&off,0,4);   /* unit_length, below */
+        put_n(infobytes,&off,4,2);   /* version */
+        put_n(infobytes,&off,tableoffsets[t],4);
+        put_n(infobytes,&off,8,1);   /* address_size */
+        d->d_offset = off;
+        d->d_code = 1;
+        d->d_tag = DW_TAG_compile_unit;
+        ++d;
+        put_n(infobytes,&off,1,1);
+        put_n(infobytes,&off,'a'+k,1);
+        put_n(infobytes,&off,0,1);
+        for (n = 0; n < count; ++n,++d) {
+            d->d_offset = off;
+            d->d_code = die_code(t,n);
+            d->d_tag = code_tag(t,d->d_code);
+            d->d_bytesize = (n*7 + k) & 0xff;
+            put_uleb(infobytes,&off,d->d_code);
+            put_n(infobytes,&off,d->d_bytesize,1);
+        }
+        diecounts[k] = count+1;
+        put_n(infobytes,&off,0,1);   /* end of children */
+        put_n(infobytes,&cuoff,off - cuoff - 4,4);
+    }
+    sectiondata[1].ts_size = off;
+}
+
+static void
+check_die(Dwarf_Die die,struct die_s *d)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    dwarf_dieoffset(die,&off,&error);
+    check("offset",d->d_offset,off,__LINE__);
+    check("abbrev code",d->d_code,dwarf_die_abbrev_code(die),
+        __LINE__);
+    res = dwarf_tag(die,&tag,&error);
+    check("tag res",DW_DLV_OK,res,__LINE__);
+    check("tag",d->d_tag,tag,__LINE__);
+    if (d->d_code != 1) {
+        res = dwarf_bytesize(die,&size,&error);
+        check("byte size res",DW_DLV_OK,res,__LINE__);
+        check("byte size",d->d_bytesize,size,__LINE__);
+    }
+}
+
+static void
+report(Dwarf_Debug dbg,int res,Dwarf_Error error,int line)
+{
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL line %d: %s\n",line,dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+    }
+}
+
+static void
+check_walk(Dwarf_Debug dbg)
+{
+    unsigned k = 0;
+
+    for (k = 0; ; ++k) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Die die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        Dwarf_Error error = 0;
+        unsigned n = 0;
+        int res = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            &cu_header_length,&version_stamp,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_header,
+            &header_cu_type,&error);
+        if (res != DW_DLV_OK) {
+            report(dbg,res,error,__LINE__);
+            break;
+        }
+        if (k >= CUCOUNT) {
+            check("more CUs than built",CUCOUNT,k+1,__LINE__);
+            dwarf_dealloc_die(cu_die);
+            break;
+        }
+        check("abbrev offset",tableoffsets[k%TABLECOUNT],
+            abbrev_offset,__LINE__);
+        check_die(cu_die,dies[k]);
+        res = dwarf_child(cu_die,&die,&error);
+        dwarf_dealloc_die(cu_die);
+        for (n = 1; res == DW_DLV_OK; ++n) {
+            Dwarf_Die sib = 0;
+
+            if (n < diecounts[k]) {
+                check_die(die,dies[k]+n);
+            }
+            res = dwarf_siblingof_c(die,&sib,&error);
+            dwarf_dealloc_die(die);
+            die = sib;
+        }
+        report(dbg,res,error,__LINE__);
+        check("DIEs walked",diecounts[k],n,__LINE__);
+    }
+    check("CUs walked",CUCOUNT,k,__LINE__);
+}
+
+/*  Last DIE first, so the CUs (and the tables) are
+    first reached from the end. */
+static void
+check_offdie(Dwarf_Debug dbg)
+{
+    unsigned k = CUCOUNT;
+
+    while (k--) {
+        unsigned n = diecounts[k];
+
+        while (n--) {
+            struct die_s *d = dies[k]+n;
+            Dwarf_Die die = 0;
+            Dwarf_Error error = 0;
+            int res = 0;
+
+            res = dwarf_offdie_b(dbg,d->d_offset,TRUE,&die,
+                &error);
+            check("offdie res",DW_DLV_OK,res,__LINE__);
+            if (res != DW_DLV_OK) {
+                report(dbg,res,error,__LINE__);
+                continue;
+            }
+            check_die(die,d);
+            dwarf_dealloc_die(die);
+        }
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    build_abbrevs();
+    build_info();
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_walk(dbg);
+    check_offdie(dbg);
+    dwarf_object_finish(dbg);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_offdie(dbg);
+    check_walk(dbg);
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_abbrev_share %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_abbrev_share\n");
+    return 0;
+}
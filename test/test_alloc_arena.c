@@ -0,0 +1,239 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_set_de_alloc_arena_flag() and
+    dwarf_get_alloc_type_counts().
+    Every DIE of test/dummyexecutable.debug is walked
+    with and without the arena and the two walks
+    must see the same DIEs. The counts must show
+    every DIE dealloc-ed and slab bytes only
+    when the arena is on.  A second arena walk
+    leaves its DIEs to dwarf_finish().
+
+    ./test_alloc_arena -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+#define OBJNAME "/test/dummyexecutable.debug"
+
+struct walk_s {
+    Dwarf_Unsigned w_diecount;
+    Dwarf_Unsigned w_offsetsum;
+    Dwarf_Unsigned w_tagsum;
+    int            w_keep;
+};
+
+static int
+walk_die(Dwarf_Die die,struct walk_s *w,Dwarf_Error *error)
+{
+    Dwarf_Die cur = die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Off off = 0;
+        Dwarf_Half tag = 0;
+
+        res = dwarf_dieoffset(cur,&off,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_tag(cur,&tag,error);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        ++w->w_diecount;
+        w->w_offsetsum += off;
+        w->w_tagsum += tag;
+        res = dwarf_child(cur,&child,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(child,w,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+        }
+        res = dwarf_siblingof_c(cur,&sib,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (cur != die && !w->w_keep) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+            break;
+        }
+        cur = sib;
+    }
+    if (cur != die && res == DW_DLV_ERROR && !w->w_keep) {
+        dwarf_dealloc_die(cur);
+    }
+    if (!w->w_keep) {
+        dwarf_dealloc_die(die);
+    }
+    return res;
+}
+
+static int
+walk_all(Dwarf_Debug dbg,struct walk_s *w,Dwarf_Error *error)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Unsigned abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_offset = 0;
+        Dwarf_Half cu_type = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,1,&cudie,
+            &header_length,&version_stamp,&abbrev_offset,
+            &address_size,&offset_size,&extension_size,
+            &signature,&typeoffset,&next_cu_offset,&cu_type,
+            error);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = walk_die(cudie,w,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+static int
+run_walk(int arena,int keep,struct walk_s *w)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned live = 0;
+    Dwarf_Unsigned total = 0;
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Unsigned arenabytes = 0;
+    int res = 0;
+
+    memset(w,0,sizeof(*w));
+    w->w_keep = keep;
+    dwarf_set_de_alloc_arena_flag(arena);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return res;
+    }
+    res = walk_all(dbg,w,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL walk: %s\n",dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+        dwarf_finish(dbg);
+        return res;
+    }
+    res = dwarf_get_alloc_type_counts(dbg,DW_DLA_DIE,
+        &live,&total,&bytes,&arenabytes);
+    check("alloc counts res",DW_DLV_OK,res,__LINE__);
+    if (keep) {
+        check("live DIEs kept",1,live >= w->w_diecount,
+            __LINE__);
+    } else {
+        check("live DIEs",0,live,__LINE__);
+    }
+    check("total DIEs",1,total >= w->w_diecount,__LINE__);
+    check("DIE bytes",1,bytes > 0,__LINE__);
+    check("arena bytes",arena?1:0,arenabytes > 0,__LINE__);
+    res = dwarf_get_alloc_type_counts(dbg,0,
+        &live,0,0,0);
+    check("type 0",DW_DLV_NO_ENTRY,res,__LINE__);
+    res = dwarf_get_alloc_type_counts(dbg,10000,
+        &live,0,0,0);
+    check("type 10000",DW_DLV_NO_ENTRY,res,__LINE__);
+    dwarf_finish(dbg);
+    return DW_DLV_OK;
+}
+
+int
+main(int argc,char **argv)
+{
+    struct walk_s plain;
+    struct walk_s arena;
+    struct walk_s kept;
+    int res = 0;
+
+    if (build_path(argc,argv,OBJNAME)) {
+        return 1;
+    }
+    res = dwarf_set_de_alloc_arena_flag(0);
+    check("initial flag",0,res,__LINE__);
+    res = dwarf_get_alloc_type_counts(0,DW_DLA_DIE,0,0,0,0);
+    check("null dbg",DW_DLV_ERROR,res,__LINE__);
+
+    run_walk(0,0,&plain);
+    run_walk(1,0,&arena);
+    run_walk(1,1,&kept);
+    res = dwarf_set_de_alloc_arena_flag(0);
+    check("flag after set",1,res,__LINE__);
+
+    check("DIEs seen",1,plain.w_diecount > 50,__LINE__);
+    check("arena DIE count",plain.w_diecount,
+        arena.w_diecount,__LINE__);
+    check("arena offsets",plain.w_offsetsum,
+        arena.w_offsetsum,__LINE__);
+    check("arena tags",plain.w_tagsum,arena.w_tagsum,__LINE__);
+    check("kept DIE count",plain.w_diecount,
+        kept.w_diecount,__LINE__);
+    check("kept offsets",plain.w_offsetsum,
+        kept.w_offsetsum,__LINE__);
+    if (errcount) {
+        printf("FAIL test_alloc_arena %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_alloc_arena\n");
+    return 0;
+}
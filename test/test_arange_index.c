@@ -0,0 +1,348 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_make_arange_index(),
+    dwarf_lookup_arange_index() and
+    dwarf_lookup_arange_index_batch() against
+    dwarf_get_arange() at, just inside and just
+    outside the ends of every arange.
+    The aranges are a hand-made set with adjacent,
+    overlapping, duplicate, empty and wrapping
+    entries (read from memory, as in jitreader.c)
+    and those of test/dummyexecutable.debug and
+    test/testuriLE64ELf.testme.
+
+    ./test_arange_index -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() free() qsort() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+static const Dwarf_Addr memranges[][2] = {
+{0x1000,0x100},
+{0x1100,0x80},   /* adjacent to the first */
+{0x1050,0x200},  /* overlaps both */
+{0x2000,0},      /* empty */
+{0x2000,0x10},
+{0x3000,0x1000},
+{0x3800,0x10},   /* inside the last */
+{0x3800,0x10},   /* duplicate */
+{0x3ff0,0x20},   /* straddles the end of 0x3000 */
+{0x500,0x10},    /* out of order */
+{0x10,1},
+{0xfffffffffffff000,0xfff},
+{0xfffffffffffff800,0x1000} /* wraps, never found */
+};
+#define MEMRANGECOUNT (sizeof(memranges)/sizeof(memranges[0]))
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children, DW_AT_name string */
+0x01, 0x11, 0x00, 0x03, 0x08, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x0c, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00 }; /* abbrev 1, "t.c" */
+/*  Header, padding, the pairs and the terminating pair. */
+static Dwarf_Small arangebytes[16 + 16*MEMRANGECOUNT + 16];
+
+static void
+put_le(Dwarf_Small *p,Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        p[i] = (Dwarf_Small)(v & 0xff);
+        v >>= 8;
+    }
+}
+
+static void
+build_aranges(void)
+{
+    Dwarf_Small *p = arangebytes;
+    unsigned i = 0;
+
+    put_le(p,sizeof(arangebytes)-4,4); /* unit_length */
+    put_le(p+4,2,2);                   /* version */
+    put_le(p+6,0,4);                   /* debug_info_offset */
+    p[10] = 8;                         /* address_size */
+    p[11] = 0;                         /* segment_size */
+    p += 16;
+    for (i = 0; i < MEMRANGECOUNT; ++i, p += 16) {
+        put_le(p,memranges[i][0],8);
+        put_le(p+8,memranges[i][1],8);
+    }
+}
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_aranges",sizeof(arangebytes),arangebytes}
+};
+static struct testobj_s testobj;
+
+static int
+compare_addr(const void *l,const void *r)
+{
+    Dwarf_Addr lv = *(const Dwarf_Addr *)l;
+    Dwarf_Addr rv = *(const Dwarf_Addr *)r;
+
+    if (lv < rv) {
+        return -1;
+    }
+    return lv > rv;
+}
+
+/*  Every address within one of the ends of an arange,
+    and the ends of the address space. */
+static Dwarf_Addr *
+make_probes(Dwarf_Arange *aranges,Dwarf_Signed count,
+    Dwarf_Unsigned *probecount,Dwarf_Error *error)
+{
+    Dwarf_Addr *probes = 0;
+    Dwarf_Unsigned n = 0;
+    Dwarf_Signed i = 0;
+
+    probes = (Dwarf_Addr *)calloc((size_t)count*6+2,
+        sizeof(Dwarf_Addr));
+    if (!probes) {
+        printf("FAIL out of memory\n");
+        return 0;
+    }
+    probes[n++] = 0;
+    probes[n++] = ~(Dwarf_Addr)0;
+    for (i = 0; i < count; ++i) {
+        Dwarf_Addr start = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Off cu_die_offset = 0;
+        int res = 0;
+
+        res = dwarf_get_arange_info_b(aranges[i],0,0,
+            &start,&length,&cu_die_offset,error);
+        if (res != DW_DLV_OK) {
+            printf("FAIL dwarf_get_arange_info_b res %d\n",res);
+            ++errcount;
+            free(probes);
+            return 0;
+        }
+        probes[n++] = start - 1;
+        probes[n++] = start;
+        probes[n++] = start + 1;
+        probes[n++] = start + length/2;
+        probes[n++] = start + length - 1;
+        probes[n++] = start + length;
+    }
+    *probecount = n;
+    return probes;
+}
+
+static void
+check_aranges(const char *name,Dwarf_Arange *aranges,
+    Dwarf_Signed count,Dwarf_Error *error)
+{
+    Dwarf_Arange_Index aindex = 0;
+    Dwarf_Addr *probes = 0;
+    Dwarf_Unsigned probecount = 0;
+    Dwarf_Arange *batch = 0;
+    Dwarf_Unsigned found = 0;
+    Dwarf_Unsigned expfound = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_make_arange_index(aranges,count,&aindex,error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_make_arange_index res %d\n",
+            name,res);
+        ++errcount;
+        return;
+    }
+    probes = make_probes(aranges,count,&probecount,error);
+    if (!probes) {
+        dwarf_dealloc_arange_index(aindex);
+        ++errcount;
+        return;
+    }
+    batch = (Dwarf_Arange *)calloc((size_t)probecount,
+        sizeof(Dwarf_Arange));
+    if (!batch) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        free(probes);
+        dwarf_dealloc_arange_index(aindex);
+        return;
+    }
+    for (i = 0; i < probecount; ++i) {
+        Dwarf_Arange expect = 0;
+        Dwarf_Arange got = 0;
+        int eres = 0;
+
+        eres = dwarf_get_arange(aranges,(Dwarf_Unsigned)count,
+            probes[i],&expect,error);
+        res = dwarf_lookup_arange_index(aindex,probes[i],
+            &got,error);
+        if (eres == DW_DLV_OK) {
+            ++expfound;
+        }
+        if (res != eres || (res == DW_DLV_OK && got != expect)) {
+            printf("FAIL %s address 0x%llx: res %d/%d "
+                "arange %p/%p\n",name,
+                (unsigned long long)probes[i],eres,res,
+                (void *)expect,(void *)got);
+            ++errcount;
+        }
+    }
+    /*  The probes are not in order, so the batch
+        lookup takes its unsorted path here and its
+        merge after the qsort(). */
+    res = dwarf_lookup_arange_index_batch(aindex,probes,
+        probecount,batch,&found,error);
+    check("batch res",DW_DLV_OK,res,__LINE__);
+    check("batch found",expfound,found,__LINE__);
+    for (i = 0; res == DW_DLV_OK && i < probecount; ++i) {
+        Dwarf_Arange expect = 0;
+
+        dwarf_get_arange(aranges,(Dwarf_Unsigned)count,
+            probes[i],&expect,error);
+        check("batch arange",(Dwarf_Unsigned)(size_t)expect,
+            (Dwarf_Unsigned)(size_t)batch[i],__LINE__);
+    }
+    qsort(probes,(size_t)probecount,sizeof(Dwarf_Addr),
+        compare_addr);
+    res = dwarf_lookup_arange_index_batch(aindex,probes,
+        probecount,batch,&found,error);
+    check("sorted batch res",DW_DLV_OK,res,__LINE__);
+    check("sorted batch found",expfound,found,__LINE__);
+    for (i = 0; res == DW_DLV_OK && i < probecount; ++i) {
+        Dwarf_Arange expect = 0;
+
+        dwarf_get_arange(aranges,(Dwarf_Unsigned)count,
+            probes[i],&expect,error);
+        check("sorted batch arange",
+            (Dwarf_Unsigned)(size_t)expect,
+            (Dwarf_Unsigned)(size_t)batch[i],__LINE__);
+    }
+    free(batch);
+    free(probes);
+    dwarf_dealloc_arange_index(aindex);
+}
+
+static void
+check_dbg(const char *name,Dwarf_Debug dbg,
+    Dwarf_Signed mincount)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Arange *aranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_get_aranges(dbg,&aranges,&count,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s dwarf_get_aranges: %s\n",name,
+            dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+        return;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("FAIL %s has no aranges\n",name);
+        ++errcount;
+        return;
+    }
+    check("arange count",1,count >= mincount,__LINE__);
+    check_aranges(name,aranges,count,&error);
+    for (i = 0; i < count; ++i) {
+        dwarf_dealloc(dbg,aranges[i],DW_DLA_ARANGE);
+    }
+    dwarf_dealloc(dbg,aranges,DW_DLA_LIST);
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    check_dbg(name,dbg,1);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Arange_Index aindex = 0;
+    int res = 0;
+
+    res = dwarf_make_arange_index(0,0,&aindex,&error);
+    check("null aranges",DW_DLV_ERROR,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,error);
+        error = 0;
+    }
+    build_aranges();
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_dbg("in-memory",dbg,MEMRANGECOUNT);
+    dwarf_object_finish(dbg);
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    if (errcount) {
+        printf("FAIL test_arange_index %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_arange_index\n");
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that dwarf_offdie_b() finds the CU of a DIE
+    whatever order the CUs are first reached in.
+    A .debug_info of CUCOUNT CUs of differing sizes is
+    built in memory (as in jitreader.c).  On a fresh
+    Dwarf_Debug the DIEs are looked up in reverse
+    order, in a scrambled order and interleaved with
+    a CU walk, and each must give its own offset,
+    its CU and the byte size it was built with.  A
+    walk of the CU headers afterwards must still see
+    every CU once, in section order. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+#define CUCOUNT 300
+#define MAXTYPES 5
+#define CUHDRSIZE 11
+#define DIECOUNT (CUCOUNT*(MAXTYPES+1))
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, children, DW_AT_name DW_FORM_string */
+0x01, 0x11, 0x01, 0x03, 0x08, 0x00, 0x00,
+/* 2: DW_TAG_base_type, no children, DW_AT_byte_size DW_FORM_data4 */
+0x02, 0x24, 0x00, 0x0b, 0x06, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[CUCOUNT*(CUHDRSIZE+4+
+    MAXTYPES*5+1)];
+
+#define SECCOUNT 2
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",0,infobytes}
+};
+static struct testobj_s testobj;
+
+/*  Each DIE as built. */
+struct die_s {
+    Dwarf_Off      d_offset;
+    Dwarf_Off      d_cu_die_offset;
+    Dwarf_Unsigned d_bytesize; /* 0 for a CU DIE */
+};
+static struct die_s dies[DIECOUNT];
+static unsigned diecount;
+static Dwarf_Off cuoffsets[CUCOUNT];
+
+static void
+put_n(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        buf[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+/*  CU k has k%MAXTYPES+1 base types, each with a
+    byte size unique in the section. */
+static void
+build_info(void)
+{
+    Dwarf_Unsigned off = 0;
+    unsigned k = 0;
+
+    for (k = 0; k < CUCOUNT; ++k) {
+        Dwarf_Unsigned cuoff = off;
+        Dwarf_Unsigned cudie = 0;
+        unsigned ntypes = k%MAXTYPES + 1;
+        unsigned j = 0;
+
+        cuoffsets[k] = cuoff;
+        put_n(infobytes,&off,0,4);   /* unit_length, below */
+        put_n(infobytes,&off,4,2);   /* version */
+        put_n(infobytes,&off,0,4);   /* debug_abbrev_offset */
+        put_n(infobytes,&off,8,1);   /* address_size */
+        cudie = off;
+        put_n(infobytes,&off,1,1);
+        put_n(infobytes,&off,'c',1);
+        put_n(infobytes,&off,'u',1);
+        put_n(infobytes,&off,0,1);
+        dies[diecount].d_offset = cudie;
+        dies[diecount].d_cu_die_offset = cudie;
+        dies[diecount].d_bytesize = 0;
+        ++diecount;
+        for (j = 0; j < ntypes; ++j) {
+            dies[diecount].d_offset = off;
+            dies[diecount].d_cu_die_offset = cudie;
+            dies[diecount].d_bytesize = k*16 + j + 1;
+            ++diecount;
+            put_n(infobytes,&off,2,1);
+            put_n(infobytes,&off,k*16 + j + 1,4);
+        }
+        put_n(infobytes,&off,0,1);   /* end of children */
+        put_n(infobytes,&cuoff,off - cuoff - 4,4);
+    }
+    sectiondata[1].ts_size = off;
+}
+
+static void
+check_die(Dwarf_Debug dbg,unsigned i)
+{
+    struct die_s *d = dies + i;
+    Dwarf_Die die = 0;
+    Dwarf_Off off = 0;
+    Dwarf_Off cuoff = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_offdie_b(dbg,d->d_offset,TRUE,&die,&error);
+    check("dwarf_offdie_b",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s\n",dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    dwarf_dieoffset(die,&off,&error);
+    check("die offset",d->d_offset,off,__LINE__);
+    res = dwarf_CU_dieoffset_given_die(die,&cuoff,&error);
+    check("CU die offset res",DW_DLV_OK,res,__LINE__);
+    check("CU die offset",d->d_cu_die_offset,cuoff,__LINE__);
+    res = dwarf_bytesize(die,&size,&error);
+    if (d->d_bytesize) {
+        check("byte size res",DW_DLV_OK,res,__LINE__);
+        check("byte size",d->d_bytesize,size,__LINE__);
+    } else {
+        check("CU die byte size",DW_DLV_NO_ENTRY,res,__LINE__);
+    }
+    dwarf_dealloc_die(die);
+}
+
+/*  The CU headers, which must be every CU in
+    order. */
+static void
+check_cu_walk(Dwarf_Debug dbg)
+{
+    unsigned k = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        Dwarf_Off off = 0;
+        Dwarf_Error error = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            &cu_header_length,&version_stamp,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_header,
+            &header_cu_type,&error);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        check("next cu res",DW_DLV_OK,res,__LINE__);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_error(dbg,error);
+            return;
+        }
+        dwarf_dieoffset(cu_die,&off,&error);
+        if (k < CUCOUNT) {
+            check("walk CU die offset",cuoffsets[k]+CUHDRSIZE,
+                off,__LINE__);
+        }
+        ++k;
+        dwarf_dealloc_die(cu_die);
+    }
+    check("CUs walked",CUCOUNT,k,__LINE__);
+}
+
+/*  order 0: reverse. 1: scrambled. 2: scrambled
+    with the CU walk first done half way. */
+static void
+check_order(int order)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    unsigned n = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    for (n = 0; n < diecount; ++n) {
+        if (order == 0) {
+            i = diecount - 1 - n;
+        } else {
+            /*  7919 is prime and does not
+                divide diecount. */
+            i = (unsigned)(((unsigned long)n*7919 + 13) %
+                diecount);
+        }
+        if (order == 2 && n == diecount/2) {
+            check_cu_walk(dbg);
+        }
+        check_die(dbg,i);
+    }
+    check_cu_walk(dbg);
+    dwarf_object_finish(dbg);
+}
+
+int
+main(void)
+{
+    build_info();
+    check("diecount not a multiple of 7919",1,
+        diecount % 7919 != 0,__LINE__);
+    check_order(0);
+    check_order(1);
+    check_order(2);
+    if (errcount) {
+        printf("FAIL test_cu_lookup %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_cu_lookup\n");
+    return 0;
+}
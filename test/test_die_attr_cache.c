@@ -0,0 +1,421 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_set_die_attr_offset_cache().
+    A DWARF5 .debug_info is built in memory (as in
+    jitreader.c) whose DIEs use two abbreviations with
+    variable size values (strings, LEB numbers, an
+    exprloc) ahead of fixed size and implicit_const
+    ones.  Every attribute lookup is done on every DIE
+    with the cache off, and then with it on: DIE by
+    DIE, and query by query across all the DIEs so
+    each lookup is on a different DIE than the one
+    before, most with the same abbreviation.
+    The results must be the same each time and as
+    built. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+#define DIECOUNT 60
+#define QUERYCOUNT 9
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, children, DW_AT_name string */
+0x01, 0x11, 0x01, 0x03, 0x08, 0x00, 0x00,
+/*  2: DW_TAG_variable, no children, DW_AT_name string,
+    DW_AT_decl_line udata, DW_AT_location exprloc,
+    DW_AT_byte_size data1, DW_AT_external flag_present,
+    DW_AT_const_value sdata,
+    DW_AT_decl_column implicit_const 7 */
+0x02, 0x34, 0x00, 0x03, 0x08, 0x3b, 0x0f, 0x02, 0x18,
+0x0b, 0x0b, 0x3f, 0x19, 0x1c, 0x0d, 0x39, 0x21, 0x07,
+0x00, 0x00,
+/*  3: DW_TAG_variable, no children, DW_AT_decl_line udata,
+    DW_AT_name string, DW_AT_byte_size data2,
+    DW_AT_encoding data1 */
+0x03, 0x34, 0x00, 0x3b, 0x0f, 0x03, 0x08, 0x0b, 0x05,
+0x3e, 0x0b, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[DIECOUNT*40];
+
+#define SECCOUNT 2
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",0,infobytes}
+};
+static struct testobj_s testobj;
+
+static Dwarf_Off dieoffsets[DIECOUNT];
+/*  Query results with the cache off. */
+static Dwarf_Unsigned expected[DIECOUNT][QUERYCOUNT];
+
+/*  Marks a query result that is a DW_DLV code
+    rather than a value. */
+#define NOT_OK ((Dwarf_Unsigned)1 << 63)
+
+static void
+put_n(Dwarf_Unsigned *off,Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        infobytes[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+static void
+put_leb(Dwarf_Unsigned *off,Dwarf_Signed v,int is_signed)
+{
+    for (;;) {
+        Dwarf_Small b = (Dwarf_Small)(v & 0x7f);
+
+        v = is_signed? v >> 7:
+            (Dwarf_Signed)((Dwarf_Unsigned)v >> 7);
+        if (is_signed? ((v == 0 && !(b & 0x40)) ||
+            (v == -1 && (b & 0x40))) : v == 0) {
+            infobytes[(*off)++] = b;
+            return;
+        }
+        infobytes[(*off)++] = b | 0x80;
+    }
+}
+
+static int
+uses_abbrev2(unsigned i)
+{
+    return i%5 < 3;
+}
+
+/*  DIE i is named with i%9+1 letters. */
+static void
+build_info(void)
+{
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned lenoff = 0;
+    unsigned i = 0;
+    unsigned j = 0;
+
+    put_n(&off,0,4);           /* unit_length, below */
+    put_n(&off,5,2);           /* version */
+    put_n(&off,DW_UT_compile,1);
+    put_n(&off,8,1);           /* address_size */
+    put_n(&off,0,4);           /* debug_abbrev_offset */
+    put_n(&off,1,1);
+    put_n(&off,'c',1);
+    put_n(&off,0,1);
+    for (i = 0; i < DIECOUNT; ++i) {
+        dieoffsets[i] = off;
+        if (uses_abbrev2(i)) {
+            put_n(&off,2,1);
+            for (j = 0; j <= i%9; ++j) {
+                put_n(&off,'a'+j,1);
+            }
+            put_n(&off,0,1);
+            put_leb(&off,(Dwarf_Signed)i*100,FALSE);
+            put_n(&off,i%4+1,1); /* exprloc length */
+            for (j = 0; j <= i%4; ++j) {
+                put_n(&off,0x30+i,1);
+            }
+            put_n(&off,i+1,1);
+            put_leb(&off,-(Dwarf_Signed)i*1000,TRUE);
+        } else {
+            put_n(&off,3,1);
+            put_leb(&off,(Dwarf_Signed)i*100,FALSE);
+            for (j = 0; j <= i%9; ++j) {
+                put_n(&off,'a'+j,1);
+            }
+            put_n(&off,0,1);
+            put_n(&off,i+300,2);
+            put_n(&off,DW_ATE_unsigned,1);
+        }
+    }
+    put_n(&off,0,1);           /* end of children */
+    put_n(&lenoff,off - 4,4);
+    sectiondata[1].ts_size = off;
+}
+
+static Dwarf_Unsigned
+not_ok(Dwarf_Debug dbg,int res,Dwarf_Error error)
+{
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s\n",dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+    }
+    return NOT_OK | (Dwarf_Unsigned)(res+1);
+}
+
+/*  The value of attribute attrnum of die
+    through dwarf_attr(), decoded as kind
+    0: udata, 1: sdata, 2: exprloc length and
+    first byte, 3: the form. */
+static Dwarf_Unsigned
+attr_value(Dwarf_Debug dbg,Dwarf_Die die,Dwarf_Half attrnum,
+    int kind)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Unsigned u = 0;
+    Dwarf_Signed s = 0;
+    Dwarf_Half form = 0;
+    Dwarf_Ptr ptr = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_attr(die,attrnum,&attr,&error);
+    if (res != DW_DLV_OK) {
+        return not_ok(dbg,res,error);
+    }
+    switch (kind) {
+    case 0:
+        res = dwarf_formudata(attr,&u,&error);
+        break;
+    case 1:
+        res = dwarf_formsdata(attr,&s,&error);
+        u = (Dwarf_Unsigned)s;
+        break;
+    case 2:
+        res = dwarf_formexprloc(attr,&u,&ptr,&error);
+        if (res == DW_DLV_OK) {
+            u = u*256 + *(Dwarf_Small *)ptr;
+        }
+        break;
+    default:
+        res = dwarf_whatform(attr,&form,&error);
+        u = form;
+        break;
+    }
+    dwarf_dealloc_attribute(attr);
+    if (res != DW_DLV_OK) {
+        return not_ok(dbg,res,error);
+    }
+    return u;
+}
+
+static Dwarf_Unsigned
+query(Dwarf_Debug dbg,Dwarf_Die die,int q)
+{
+    char *name = 0;
+    Dwarf_Unsigned u = 0;
+    Dwarf_Bool b = FALSE;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    switch (q) {
+    case 0:
+        res = dwarf_diename(die,&name,&error);
+        if (res != DW_DLV_OK) {
+            return not_ok(dbg,res,error);
+        }
+        return strlen(name)*256 + (Dwarf_Small)name[0];
+    case 1:
+        return attr_value(dbg,die,DW_AT_decl_line,0);
+    case 2:
+        return attr_value(dbg,die,DW_AT_const_value,1);
+    case 3:
+        return attr_value(dbg,die,DW_AT_location,2);
+    case 4:
+        res = dwarf_bytesize(die,&u,&error);
+        if (res != DW_DLV_OK) {
+            return not_ok(dbg,res,error);
+        }
+        return u;
+    case 5:
+        return attr_value(dbg,die,DW_AT_decl_column,1);
+    case 6:
+        return attr_value(dbg,die,DW_AT_external,3);
+    case 7:
+        res = dwarf_hasattr(die,DW_AT_type,&b,&error);
+        if (res != DW_DLV_OK) {
+            return not_ok(dbg,res,error);
+        }
+        return b;
+    default:
+        return attr_value(dbg,die,DW_AT_encoding,0);
+    }
+}
+
+static int
+open_dies(Dwarf_Debug *dbg,Dwarf_Die *dies)
+{
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return res;
+    }
+    for (i = 0; i < DIECOUNT; ++i) {
+        res = dwarf_offdie_b(*dbg,dieoffsets[i],TRUE,&dies[i],
+            &error);
+        if (res != DW_DLV_OK) {
+            not_ok(*dbg,res,error);
+            printf("FAIL offdie of DIE %u\n",i);
+            ++errcount;
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static void
+close_dies(Dwarf_Debug dbg,Dwarf_Die *dies)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < DIECOUNT; ++i) {
+        dwarf_dealloc_die(dies[i]);
+    }
+    dwarf_object_finish(dbg);
+}
+
+static void
+check_query(Dwarf_Debug dbg,Dwarf_Die *dies,unsigned i,int q,
+    int line)
+{
+    Dwarf_Unsigned got = query(dbg,dies[i],q);
+
+    if (got != expected[i][q]) {
+        printf("FAIL DIE %u query %d: cached 0x%lx "
+            "uncached 0x%lx (line %d)\n",i,q,
+            (unsigned long)got,(unsigned long)expected[i][q],
+            line);
+        ++errcount;
+    }
+}
+
+/*  Spot checks of the uncached results against
+    what was built. */
+static void
+check_expected(void)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < DIECOUNT; ++i) {
+        Dwarf_Unsigned *e = expected[i];
+
+        check("name",(i%9+1)*256+'a',e[0],__LINE__);
+        check("decl_line",i*100,e[1],__LINE__);
+        check("no DW_AT_type",FALSE,e[7],__LINE__);
+        if (uses_abbrev2(i)) {
+            check("const_value",(Dwarf_Unsigned)
+                -(Dwarf_Signed)i*1000,e[2],__LINE__);
+            check("location",(i%4+1)*256+0x30+i,e[3],__LINE__);
+            check("byte_size",i+1,e[4],__LINE__);
+            check("implicit_const",7,e[5],__LINE__);
+            check("external form",DW_FORM_flag_present,e[6],
+                __LINE__);
+            check("no encoding",NOT_OK|(DW_DLV_NO_ENTRY+1),e[8],
+                __LINE__);
+        } else {
+            check("no const_value",NOT_OK|(DW_DLV_NO_ENTRY+1),
+                e[2],__LINE__);
+            check("byte_size",i+300,e[4],__LINE__);
+            check("encoding",DW_ATE_unsigned,e[8],__LINE__);
+        }
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Die dies[DIECOUNT];
+    unsigned i = 0;
+    int q = 0;
+    int prev = 0;
+
+    build_info();
+    memset(dies,0,sizeof(dies));
+    if (open_dies(&dbg,dies) != DW_DLV_OK) {
+        return 1;
+    }
+    for (i = 0; i < DIECOUNT; ++i) {
+        for (q = 0; q < QUERYCOUNT; ++q) {
+            expected[i][q] = query(dbg,dies[i],q);
+        }
+    }
+    check_expected();
+    prev = dwarf_set_die_attr_offset_cache(dbg,TRUE);
+    check("cache off by default",FALSE,prev,__LINE__);
+    /*  DIE by DIE, each query twice. */
+    for (i = 0; i < DIECOUNT; ++i) {
+        for (q = 0; q < QUERYCOUNT; ++q) {
+            check_query(dbg,dies,i,q,__LINE__);
+        }
+        for (q = QUERYCOUNT; q--; ) {
+            check_query(dbg,dies,i,q,__LINE__);
+        }
+    }
+    /*  Every lookup on a DIE other than the one
+        before, mostly of the same abbreviation. */
+    for (q = 0; q < QUERYCOUNT; ++q) {
+        for (i = 0; i < DIECOUNT; ++i) {
+            check_query(dbg,dies,i,q,__LINE__);
+            check_query(dbg,dies,(i+3)%DIECOUNT,
+                QUERYCOUNT-1-q,__LINE__);
+        }
+    }
+    prev = dwarf_set_die_attr_offset_cache(dbg,FALSE);
+    check("cache was on",TRUE,prev,__LINE__);
+    for (i = 0; i < DIECOUNT; ++i) {
+        check_query(dbg,dies,i,i%QUERYCOUNT,__LINE__);
+    }
+    close_dies(dbg,dies);
+
+    /*  The cache on from the start, so the first
+        lookups fill it. */
+    if (open_dies(&dbg,dies) != DW_DLV_OK) {
+        return 1;
+    }
+    dwarf_set_die_attr_offset_cache(dbg,TRUE);
+    for (i = DIECOUNT; i--; ) {
+        for (q = 0; q < QUERYCOUNT; ++q) {
+            check_query(dbg,dies,i,q,__LINE__);
+            check_query(dbg,dies,DIECOUNT-1-i,q,__LINE__);
+        }
+    }
+    close_dies(dbg,dies);
+    if (errcount) {
+        printf("FAIL test_die_attr_cache %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_die_attr_cache\n");
+    return 0;
+}
@@ -0,0 +1,445 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_get_die_attr_values() against
+    dwarf_attrlist() and the dwarf_form*() calls
+    on every DIE of test/dummyexecutable.debug,
+    test/testuriLE64ELf.testme and
+    test/test-mach-o-32.dSYM, fetching all the
+    attributes, a short list of them, and all of
+    them into too small an array.
+
+    ./test_die_attr_values -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+#define MAXATTRS 64
+#define WANTCOUNT 4
+
+struct counts_s {
+    Dwarf_Unsigned c_dies;
+    Dwarf_Unsigned c_attrs;
+    Dwarf_Unsigned c_strings;
+    Dwarf_Unsigned c_blocks;
+    Dwarf_Unsigned c_subset;
+};
+
+static void
+check_attr(const char *msg,Dwarf_Off dieoff,
+    Dwarf_Half attrnum,int ok)
+{
+    if (ok) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s DIE 0x%llx attr 0x%x\n",msg,
+        (unsigned long long)dieoff,attrnum);
+}
+
+/*  Compare one value with what the dwarf_form*()
+    calls return for the same attribute. */
+static void
+compare_value(Dwarf_Debug dbg,Dwarf_Off dieoff,
+    Dwarf_Attribute attr,Dwarf_Attr_Value *v,
+    struct counts_s *counts)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Half  attrnum = v->av_attrnum;
+    int res = 0;
+
+    switch (v->av_form) {
+    case DW_FORM_data1: case DW_FORM_data2:
+    case DW_FORM_data4: case DW_FORM_data8:
+    case DW_FORM_udata: case DW_FORM_flag:
+    case DW_FORM_flag_present:
+    case DW_FORM_loclistx: case DW_FORM_rnglistx: {
+        Dwarf_Unsigned u = 0;
+
+        res = dwarf_formudata(attr,&u,&error);
+        check_attr("dwarf_formudata",dieoff,attrnum,
+            res == DW_DLV_OK && u == v->av_uvalue);
+        break;
+    }
+    case DW_FORM_sdata: case DW_FORM_implicit_const: {
+        Dwarf_Signed s = 0;
+
+        res = dwarf_formsdata(attr,&s,&error);
+        check_attr("dwarf_formsdata",dieoff,attrnum,
+            res == DW_DLV_OK && s == v->av_svalue);
+        break;
+    }
+    case DW_FORM_addr: {
+        Dwarf_Addr addr = 0;
+
+        res = dwarf_formaddr(attr,&addr,&error);
+        check_attr("dwarf_formaddr",dieoff,attrnum,
+            res == DW_DLV_OK && addr == v->av_uvalue);
+        break;
+    }
+    case DW_FORM_addrx: case DW_FORM_addrx1:
+    case DW_FORM_addrx2: case DW_FORM_addrx3:
+    case DW_FORM_addrx4: case DW_FORM_GNU_addr_index: {
+        Dwarf_Unsigned index = 0;
+
+        res = dwarf_get_debug_addr_index(attr,&index,&error);
+        check_attr("dwarf_get_debug_addr_index",dieoff,
+            attrnum,res == DW_DLV_OK && index == v->av_uvalue);
+        break;
+    }
+    case DW_FORM_ref1: case DW_FORM_ref2:
+    case DW_FORM_ref4: case DW_FORM_ref8:
+    case DW_FORM_ref_udata: case DW_FORM_ref_addr:
+    case DW_FORM_sec_offset: {
+        Dwarf_Off off = 0;
+        Dwarf_Bool is_info = 0;
+
+        res = dwarf_global_formref_b(attr,&off,&is_info,&error);
+        check_attr("dwarf_global_formref_b",dieoff,attrnum,
+            res == DW_DLV_OK && off == v->av_uvalue);
+        break;
+    }
+    case DW_FORM_string: case DW_FORM_strp:
+    case DW_FORM_line_strp: case DW_FORM_strx:
+    case DW_FORM_strx1: case DW_FORM_strx2:
+    case DW_FORM_strx3: case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index: {
+        char *str = 0;
+
+        res = dwarf_formstring(attr,&str,&error);
+        /*  The same pointer into the section,
+            not just the same characters. */
+        check_attr("dwarf_formstring",dieoff,attrnum,
+            res == DW_DLV_OK && str == v->av_string);
+        counts->c_strings++;
+        break;
+    }
+    case DW_FORM_exprloc: {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr data = 0;
+
+        res = dwarf_formexprloc(attr,&len,&data,&error);
+        check_attr("dwarf_formexprloc",dieoff,attrnum,
+            res == DW_DLV_OK && len == v->av_len &&
+            data == (Dwarf_Ptr)v->av_data);
+        counts->c_blocks++;
+        break;
+    }
+    case DW_FORM_block1: case DW_FORM_block2:
+    case DW_FORM_block4: case DW_FORM_block: {
+        Dwarf_Block *block = 0;
+
+        res = dwarf_formblock(attr,&block,&error);
+        check_attr("dwarf_formblock",dieoff,attrnum,
+            res == DW_DLV_OK && block->bl_len == v->av_len &&
+            block->bl_data == (Dwarf_Ptr)v->av_data);
+        if (res == DW_DLV_OK) {
+            dwarf_dealloc(dbg,block,DW_DLA_BLOCK);
+        }
+        counts->c_blocks++;
+        break;
+    }
+    default:
+        break;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+    }
+}
+
+/*  Ask for a few attributes, one of which no DIE has,
+    and compare with the full list. */
+static void
+check_subset(Dwarf_Debug dbg,Dwarf_Die die,Dwarf_Off dieoff,
+    Dwarf_Attr_Value *all,Dwarf_Unsigned allcount,
+    struct counts_s *counts)
+{
+    static const Dwarf_Half want[WANTCOUNT] = {
+        DW_AT_type, DW_AT_name, DW_AT_hi_user,
+        DW_AT_low_pc };
+    Dwarf_Attr_Value sub[WANTCOUNT];
+    Dwarf_Unsigned subcount = 0;
+    Dwarf_Unsigned expect = 0;
+    Dwarf_Error error = 0;
+    unsigned k = 0;
+    int res = 0;
+
+    res = dwarf_get_die_attr_values(die,want,WANTCOUNT,
+        sub,WANTCOUNT,&subcount,&error);
+    if (res == DW_DLV_ERROR) {
+        check_attr("subset error",dieoff,0,0);
+        dwarf_dealloc_error(dbg,error);
+        return;
+    }
+    for (k = 0; k < WANTCOUNT; ++k) {
+        Dwarf_Attr_Value *match = 0;
+        Dwarf_Unsigned m = 0;
+
+        for (m = 0; m < allcount; ++m) {
+            if (all[m].av_attrnum == want[k]) {
+                match = &all[m];
+                break;
+            }
+        }
+        check_attr("subset attrnum",dieoff,want[k],
+            sub[k].av_attrnum == want[k]);
+        if (!match) {
+            check_attr("subset absent",dieoff,want[k],
+                sub[k].av_form == 0);
+            continue;
+        }
+        ++expect;
+        check_attr("subset value",dieoff,want[k],
+            res == DW_DLV_OK &&
+            sub[k].av_form == match->av_form &&
+            sub[k].av_uvalue == match->av_uvalue &&
+            sub[k].av_string == match->av_string &&
+            sub[k].av_data == match->av_data);
+    }
+    check("subset count",expect,subcount,__LINE__);
+    check("subset result",expect?DW_DLV_OK:DW_DLV_NO_ENTRY,
+        res,__LINE__);
+    counts->c_subset += subcount;
+}
+
+static void
+check_die(Dwarf_Debug dbg,Dwarf_Die die,struct counts_s *counts)
+{
+    Dwarf_Attr_Value vals[MAXATTRS];
+    Dwarf_Attr_Value first;
+    Dwarf_Unsigned n = 0;
+    Dwarf_Unsigned n1 = 0;
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed attrcount = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Off dieoff = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+    int vres = 0;
+
+    counts->c_dies++;
+    dwarf_dieoffset(die,&dieoff,&error);
+    res = dwarf_attrlist(die,&attrs,&attrcount,&error);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+        error = 0;
+        check_attr("dwarf_attrlist error",dieoff,0,0);
+        return;
+    }
+    vres = dwarf_get_die_attr_values(die,0,0,vals,MAXATTRS,
+        &n,&error);
+    if (vres == DW_DLV_ERROR) {
+        printf("FAIL DIE 0x%llx %s\n",
+            (unsigned long long)dieoff,dwarf_errmsg(error));
+        ++errcount;
+        dwarf_dealloc_error(dbg,error);
+        error = 0;
+    }
+    check("result",res,vres,__LINE__);
+    if (res == DW_DLV_OK && vres == DW_DLV_OK) {
+        check("count",attrcount,n,__LINE__);
+        for (i = 0; i < attrcount && i < (Dwarf_Signed)n &&
+            i < MAXATTRS; ++i) {
+            Dwarf_Half attrnum = 0;
+            Dwarf_Half form = 0;
+
+            dwarf_whatattr(attrs[i],&attrnum,&error);
+            dwarf_whatform(attrs[i],&form,&error);
+            check_attr("attribute and form",dieoff,attrnum,
+                attrnum == vals[i].av_attrnum &&
+                form == vals[i].av_form);
+            if (attrnum == vals[i].av_attrnum &&
+                form == vals[i].av_form) {
+                compare_value(dbg,dieoff,attrs[i],&vals[i],
+                    counts);
+            }
+            counts->c_attrs++;
+        }
+        check_subset(dbg,die,dieoff,vals,n,counts);
+
+        /*  Too small an array still counts them all. */
+        res = dwarf_get_die_attr_values(die,0,0,&first,1,
+            &n1,&error);
+        check("one slot",DW_DLV_OK,res,__LINE__);
+        check("one slot count",n,n1,__LINE__);
+        check_attr("one slot value",dieoff,first.av_attrnum,
+            first.av_attrnum == vals[0].av_attrnum &&
+            first.av_form == vals[0].av_form &&
+            first.av_uvalue == vals[0].av_uvalue);
+    }
+    if (res == DW_DLV_OK && attrs) {
+        for (i = 0; i < attrcount; ++i) {
+            dwarf_dealloc_attribute(attrs[i]);
+        }
+        dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+    }
+}
+
+static void
+walk_die(Dwarf_Debug dbg,Dwarf_Die die,struct counts_s *counts)
+{
+    Dwarf_Die cur = die;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        check_die(dbg,cur,counts);
+        res = dwarf_child(cur,&child,&error);
+        if (res == DW_DLV_OK) {
+            walk_die(dbg,child,counts);
+            dwarf_dealloc_die(child);
+        } else if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            ++errcount;
+        }
+        res = dwarf_siblingof_c(cur,&sib,&error);
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                ++errcount;
+            }
+            break;
+        }
+        cur = sib;
+    }
+}
+
+/*  A list of attributes larger than the result
+    array is an error. */
+static void
+check_short_array(Dwarf_Debug dbg,Dwarf_Die die)
+{
+    static const Dwarf_Half want[2] = {
+        DW_AT_name, DW_AT_producer };
+    Dwarf_Attr_Value vals[2];
+    Dwarf_Unsigned n = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_die_attr_values(die,want,2,vals,1,
+        &n,&error);
+    check("short array",DW_DLV_ERROR,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        check("short array errno",DW_DLE_IA,
+            dwarf_errno(error),__LINE__);
+        dwarf_dealloc_error(dbg,error);
+    }
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    struct counts_s counts;
+    int is_info = 0;
+    int res = 0;
+
+    memset(&counts,0,sizeof(counts));
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    for (is_info = 1; is_info >= 0; --is_info) {
+        for (;;) {
+            Dwarf_Die cu = 0;
+            Dwarf_Unsigned hdrlen = 0;
+            Dwarf_Half version = 0;
+            Dwarf_Off abbrevoff = 0;
+            Dwarf_Half addrsize = 0;
+            Dwarf_Half offsize = 0;
+            Dwarf_Half extsize = 0;
+            Dwarf_Sig8 sig;
+            Dwarf_Unsigned typeoff = 0;
+            Dwarf_Unsigned nexthdr = 0;
+            Dwarf_Half hdrtype = 0;
+
+            memset(&sig,0,sizeof(sig));
+            res = dwarf_next_cu_header_e(dbg,is_info,&cu,
+                &hdrlen,&version,&abbrevoff,&addrsize,
+                &offsize,&extsize,&sig,&typeoff,&nexthdr,
+                &hdrtype,&error);
+            if (res == DW_DLV_ERROR) {
+                printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+                ++errcount;
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            if (!counts.c_dies) {
+                check_short_array(dbg,cu);
+            }
+            walk_die(dbg,cu,&counts);
+            dwarf_dealloc_die(cu);
+        }
+    }
+    check("DIEs seen",1,counts.c_dies > 50,__LINE__);
+    check("attributes seen",1,counts.c_attrs > counts.c_dies,
+        __LINE__);
+    check("strings seen",1,counts.c_strings > 0,__LINE__);
+    check("blocks seen",1,counts.c_blocks > 0,__LINE__);
+    check("subset seen",1,counts.c_subset > 0,__LINE__);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    if (errcount) {
+        printf("FAIL test_die_attr_values %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_die_attr_values\n");
+    return 0;
+}
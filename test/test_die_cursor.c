@@ -0,0 +1,362 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_make_die_cursor(), dwarf_die_cursor_next()
+    and dwarf_die_cursor_skip_children().
+    Each CU of test/dummyexecutable.debug,
+    test/testuriLE64ELf.testme and test/test-mach-o-32.dSYM
+    is walked with dwarf_child() and dwarf_siblingof_c()
+    and the cursor must return the same DIEs in the same
+    order at the same depths: for the whole CU, with
+    the children of subprograms and structures skipped,
+    and starting from a DIE inside the CU.
+
+    ./test_die_cursor -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* free() realloc() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+struct die_rec_s {
+    Dwarf_Off      r_offset;
+    Dwarf_Unsigned r_depth;
+    Dwarf_Half     r_tag;
+    Dwarf_Unsigned r_abbrev_code;
+    int            r_has_child;
+};
+
+struct walk_s {
+    struct die_rec_s *w_recs;
+    Dwarf_Unsigned    w_count;
+    Dwarf_Unsigned    w_size;
+};
+
+static int
+skip_tag(Dwarf_Half tag)
+{
+    return tag == DW_TAG_subprogram ||
+        tag == DW_TAG_structure_type;
+}
+
+static struct die_rec_s *
+new_rec(struct walk_s *w)
+{
+    struct die_rec_s *r = 0;
+
+    if (w->w_count == w->w_size) {
+        Dwarf_Unsigned newsize = w->w_size?w->w_size*2:256;
+        struct die_rec_s *newrecs = 0;
+
+        newrecs = (struct die_rec_s *)realloc(w->w_recs,
+            (size_t)newsize*sizeof(struct die_rec_s));
+        if (!newrecs) {
+            printf("FAIL out of memory\n");
+            ++errcount;
+            return 0;
+        }
+        w->w_recs = newrecs;
+        w->w_size = newsize;
+    }
+    r = &w->w_recs[w->w_count++];
+    memset(r,0,sizeof(*r));
+    return r;
+}
+
+/*  The usual walk. With skipping, the children of
+    skip_tag() DIEs are left out. */
+static void
+plain_walk(Dwarf_Debug dbg,Dwarf_Die die,Dwarf_Unsigned depth,
+    int skipping,struct walk_s *w)
+{
+    Dwarf_Die cur = die;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        struct die_rec_s *r = new_rec(w);
+
+        if (!r) {
+            break;
+        }
+        r->r_depth = depth;
+        dwarf_dieoffset(cur,&r->r_offset,&error);
+        dwarf_tag(cur,&r->r_tag,&error);
+        r->r_abbrev_code = (Dwarf_Unsigned)dwarf_die_abbrev_code(cur);
+        res = dwarf_child(cur,&child,&error);
+        if (res == DW_DLV_OK) {
+            r->r_has_child = 1;
+            if (!skipping || !skip_tag(r->r_tag)) {
+                plain_walk(dbg,child,depth+1,skipping,w);
+            }
+            dwarf_dealloc_die(child);
+        } else if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            ++errcount;
+        }
+        if (!depth) {
+            /* The top DIE of the walk, not its siblings. */
+            break;
+        }
+        res = dwarf_siblingof_c(cur,&sib,&error);
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                ++errcount;
+            }
+            break;
+        }
+        cur = sib;
+    }
+}
+
+/*  Walk with a cursor from die and compare with
+    ref from index first on. With want_die the
+    returned Dwarf_Die is checked too, without it
+    every return pointer but the offset is NULL. */
+static void
+cursor_walk(Dwarf_Debug dbg,Dwarf_Die die,int skipping,
+    int want_die,struct walk_s *ref,Dwarf_Unsigned first,
+    Dwarf_Unsigned count)
+{
+    Dwarf_Die_Cursor cursor = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned basedepth = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (count) {
+        basedepth = ref->w_recs[first].r_depth;
+    }
+    res = dwarf_make_die_cursor(die,&cursor,&error);
+    check("make cursor",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    for (;; ++i) {
+        struct die_rec_s *r = 0;
+        Dwarf_Off off = 0;
+        Dwarf_Unsigned depth = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Unsigned code = 0;
+        Dwarf_Die cdie = 0;
+
+        if (want_die) {
+            res = dwarf_die_cursor_next(cursor,&off,&depth,
+                &tag,&code,&cdie,&error);
+        } else {
+            res = dwarf_die_cursor_next(cursor,&off,0,
+                0,0,0,&error);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (i >= count) {
+            continue;
+        }
+        r = &ref->w_recs[first+i];
+        if (r->r_offset != off) {
+            printf("FAIL cursor DIE %llu at 0x%llx not 0x%llx\n",
+                (unsigned long long)i,(unsigned long long)off,
+                (unsigned long long)r->r_offset);
+            ++errcount;
+            break;
+        }
+        if (want_die) {
+            Dwarf_Off doff = 0;
+            Dwarf_Half dtag = 0;
+
+            check("cursor depth",r->r_depth - basedepth,
+                depth,__LINE__);
+            check("cursor tag",r->r_tag,tag,__LINE__);
+            check("cursor abbrev code",r->r_abbrev_code,code,
+                __LINE__);
+            dwarf_dieoffset(cdie,&doff,&error);
+            dwarf_tag(cdie,&dtag,&error);
+            check("cursor die offset",off,doff,__LINE__);
+            check("cursor die tag",tag,dtag,__LINE__);
+        }
+        if (skipping && r->r_has_child && skip_tag(r->r_tag)) {
+            res = dwarf_die_cursor_skip_children(cursor,&error);
+            check("skip children",DW_DLV_OK,res,__LINE__);
+        } else if (skipping && !r->r_has_child) {
+            /* Does nothing. */
+            res = dwarf_die_cursor_skip_children(cursor,&error);
+            check("skip no children",DW_DLV_OK,res,__LINE__);
+        }
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL cursor %s\n",dwarf_errmsg(error));
+        ++errcount;
+        dwarf_dealloc_error(dbg,error);
+    }
+    check("cursor DIE count",count,i,__LINE__);
+    dwarf_dealloc_die_cursor(cursor);
+}
+
+/*  Start a cursor at the first child of the CU DIE
+    that has children, and compare with its
+    subtree in the full walk. */
+static void
+check_subtree(Dwarf_Debug dbg,Dwarf_Bool is_info,
+    struct walk_s *full)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned end = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (i = 1; i < full->w_count; ++i) {
+        if (full->w_recs[i].r_depth == 1 &&
+            full->w_recs[i].r_has_child) {
+            break;
+        }
+    }
+    if (i >= full->w_count) {
+        return;
+    }
+    for (end = i+1; end < full->w_count; ++end) {
+        if (full->w_recs[end].r_depth <= 1) {
+            break;
+        }
+    }
+    res = dwarf_offdie_b(dbg,full->w_recs[i].r_offset,
+        is_info,&die,&error);
+    check("subtree offdie",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    cursor_walk(dbg,die,0,1,full,i,end-i);
+    dwarf_dealloc_die(die);
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    struct walk_s full;
+    struct walk_s skipped;
+    Dwarf_Unsigned total = 0;
+    Dwarf_Unsigned skippedtotal = 0;
+    int is_info = 0;
+    int res = 0;
+
+    memset(&full,0,sizeof(full));
+    memset(&skipped,0,sizeof(skipped));
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    for (is_info = 1; is_info >= 0; --is_info) {
+        for (;;) {
+            Dwarf_Die cu = 0;
+            Dwarf_Unsigned hdrlen = 0;
+            Dwarf_Half version = 0;
+            Dwarf_Off abbrevoff = 0;
+            Dwarf_Half addrsize = 0;
+            Dwarf_Half offsize = 0;
+            Dwarf_Half extsize = 0;
+            Dwarf_Sig8 sig;
+            Dwarf_Unsigned typeoff = 0;
+            Dwarf_Unsigned nexthdr = 0;
+            Dwarf_Half hdrtype = 0;
+
+            memset(&sig,0,sizeof(sig));
+            res = dwarf_next_cu_header_e(dbg,is_info,&cu,
+                &hdrlen,&version,&abbrevoff,&addrsize,
+                &offsize,&extsize,&sig,&typeoff,&nexthdr,
+                &hdrtype,&error);
+            if (res == DW_DLV_ERROR) {
+                printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+                ++errcount;
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            full.w_count = 0;
+            skipped.w_count = 0;
+            plain_walk(dbg,cu,0,0,&full);
+            plain_walk(dbg,cu,0,1,&skipped);
+            cursor_walk(dbg,cu,0,1,&full,0,full.w_count);
+            cursor_walk(dbg,cu,0,0,&full,0,full.w_count);
+            cursor_walk(dbg,cu,1,1,&skipped,0,skipped.w_count);
+            check_subtree(dbg,(Dwarf_Bool)is_info,&full);
+            total += full.w_count;
+            skippedtotal += skipped.w_count;
+            dwarf_dealloc_die(cu);
+        }
+    }
+    check("DIEs seen",1,total > 50,__LINE__);
+    check("DIEs skipped",1,skippedtotal < total,__LINE__);
+    free(full.w_recs);
+    free(skipped.w_recs);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    if (errcount) {
+        printf("FAIL test_die_cursor %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_die_cursor\n");
+    return 0;
+}
@@ -0,0 +1,376 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_child_reuse(), dwarf_siblingof_reuse()
+    and dwarf_offdie_reuse().
+    Every DIE of test/dummyexecutable.debug,
+    test/testuriLE64ELf.testme and test/test-mach-o-32.dSYM
+    is walked with dwarf_child() and dwarf_siblingof_c()
+    and again keeping one Dwarf_Die per level, and the
+    two walks must see the same DIEs with the same
+    names. The second walk must allocate no more
+    Dwarf_Die than there are levels, and a NO_ENTRY
+    must leave the Dwarf_Die passed in as it was.
+    Then each DIE is looked up by offset into
+    a single Dwarf_Die.
+
+    ./test_die_reuse -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* free() realloc() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+#define MAXDEPTH 100
+
+struct die_rec_s {
+    Dwarf_Off  r_offset;
+    Dwarf_Half r_tag;
+    int        r_depth;
+    char      *r_name;
+};
+
+struct walk_s {
+    struct die_rec_s *w_recs;
+    Dwarf_Unsigned    w_count;
+    Dwarf_Unsigned    w_size;
+    int               w_maxdepth;
+};
+
+/*  The name is a pointer into the section, so it
+    stays valid after the Dwarf_Die changes. */
+static void
+record_die(Dwarf_Debug dbg,Dwarf_Die die,int depth,
+    struct walk_s *w)
+{
+    struct die_rec_s *r = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (w->w_count == w->w_size) {
+        Dwarf_Unsigned newsize = w->w_size?w->w_size*2:256;
+        struct die_rec_s *newrecs = 0;
+
+        newrecs = (struct die_rec_s *)realloc(w->w_recs,
+            (size_t)newsize*sizeof(struct die_rec_s));
+        if (!newrecs) {
+            printf("FAIL out of memory\n");
+            ++errcount;
+            return;
+        }
+        w->w_recs = newrecs;
+        w->w_size = newsize;
+    }
+    r = &w->w_recs[w->w_count++];
+    memset(r,0,sizeof(*r));
+    r->r_depth = depth;
+    if (depth > w->w_maxdepth) {
+        w->w_maxdepth = depth;
+    }
+    res = dwarf_dieoffset(die,&r->r_offset,&error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_tag(die,&r->r_tag,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_diename(die,&r->r_name,&error);
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s\n",dwarf_errmsg(error));
+        ++errcount;
+        dwarf_dealloc_error(dbg,error);
+    }
+}
+
+/*  The usual walk, one Dwarf_Die per DIE. */
+static void
+plain_walk(Dwarf_Debug dbg,Dwarf_Die die,int depth,
+    struct walk_s *w)
+{
+    Dwarf_Die cur = die;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        record_die(dbg,cur,depth,w);
+        res = dwarf_child(cur,&child,&error);
+        if (res == DW_DLV_OK) {
+            plain_walk(dbg,child,depth+1,w);
+            dwarf_dealloc_die(child);
+        } else if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            ++errcount;
+        }
+        if (!depth) {
+            /* A CU DIE has no siblings. */
+            break;
+        }
+        res = dwarf_siblingof_c(cur,&sib,&error);
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                ++errcount;
+            }
+            break;
+        }
+        cur = sib;
+    }
+}
+
+/*  The walk with one Dwarf_Die per level,
+    levels[depth] moving along its sibling list. */
+static void
+reuse_walk(Dwarf_Debug dbg,Dwarf_Die *levels,int depth,
+    struct walk_s *w)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (depth+1 >= MAXDEPTH) {
+        printf("FAIL DIEs nested too deeply\n");
+        ++errcount;
+        return;
+    }
+    for (;;) {
+        Dwarf_Off before = 0;
+        Dwarf_Off after = 0;
+        Dwarf_Die was = levels[depth];
+
+        record_die(dbg,levels[depth],depth,w);
+        res = dwarf_child_reuse(levels[depth],&levels[depth+1],
+            &error);
+        if (res == DW_DLV_OK) {
+            reuse_walk(dbg,levels,depth+1,w);
+        } else if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            ++errcount;
+        }
+        if (!depth) {
+            break;
+        }
+        dwarf_dieoffset(levels[depth],&before,&error);
+        res = dwarf_siblingof_reuse(levels[depth],
+            &levels[depth],&error);
+        check("sibling in place",1,was == levels[depth],
+            __LINE__);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                ++errcount;
+            }
+            dwarf_dieoffset(levels[depth],&after,&error);
+            check("unchanged at end",before,after,__LINE__);
+            break;
+        }
+    }
+}
+
+static void
+compare_walks(const char *name,struct walk_s *a,
+    struct walk_s *b)
+{
+    Dwarf_Unsigned i = 0;
+
+    check("DIE count",a->w_count,b->w_count,__LINE__);
+    for (i = 0; i < a->w_count && i < b->w_count; ++i) {
+        struct die_rec_s *ra = &a->w_recs[i];
+        struct die_rec_s *rb = &b->w_recs[i];
+
+        if (ra->r_offset != rb->r_offset ||
+            ra->r_tag != rb->r_tag ||
+            ra->r_depth != rb->r_depth ||
+            ra->r_name != rb->r_name) {
+            printf("FAIL %s DIE %llu at 0x%llx differs\n",
+                name,(unsigned long long)i,
+                (unsigned long long)ra->r_offset);
+            ++errcount;
+            break;
+        }
+    }
+}
+
+/*  Look up every DIE by offset into one Dwarf_Die. */
+static void
+check_offdie(Dwarf_Debug dbg,Dwarf_Bool is_info,
+    struct walk_s *w,Dwarf_Unsigned first)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Die held = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    for (i = first; i < w->w_count; ++i) {
+        struct die_rec_s *r = &w->w_recs[i];
+        Dwarf_Off off = 0;
+        Dwarf_Half tag = 0;
+        char *diename = 0;
+
+        res = dwarf_offdie_reuse(dbg,r->r_offset,is_info,
+            &die,&error);
+        if (res != DW_DLV_OK) {
+            check("offdie",DW_DLV_OK,res,__LINE__);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            continue;
+        }
+        if (!held) {
+            held = die;
+        }
+        check("offdie in place",1,held == die,__LINE__);
+        dwarf_dieoffset(die,&off,&error);
+        dwarf_tag(die,&tag,&error);
+        dwarf_diename(die,&diename,&error);
+        check("offdie offset",r->r_offset,off,__LINE__);
+        check("offdie tag",r->r_tag,tag,__LINE__);
+        check("offdie name",1,diename == r->r_name,__LINE__);
+    }
+    if (die) {
+        dwarf_dealloc_die(die);
+    }
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    struct walk_s plain;
+    struct walk_s reuse;
+    int is_info = 0;
+    int res = 0;
+
+    memset(&plain,0,sizeof(plain));
+    memset(&reuse,0,sizeof(reuse));
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    for (is_info = 1; is_info >= 0; --is_info) {
+        Dwarf_Unsigned first = plain.w_count;
+
+        for (;;) {
+            Dwarf_Die levels[MAXDEPTH];
+            Dwarf_Unsigned before = 0;
+            Dwarf_Unsigned after = 0;
+            Dwarf_Unsigned hdrlen = 0;
+            Dwarf_Half version = 0;
+            Dwarf_Off abbrevoff = 0;
+            Dwarf_Half addrsize = 0;
+            Dwarf_Half offsize = 0;
+            Dwarf_Half extsize = 0;
+            Dwarf_Sig8 sig;
+            Dwarf_Unsigned typeoff = 0;
+            Dwarf_Unsigned nexthdr = 0;
+            Dwarf_Half hdrtype = 0;
+            int d = 0;
+
+            memset(levels,0,sizeof(levels));
+            memset(&sig,0,sizeof(sig));
+            res = dwarf_next_cu_header_e(dbg,is_info,&levels[0],
+                &hdrlen,&version,&abbrevoff,&addrsize,
+                &offsize,&extsize,&sig,&typeoff,&nexthdr,
+                &hdrtype,&error);
+            if (res == DW_DLV_ERROR) {
+                printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+                ++errcount;
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            plain_walk(dbg,levels[0],0,&plain);
+            dwarf_get_alloc_type_counts(dbg,DW_DLA_DIE,
+                0,&before,0,0);
+            reuse_walk(dbg,levels,0,&reuse);
+            dwarf_get_alloc_type_counts(dbg,DW_DLA_DIE,
+                0,&after,0,0);
+            /*  At most one new Dwarf_Die per level below
+                the CU DIE. */
+            check("DIEs allocated",1,
+                after - before <= (Dwarf_Unsigned)reuse.w_maxdepth,
+                __LINE__);
+            for (d = 0; d < MAXDEPTH; ++d) {
+                if (levels[d]) {
+                    dwarf_dealloc_die(levels[d]);
+                }
+            }
+        }
+        check_offdie(dbg,(Dwarf_Bool)is_info,&plain,first);
+    }
+    check("DIEs seen",1,plain.w_count > 50,__LINE__);
+    compare_walks(name,&plain,&reuse);
+    free(plain.w_recs);
+    free(reuse.w_recs);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_child_reuse(0,0,&error);
+    check("null die",DW_DLV_ERROR,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,error);
+    }
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    if (errcount) {
+        printf("FAIL test_die_reuse %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_die_reuse\n");
+    return 0;
+}
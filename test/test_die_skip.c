@@ -0,0 +1,496 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that stepping over DIEs (which uses the
+    abbrev skip plans) lands on the right sibling.
+    A .debug_info is built in memory (as in
+    jitreader.c) with DIEs using every kind of FORM a
+    skip plan handles: fixed sizes, LEB numbers,
+    blocks of each length size, exprloc and strings,
+    and no DW_AT_sibling.  The same tree is in five
+    CUs sharing one abbrev table, each differing from
+    the one before in just the version, the address
+    size or the offset size, so the FORM sizes change
+    from CU to CU.
+    A walk with dwarf_child() and dwarf_siblingof_c()
+    must see every DIE as built, and from each DIE
+    looked up alone by offset dwarf_siblingof_c() must
+    give the first DIE after all its children (or
+    DW_DLV_NO_ENTRY if there is none at its level). */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, children, DW_AT_name string */
+0x01, 0x11, 0x01, 0x03, 0x08, 0x00, 0x00,
+/*  2: DW_TAG_subprogram, children, DW_AT_name string,
+    DW_AT_low_pc addr, DW_AT_high_pc data8,
+    DW_AT_frame_base exprloc, DW_AT_decl_line udata,
+    DW_AT_decl_file data1, DW_AT_type ref4 */
+0x02, 0x2e, 0x01, 0x03, 0x08, 0x11, 0x01, 0x12, 0x07,
+0x40, 0x18, 0x3b, 0x0f, 0x3a, 0x0b, 0x49, 0x13, 0x00, 0x00,
+/*  3: DW_TAG_variable, no children, DW_AT_name string,
+    DW_AT_location block1, DW_AT_const_value sdata,
+    DW_AT_decl_line data2, DW_AT_type ref_addr */
+0x03, 0x34, 0x00, 0x03, 0x08, 0x02, 0x0a, 0x1c, 0x0d,
+0x3b, 0x05, 0x49, 0x10, 0x00, 0x00,
+/*  4: DW_TAG_lexical_block, children, DW_AT_low_pc addr,
+    DW_AT_high_pc data4, DW_AT_external flag_present */
+0x04, 0x0b, 0x01, 0x11, 0x01, 0x12, 0x06, 0x3f, 0x19,
+0x00, 0x00,
+/*  5: DW_TAG_base_type, no children, DW_AT_byte_size data1,
+    DW_AT_encoding data1, DW_AT_const_value data16 */
+0x05, 0x24, 0x00, 0x0b, 0x0b, 0x3e, 0x0b, 0x1c, 0x1e,
+0x00, 0x00,
+/*  6: DW_TAG_member, no children, DW_AT_name string,
+    DW_AT_data_member_location block2,
+    DW_AT_description block4, DW_AT_count block */
+0x06, 0x0d, 0x00, 0x03, 0x08, 0x38, 0x03, 0x5a, 0x04,
+0x37, 0x09, 0x00, 0x00,
+0x00 };
+
+/*  The DIE tree of every CU in pre-order: depth and
+    abbrev code.  Abbrevs 1, 2 and 4 have children. */
+struct node_s {
+    unsigned n_depth;
+    unsigned n_abbrev;
+};
+static struct node_s tree[] = {
+{0,1},
+{1,2},
+{2,3},
+{2,4},
+{3,3},
+{3,6},
+{3,4},
+{2,5},
+{2,3},
+{1,2},
+{1,5},
+{1,4},
+{2,6},
+{1,6},
+{1,2},
+{2,4},
+{3,4},
+{4,3},
+{1,3}
+};
+#define NODECOUNT (sizeof(tree)/sizeof(tree[0]))
+
+#define CUCOUNT 5
+struct cu_s {
+    Dwarf_Half     c_version;
+    Dwarf_Small    c_address_size;
+    Dwarf_Small    c_offset_size;
+};
+static struct cu_s cus[CUCOUNT] = {
+{4,8,4},
+{2,8,4},
+{2,4,4},
+{4,4,4},
+{4,4,8}
+};
+
+static Dwarf_Small infobytes[10000];
+
+#define SECCOUNT 2
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",0,infobytes}
+};
+static struct testobj_s testobj;
+
+/*  Each DIE as built. */
+static Dwarf_Off dieoffsets[CUCOUNT][NODECOUNT];
+
+static void
+put_n(Dwarf_Unsigned *off,Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        infobytes[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+static void
+put_uleb(Dwarf_Unsigned *off,Dwarf_Unsigned v)
+{
+    do {
+        Dwarf_Small b = (Dwarf_Small)(v & 0x7f);
+
+        v >>= 7;
+        if (v) {
+            b |= 0x80;
+        }
+        infobytes[(*off)++] = b;
+    } while (v);
+}
+
+static void
+put_sleb(Dwarf_Unsigned *off,Dwarf_Signed v)
+{
+    for (;;) {
+        Dwarf_Small b = (Dwarf_Small)(v & 0x7f);
+
+        v >>= 7;
+        if ((v == 0 && !(b & 0x40)) ||
+            (v == -1 && (b & 0x40))) {
+            infobytes[(*off)++] = b;
+            return;
+        }
+        infobytes[(*off)++] = b | 0x80;
+    }
+}
+
+/*  A name of i%7+1 letters. */
+static void
+put_name(Dwarf_Unsigned *off,unsigned i)
+{
+    unsigned j = 0;
+
+    for (j = 0; j <= i%7; ++j) {
+        put_n(off,'a'+j,1);
+    }
+    put_n(off,0,1);
+}
+
+/*  len bytes of block content. */
+static void
+put_block(Dwarf_Unsigned *off,unsigned len)
+{
+    unsigned j = 0;
+
+    for (j = 0; j < len; ++j) {
+        put_n(off,j+1,1);
+    }
+}
+
+/*  The attribute values of tree[i] in a CU like c,
+    varied with i so the variable sizes differ. */
+static void
+put_die(Dwarf_Unsigned *off,struct cu_s *c,unsigned i)
+{
+    unsigned abbrev = tree[i].n_abbrev;
+    Dwarf_Small refaddrsize = (c->c_version == 2)?
+        c->c_address_size:c->c_offset_size;
+
+    put_uleb(off,abbrev);
+    switch (abbrev) {
+    case 1:
+        put_name(off,i);
+        break;
+    case 2:
+        put_name(off,i);
+        put_n(off,0x1000+i*0x10,c->c_address_size);
+        put_n(off,0x10,8);
+        put_uleb(off,2);
+        put_n(off,0x91,1);
+        put_n(off,0x70,1);
+        put_uleb(off,(Dwarf_Unsigned)i*300);
+        put_n(off,1,1);
+        put_n(off,0x20,4);
+        break;
+    case 3:
+        put_name(off,i);
+        put_n(off,i%5,1);
+        put_block(off,i%5);
+        put_sleb(off,(i%2)? -(Dwarf_Signed)i*70000:
+            -(Dwarf_Signed)i);
+        put_n(off,i,2);
+        put_n(off,0x20,refaddrsize);
+        break;
+    case 4:
+        put_n(off,0x1000+i*0x10,c->c_address_size);
+        put_n(off,8,4);
+        break;
+    case 5:
+        put_n(off,4,1);
+        put_n(off,DW_ATE_signed,1);
+        put_n(off,i,8);
+        put_n(off,0,8);
+        break;
+    case 6:
+        put_name(off,i);
+        put_n(off,i%3+1,2);
+        put_block(off,i%3+1);
+        put_n(off,i%4,4);
+        put_block(off,i%4);
+        put_uleb(off,i*40);
+        put_block(off,i*40);
+        break;
+    default:
+        break;
+    }
+}
+
+static Dwarf_Bool
+has_children(unsigned i)
+{
+    unsigned abbrev = tree[i].n_abbrev;
+
+    return abbrev == 1 || abbrev == 2 || abbrev == 4;
+}
+
+static void
+build_info(void)
+{
+    Dwarf_Unsigned off = 0;
+    unsigned k = 0;
+
+    for (k = 0; k < CUCOUNT; ++k) {
+        struct cu_s *c = cus + k;
+        Dwarf_Unsigned lenoff = 0;
+        Dwarf_Unsigned start = 0;
+        unsigned open = 0;
+        unsigned i = 0;
+
+        if (c->c_offset_size == 8) {
+            put_n(&off,0xffffffff,4);
+        }
+        lenoff = off;
+        put_n(&off,0,c->c_offset_size); /* unit_length, below */
+        start = off;
+        put_n(&off,c->c_version,2);
+        put_n(&off,0,c->c_offset_size); /* debug_abbrev_offset */
+        put_n(&off,c->c_address_size,1);
+        for (i = 0; i < NODECOUNT; ++i) {
+            /*  Null entries end the children of
+                the DIEs left open. */
+            for ( ; open > tree[i].n_depth; --open) {
+                put_n(&off,0,1);
+            }
+            dieoffsets[k][i] = off;
+            put_die(&off,c,i);
+            if (has_children(i)) {
+                open = tree[i].n_depth+1;
+            }
+        }
+        for ( ; open; --open) {
+            put_n(&off,0,1);
+        }
+        put_n(&lenoff,off - start,c->c_offset_size);
+    }
+    sectiondata[1].ts_size = off;
+}
+
+/*  Index of the sibling of tree[i], or NODECOUNT if
+    it has none. */
+static unsigned
+sibling_of(unsigned i)
+{
+    unsigned j = 0;
+
+    for (j = i+1; j < NODECOUNT; ++j) {
+        if (tree[j].n_depth < tree[i].n_depth) {
+            break;
+        }
+        if (tree[j].n_depth == tree[i].n_depth) {
+            return j;
+        }
+    }
+    return NODECOUNT;
+}
+
+static void
+report(Dwarf_Debug dbg,int res,Dwarf_Error error,int line)
+{
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL line %d: %s\n",line,dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+    }
+}
+
+/*  Walks die, which is tree[*ip] of CU k, and its
+    siblings and their children, counting *ip on.
+    Deallocates die. */
+static void
+walk_die(Dwarf_Debug dbg,unsigned k,Dwarf_Die die,unsigned *ip)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    while (die) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Off off = 0;
+
+        dwarf_dieoffset(die,&off,&error);
+        if (*ip >= NODECOUNT) {
+            check("DIE beyond the tree",0,off,__LINE__);
+            dwarf_dealloc_die(die);
+            return;
+        }
+        check("walk offset",dieoffsets[k][*ip],off,__LINE__);
+        ++*ip;
+        res = dwarf_child(die,&child,&error);
+        report(dbg,res,error,__LINE__);
+        if (res == DW_DLV_OK) {
+            walk_die(dbg,k,child,ip);
+        }
+        res = dwarf_siblingof_c(die,&sib,&error);
+        report(dbg,res,error,__LINE__);
+        dwarf_dealloc_die(die);
+        die = (res == DW_DLV_OK)? sib:0;
+    }
+}
+
+static void
+check_walk(Dwarf_Debug dbg)
+{
+    unsigned k = 0;
+
+    for (k = 0; ; ++k) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        Dwarf_Error error = 0;
+        unsigned i = 0;
+        int res = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            &cu_header_length,&version_stamp,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_header,
+            &header_cu_type,&error);
+        if (res != DW_DLV_OK) {
+            report(dbg,res,error,__LINE__);
+            break;
+        }
+        if (k >= CUCOUNT) {
+            check("more CUs than built",CUCOUNT,k+1,__LINE__);
+            dwarf_dealloc_die(cu_die);
+            break;
+        }
+        check("version",cus[k].c_version,version_stamp,__LINE__);
+        check("offset size",cus[k].c_offset_size,length_size,
+            __LINE__);
+        walk_die(dbg,k,cu_die,&i);
+        check("DIEs walked",NODECOUNT,i,__LINE__);
+    }
+    check("CUs walked",CUCOUNT,k,__LINE__);
+}
+
+/*  Each DIE looked up alone, so reaching its sibling
+    means stepping over all its children. */
+static void
+check_siblings(Dwarf_Debug dbg)
+{
+    unsigned k = 0;
+    unsigned i = 0;
+
+    for (k = 0; k < CUCOUNT; ++k) {
+        for (i = 0; i < NODECOUNT; ++i) {
+            unsigned s = sibling_of(i);
+            Dwarf_Die die = 0;
+            Dwarf_Die sib = 0;
+            Dwarf_Off off = 0;
+            Dwarf_Error error = 0;
+            int res = 0;
+
+            res = dwarf_offdie_b(dbg,dieoffsets[k][i],TRUE,
+                &die,&error);
+            check("offdie res",DW_DLV_OK,res,__LINE__);
+            if (res != DW_DLV_OK) {
+                report(dbg,res,error,__LINE__);
+                continue;
+            }
+            res = dwarf_siblingof_c(die,&sib,&error);
+            if (s == NODECOUNT) {
+                check("no sibling",DW_DLV_NO_ENTRY,res,__LINE__);
+            } else {
+                check("sibling res",DW_DLV_OK,res,__LINE__);
+            }
+            if (res == DW_DLV_OK) {
+                dwarf_dieoffset(sib,&off,&error);
+                if (s < NODECOUNT) {
+                    check("sibling offset",dieoffsets[k][s],off,
+                        __LINE__);
+                }
+                dwarf_dealloc_die(sib);
+            } else {
+                report(dbg,res,error,__LINE__);
+            }
+            dwarf_dealloc_die(die);
+        }
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    build_info();
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_walk(dbg);
+    check_siblings(dbg);
+    dwarf_object_finish(dbg);
+    /*  Again with the DIEs looked up before any walk. */
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_siblings(dbg);
+    check_walk(dbg);
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_die_skip %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_die_skip\n");
+    return 0;
+}
@@ -0,0 +1,442 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_dnames_find_name() and
+    dwarf_dnames_find_names().
+    A .debug_names table and its .debug_str are built
+    in memory (as in jitreader.c) with several bucket
+    counts, including none, so names share buckets and
+    some buckets are empty.  Every name must give
+    exactly its DIEs, in order, with their tags and
+    unit offsets.  Entries in a foreign type unit must
+    be left out.  Names differing only in case hash
+    alike but must not match.  The batch form must
+    agree with single lookups, also when its arrays
+    are too short. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() sprintf() */
+#include <string.h> /* memcpy() strcpy() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+#define NAMECOUNT 200
+#define MAXENTRIES 4
+#define CU1OFFSET 0x100
+#define FOREIGNSIG 0x89abcdef
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children, DW_AT_name DW_FORM_string */
+0x01, 0x11, 0x00, 0x03, 0x08, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x0c, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00 }; /* abbrev 1, "t.c" */
+
+/*  Filled in by build_tables(). */
+static Dwarf_Small strbytes[4000];
+static Dwarf_Small namesbytes[20000];
+
+#define SECCOUNT 4
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_str",0,strbytes},
+{".debug_names",0,namesbytes}
+};
+static struct testobj_s testobj;
+
+/*  names[0] and names[1] differ only in case. */
+static char names[NAMECOUNT][16];
+/*  Index into names[] of each name table entry. */
+static unsigned order[NAMECOUNT];
+
+/*  Written out independently of the library. */
+static Dwarf_Unsigned
+djb_hash(const char *s)
+{
+    Dwarf_Unsigned h = 5381;
+
+    for ( ; *s; ++s) {
+        unsigned c = (unsigned char)*s;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = (h*33 + c) & 0xffffffff;
+    }
+    return h;
+}
+
+/*  The DIEs the table lists for names[n]:
+    1 to 3 in alternate CUs, the first a subprogram. */
+static unsigned
+entry_count(unsigned n)
+{
+    return 1 + n%3;
+}
+static Dwarf_Unsigned
+entry_cu(unsigned n,unsigned k)
+{
+    return (n+k)%2;
+}
+static Dwarf_Unsigned
+entry_die(unsigned n,unsigned k)
+{
+    return 0x20 + 8*n + k;
+}
+static Dwarf_Half
+entry_tag(unsigned k)
+{
+    return k? DW_TAG_variable:DW_TAG_subprogram;
+}
+
+static void
+put_bytes(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    const void *v,Dwarf_Unsigned len)
+{
+    memcpy(buf + *off,v,(size_t)len);
+    *off += len;
+}
+static void
+put_n(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        buf[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+static void
+put_uleb(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    Dwarf_Unsigned v)
+{
+    do {
+        Dwarf_Small b = (Dwarf_Small)(v & 0x7f);
+
+        v >>= 7;
+        buf[(*off)++] = v? (b|0x80):b;
+    } while (v);
+}
+
+/*  Builds .debug_str and a .debug_names table with
+    bucketcount buckets.  Names are in bucket order,
+    as the hash table requires. Every fifth name also
+    has a DIE in a foreign type unit. */
+static void
+build_tables(unsigned bucketcount)
+{
+    static Dwarf_Small abbrevs[] = {
+    0x01, 0x2e, 0x01, 0x0f, 0x03, 0x13, 0x00, 0x00,
+    0x02, 0x34, 0x01, 0x0f, 0x03, 0x13, 0x00, 0x00,
+    /* 3: DW_IDX_type_unit DW_FORM_data1 */
+    0x03, 0x24, 0x02, 0x0b, 0x03, 0x13, 0x00, 0x00,
+    0x00 };
+    Dwarf_Unsigned stroff[NAMECOUNT];
+    Dwarf_Unsigned pooloff[NAMECOUNT];
+    Dwarf_Small pool[NAMECOUNT*32];
+    Dwarf_Unsigned poolsize = 0;
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned b = 0;
+    unsigned i = 0;
+    unsigned j = 0;
+    unsigned k = 0;
+
+    /*  .debug_str starts with an empty string. */
+    strbytes[off++] = 0;
+    for (i = 0; i < NAMECOUNT; ++i) {
+        stroff[i] = off;
+        put_bytes(strbytes,&off,names[i],strlen(names[i])+1);
+        order[i] = i;
+    }
+    sectiondata[2].ts_size = off;
+
+    for (i = 1; bucketcount && i < NAMECOUNT; ++i) {
+        unsigned n = order[i];
+        Dwarf_Unsigned nb = djb_hash(names[n])%bucketcount;
+
+        for (j = i; j > 0 &&
+            djb_hash(names[order[j-1]])%bucketcount > nb; --j) {
+            order[j] = order[j-1];
+        }
+        order[j] = n;
+    }
+    for (i = 0; i < NAMECOUNT; ++i) {
+        unsigned n = order[i];
+
+        pooloff[i] = poolsize;
+        for (k = 0; k < entry_count(n); ++k) {
+            put_uleb(pool,&poolsize,k?2:1);
+            put_uleb(pool,&poolsize,entry_cu(n,k));
+            put_n(pool,&poolsize,entry_die(n,k),4);
+        }
+        if (!(n%5)) {
+            put_uleb(pool,&poolsize,3);
+            put_n(pool,&poolsize,0,1);
+            put_n(pool,&poolsize,0x30,4);
+        }
+        put_uleb(pool,&poolsize,0);
+    }
+
+    off = 4;
+    put_n(namesbytes,&off,5,2);          /* version */
+    put_n(namesbytes,&off,0,2);          /* padding */
+    put_n(namesbytes,&off,2,4);          /* comp_unit_count */
+    put_n(namesbytes,&off,0,4);          /* local_type_unit_count */
+    put_n(namesbytes,&off,1,4);          /* foreign_type_unit_count */
+    put_n(namesbytes,&off,bucketcount,4);
+    put_n(namesbytes,&off,NAMECOUNT,4);
+    put_n(namesbytes,&off,sizeof(abbrevs),4);
+    put_n(namesbytes,&off,0,4);          /* augmentation size */
+    put_n(namesbytes,&off,0,4);
+    put_n(namesbytes,&off,CU1OFFSET,4);
+    put_n(namesbytes,&off,FOREIGNSIG,8);
+    for (b = 0; b < bucketcount; ++b) {
+        Dwarf_Unsigned first = 0;
+
+        for (i = 0; i < NAMECOUNT; ++i) {
+            if (djb_hash(names[order[i]])%bucketcount == b) {
+                first = i+1;
+                break;
+            }
+        }
+        put_n(namesbytes,&off,first,4);
+    }
+    for (i = 0; bucketcount && i < NAMECOUNT; ++i) {
+        put_n(namesbytes,&off,djb_hash(names[order[i]]),4);
+    }
+    for (i = 0; i < NAMECOUNT; ++i) {
+        put_n(namesbytes,&off,stroff[order[i]],4);
+    }
+    for (i = 0; i < NAMECOUNT; ++i) {
+        put_n(namesbytes,&off,pooloff[i],4);
+    }
+    put_bytes(namesbytes,&off,abbrevs,sizeof(abbrevs));
+    put_bytes(namesbytes,&off,pool,poolsize);
+    b = 0;
+    put_n(namesbytes,&b,off-4,4);        /* unit_length */
+    sectiondata[3].ts_size = off;
+}
+
+/*  Checks the DIEs found for names[n] starting at
+    entry first of the arrays. */
+static void
+check_entries(unsigned n,Dwarf_Unsigned count,
+    Dwarf_Unsigned first,Dwarf_Half *tags,
+    Dwarf_Unsigned *units,Dwarf_Unsigned *dies,int line)
+{
+    unsigned k = 0;
+
+    check("entry count",entry_count(n),count,line);
+    for (k = 0; k < entry_count(n) && k < count; ++k) {
+        Dwarf_Unsigned unit = entry_cu(n,k)? CU1OFFSET:0;
+
+        check("tag",entry_tag(k),tags[first+k],line);
+        check("unit offset",unit,units[first+k],line);
+        check("die offset",unit + entry_die(n,k),
+            dies[first+k],line);
+    }
+}
+
+static void
+check_missing(Dwarf_Dnames_Head dn,const char *name)
+{
+    Dwarf_Half tag = 0;
+    Dwarf_Unsigned unit = 0;
+    Dwarf_Unsigned die = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_dnames_find_name(dn,name,1,&tag,&unit,&die,
+        &count,&error);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL \"%s\" res %d\n",name,res);
+        ++errcount;
+    }
+}
+
+static void
+check_batch(Dwarf_Debug dbg,Dwarf_Dnames_Head dn)
+{
+    /*  Every name, with a NULL and a missing name
+        mixed in. */
+    const char *batch[NAMECOUNT+2];
+    Dwarf_Unsigned first[NAMECOUNT+3];
+    Dwarf_Half tags[NAMECOUNT*MAXENTRIES];
+    Dwarf_Unsigned units[NAMECOUNT*MAXENTRIES];
+    Dwarf_Unsigned dies[NAMECOUNT*MAXENTRIES];
+    Dwarf_Unsigned total = 0;
+    Dwarf_Error error = 0;
+    unsigned m = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < NAMECOUNT; ++i) {
+        batch[m++] = names[i];
+        total += entry_count(i);
+        if (i == 5) {
+            batch[m++] = 0;
+        }
+        if (i == 7) {
+            batch[m++] = "nothere";
+        }
+    }
+    res = dwarf_dnames_find_names(dn,batch,m,first,
+        NAMECOUNT*MAXENTRIES,tags,units,dies,&error);
+    check("batch",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    check("batch total",total,first[m],__LINE__);
+    for (i = 0, m = 0; i < NAMECOUNT; ++i, ++m) {
+        check_entries(i,first[m+1]-first[m],first[m],
+            tags,units,dies,__LINE__);
+        if (i == 5 || i == 7) {
+            ++m;
+            check("nothing found",first[m],first[m+1],
+                __LINE__);
+        }
+    }
+    /*  Arrays too short: still all counted. */
+    res = dwarf_dnames_find_names(dn,batch,m,first,3,
+        tags,units,dies,&error);
+    check("short batch",DW_DLV_OK,res,__LINE__);
+    check("short batch total",total,first[m],__LINE__);
+    check_entries(0,first[1],0,tags,units,dies,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+    }
+}
+
+static void
+check_table(unsigned bucketcount)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Off next = 0;
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    build_tables(bucketcount);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    res = dwarf_dnames_header(dbg,0,&dn,&next,&error);
+    check("dnames header",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s\n",dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        }
+        dwarf_object_finish(dbg);
+        return;
+    }
+    for (i = 0; i < NAMECOUNT; ++i) {
+        Dwarf_Half tags[MAXENTRIES];
+        Dwarf_Unsigned units[MAXENTRIES];
+        Dwarf_Unsigned dies[MAXENTRIES];
+        Dwarf_Unsigned count = 0;
+
+        res = dwarf_dnames_find_name(dn,names[i],MAXENTRIES,
+            tags,units,dies,&count,&error);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %u buckets: %s res %d\n",
+                bucketcount,names[i],res);
+            ++errcount;
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            continue;
+        }
+        check_entries(i,count,0,tags,units,dies,__LINE__);
+        /*  With no arrays only the count is returned. */
+        count = 0;
+        res = dwarf_dnames_find_name(dn,names[i],0,0,0,0,
+            &count,&error);
+        check("count only",entry_count(i),count,__LINE__);
+    }
+    check_missing(dn,"");
+    check_missing(dn,"nothere");
+    check_missing(dn,"MIXEDCASE");
+    check_missing(dn,"n10");
+    check_missing(dn,"n10_vx");
+    check_missing(dn,"N10_v");
+    check_batch(dbg,dn);
+    res = dwarf_dnames_find_name(dn,0,0,0,0,0,&next,&error);
+    check("NULL name",DW_DLV_ERROR,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        check("NULL name error",DW_DLE_IA,
+            dwarf_errno(error),__LINE__);
+        dwarf_dealloc_error(dbg,error);
+    }
+    dwarf_dealloc_dnames(dn);
+    dwarf_object_finish(dbg);
+}
+
+int
+main(void)
+{
+    static const unsigned bucketcounts[] =
+        {0,1,7,37,1024};
+    unsigned i = 0;
+
+    strcpy(names[0],"MixedCase");
+    strcpy(names[1],"mixedcase");
+    for (i = 2; i < NAMECOUNT; ++i) {
+        sprintf(names[i],"n%u_v",i);
+    }
+    check("same hash",djb_hash(names[0]),djb_hash(names[1]),
+        __LINE__);
+    for (i = 0; i < sizeof(bucketcounts)/sizeof(unsigned);
+        ++i) {
+        check_table(bucketcounts[i]);
+    }
+    if (errcount) {
+        printf("FAIL test_dnames_find %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_dnames_find\n");
+    return 0;
+}
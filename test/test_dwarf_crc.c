@@ -0,0 +1,202 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_basic_crc32() against the plain
+    bit at a time crc definition, for every length
+    and alignment up to a few blocks, and for
+    crc values chained across calls.
+
+    With --bench also times dwarf_basic_crc32()
+    against the byte at a time table loop it
+    replaced. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* malloc() free() */
+#include <string.h> /* strcmp() */
+#include <time.h>   /* clock() */
+
+#include "libdwarf.h"
+
+static int errcount;
+
+/*  The reference: the crc32 definition with
+    no tables at all. */
+static unsigned int
+bitwise_crc32(const unsigned char *buf,unsigned long len,
+    unsigned int crc)
+{
+    unsigned long i = 0;
+
+    crc = ~crc;
+    for (i = 0; i < len; ++i) {
+        int k = 0;
+
+        crc ^= buf[i];
+        for (k = 0; k < 8; ++k) {
+            crc = (crc & 1)? (crc >> 1) ^ 0xedb88320:
+                (crc >> 1);
+        }
+    }
+    return ~crc & 0xffffffff;
+}
+
+/*  The byte at a time table loop as libdwarf
+    had it before slicing-by-8. For --bench. */
+static unsigned int bytewise_table[256];
+static void
+make_bytewise_table(void)
+{
+    unsigned int i = 0;
+
+    for (i = 0; i < 256; ++i) {
+        unsigned int c = i;
+        int k = 0;
+
+        for (k = 0; k < 8; ++k) {
+            c = (c & 1)? (c >> 1) ^ 0xedb88320: (c >> 1);
+        }
+        bytewise_table[i] = c;
+    }
+}
+static unsigned int
+bytewise_crc32(const unsigned char *buf,unsigned long len,
+    unsigned int crc)
+{
+    const unsigned char *end = buf + len;
+
+    crc = ~crc;
+    for ( ; buf < end; ++buf)
+        crc = bytewise_table[(crc ^ *buf) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void
+check(const char *msg,unsigned long len,unsigned int off,
+    unsigned int expect,unsigned int got,int line)
+{
+    if (expect == got) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s len %lu offset %u expected 0x%08x"
+        " got 0x%08x line %d\n",msg,len,off,expect,got,line);
+}
+
+static void
+run_checks(void)
+{
+    unsigned char buf[200];
+    unsigned long len = 0;
+    unsigned int off = 0;
+    unsigned int seed = 12345;
+    unsigned int i = 0;
+    const char *known = "123456789";
+
+    for (i = 0; i < sizeof(buf); ++i) {
+        seed = seed*1103515245 + 12345;
+        buf[i] = (unsigned char)(seed >> 16);
+    }
+    /*  The standard check value. */
+    check("check value",9,0,0xcbf43926,
+        dwarf_basic_crc32((const unsigned char *)known,9,0),
+        __LINE__);
+    check("null buffer",0,0,0,
+        dwarf_basic_crc32(0,10,0),__LINE__);
+    for (off = 0; off < 8; ++off) {
+        for (len = 0; len + off <= 80; ++len) {
+            unsigned int expect = bitwise_crc32(buf+off,len,0);
+
+            check("one call",len,off,expect,
+                dwarf_basic_crc32(buf+off,len,0),__LINE__);
+        }
+    }
+    /*  Split at every point: the second call continues
+        from the crc of the first. */
+    for (len = 0; len <= 150; ++len) {
+        unsigned int expect = bitwise_crc32(buf+3,150,0);
+        unsigned int c = dwarf_basic_crc32(buf+3,len,0);
+
+        c = dwarf_basic_crc32(buf+3+len,150-len,c);
+        check("chained",len,3,expect,c,__LINE__);
+    }
+}
+
+static void
+run_bench(void)
+{
+    unsigned long size = 64*1024*1024;
+    unsigned char *big = 0;
+    unsigned long i = 0;
+    clock_t t = 0;
+    double told = 0.0;
+    double tnew = 0.0;
+    unsigned int cold = 0;
+    unsigned int cnew = 0;
+
+    big = (unsigned char *)malloc(size);
+    if (!big) {
+        printf("FAIL bench: no memory\n");
+        ++errcount;
+        return;
+    }
+    for (i = 0; i < size; ++i) {
+        big[i] = (unsigned char)(i*7 + (i >> 11));
+    }
+    make_bytewise_table();
+    t = clock();
+    cold = bytewise_crc32(big,size,0);
+    told = (double)(clock() - t)/CLOCKS_PER_SEC;
+    t = clock();
+    cnew = dwarf_basic_crc32(big,size,0);
+    tnew = (double)(clock() - t)/CLOCKS_PER_SEC;
+    check("bench",size,0,cold,cnew,__LINE__);
+    printf("crc32 of %lu MiB: byte at a time %.3f s,"
+        " dwarf_basic_crc32 %.3f s",size >> 20,told,tnew);
+    if (tnew > 0.0) {
+        printf(" (%.1fx)",told/tnew);
+    }
+    printf("\n");
+    free(big);
+}
+
+int
+main(int argc, char **argv)
+{
+    run_checks();
+    if (argc > 1 && !strcmp(argv[1],"--bench")) {
+        run_bench();
+    }
+    if (errcount) {
+        printf("FAIL test_dwarf_crc %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_dwarf_crc\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks the decompressed-section cache in
+    dwarf_decompress_cache.c directly: a second
+    load of the same compressed bytes is a hit,
+    a forced key collision (same key and lengths,
+    different bytes) is a miss, and sections in use
+    are kept past the budget until released. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* malloc() free() */
+#include <string.h> /* memcpy() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_decompress_cache.h"
+
+#define COMPLEN   64
+#define UNCOMPLEN 1000
+
+static int errcount;
+
+static void
+check(const char *msg,Dwarf_Unsigned expect,
+    Dwarf_Unsigned got,int line)
+{
+    if (expect == got) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s expected %llu got %llu line %d\n",msg,
+        (unsigned long long)expect,(unsigned long long)got,
+        line);
+}
+
+static void
+check_stats(const char *msg,Dwarf_Unsigned bytes,
+    Dwarf_Unsigned entries,Dwarf_Unsigned hits,
+    Dwarf_Unsigned misses,Dwarf_Unsigned evictions,int line)
+{
+    Dwarf_Unsigned b = 0;
+    Dwarf_Unsigned e = 0;
+    Dwarf_Unsigned h = 0;
+    Dwarf_Unsigned m = 0;
+    Dwarf_Unsigned v = 0;
+
+    dwarf_get_decompressed_section_cache_stats(&b,&e,&h,&m,&v);
+    check(msg,bytes,b,line);
+    check(msg,entries,e,line);
+    check(msg,hits,h,line);
+    check(msg,misses,m,line);
+    check(msg,evictions,v,line);
+}
+
+/*  Stands in for decompressing: contents
+    that depend on the compressed bytes. */
+static Dwarf_Small *
+fake_decompress(Dwarf_Small *src)
+{
+    Dwarf_Small *d = (Dwarf_Small *)malloc(UNCOMPLEN);
+    unsigned i = 0;
+
+    if (!d) {
+        printf("FAIL out of memory\n");
+        exit(1);
+    }
+    for (i = 0; i < UNCOMPLEN; ++i) {
+        d[i] = (Dwarf_Small)(src[i % COMPLEN] + i);
+    }
+    return d;
+}
+
+/*  Loads a section the way dwarf_init_finish.c does:
+    look up, and on a miss decompress and insert.
+    Returns the entry, which the caller releases,
+    or NULL if not cached, and then the caller
+    owns *data_out. */
+static struct Dwarf_Dcache_Entry_s *
+load_section(Dwarf_Small *src,Dwarf_Unsigned key,
+    Dwarf_Small **data_out)
+{
+    struct Dwarf_Dcache_Entry_s *e = 0;
+    Dwarf_Small *data = 0;
+
+    e = _dwarf_dcache_lookup(key,src,COMPLEN,UNCOMPLEN,&data);
+    if (e) {
+        *data_out = data;
+        return e;
+    }
+    data = fake_decompress(src);
+    e = _dwarf_dcache_insert(key,src,COMPLEN,UNCOMPLEN,data);
+    *data_out = data;
+    return e;
+}
+
+static void
+run_checks(void)
+{
+    Dwarf_Small a[COMPLEN];
+    Dwarf_Small a2[COMPLEN];
+    Dwarf_Small b[COMPLEN];
+    Dwarf_Unsigned akey = 0;
+    Dwarf_Unsigned entbytes = UNCOMPLEN + COMPLEN;
+    struct Dwarf_Dcache_Entry_s *e1 = 0;
+    struct Dwarf_Dcache_Entry_s *e2 = 0;
+    struct Dwarf_Dcache_Entry_s *e3 = 0;
+    Dwarf_Small *d1 = 0;
+    Dwarf_Small *d2 = 0;
+    Dwarf_Small *d3 = 0;
+    Dwarf_Small *expect = 0;
+    unsigned i = 0;
+
+    for (i = 0; i < COMPLEN; ++i) {
+        a[i] = (Dwarf_Small)(i*7 + 1);
+        b[i] = a[i];
+    }
+    b[COMPLEN/2] ^= 0x55;
+    /*  The same bytes at another address, as
+        a second open of the object has. */
+    memcpy(a2,a,COMPLEN);
+    akey = _dwarf_dcache_key(a,COMPLEN);
+    check("key of copy",akey,_dwarf_dcache_key(a2,COMPLEN),
+        __LINE__);
+
+    check("disabled",0,_dwarf_dcache_enabled(),__LINE__);
+    dwarf_set_decompressed_section_cache_size(10*entbytes);
+    check("enabled",1,_dwarf_dcache_enabled(),__LINE__);
+
+    /*  The same section twice: a miss, then a hit
+        sharing the first load's data. */
+    e1 = load_section(a,akey,&d1);
+    check("first load",1,e1 != 0,__LINE__);
+    check_stats("after first load",entbytes,1,0,1,0,__LINE__);
+    e2 = load_section(a2,akey,&d2);
+    check("second load entry",1,e1 == e2,__LINE__);
+    check("second load data",1,d1 == d2,__LINE__);
+    check_stats("after second load",entbytes,1,1,1,0,__LINE__);
+
+    /*  A forced collision: b differs from a but is
+        looked up with a's key and lengths. */
+    e3 = load_section(b,akey,&d3);
+    check("collision is a miss",1,e3 != e1 && e3 != 0,__LINE__);
+    check("collision data",1,d3 != d1,__LINE__);
+    expect = fake_decompress(b);
+    check("collision contents",0,
+        (Dwarf_Unsigned)memcmp(expect,d3,UNCOMPLEN),__LINE__);
+    free(expect);
+    check_stats("after collision",2*entbytes,2,1,2,0,__LINE__);
+
+    /*  Both entries with key akey are still
+        found by their own bytes. */
+    _dwarf_dcache_release(e3);
+    e3 = load_section(b,akey,&d2);
+    check("collision entry found again",1,d2 == d3,__LINE__);
+    d2 = 0;
+    check_stats("after reload",2*entbytes,2,2,2,0,__LINE__);
+
+    /*  In-use sections are not evicted, so the
+        total stays over a tiny budget until they
+        are released. */
+    dwarf_set_decompressed_section_cache_size(1);
+    check_stats("over budget while in use",2*entbytes,2,2,2,0,
+        __LINE__);
+    _dwarf_dcache_release(e1);
+    check_stats("one still in use",2*entbytes,2,2,2,0,__LINE__);
+    _dwarf_dcache_release(e2);
+    check_stats("first released",entbytes,1,2,2,1,__LINE__);
+    _dwarf_dcache_release(e3);
+    check_stats("all released",0,0,2,2,2,__LINE__);
+
+    /*  Too big for the budget: not cached,
+        the caller keeps the data. */
+    e1 = load_section(a,akey,&d1);
+    check("not cached",1,e1 == 0 && d1 != 0,__LINE__);
+    free(d1);
+    check_stats("nothing cached",0,0,2,3,2,__LINE__);
+    dwarf_set_decompressed_section_cache_size(0);
+}
+
+int
+main(void)
+{
+    run_checks();
+    if (errcount) {
+        printf("FAIL test_dwarf_dcache %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_dwarf_dcache\n");
+    return 0;
+}
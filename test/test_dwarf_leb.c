@@ -31,6 +31,9 @@
 
 #include <stddef.h> /* size_t */
 #include <stdio.h>  /* printf() */
+#include <stdlib.h> /* malloc() free() */
+#include <string.h> /* strcmp() */
+#include <time.h>   /* clock() */
 
 #include "libdwarf.h"
 #include "libdwarf_private.h"
@@ -925,7 +928,215 @@ testatmaxlimit(void)
     return errcnt;
 }
 
-int main(void)
+/*  Every encoded length from 1 to 10 bytes at every
+    distance from endptr, so the 8 byte load path and
+    the byte at a time path used near endptr are
+    both checked, as is running off the end. */
+#define BOUNDLEN 40
+static unsigned
+boundarytests(void)
+{
+    unsigned errcnt = 0;
+    unsigned nbytes = 0;
+    char buf[BOUNDLEN];
+    char *endp = &buf[BOUNDLEN];
+
+    for (nbytes = 1; nbytes <= 10; ++nbytes) {
+        unsigned extra = 0;
+        /*  Top 7 bit group non-zero, so exactly nbytes
+            bytes encoded (64 bits fit 10 bytes). */
+        Dwarf_Unsigned uval = ((Dwarf_Unsigned)1 <<
+            (7*(nbytes-1))) | 0x15;
+        Dwarf_Signed sval = -(Dwarf_Signed)uval;
+
+        if (nbytes == 10) {
+            uval = 0xfedcba9876543215ULL;
+            sval = (Dwarf_Signed)0x8000000000000015ULL;
+        }
+        for (extra = 0; extra <= 12; ++extra) {
+            int encodelen = 0;
+            char *start = 0;
+            Dwarf_Unsigned len = 0;
+            Dwarf_Unsigned skiplen = 0;
+            Dwarf_Unsigned uout = 0;
+            Dwarf_Signed sout = 0;
+            int res = 0;
+
+            memset(buf,0xaa,sizeof(buf));
+            res = dwarf_encode_leb128(uval,&encodelen,
+                buf+20,20);
+            start = endp - encodelen - extra;
+            memmove(start,buf+20,encodelen);
+            res = dwarf_decode_leb128(start,&len,&uout,endp);
+            if (res != DW_DLV_OK || uout != uval ||
+                len != (Dwarf_Unsigned)encodelen) {
+                printf("FAIL boundary unsigned nbytes %u extra %u"
+                    " line:%d\n",nbytes,extra,__LINE__);
+                ++errcnt;
+            }
+            res = _dwarf_skip_leb128(start,&skiplen,endp);
+            if (res != DW_DLV_OK || skiplen != len) {
+                printf("FAIL boundary skip nbytes %u extra %u"
+                    " line:%d\n",nbytes,extra,__LINE__);
+                ++errcnt;
+            }
+            res = dwarf_decode_leb128(start,&len,&uout,
+                start + encodelen - 1);
+            if (res != DW_DLV_ERROR) {
+                printf("FAIL boundary truncated nbytes %u extra %u"
+                    " line:%d\n",nbytes,extra,__LINE__);
+                ++errcnt;
+            }
+
+            memset(buf,0xaa,sizeof(buf));
+            res = dwarf_encode_signed_leb128(sval,&encodelen,
+                buf+20,20);
+            start = endp - encodelen - extra;
+            memmove(start,buf+20,encodelen);
+            res = dwarf_decode_signed_leb128(start,&len,&sout,endp);
+            if (res != DW_DLV_OK || sout != sval ||
+                len != (Dwarf_Unsigned)encodelen) {
+                printf("FAIL boundary signed nbytes %u extra %u"
+                    " line:%d\n",nbytes,extra,__LINE__);
+                ++errcnt;
+            }
+            res = dwarf_encode_signed_leb128(-sval,&encodelen,
+                buf+20,20);
+            start = endp - encodelen - extra;
+            memmove(start,buf+20,encodelen);
+            res = dwarf_decode_signed_leb128(start,&len,&sout,endp);
+            if (nbytes < 10 && (res != DW_DLV_OK || sout != -sval ||
+                len != (Dwarf_Unsigned)encodelen)) {
+                printf("FAIL boundary positive signed nbytes %u"
+                    " extra %u line:%d\n",nbytes,extra,__LINE__);
+                ++errcnt;
+            }
+        }
+    }
+    return errcnt;
+}
+
+/*  The byte at a time decode, for timing
+    comparison with --bench. */
+static int
+bytewise_uleb(char *leb,Dwarf_Unsigned *lenout,
+    Dwarf_Unsigned *valout,char *endptr)
+{
+    Dwarf_Unsigned v = 0;
+    unsigned shift = 0;
+    char *p = leb;
+
+    for (;;) {
+        unsigned char b = 0;
+
+        if (p >= endptr || shift >= 64) {
+            return DW_DLV_ERROR;
+        }
+        b = *(unsigned char *)p++;
+        v |= ((Dwarf_Unsigned)(b & 0x7f)) << shift;
+        if (!(b & 0x80)) {
+            break;
+        }
+        shift += 7;
+    }
+    *lenout = p - leb;
+    *valout = v;
+    return DW_DLV_OK;
+}
+
+#define BENCH_COUNT 4000000
+static unsigned
+lebbench(void)
+{
+    unsigned errcnt = 0;
+    char *buf = 0;
+    char *endp = 0;
+    char *p = 0;
+    unsigned long i = 0;
+    unsigned long seed = 1;
+    unsigned long bufsize = BENCH_COUNT*10;
+    Dwarf_Unsigned sumold = 0;
+    Dwarf_Unsigned sumnew = 0;
+    Dwarf_Unsigned sumskip = 0;
+    clock_t t = 0;
+    double told = 0.0;
+    double tnew = 0.0;
+    double tskip = 0.0;
+
+    buf = malloc(bufsize);
+    if (!buf) {
+        printf("FAIL bench: no memory\n");
+        return 1;
+    }
+    /*  Mostly short values, as in real DWARF:
+        half one byte, a quarter two bytes, the
+        rest spread up to 64 bits. */
+    p = buf;
+    for (i = 0; i < BENCH_COUNT; ++i) {
+        Dwarf_Unsigned v = 0;
+        int len = 0;
+
+        seed = seed*1103515245 + 12345;
+        switch((seed >> 16) & 7) {
+        case 0: case 1: case 2: case 3:
+            v = (seed >> 8) & 0x7f;
+            break;
+        case 4: case 5:
+            v = (seed >> 4) & 0x3fff;
+            break;
+        case 6:
+            v = seed & 0xfffffff;
+            break;
+        default:
+            v = ((Dwarf_Unsigned)seed << 32) ^ seed;
+            break;
+        }
+        dwarf_encode_leb128(v,&len,p,10);
+        p += len;
+    }
+    endp = p;
+
+    t = clock();
+    for (p = buf; p < endp; ) {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned v = 0;
+
+        bytewise_uleb(p,&len,&v,endp);
+        sumold += v;
+        p += len;
+    }
+    told = (double)(clock() - t)/CLOCKS_PER_SEC;
+    t = clock();
+    for (p = buf; p < endp; ) {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned v = 0;
+
+        dwarf_decode_leb128(p,&len,&v,endp);
+        sumnew += v;
+        p += len;
+    }
+    tnew = (double)(clock() - t)/CLOCKS_PER_SEC;
+    t = clock();
+    for (p = buf; p < endp; ) {
+        Dwarf_Unsigned len = 0;
+
+        _dwarf_skip_leb128(p,&len,endp);
+        ++sumskip;
+        p += len;
+    }
+    tskip = (double)(clock() - t)/CLOCKS_PER_SEC;
+    if (sumold != sumnew || sumskip != BENCH_COUNT) {
+        printf("FAIL bench decode mismatch line:%d\n",__LINE__);
+        ++errcnt;
+    }
+    printf("uleb decode of %d values: byte at a time %.3f s,"
+        " dwarf_decode_leb128 %.3f s, _dwarf_skip_leb128 %.3f s\n",
+        BENCH_COUNT,told,tnew,tskip);
+    free(buf);
+    return errcnt;
+}
+
+int main(int argc, char **argv)
 {
     unsigned slen = sizeof(stest)/sizeof(Dwarf_Signed);
     unsigned ulen = sizeof(utest)/sizeof(Dwarf_Unsigned);
@@ -940,6 +1151,12 @@ int main(void)
 
     errs += testatmaxlimit();
 
+    errs += boundarytests();
+
+    if (argc > 1 && !strcmp(argv[1],"--bench")) {
+        errs += lebbench();
+    }
+
     if (errs) {
         printf("FAIL. leb encode/decode errors\n");
         return 1;
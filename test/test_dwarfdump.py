@@ -147,11 +147,13 @@ def getbaseline(path):
 
 
 # Run dwarfdump, limiting output to gmaxlines lines
-def rundwarfdump(td, dd, dwarfdumppath, objpath, lmaxlines):
+def rundwarfdump(td, dd, dwarfdumppath, objpath, lmaxlines,
+    extraopts=[]):
     out = []
-    print("Run:", dwarfdumppath, dd.ddopts[0], dd.ddopts[1], objpath)
+    cmd = [dwarfdumppath] + dd.ddopts + extraopts + [objpath]
+    print("Run:", " ".join(cmd))
     p1 = Popen(
-        [dwarfdumppath, dd.ddopts[0], dd.ddopts[1], objpath],
+        cmd,
         stdout=PIPE,
         stderr=PIPE,
     )
@@ -264,5 +266,17 @@ if __name__ == "__main__":
         print("If update to baseline desired then:")
         print("mv", tempfilepath, baseline_path)
         sys.exit(1)
+    # The DIE attribute offset cache must not change
+    # anything dwarfdump prints.
+    fullout = rundwarfdump(td, dd, dwarfdumppath, objpath, 1000000)
+    cacheout = rundwarfdump(td, dd, dwarfdumppath, objpath, 1000000,
+        ["--die-attr-cache"])
+    if not fullout == cacheout:
+        diffs = difflib.unified_diff(fullout, cacheout, lineterm="")
+        for s in diffs:
+            print(s)
+        print("FAIL test_dwarfdump.py on", td.objtype,
+            " output differs with --die-attr-cache")
+        sys.exit(1)
     print("PASS", td.objtype)
     sys.exit(0)
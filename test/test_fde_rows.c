@@ -0,0 +1,369 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks the cache of FDE rows that
+    dwarf_get_fde_info_for_all_regs3_b() builds on
+    the second lookup in an FDE.  Every pc of every
+    FDE is looked up in one Dwarf_Debug, so all but
+    the first lookup in each FDE come from the cache.
+    Each answer is compared with the answer from a
+    fresh Dwarf_Debug in which it is the first lookup
+    in its FDE, so the instructions are run to the pc.
+
+    The FDEs are a hand-made .debug_frame read from
+    memory (as in jitreader.c) with remember_state,
+    restore_state, an expression and DW_CFA_set_loc
+    both after an advance and going backwards, and the
+    .eh_frame of test/dummyexecutable and
+    test/testuriLE64ELf.testme.
+
+    ./test_fde_rows -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() free() */
+#include <string.h> /* memcmp() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+static Dwarf_Small framebytes[] = {
+/* CIE version 1, "", code align 1, data align -8, ra 16 */
+0x14, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+0x01, 0x00, 0x01, 0x78, 0x10,
+0x0c, 0x07, 0x08,       /* DW_CFA_def_cfa r7 8 */
+0x90, 0x01,             /* DW_CFA_offset r16 1 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* FDE 0x1000..0x1040 */
+0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x41,                   /* DW_CFA_advance_loc 1 */
+0x0e, 0x10,             /* DW_CFA_def_cfa_offset 16 */
+0x86, 0x02,             /* DW_CFA_offset r6 2 */
+0x43,                   /* DW_CFA_advance_loc 3 */
+0x0d, 0x06,             /* DW_CFA_def_cfa_register r6 */
+0x0a,                   /* DW_CFA_remember_state */
+0x60,                   /* DW_CFA_advance_loc 32 */
+0x0c, 0x07, 0x08,       /* DW_CFA_def_cfa r7 8 */
+0xc6,                   /* DW_CFA_restore r6 */
+0x10, 0x03, 0x02, 0x70, 0x00, /* DW_CFA_expression r3 breg0 0 */
+0x44,                   /* DW_CFA_advance_loc 4 */
+0x0b,                   /* DW_CFA_restore_state */
+0x00, 0x00, 0x00,
+/* FDE 0x2000..0x2030 */
+0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* DW_CFA_set_loc 0x2010 */
+0x01, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x18,             /* DW_CFA_def_cfa_offset 24 */
+/* DW_CFA_set_loc 0x2008, going backwards */
+0x01, 0x08, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x83, 0x03,             /* DW_CFA_offset r3 3 */
+/* DW_CFA_set_loc 0x2020 */
+0x01, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x20,             /* DW_CFA_def_cfa_offset 32 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* FDE 0x3000..0x3020 */
+0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x42,                   /* DW_CFA_advance_loc 2 */
+0x0e, 0x10,             /* DW_CFA_def_cfa_offset 16 */
+/* DW_CFA_set_loc 0x3008 */
+0x01, 0x08, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x86, 0x02,             /* DW_CFA_offset r6 2 */
+0x48,                   /* DW_CFA_advance_loc 8 */
+0x08, 0x06,             /* DW_CFA_same_value r6 */
+0x07, 0x03,             /* DW_CFA_undefined r3 */
+0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SECCOUNT 1
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_frame",sizeof(framebytes),framebytes}
+};
+static struct testobj_s testobj;
+
+/*  One open object with its FDEs and a register table. */
+struct frames_s {
+    Dwarf_Debug     fr_dbg;
+    int             fr_in_memory;
+    Dwarf_Cie      *fr_cies;
+    Dwarf_Signed    fr_cie_count;
+    Dwarf_Fde      *fr_fdes;
+    Dwarf_Signed    fr_fde_count;
+    Dwarf_Regtable3 fr_regtab;
+};
+
+/*  One lookup result. */
+struct row_s {
+    int             rw_res;
+    Dwarf_Addr      rw_row_pc;
+    Dwarf_Bool      rw_has_more_rows;
+    Dwarf_Addr      rw_subsequent_pc;
+};
+
+static int
+open_frames(const char *path,struct frames_s *f)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned rulecount = 0;
+    int res = 0;
+
+    memset(f,0,sizeof(*f));
+    if (path) {
+        res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+            0,0,&f->fr_dbg,&error);
+    } else {
+        f->fr_in_memory = 1;
+        res = testobj_init(&testobj,sectiondata,SECCOUNT,
+            &f->fr_dbg,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",
+            path?path:"in-memory object",res);
+        return res;
+    }
+    if (path) {
+        res = dwarf_get_fde_list_eh(f->fr_dbg,&f->fr_cies,
+            &f->fr_cie_count,&f->fr_fdes,&f->fr_fde_count,&error);
+    } else {
+        res = dwarf_get_fde_list(f->fr_dbg,&f->fr_cies,
+            &f->fr_cie_count,&f->fr_fdes,&f->fr_fde_count,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL getting FDEs res %d %s\n",res,
+            res == DW_DLV_ERROR?dwarf_errmsg(error):"");
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(f->fr_dbg,error);
+        }
+        f->fr_fdes = 0;
+        return DW_DLV_ERROR;
+    }
+    rulecount = dwarf_set_frame_rule_table_size(f->fr_dbg,1);
+    dwarf_set_frame_rule_table_size(f->fr_dbg,
+        (Dwarf_Half)rulecount);
+    f->fr_regtab.rt3_reg_table_size = (Dwarf_Half)rulecount;
+    f->fr_regtab.rt3_rules = (struct Dwarf_Regtable_Entry3_s *)
+        calloc(rulecount,sizeof(struct Dwarf_Regtable_Entry3_s));
+    if (!f->fr_regtab.rt3_rules) {
+        printf("FAIL out of memory\n");
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+static void
+close_frames(struct frames_s *f)
+{
+    free(f->fr_regtab.rt3_rules);
+    if (f->fr_fdes) {
+        dwarf_dealloc_fde_cie_list(f->fr_dbg,f->fr_cies,
+            f->fr_cie_count,f->fr_fdes,f->fr_fde_count);
+    }
+    if (f->fr_in_memory) {
+        dwarf_object_finish(f->fr_dbg);
+    } else {
+        dwarf_finish(f->fr_dbg);
+    }
+}
+
+static void
+lookup_row(struct frames_s *f,Dwarf_Signed fdeindex,
+    Dwarf_Addr pc,struct row_s *row)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Regtable3 *rt = &f->fr_regtab;
+
+    memset(row,0,sizeof(*row));
+    memset(&rt->rt3_cfa_rule,0,sizeof(rt->rt3_cfa_rule));
+    memset(rt->rt3_rules,0,rt->rt3_reg_table_size*
+        sizeof(struct Dwarf_Regtable_Entry3_s));
+    row->rw_res = dwarf_get_fde_info_for_all_regs3_b(
+        f->fr_fdes[fdeindex],pc,rt,&row->rw_row_pc,
+        &row->rw_has_more_rows,&row->rw_subsequent_pc,&error);
+    if (row->rw_res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(f->fr_dbg,error);
+    }
+}
+
+static int
+same_rule(struct Dwarf_Regtable_Entry3_s *l,
+    struct Dwarf_Regtable_Entry3_s *r)
+{
+    if (l->dw_offset_relevant != r->dw_offset_relevant ||
+        l->dw_value_type != r->dw_value_type ||
+        l->dw_regnum != r->dw_regnum ||
+        l->dw_offset != r->dw_offset ||
+        l->dw_args_size != r->dw_args_size ||
+        l->dw_block.bl_len != r->dw_block.bl_len) {
+        return 0;
+    }
+    if (l->dw_block.bl_len &&
+        memcmp(l->dw_block.bl_data,r->dw_block.bl_data,
+        (size_t)l->dw_block.bl_len)) {
+        return 0;
+    }
+    return 1;
+}
+
+static void
+compare_rows(const char *name,Dwarf_Addr pc,
+    struct frames_s *ef,struct row_s *expect,
+    struct frames_s *gf,struct row_s *got)
+{
+    Dwarf_Half r = 0;
+    int bad = 0;
+
+    if (expect->rw_res != got->rw_res) {
+        bad = 1;
+    } else if (expect->rw_res == DW_DLV_OK) {
+        if (expect->rw_row_pc != got->rw_row_pc ||
+            expect->rw_has_more_rows != got->rw_has_more_rows ||
+            expect->rw_subsequent_pc != got->rw_subsequent_pc ||
+            !same_rule(&ef->fr_regtab.rt3_cfa_rule,
+                &gf->fr_regtab.rt3_cfa_rule)) {
+            bad = 1;
+        }
+        for (r = 0; !bad &&
+            r < ef->fr_regtab.rt3_reg_table_size; ++r) {
+            if (!same_rule(&ef->fr_regtab.rt3_rules[r],
+                &gf->fr_regtab.rt3_rules[r])) {
+                bad = 1;
+            }
+        }
+    }
+    if (bad) {
+        printf("FAIL %s pc 0x%llx res %d/%d row 0x%llx/0x%llx"
+            " next 0x%llx/0x%llx\n",name,
+            (unsigned long long)pc,expect->rw_res,got->rw_res,
+            (unsigned long long)expect->rw_row_pc,
+            (unsigned long long)got->rw_row_pc,
+            (unsigned long long)expect->rw_subsequent_pc,
+            (unsigned long long)got->rw_subsequent_pc);
+        ++errcount;
+    }
+}
+
+static void
+check_frames(const char *name,const char *path,
+    Dwarf_Signed minfdes)
+{
+    struct frames_s cached;
+    Dwarf_Unsigned round = 0;
+    Dwarf_Unsigned maxlen = 0;
+    Dwarf_Unsigned lookups = 0;
+    Dwarf_Signed i = 0;
+
+    if (open_frames(path,&cached) != DW_DLV_OK) {
+        ++errcount;
+        close_frames(&cached);
+        return;
+    }
+    if (cached.fr_fde_count < minfdes) {
+        printf("FAIL %s has %d FDEs\n",name,
+            (int)cached.fr_fde_count);
+        ++errcount;
+    }
+    for (i = 0; i < cached.fr_fde_count; ++i) {
+        Dwarf_Addr low = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Error error = 0;
+
+        if (dwarf_get_fde_range(cached.fr_fdes[i],&low,&len,
+            0,0,0,0,0,&error) == DW_DLV_OK && len > maxlen) {
+            maxlen = len;
+        }
+    }
+    /*  Round n looks up pc low+n of every FDE, the first
+        lookup in each FDE of a fresh Dwarf_Debug. */
+    for (round = 0; round < maxlen; ++round) {
+        struct frames_s fresh;
+
+        if (open_frames(path,&fresh) != DW_DLV_OK ||
+            fresh.fr_fde_count != cached.fr_fde_count) {
+            ++errcount;
+            close_frames(&fresh);
+            break;
+        }
+        for (i = 0; i < cached.fr_fde_count; ++i) {
+            Dwarf_Addr low = 0;
+            Dwarf_Unsigned len = 0;
+            Dwarf_Error error = 0;
+            struct row_s expect;
+            struct row_s got;
+
+            if (dwarf_get_fde_range(cached.fr_fdes[i],&low,&len,
+                0,0,0,0,0,&error) != DW_DLV_OK) {
+                printf("FAIL %s no range for FDE %d\n",name,
+                    (int)i);
+                ++errcount;
+                break;
+            }
+            if (round >= len) {
+                continue;
+            }
+            lookup_row(&fresh,i,low+round,&expect);
+            lookup_row(&cached,i,low+round,&got);
+            compare_rows(name,low+round,&fresh,&expect,
+                &cached,&got);
+            ++lookups;
+        }
+        close_frames(&fresh);
+    }
+    if (!lookups) {
+        printf("FAIL %s no lookups done\n",name);
+        ++errcount;
+    }
+    close_frames(&cached);
+}
+
+int
+main(int argc,char **argv)
+{
+    check_frames("in-memory",0,3);
+    if (build_path(argc,argv,"/test/dummyexecutable")) {
+        return 1;
+    }
+    check_frames("dummyexecutable",pathbuf,5);
+    if (build_path(argc,argv,"/test/testuriLE64ELf.testme")) {
+        return 1;
+    }
+    check_frames("testuriLE64ELf.testme",pathbuf,3);
+    if (errcount) {
+        printf("FAIL test_fde_rows %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_fde_rows\n");
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks the rows dwarf_iterate_fde_all_regs3()
+    reports for an FDE using DW_CFA_set_loc: each
+    row must have the pc at which its rules start
+    and, as subsequent pc, the pc of the next row
+    (its own pc for the last row).
+    dwarf_get_fde_info_for_all_regs3_b() at each row
+    pc must give the same row.
+
+    The FDE is a hand-made .debug_frame read from
+    memory (as in jitreader.c).
+
+    ./test_frame_set_loc */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() free() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+static Dwarf_Small framebytes[] = {
+/* CIE version 1, "", code align 1, data align -8, ra 16 */
+0x14, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+0x01, 0x00, 0x01, 0x78, 0x10,
+0x0c, 0x07, 0x08,       /* DW_CFA_def_cfa r7 8 */
+0x90, 0x01,             /* DW_CFA_offset r16 1 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* FDE 0x1000..0x1040 */
+0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x44,                   /* DW_CFA_advance_loc 4 */
+0x0e, 0x10,             /* DW_CFA_def_cfa_offset 16 */
+/* DW_CFA_set_loc 0x1010 */
+0x01, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x18,             /* DW_CFA_def_cfa_offset 24 */
+/* DW_CFA_set_loc 0x1028 */
+0x01, 0x28, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x20,             /* DW_CFA_def_cfa_offset 32 */
+0x42,                   /* DW_CFA_advance_loc 2 */
+0x0e, 0x28,             /* DW_CFA_def_cfa_offset 40 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SECCOUNT 1
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_frame",sizeof(framebytes),framebytes}
+};
+static struct testobj_s testobj;
+
+struct row_s {
+    Dwarf_Addr     rw_row_pc;
+    Dwarf_Bool     rw_has_more_rows;
+    Dwarf_Addr     rw_subsequent_pc;
+    Dwarf_Unsigned rw_cfa_offset;
+};
+static struct row_s expected[] = {
+{0x1000,TRUE,0x1004,8},
+{0x1004,TRUE,0x1010,16},
+{0x1010,TRUE,0x1028,24},
+{0x1028,TRUE,0x102a,32},
+{0x102a,FALSE,0x102a,40}
+};
+#define EXPECTCOUNT (sizeof(expected)/sizeof(expected[0]))
+
+static unsigned rowcount;
+
+static int
+record_row(Dwarf_Regtable3 *regtab,Dwarf_Addr row_pc,
+    Dwarf_Bool has_more_rows,Dwarf_Addr subsequent_pc,
+    void *user_data)
+{
+    struct row_s *e = 0;
+
+    (void)user_data;
+    if (rowcount >= EXPECTCOUNT) {
+        printf("FAIL extra row 0x%llx\n",
+            (unsigned long long)row_pc);
+        ++errcount;
+        return DW_DLV_OK;
+    }
+    e = &expected[rowcount];
+    check("row pc",e->rw_row_pc,row_pc,__LINE__);
+    check("has more rows",e->rw_has_more_rows,has_more_rows,
+        __LINE__);
+    check("subsequent pc",e->rw_subsequent_pc,
+        subsequent_pc,__LINE__);
+    check("cfa offset",e->rw_cfa_offset,
+        (Dwarf_Unsigned)regtab->rt3_cfa_rule.dw_offset,__LINE__);
+    ++rowcount;
+    return DW_DLV_OK;
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Cie *cies = 0;
+    Dwarf_Signed ciecount = 0;
+    Dwarf_Fde *fdes = 0;
+    Dwarf_Signed fdecount = 0;
+    Dwarf_Regtable3 regtab;
+    Dwarf_Unsigned rulecount = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    res = dwarf_get_fde_list(dbg,&cies,&ciecount,&fdes,
+        &fdecount,&error);
+    check("fde list",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        dwarf_object_finish(dbg);
+        return 1;
+    }
+    check("fde count",1,fdecount,__LINE__);
+    memset(&regtab,0,sizeof(regtab));
+    rulecount = dwarf_set_frame_rule_table_size(dbg,1);
+    dwarf_set_frame_rule_table_size(dbg,(Dwarf_Half)rulecount);
+    regtab.rt3_reg_table_size = (Dwarf_Half)rulecount;
+    regtab.rt3_rules = (struct Dwarf_Regtable_Entry3_s *)
+        calloc(rulecount,sizeof(struct Dwarf_Regtable_Entry3_s));
+    if (!regtab.rt3_rules) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        fdecount = 0;
+    }
+    if (fdecount) {
+        res = dwarf_iterate_fde_all_regs3(fdes[0],&regtab,
+            record_row,0,&error);
+        check("iterate",DW_DLV_OK,res,__LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+        }
+        check("row count",EXPECTCOUNT,rowcount,__LINE__);
+    }
+    for (i = 0; fdecount && i < EXPECTCOUNT; ++i) {
+        Dwarf_Addr row_pc = 0;
+        Dwarf_Bool has_more_rows = FALSE;
+        Dwarf_Addr subsequent_pc = 0;
+
+        res = dwarf_get_fde_info_for_all_regs3_b(fdes[0],
+            expected[i].rw_row_pc,&regtab,&row_pc,
+            &has_more_rows,&subsequent_pc,&error);
+        check("lookup",DW_DLV_OK,res,__LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            continue;
+        }
+        check("lookup row pc",expected[i].rw_row_pc,row_pc,
+            __LINE__);
+        check("lookup cfa offset",expected[i].rw_cfa_offset,
+            (Dwarf_Unsigned)regtab.rt3_cfa_rule.dw_offset,
+            __LINE__);
+    }
+    free(regtab.rt3_rules);
+    dwarf_dealloc_fde_cie_list(dbg,cies,ciecount,fdes,fdecount);
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_frame_set_loc %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_frame_set_loc\n");
+    return 0;
+}
@@ -0,0 +1,429 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_gdbindex_lookup() and
+    dwarf_gdbindex_addressarea_lookup().
+    A .gdb_index section is built in memory (as in
+    jitreader.c) the way gdb writes one, with symbol
+    tables from nearly empty to full so that probe
+    sequences are long and some searches visit every
+    slot.  Every symbol must be found in its own slot
+    with its own CU vector, and names that are absent
+    or differ only in case must not be found.
+    Address lookups at, just inside and just outside
+    every address area entry must agree with a search
+    of every entry, also when the area is out of order. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() sprintf() */
+#include <string.h> /* memcpy() memset() strcpy() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+#define NAMECOUNT 200
+#define ADDRCOUNT 40
+#define CUCOUNT 3
+#define SYMTABOFFSET (24 + CUCOUNT*16 + ADDRCOUNT*20)
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children, DW_AT_name DW_FORM_string */
+0x01, 0x11, 0x00, 0x03, 0x08, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x0c, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00 }; /* abbrev 1, "t.c" */
+
+/*  Filled in by build_index(). */
+static Dwarf_Small gdbbytes[20000];
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".gdb_index",0,gdbbytes}
+};
+static struct testobj_s testobj;
+
+/*  names[0] and names[1] differ only in case. */
+static char names[NAMECOUNT][16];
+/*  The slot and CU vector offset of each name. */
+static Dwarf_Unsigned slotof[NAMECOUNT];
+static Dwarf_Unsigned cuvecof[NAMECOUNT];
+/*  The address area as built. */
+static Dwarf_Unsigned addrlow[ADDRCOUNT];
+static Dwarf_Unsigned addrhigh[ADDRCOUNT];
+static Dwarf_Unsigned addrcu[ADDRCOUNT];
+
+/*  gdb's mapped_index_string_hash(), version 5 on,
+    written out independently of the library. */
+static Dwarf_Unsigned
+gdb_hash(const char *s)
+{
+    Dwarf_Unsigned r = 0;
+
+    for ( ; *s; ++s) {
+        unsigned c = (unsigned char)*s;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        r = (r*67 + c - 113) & 0xffffffff;
+    }
+    return r;
+}
+
+static void
+put_bytes(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    const void *v,Dwarf_Unsigned len)
+{
+    memcpy(buf + *off,v,(size_t)len);
+    *off += len;
+}
+static void
+put_n(Dwarf_Small *buf,Dwarf_Unsigned *off,
+    Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        buf[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+/*  Builds a version 8 .gdb_index with namecount of the
+    names in slotcount slots, entered as gdb does.
+    names[i] is in CU vector (i+k)%CUCOUNT for k up to
+    i%3.  The address area has gaps and one pair of
+    adjacent entries; with swap two entries trade
+    places, putting it out of order. */
+static void
+build_index(unsigned slotcount,unsigned namecount,int swap)
+{
+    Dwarf_Unsigned symtab[2*1024];
+    Dwarf_Small pool[NAMECOUNT*32];
+    Dwarf_Unsigned poolsize = 0;
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned symoff = 0;
+    Dwarf_Unsigned pooloff = 0;
+    unsigned i = 0;
+    unsigned k = 0;
+
+    memset(symtab,0,sizeof(symtab));
+    for (i = 0; i < namecount; ++i) {
+        cuvecof[i] = poolsize;
+        put_n(pool,&poolsize,1 + i%3,4);
+        for (k = 0; k <= i%3; ++k) {
+            put_n(pool,&poolsize,(i+k)%CUCOUNT,4);
+        }
+    }
+    for (i = 0; i < namecount; ++i) {
+        Dwarf_Unsigned h = gdb_hash(names[i]);
+        Dwarf_Unsigned slot = h & (slotcount-1);
+        Dwarf_Unsigned step = ((h*17) & (slotcount-1)) | 1;
+
+        while (symtab[2*slot] || symtab[2*slot+1]) {
+            slot = (slot + step) & (slotcount-1);
+        }
+        slotof[i] = slot;
+        symtab[2*slot] = poolsize;
+        symtab[2*slot+1] = cuvecof[i];
+        put_bytes(pool,&poolsize,names[i],strlen(names[i])+1);
+    }
+    for (i = 0; i < ADDRCOUNT; ++i) {
+        addrlow[i] = 0x1000 + 0x100*i;
+        addrhigh[i] = addrlow[i] + 0x80;
+        addrcu[i] = i%CUCOUNT;
+    }
+    addrhigh[10] = addrlow[11];
+    if (swap) {
+        Dwarf_Unsigned t = addrlow[20];
+
+        addrlow[20] = addrlow[30];
+        addrlow[30] = t;
+        t = addrhigh[20];
+        addrhigh[20] = addrhigh[30];
+        addrhigh[30] = t;
+    }
+
+    symoff = SYMTABOFFSET;
+    pooloff = symoff + slotcount*8;
+    put_n(gdbbytes,&off,8,4);            /* version */
+    put_n(gdbbytes,&off,24,4);           /* CU list */
+    put_n(gdbbytes,&off,24 + CUCOUNT*16,4); /* types CU list */
+    put_n(gdbbytes,&off,24 + CUCOUNT*16,4); /* address area */
+    put_n(gdbbytes,&off,symoff,4);
+    put_n(gdbbytes,&off,pooloff,4);
+    for (i = 0; i < CUCOUNT; ++i) {
+        put_n(gdbbytes,&off,0x100*i,8);
+        put_n(gdbbytes,&off,0x100,8);
+    }
+    for (i = 0; i < ADDRCOUNT; ++i) {
+        put_n(gdbbytes,&off,addrlow[i],8);
+        put_n(gdbbytes,&off,addrhigh[i],8);
+        put_n(gdbbytes,&off,addrcu[i],4);
+    }
+    for (i = 0; i < slotcount; ++i) {
+        put_n(gdbbytes,&off,symtab[2*i],4);
+        put_n(gdbbytes,&off,symtab[2*i+1],4);
+    }
+    put_bytes(gdbbytes,&off,pool,poolsize);
+    sectiondata[2].ts_size = off;
+}
+
+static void
+check_missing(Dwarf_Debug dbg,Dwarf_Gdbindex gi,
+    const char *name)
+{
+    Dwarf_Unsigned slot = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_lookup(gi,name,&slot,0,&error);
+    if (res != DW_DLV_NO_ENTRY) {
+        printf("FAIL \"%s\" res %d\n",name,res);
+        ++errcount;
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+    }
+}
+
+static void
+check_symbols(Dwarf_Debug dbg,Dwarf_Gdbindex gi,
+    unsigned namecount)
+{
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < namecount; ++i) {
+        Dwarf_Unsigned slot = 0;
+        Dwarf_Unsigned cuvec = 0;
+        Dwarf_Unsigned inner = 0;
+
+        res = dwarf_gdbindex_lookup(gi,names[i],&slot,&cuvec,
+            &error);
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s res %d\n",names[i],res);
+            ++errcount;
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            continue;
+        }
+        check("slot",slotof[i],slot,__LINE__);
+        check("CU vector",cuvecof[i],cuvec,__LINE__);
+        res = dwarf_gdbindex_cuvector_length(gi,cuvec,&inner,
+            &error);
+        check("CU vector length",DW_DLV_OK,res,__LINE__);
+        check("CU vector count",1 + i%3,inner,__LINE__);
+    }
+    for (i = namecount; i < NAMECOUNT; ++i) {
+        check_missing(dbg,gi,names[i]);
+    }
+    check_missing(dbg,gi,"");
+    check_missing(dbg,gi,"nothere");
+    check_missing(dbg,gi,"MIXEDCASE");
+    check_missing(dbg,gi,"s10");
+    check_missing(dbg,gi,"s10_fx");
+}
+
+static void
+check_addresses(Dwarf_Debug dbg,Dwarf_Gdbindex gi)
+{
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    unsigned k = 0;
+    int res = 0;
+
+    for (i = 0; i < ADDRCOUNT; ++i) {
+        Dwarf_Addr pcs[5];
+
+        pcs[0] = addrlow[i] - 1;
+        pcs[1] = addrlow[i];
+        pcs[2] = addrlow[i] + 0x40;
+        pcs[3] = addrhigh[i] - 1;
+        pcs[4] = addrhigh[i];
+        for (k = 0; k < 5; ++k) {
+            Dwarf_Unsigned want = ADDRCOUNT;
+            Dwarf_Unsigned entry = 0;
+            Dwarf_Unsigned cu = 0;
+            unsigned j = 0;
+
+            for (j = 0; j < ADDRCOUNT; ++j) {
+                if (addrlow[j] <= pcs[k] && pcs[k] < addrhigh[j]) {
+                    want = j;
+                    break;
+                }
+            }
+            res = dwarf_gdbindex_addressarea_lookup(gi,pcs[k],
+                &entry,&cu,&error);
+            if (want == ADDRCOUNT) {
+                check("no address entry",DW_DLV_NO_ENTRY,res,
+                    __LINE__);
+            } else {
+                check("address lookup",DW_DLV_OK,res,__LINE__);
+                check("address entry",want,entry,__LINE__);
+                check("address CU",addrcu[want],cu,__LINE__);
+            }
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+        }
+    }
+}
+
+static void
+check_index(unsigned slotcount,unsigned namecount,int swap)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Gdbindex gi = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Unsigned culist = 0;
+    Dwarf_Unsigned typeslist = 0;
+    Dwarf_Unsigned addrarea = 0;
+    Dwarf_Unsigned symtab = 0;
+    Dwarf_Unsigned pool = 0;
+    Dwarf_Unsigned size = 0;
+    const char *secname = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    build_index(slotcount,namecount,swap);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    res = dwarf_gdbindex_header(dbg,&gi,&version,&culist,
+        &typeslist,&addrarea,&symtab,&pool,&size,&secname,
+        &error);
+    check("gdbindex header",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s\n",dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        }
+        dwarf_object_finish(dbg);
+        return;
+    }
+    check_symbols(dbg,gi,namecount);
+    check_addresses(dbg,gi);
+    res = dwarf_gdbindex_lookup(gi,0,0,0,&error);
+    check("NULL name",DW_DLV_ERROR,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        check("NULL name error",DW_DLE_IA,
+            dwarf_errno(error),__LINE__);
+        dwarf_dealloc_error(dbg,error);
+    }
+    dwarf_dealloc_gdbindex(gi);
+    dwarf_object_finish(dbg);
+}
+
+/*  A slot count that is not a power of two cannot
+    be probed. */
+static void
+check_bad_slotcount(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Gdbindex gi = 0;
+    Dwarf_Unsigned v[7];
+    const char *secname = 0;
+    Dwarf_Unsigned slot = 0;
+    Dwarf_Unsigned off = 20;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    build_index(8,4,FALSE);
+    /*  Six slots: the constant pool offset moves back. */
+    put_n(gdbbytes,&off,SYMTABOFFSET + 6*8,4);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    res = dwarf_gdbindex_header(dbg,&gi,&v[0],&v[1],&v[2],
+        &v[3],&v[4],&v[5],&v[6],&secname,&error);
+    check("gdbindex header",DW_DLV_OK,res,__LINE__);
+    if (res == DW_DLV_OK) {
+        res = dwarf_gdbindex_lookup(gi,names[0],&slot,0,
+            &error);
+        check("six slots",DW_DLV_ERROR,res,__LINE__);
+        if (res == DW_DLV_ERROR) {
+            check("six slots error",
+                DW_DLE_GDB_INDEX_COUNT_ERROR,
+                dwarf_errno(error),__LINE__);
+            dwarf_dealloc_error(dbg,error);
+        }
+        dwarf_dealloc_gdbindex(gi);
+    } else if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+    }
+    dwarf_object_finish(dbg);
+}
+
+int
+main(void)
+{
+    unsigned i = 0;
+
+    strcpy(names[0],"MixedCase");
+    strcpy(names[1],"mixedcase");
+    for (i = 2; i < NAMECOUNT; ++i) {
+        sprintf(names[i],"s%u_f",i);
+    }
+    check("same hash",gdb_hash(names[0]),gdb_hash(names[1]),
+        __LINE__);
+    /*  From nearly empty to full, where a search for a
+        missing name visits every slot. */
+    check_index(1024,NAMECOUNT,FALSE);
+    check_index(256,NAMECOUNT,FALSE);
+    check_index(256,NAMECOUNT,TRUE);
+    check_index(4,4,FALSE);
+    check_index(1,1,FALSE);
+    check_bad_slotcount();
+    if (errcount) {
+        printf("FAIL test_gdbindex_lookup %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_gdbindex_lookup\n");
+    return 0;
+}
@@ -0,0 +1,543 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_make_line_columns(),
+    dwarf_line_columns_row() and
+    dwarf_lookup_line_columns().
+    The rows of each table must be those of the
+    Dwarf_Line array (in some order), and a lookup at,
+    just before and just after every row address
+    must find the row a search of every sequence
+    finds: in the covering sequence starting
+    nearest below the pc, the last row at or below
+    the pc.
+
+    The line tables are a hand-made one with
+    overlapping sequences, as in a relocatable
+    object (read from memory, as in jitreader.c),
+    and those of test/dummyexecutable.debug,
+    test/testuriLE64ELf.testme and
+    test/test-mach-o-32.dSYM.
+
+    ./test_line_columns -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() free() qsort() */
+#include <string.h> /* memcmp() memcpy() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children */
+0x01, 0x11, 0x00,
+/* DW_AT_name DW_FORM_string, DW_AT_stmt_list DW_FORM_sec_offset */
+0x03, 0x08, 0x10, 0x17, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x10, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00, /* abbrev 1, "t.c" */
+0x00, 0x00, 0x00, 0x00 };     /* stmt_list */
+/*  unit_length is set by main().
+    Special opcode 0x13 adds a row at the same address
+    one line on, 0xf3 adds one 16 bytes and one line on. */
+static Dwarf_Small linebytes[] = {
+0x00, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x1b, 0x00, 0x00, 0x00, /* header_length */
+0x01, 0x01, 0x01,       /* min inst len, max ops, default_is_stmt */
+0xfb, 0x0e, 0x0d,       /* line_base -5, line_range, opcode_base */
+0x00, 0x01, 0x01, 0x01, 0x01, 0x00,
+0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+0x00,                   /* no include directories */
+0x74, 0x2e, 0x63, 0x00, 0x00, 0x00, 0x00, /* "t.c" */
+0x00,                   /* end of file names */
+/* 0x1000-0x1040: line 2 at 0x1000, line 3 at 0x1010 */
+0x00, 0x09, 0x02, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x13, 0xf3,
+0x02, 0x30,             /* DW_LNS_advance_pc 0x30 */
+0x00, 0x01, 0x01,       /* DW_LNE_end_sequence */
+/* 0x1004-0x1024: line 9 at 0x1004, line 10 at 0x1014 */
+0x00, 0x09, 0x02, 0x04, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x03, 0x08,             /* DW_LNS_advance_line 8 */
+0x01,                   /* DW_LNS_copy */
+0xf3,
+0x02, 0x10,
+0x00, 0x01, 0x01,
+/* 0x1018-0x1030: line 21 at 0x1018 */
+0x00, 0x09, 0x02, 0x18, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x03, 0x14,
+0x01,
+0x02, 0x18,
+0x00, 0x01, 0x01,
+/* 0x2000-0x2008: line 1 at 0x2000 */
+0x00, 0x09, 0x02, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x01,
+0x02, 0x08,
+0x00, 0x01, 0x01 };
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_line",sizeof(linebytes),linebytes}
+};
+static struct testobj_s testobj;
+
+/*  Lookups in the hand-made table. Line 0 means
+    no sequence covers the pc. */
+struct expect_s {
+    Dwarf_Addr     ex_pc;
+    Dwarf_Unsigned ex_line;
+};
+static struct expect_s expected[] = {
+{0x0fff,0},
+{0x1000,2},
+{0x1003,2},
+{0x1004,9},   /* the second sequence starts nearer */
+{0x1013,9},
+{0x1016,10},
+{0x1018,21},
+{0x1024,21},
+{0x1030,3},   /* only the first sequence is left */
+{0x103f,3},
+{0x1040,0},
+{0x2004,1},
+{0x2008,0}
+};
+#define EXPECTCOUNT (sizeof(expected)/sizeof(expected[0]))
+
+struct row_s {
+    Dwarf_Addr     r_addr;
+    Dwarf_Unsigned r_line;
+    Dwarf_Unsigned r_file;
+    Dwarf_Unsigned r_column;
+    Dwarf_Unsigned r_discriminator;
+    Dwarf_Unsigned r_flags;
+};
+
+static int
+compare_rows(const void *l,const void *r)
+{
+    const struct row_s *lr = (const struct row_s *)l;
+    const struct row_s *rr = (const struct row_s *)r;
+
+    if (lr->r_addr != rr->r_addr) {
+        return lr->r_addr < rr->r_addr? -1:1;
+    }
+    if (lr->r_line != rr->r_line) {
+        return lr->r_line < rr->r_line? -1:1;
+    }
+    if (lr->r_file != rr->r_file) {
+        return lr->r_file < rr->r_file? -1:1;
+    }
+    if (lr->r_column != rr->r_column) {
+        return lr->r_column < rr->r_column? -1:1;
+    }
+    if (lr->r_discriminator != rr->r_discriminator) {
+        return lr->r_discriminator < rr->r_discriminator?
+            -1:1;
+    }
+    if (lr->r_flags != rr->r_flags) {
+        return lr->r_flags < rr->r_flags? -1:1;
+    }
+    return 0;
+}
+
+static int
+read_line(Dwarf_Line line,struct row_s *r,Dwarf_Error *error)
+{
+    Dwarf_Bool flag = FALSE;
+    Dwarf_Bool prologue_end = FALSE;
+    Dwarf_Bool epilogue_begin = FALSE;
+    Dwarf_Unsigned isa = 0;
+    int res = 0;
+
+    memset(r,0,sizeof(*r));
+    res = dwarf_lineaddr(line,&r->r_addr,error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineno(line,&r->r_line,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_line_srcfileno(line,&r->r_file,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineoff_b(line,&r->r_column,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_linebeginstatement(line,&flag,error);
+        r->r_flags |= flag? DW_LINE_COLUMNS_IS_STMT:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineblock(line,&flag,error);
+        r->r_flags |= flag? DW_LINE_COLUMNS_BASIC_BLOCK:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineendsequence(line,&flag,error);
+        r->r_flags |= flag? DW_LINE_COLUMNS_END_SEQUENCE:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_prologue_end_etc(line,&prologue_end,
+            &epilogue_begin,&isa,&r->r_discriminator,error);
+        r->r_flags |= prologue_end?
+            DW_LINE_COLUMNS_PROLOGUE_END:0;
+        r->r_flags |= epilogue_begin?
+            DW_LINE_COLUMNS_EPILOGUE_BEGIN:0;
+    }
+    return res;
+}
+
+/*  Search every sequence, in table order, for the
+    covering one starting nearest below pc, as the
+    library documents. Sequences whose addresses go
+    backwards are never found.
+    Returns the index in rows or -1. */
+static Dwarf_Signed
+reference_lookup(struct row_s *rows,Dwarf_Signed count,
+    Dwarf_Addr pc)
+{
+    Dwarf_Signed first = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Signed best = -1;
+    Dwarf_Addr beststart = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Signed j = 0;
+        Dwarf_Signed last = -1;
+        int ascending = TRUE;
+
+        if (!(rows[i].r_flags & DW_LINE_COLUMNS_END_SEQUENCE) &&
+            i+1 < count) {
+            continue;
+        }
+        for (j = first; j <= i; ++j) {
+            if (j > first && rows[j].r_addr < rows[j-1].r_addr) {
+                ascending = FALSE;
+            }
+            if (rows[j].r_addr <= pc) {
+                last = j;
+            }
+        }
+        if (ascending && rows[first].r_addr <= pc &&
+            pc < rows[i].r_addr &&
+            (best < 0 || rows[first].r_addr >= beststart)) {
+            best = last;
+            beststart = rows[first].r_addr;
+        }
+        first = i + 1;
+    }
+    return best;
+}
+
+static void
+check_lookup(Dwarf_Line_Columns cols,struct row_s *rows,
+    Dwarf_Signed count,Dwarf_Addr pc)
+{
+    Dwarf_Signed expect = reference_lookup(rows,count,pc);
+    Dwarf_Unsigned row = 0;
+    Dwarf_Addr addr = 0;
+    Dwarf_Unsigned line = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_lookup_line_columns(cols,pc,&row,&error);
+    if (expect < 0) {
+        if (res != DW_DLV_NO_ENTRY) {
+            printf("FAIL pc 0x%llx found res %d\n",
+                (unsigned long long)pc,res);
+            ++errcount;
+        }
+        return;
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL pc 0x%llx not found res %d\n",
+            (unsigned long long)pc,res);
+        ++errcount;
+        return;
+    }
+    dwarf_line_columns_row(cols,row,&addr,&line,0,0,0,0,&error);
+    if (addr != rows[expect].r_addr ||
+        line != rows[expect].r_line) {
+        printf("FAIL pc 0x%llx found 0x%llx line %llu "
+            "not 0x%llx line %llu\n",
+            (unsigned long long)pc,(unsigned long long)addr,
+            (unsigned long long)line,
+            (unsigned long long)rows[expect].r_addr,
+            (unsigned long long)rows[expect].r_line);
+        ++errcount;
+    }
+}
+
+/*  Returns the number of rows checked. */
+static Dwarf_Signed
+check_context(Dwarf_Debug dbg,Dwarf_Line_Context context,
+    Dwarf_Line_Columns *cols_out)
+{
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Line_Columns cols = 0;
+    Dwarf_Unsigned rowcount = 0;
+    struct row_s *rows = 0;
+    struct row_s *colrows = 0;
+    struct row_s *sorted = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,&error);
+    if (res != DW_DLV_OK || !count) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return 0;
+    }
+    res = dwarf_make_line_columns(context,&cols,&rowcount,
+        &error);
+    check("make line columns",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return 0;
+    }
+    check("row count",count,rowcount,__LINE__);
+    rows = (struct row_s *)calloc((size_t)count,
+        sizeof(struct row_s));
+    colrows = (struct row_s *)calloc((size_t)count,
+        sizeof(struct row_s));
+    sorted = (struct row_s *)calloc((size_t)count,
+        sizeof(struct row_s));
+    if (!rows || !colrows || !sorted) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        count = 0;
+    }
+    for (i = 0; i < count; ++i) {
+        struct row_s *c = &colrows[i];
+
+        res = read_line(lines[i],&rows[i],&error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+            ++errcount;
+        }
+        res = dwarf_line_columns_row(cols,(Dwarf_Unsigned)i,
+            &c->r_addr,&c->r_line,&c->r_file,&c->r_column,
+            &c->r_discriminator,&c->r_flags,&error);
+        check("columns row",DW_DLV_OK,res,__LINE__);
+    }
+    if (count) {
+        Dwarf_Unsigned dummy = 0;
+
+        res = dwarf_line_columns_row(cols,(Dwarf_Unsigned)count,
+            &dummy,0,0,0,0,0,&error);
+        check("row past the end",DW_DLV_NO_ENTRY,res,__LINE__);
+        memcpy(sorted,rows,(size_t)count*sizeof(struct row_s));
+        qsort(sorted,(size_t)count,sizeof(struct row_s),
+            compare_rows);
+        qsort(colrows,(size_t)count,sizeof(struct row_s),
+            compare_rows);
+        if (memcmp(sorted,colrows,
+            (size_t)count*sizeof(struct row_s))) {
+            printf("FAIL rows differ\n");
+            ++errcount;
+        }
+    }
+    for (i = 0; i < count; ++i) {
+        check_lookup(cols,rows,count,rows[i].r_addr - 1);
+        check_lookup(cols,rows,count,rows[i].r_addr);
+        check_lookup(cols,rows,count,rows[i].r_addr + 1);
+    }
+    free(rows);
+    free(colrows);
+    free(sorted);
+    if (cols_out) {
+        *cols_out = cols;
+    } else {
+        dwarf_dealloc_line_columns(cols);
+    }
+    return count;
+}
+
+/*  Returns the line context of the next CU with
+    one, or NULL. */
+static Dwarf_Line_Context
+next_context(Dwarf_Debug dbg,const char *name)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cu = 0;
+        Dwarf_Unsigned hdrlen = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrevoff = 0;
+        Dwarf_Half addrsize = 0;
+        Dwarf_Half offsize = 0;
+        Dwarf_Half extsize = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Unsigned typeoff = 0;
+        Dwarf_Unsigned nexthdr = 0;
+        Dwarf_Half hdrtype = 0;
+        Dwarf_Unsigned lineversion = 0;
+        Dwarf_Small tablecount = 0;
+        Dwarf_Line_Context context = 0;
+
+        memset(&sig,0,sizeof(sig));
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu,
+            &hdrlen,&version,&abbrevoff,&addrsize,
+            &offsize,&extsize,&sig,&typeoff,&nexthdr,
+            &hdrtype,&error);
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+            ++errcount;
+            dwarf_dealloc_error(dbg,error);
+        }
+        if (res != DW_DLV_OK) {
+            return 0;
+        }
+        res = dwarf_srclines_b(cu,&lineversion,&tablecount,
+            &context,&error);
+        dwarf_dealloc_die(cu);
+        if (res == DW_DLV_OK) {
+            return context;
+        }
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+            ++errcount;
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+        }
+    }
+}
+
+static void
+check_memory(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line_Columns cols = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    context = next_context(dbg,"in-memory");
+    if (!context) {
+        printf("FAIL no in-memory line table\n");
+        ++errcount;
+        dwarf_object_finish(dbg);
+        return;
+    }
+    check("in-memory rows",10,
+        (Dwarf_Unsigned)check_context(dbg,context,&cols),
+        __LINE__);
+    /*  The table does not refer to the context. */
+    dwarf_srclines_dealloc_b(context);
+    for (i = 0; cols && i < EXPECTCOUNT; ++i) {
+        Dwarf_Unsigned row = 0;
+        Dwarf_Unsigned line = 0;
+
+        res = dwarf_lookup_line_columns(cols,
+            expected[i].ex_pc,&row,&error);
+        if (!expected[i].ex_line) {
+            check("in-memory no entry",DW_DLV_NO_ENTRY,res,
+                __LINE__);
+            continue;
+        }
+        check("in-memory lookup",DW_DLV_OK,res,__LINE__);
+        dwarf_line_columns_row(cols,row,0,&line,0,0,0,0,
+            &error);
+        check("in-memory line",expected[i].ex_line,line,
+            __LINE__);
+    }
+    dwarf_dealloc_line_columns(cols);
+    dwarf_object_finish(dbg);
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Signed total = 0;
+    int res = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    while ((context = next_context(dbg,name)) != 0) {
+        total += check_context(dbg,context,0);
+        dwarf_srclines_dealloc_b(context);
+    }
+    check("rows seen",1,total > 10,__LINE__);
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Unsigned unitlen = sizeof(linebytes) - 4;
+
+    linebytes[0] = (Dwarf_Small)unitlen;
+    linebytes[1] = (Dwarf_Small)(unitlen >> 8);
+    check_memory();
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    if (errcount) {
+        printf("FAIL test_line_columns %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_line_columns\n");
+    return 0;
+}
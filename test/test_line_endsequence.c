@@ -0,0 +1,223 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  A regression test for the end_sequence flag of
+    line table rows made by a special opcode.
+    Such rows used to take li_end_sequence from the
+    epilogue_begin register, so a row following
+    DW_LNS_set_epilogue_begin was reported by
+    dwarf_lineendsequence() as ending its sequence.
+
+    The DWARF is a hand-assembled DWARF4 compilation
+    unit read from memory, as in jitreader.c. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children */
+0x01, 0x11, 0x00,
+/* DW_AT_name DW_FORM_string, DW_AT_stmt_list DW_FORM_sec_offset */
+0x03, 0x08, 0x10, 0x17, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x10, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00, /* abbrev 1, "t.c" */
+0x00, 0x00, 0x00, 0x00 };     /* stmt_list */
+static Dwarf_Small linebytes[] = {
+0x34, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x1b, 0x00, 0x00, 0x00, /* header_length */
+0x01, 0x01, 0x01,       /* min inst len, max ops, default_is_stmt */
+0xfb, 0x0e, 0x0d,       /* line_base -5, line_range, opcode_base */
+0x00, 0x01, 0x01, 0x01, 0x01, 0x00,
+0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+0x00,                   /* no include directories */
+0x74, 0x2e, 0x63, 0x00, 0x00, 0x00, 0x00, /* "t.c" */
+0x00,                   /* end of file names */
+/* DW_LNE_set_address 0x1000 */
+0x00, 0x09, 0x02, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x13,                   /* special: line 2, row at 0x1000 */
+0x0b,                   /* DW_LNS_set_epilogue_begin */
+0x4b,                   /* special: +4, line 3, row at 0x1004 */
+0x02, 0x04,             /* DW_LNS_advance_pc 4 */
+0x00, 0x01, 0x01 };     /* DW_LNE_end_sequence at 0x1008 */
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_line",sizeof(linebytes),linebytes}
+};
+static struct testobj_s testobj;
+
+struct expect_s {
+    Dwarf_Addr     ex_addr;
+    Dwarf_Unsigned ex_line;
+    Dwarf_Bool     ex_end_sequence;
+    Dwarf_Bool     ex_epilogue_begin;
+};
+static struct expect_s expected[] = {
+{0x1000,2,FALSE,FALSE},
+{0x1004,3,FALSE,TRUE},
+{0x1008,3,TRUE,FALSE}
+};
+#define EXPECTCOUNT (sizeof(expected)/sizeof(expected[0]))
+
+static int
+check_lines(Dwarf_Debug dbg,Dwarf_Error *error)
+{
+    Dwarf_Die cudie = 0;
+    Dwarf_Unsigned header_length = 0;
+    Dwarf_Half version_stamp = 0;
+    Dwarf_Unsigned abbrev_offset = 0;
+    Dwarf_Half address_size = 0;
+    Dwarf_Half offset_size = 0;
+    Dwarf_Half extension_size = 0;
+    Dwarf_Sig8 signature;
+    Dwarf_Unsigned typeoffset = 0;
+    Dwarf_Unsigned next_cu_offset = 0;
+    Dwarf_Half cu_type = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    memset(&signature,0,sizeof(signature));
+    res = dwarf_next_cu_header_e(dbg,TRUE,&cudie,
+        &header_length,&version_stamp,&abbrev_offset,
+        &address_size,&offset_size,&extension_size,
+        &signature,&typeoffset,&next_cu_offset,&cu_type,
+        error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL no CU, res %d\n",res);
+        return res;
+    }
+    res = dwarf_srclines_b(cudie,&version,&table_count,
+        &context,error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_srclines_b res %d\n",res);
+        dwarf_dealloc_die(cudie);
+        return res;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_srclines_from_linecontext res %d\n",
+            res);
+        dwarf_srclines_dealloc_b(context);
+        dwarf_dealloc_die(cudie);
+        return res;
+    }
+    check("row count",EXPECTCOUNT,(Dwarf_Unsigned)count,
+        __LINE__);
+    for (i = 0; i < count && i < (Dwarf_Signed)EXPECTCOUNT;
+        ++i) {
+        struct expect_s *ex = expected + i;
+        Dwarf_Addr addr = 0;
+        Dwarf_Unsigned lineno = 0;
+        Dwarf_Bool endseq = FALSE;
+        Dwarf_Bool prologue_end = FALSE;
+        Dwarf_Bool epilogue_begin = FALSE;
+        Dwarf_Unsigned isa = 0;
+        Dwarf_Unsigned discriminator = 0;
+        int errs_before = errcount;
+
+        res = dwarf_lineaddr(lines[i],&addr,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineno(lines[i],&lineno,error);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineendsequence(lines[i],&endseq,error);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_prologue_end_etc(lines[i],
+                &prologue_end,&epilogue_begin,&isa,
+                &discriminator,error);
+        }
+        if (res != DW_DLV_OK) {
+            printf("FAIL reading row %d res %d\n",(int)i,res);
+            break;
+        }
+        check("address",ex->ex_addr,addr,__LINE__);
+        check("line",ex->ex_line,lineno,__LINE__);
+        check("end_sequence",ex->ex_end_sequence,endseq,
+            __LINE__);
+        check("epilogue_begin",ex->ex_epilogue_begin,
+            epilogue_begin,__LINE__);
+        if (errcount != errs_before) {
+            printf("FAIL in row %d\n",(int)i);
+        }
+    }
+    dwarf_srclines_dealloc_b(context);
+    dwarf_dealloc_die(cudie);
+    return res;
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    res = check_lines(dbg,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s\n",dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+    } else if (res == DW_DLV_NO_ENTRY) {
+        ++errcount;
+    }
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_line_endsequence %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_line_endsequence\n");
+    return 0;
+}
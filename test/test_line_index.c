@@ -0,0 +1,707 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_make_line_index(),
+    dwarf_lookup_line_index() and
+    dwarf_lookup_line_index_batch().
+    The index of each object is written to a temporary
+    file and read back into new memory, and the
+    Dwarf_Debug is finished before any lookup, as a
+    saved index would be used.
+    At, just before and just after every row address
+    a lookup must give the file and line that a search
+    of every sequence of every CU gives: in the covering
+    sequence starting nearest below the pc, the last row
+    at or below the pc.  The batch lookup must agree.
+    A truncated index must be rejected.
+
+    The line tables are the hand-made one of
+    test_line_columns.c plus a repeated sequence
+    (read from memory, as in jitreader.c) and those
+    of test/dummyexecutable.debug,
+    test/testuriLE64ELf.testme and
+    test/test-mach-o-32.dSYM.
+
+    ./test_line_index -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fread() fwrite() printf() tmpfile() */
+#include <stdlib.h> /* calloc() free() malloc() realloc() */
+#include <string.h> /* memcpy() memset() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children */
+0x01, 0x11, 0x00,
+/* DW_AT_name DW_FORM_string, DW_AT_stmt_list DW_FORM_sec_offset */
+0x03, 0x08, 0x10, 0x17, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[] = {
+0x10, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00, /* abbrev 1, "t.c" */
+0x00, 0x00, 0x00, 0x00 };     /* stmt_list */
+/*  unit_length is set by main().
+    Special opcode 0x13 adds a row at the same address
+    one line on, 0xf3 adds one 16 bytes and one line on. */
+static Dwarf_Small linebytes[] = {
+0x00, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x1b, 0x00, 0x00, 0x00, /* header_length */
+0x01, 0x01, 0x01,       /* min inst len, max ops, default_is_stmt */
+0xfb, 0x0e, 0x0d,       /* line_base -5, line_range, opcode_base */
+0x00, 0x01, 0x01, 0x01, 0x01, 0x00,
+0x00, 0x00, 0x01, 0x00, 0x00, 0x01,
+0x00,                   /* no include directories */
+0x74, 0x2e, 0x63, 0x00, 0x00, 0x00, 0x00, /* "t.c" */
+0x00,                   /* end of file names */
+/* 0x1000-0x1040: line 2 at 0x1000, line 3 at 0x1010 */
+0x00, 0x09, 0x02, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x13, 0xf3,
+0x02, 0x30,             /* DW_LNS_advance_pc 0x30 */
+0x00, 0x01, 0x01,       /* DW_LNE_end_sequence */
+/* 0x1004-0x1024: line 9 at 0x1004, line 10 at 0x1014 */
+0x00, 0x09, 0x02, 0x04, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x03, 0x08,             /* DW_LNS_advance_line 8 */
+0x01,                   /* DW_LNS_copy */
+0xf3,
+0x02, 0x10,
+0x00, 0x01, 0x01,
+/* 0x1018-0x1030: line 21 at 0x1018 */
+0x00, 0x09, 0x02, 0x18, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x03, 0x14,
+0x01,
+0x02, 0x18,
+0x00, 0x01, 0x01,
+/* 0x2000-0x2008: line 1 at 0x2000 */
+0x00, 0x09, 0x02, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x01,
+0x02, 0x08,
+0x00, 0x01, 0x01,
+/* 0x2000-0x2008 again, recorded once */
+0x00, 0x09, 0x02, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x01,
+0x02, 0x08,
+0x00, 0x01, 0x01 };
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_line",sizeof(linebytes),linebytes}
+};
+static struct testobj_s testobj;
+
+/*  Lookups in the hand-made index. Line 0 means
+    no sequence covers the pc. */
+struct expect_s {
+    Dwarf_Addr     ex_pc;
+    Dwarf_Unsigned ex_line;
+};
+static struct expect_s expected[] = {
+{0x0fff,0},
+{0x1000,2},
+{0x1004,9},   /* the second sequence starts nearer */
+{0x1016,10},
+{0x1018,21},
+{0x1030,3},   /* only the first sequence is left */
+{0x1040,0},
+{0x2004,1},
+{0x2008,0}
+};
+#define EXPECTCOUNT (sizeof(expected)/sizeof(expected[0]))
+
+struct ref_row_s {
+    Dwarf_Addr     rr_addr;
+    Dwarf_Unsigned rr_line;
+    char          *rr_file;
+};
+
+struct ref_seq_s {
+    Dwarf_Addr        rs_start;
+    Dwarf_Addr        rs_end;
+    struct ref_row_s *rs_rows;
+    Dwarf_Unsigned    rs_count;
+};
+
+struct ref_s {
+    struct ref_seq_s *r_seqs;
+    Dwarf_Unsigned    r_count;
+    Dwarf_Unsigned    r_size;
+    Dwarf_Addr       *r_pcs;
+    Dwarf_Unsigned    r_pccount;
+};
+
+static char *
+copy_string(const char *s)
+{
+    size_t len = strlen(s);
+    char *copy = (char *)malloc(len+1);
+
+    if (copy) {
+        memcpy(copy,s,len+1);
+    }
+    return copy;
+}
+
+/*  Record one sequence, lines[first] through the
+    end_sequence row lines[last], with the file names
+    copied so they outlive the Dwarf_Debug.
+    As the index does, sequences that are empty or
+    whose addresses go backwards are left out. */
+static void
+add_sequence(Dwarf_Debug dbg,struct ref_s *ref,
+    Dwarf_Line *lines,Dwarf_Signed first,Dwarf_Signed last)
+{
+    struct ref_seq_s *seq = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Signed i = 0;
+
+    for (i = first; i <= last; ++i) {
+        Dwarf_Addr addr = 0;
+        Dwarf_Addr prev = 0;
+
+        dwarf_lineaddr(lines[i],&addr,&error);
+        if (i > first) {
+            dwarf_lineaddr(lines[i-1],&prev,&error);
+            if (addr < prev) {
+                return;
+            }
+        }
+    }
+    if (ref->r_count == ref->r_size) {
+        Dwarf_Unsigned newsize = ref->r_size?ref->r_size*2:64;
+        struct ref_seq_s *newseqs = 0;
+
+        newseqs = (struct ref_seq_s *)realloc(ref->r_seqs,
+            (size_t)newsize*sizeof(struct ref_seq_s));
+        if (!newseqs) {
+            printf("FAIL out of memory\n");
+            ++errcount;
+            return;
+        }
+        ref->r_seqs = newseqs;
+        ref->r_size = newsize;
+    }
+    seq = &ref->r_seqs[ref->r_count];
+    memset(seq,0,sizeof(*seq));
+    dwarf_lineaddr(lines[first],&seq->rs_start,&error);
+    dwarf_lineaddr(lines[last],&seq->rs_end,&error);
+    if (seq->rs_end <= seq->rs_start) {
+        return;
+    }
+    seq->rs_count = (Dwarf_Unsigned)(last - first + 1);
+    seq->rs_rows = (struct ref_row_s *)calloc(
+        (size_t)seq->rs_count,sizeof(struct ref_row_s));
+    if (!seq->rs_rows) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        return;
+    }
+    ref->r_count++;
+    for (i = first; i <= last; ++i) {
+        struct ref_row_s *r = &seq->rs_rows[i-first];
+        char *file = 0;
+        int res = 0;
+
+        dwarf_lineaddr(lines[i],&r->rr_addr,&error);
+        dwarf_lineno(lines[i],&r->rr_line,&error);
+        res = dwarf_linesrc(lines[i],&file,&error);
+        if (res == DW_DLV_OK) {
+            r->rr_file = copy_string(file);
+            dwarf_dealloc(dbg,file,DW_DLA_STRING);
+        } else {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+                error = 0;
+            }
+            r->rr_file = copy_string("");
+        }
+    }
+}
+
+static void
+add_context(Dwarf_Debug dbg,struct ref_s *ref,
+    Dwarf_Line_Context context)
+{
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed first = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,&error);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Bool endseq = 0;
+
+        dwarf_lineendsequence(lines[i],&endseq,&error);
+        if (endseq) {
+            add_sequence(dbg,ref,lines,first,i);
+            first = i + 1;
+        }
+    }
+}
+
+static void
+build_reference(Dwarf_Debug dbg,const char *name,
+    struct ref_s *ref)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned j = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cu = 0;
+        Dwarf_Unsigned hdrlen = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrevoff = 0;
+        Dwarf_Half addrsize = 0;
+        Dwarf_Half offsize = 0;
+        Dwarf_Half extsize = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Unsigned typeoff = 0;
+        Dwarf_Unsigned nexthdr = 0;
+        Dwarf_Half hdrtype = 0;
+        Dwarf_Unsigned lineversion = 0;
+        Dwarf_Small tablecount = 0;
+        Dwarf_Line_Context context = 0;
+
+        memset(&sig,0,sizeof(sig));
+        res = dwarf_next_cu_header_e(dbg,1,&cu,
+            &hdrlen,&version,&abbrevoff,&addrsize,
+            &offsize,&extsize,&sig,&typeoff,&nexthdr,
+            &hdrtype,&error);
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+            ++errcount;
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_srclines_b(cu,&lineversion,&tablecount,
+            &context,&error);
+        if (res == DW_DLV_OK) {
+            /*  Two-level tables are not indexed. */
+            if (tablecount == 1) {
+                add_context(dbg,ref,context);
+            }
+            dwarf_srclines_dealloc_b(context);
+        } else if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+            error = 0;
+        }
+        dwarf_dealloc_die(cu);
+    }
+    for (i = 0; i < ref->r_count; ++i) {
+        ref->r_pccount += 3*ref->r_seqs[i].rs_count;
+    }
+    ref->r_pcs = (Dwarf_Addr *)calloc(
+        (size_t)(ref->r_pccount+1),sizeof(Dwarf_Addr));
+    if (!ref->r_pcs) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        ref->r_pccount = 0;
+        return;
+    }
+    ref->r_pccount = 0;
+    for (i = 0; i < ref->r_count; ++i) {
+        struct ref_seq_s *seq = &ref->r_seqs[i];
+
+        for (j = 0; j < seq->rs_count; ++j) {
+            Dwarf_Addr a = seq->rs_rows[j].rr_addr;
+
+            ref->r_pcs[ref->r_pccount++] = a - 1;
+            ref->r_pcs[ref->r_pccount++] = a;
+            ref->r_pcs[ref->r_pccount++] = a + 1;
+        }
+    }
+}
+
+static void
+free_reference(struct ref_s *ref)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned j = 0;
+
+    for (i = 0; i < ref->r_count; ++i) {
+        struct ref_seq_s *seq = &ref->r_seqs[i];
+
+        for (j = 0; j < seq->rs_count; ++j) {
+            free(seq->rs_rows[j].rr_file);
+        }
+        free(seq->rs_rows);
+    }
+    free(ref->r_seqs);
+    free(ref->r_pcs);
+}
+
+/*  Search every sequence for pc. Returns 0 if none
+    covers it, 1 with the row in *row_out, or 2 if
+    sequences starting at the same address disagree
+    (which the index may answer either way). */
+static int
+reference_lookup(struct ref_s *ref,Dwarf_Addr pc,
+    struct ref_row_s **row_out)
+{
+    struct ref_seq_s *best = 0;
+    struct ref_row_s *bestrow = 0;
+    int ambiguous = 0;
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < ref->r_count; ++i) {
+        struct ref_seq_s *seq = &ref->r_seqs[i];
+        struct ref_row_s *last = 0;
+        Dwarf_Unsigned j = 0;
+
+        if (pc < seq->rs_start || pc >= seq->rs_end) {
+            continue;
+        }
+        for (j = 0; j < seq->rs_count; ++j) {
+            if (seq->rs_rows[j].rr_addr <= pc) {
+                last = &seq->rs_rows[j];
+            }
+        }
+        if (!best || seq->rs_start > best->rs_start) {
+            best = seq;
+            bestrow = last;
+            ambiguous = 0;
+        } else if (seq->rs_start == best->rs_start &&
+            (last->rr_line != bestrow->rr_line ||
+            strcmp(last->rr_file,bestrow->rr_file))) {
+            ambiguous = 1;
+        }
+    }
+    if (!best) {
+        return 0;
+    }
+    *row_out = bestrow;
+    return ambiguous? 2:1;
+}
+
+/*  Writes the index to a temporary file and reads it
+    back into new memory, as a saved index would be. */
+static void *
+write_and_read_back(void *table,Dwarf_Unsigned size)
+{
+    FILE *f = tmpfile();
+    void *copy = 0;
+
+    if (!f) {
+        printf("FAIL cannot create a temporary file\n");
+        return 0;
+    }
+    if (fwrite(table,1,(size_t)size,f) != (size_t)size) {
+        printf("FAIL writing the line index\n");
+        fclose(f);
+        return 0;
+    }
+    rewind(f);
+    /*  malloc() memory is suitably aligned for any
+        type, so 8 byte aligned. */
+    copy = malloc((size_t)size);
+    if (!copy) {
+        printf("FAIL out of memory\n");
+        fclose(f);
+        return 0;
+    }
+    if (fread(copy,1,(size_t)size,f) != (size_t)size) {
+        printf("FAIL reading the line index back\n");
+        free(copy);
+        copy = 0;
+    }
+    fclose(f);
+    return copy;
+}
+
+static void
+check_lookups(const char *name,struct ref_s *ref,
+    const void *table,Dwarf_Unsigned size)
+{
+    const char **files = 0;
+    Dwarf_Unsigned *lines = 0;
+    Dwarf_Unsigned found = 0;
+    Dwarf_Unsigned expectfound = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    files = (const char **)calloc((size_t)ref->r_pccount+1,
+        sizeof(const char *));
+    lines = (Dwarf_Unsigned *)calloc((size_t)ref->r_pccount+1,
+        sizeof(Dwarf_Unsigned));
+    if (!files || !lines) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        free(files);
+        free(lines);
+        return;
+    }
+    res = dwarf_lookup_line_index_batch(table,size,
+        ref->r_pcs,ref->r_pccount,files,lines,&found,&error);
+    check("batch lookup",DW_DLV_OK,res,__LINE__);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,error);
+        error = 0;
+    }
+    for (i = 0; i < ref->r_pccount; ++i) {
+        Dwarf_Addr pc = ref->r_pcs[i];
+        struct ref_row_s *row = 0;
+        const char *file = 0;
+        Dwarf_Unsigned line = 0;
+        int kind = reference_lookup(ref,pc,&row);
+
+        res = dwarf_lookup_line_index(table,size,pc,&file,
+            &line,0,&error);
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s pc 0x%llx: %s\n",name,
+                (unsigned long long)pc,dwarf_errmsg(error));
+            ++errcount;
+            dwarf_dealloc_error(0,error);
+            error = 0;
+            continue;
+        }
+        if (res == DW_DLV_OK) {
+            ++expectfound;
+        }
+        if (files[i] != file || lines[i] != line) {
+            printf("FAIL %s pc 0x%llx batch differs\n",name,
+                (unsigned long long)pc);
+            ++errcount;
+        }
+        if (kind == 0) {
+            if (res != DW_DLV_NO_ENTRY) {
+                printf("FAIL %s pc 0x%llx found\n",name,
+                    (unsigned long long)pc);
+                ++errcount;
+            }
+            continue;
+        }
+        if (kind == 2) {
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            printf("FAIL %s pc 0x%llx not found\n",name,
+                (unsigned long long)pc);
+            ++errcount;
+            continue;
+        }
+        if (line != row->rr_line || strcmp(file,row->rr_file)) {
+            printf("FAIL %s pc 0x%llx %s:%llu not %s:%llu\n",
+                name,(unsigned long long)pc,file,
+                (unsigned long long)line,row->rr_file,
+                (unsigned long long)row->rr_line);
+            ++errcount;
+        }
+    }
+    check("batch found",expectfound,found,__LINE__);
+    free(files);
+    free(lines);
+}
+
+/*  A table cut short anywhere is not a valid table. */
+static void
+check_truncated(const void *table,Dwarf_Unsigned size)
+{
+    Dwarf_Unsigned cut = 0;
+    Dwarf_Error error = 0;
+
+    for (cut = 0; cut < size; cut += 8) {
+        const char *file = 0;
+        Dwarf_Unsigned line = 0;
+        int res = 0;
+
+        res = dwarf_lookup_line_index(table,cut,0,&file,
+            &line,0,&error);
+        if (res != DW_DLV_ERROR) {
+            printf("FAIL table cut to %llu bytes accepted\n",
+                (unsigned long long)cut);
+            ++errcount;
+            return;
+        }
+        dwarf_dealloc_error(0,error);
+        error = 0;
+    }
+}
+
+/*  Damage to the header must be caught or at worst
+    give wrong answers, never a read outside the table.
+    Run under a sanitizer to see the difference. */
+static void
+check_corrupt(const void *table,Dwarf_Unsigned size)
+{
+    unsigned char *bad = (unsigned char *)malloc((size_t)size);
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+
+    if (!bad) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        return;
+    }
+    for (i = 8; i < size && i < 120; ++i) {
+        const char *file = 0;
+        Dwarf_Unsigned line = 0;
+        int res = 0;
+
+        memcpy(bad,table,(size_t)size);
+        bad[i] ^= 0xff;
+        res = dwarf_lookup_line_index(bad,size,0x1000,&file,
+            &line,0,&error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(0,error);
+            error = 0;
+        }
+    }
+    free(bad);
+}
+
+/*  Builds the reference and the index from dbg,
+    finishes dbg, then checks the index. */
+static void
+check_dbg(const char *name,Dwarf_Debug dbg,int inmemory)
+{
+    struct ref_s ref;
+    void *table = 0;
+    void *copy = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    memset(&ref,0,sizeof(ref));
+    res = dwarf_make_line_index(dbg,&table,&size,&error);
+    check("make line index",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s: %s\n",name,dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    build_reference(dbg,name,&ref);
+    if (inmemory) {
+        dwarf_object_finish(dbg);
+    } else {
+        dwarf_finish(dbg);
+    }
+    copy = write_and_read_back(table,size);
+    dwarf_dealloc_line_index(table);
+    if (!copy) {
+        ++errcount;
+        free_reference(&ref);
+        return;
+    }
+    check("rows seen",1,ref.r_pccount > 10,__LINE__);
+    check_lookups(name,&ref,copy,size);
+    check_truncated(copy,size);
+    check_corrupt(copy,size);
+    for (i = 0; inmemory && i < EXPECTCOUNT; ++i) {
+        const char *file = 0;
+        Dwarf_Unsigned line = 0;
+
+        res = dwarf_lookup_line_index(copy,size,
+            expected[i].ex_pc,&file,&line,0,&error);
+        if (!expected[i].ex_line) {
+            check("in-memory no entry",DW_DLV_NO_ENTRY,res,
+                __LINE__);
+            continue;
+        }
+        check("in-memory lookup",DW_DLV_OK,res,__LINE__);
+        check("in-memory line",expected[i].ex_line,line,
+            __LINE__);
+    }
+    free(copy);
+    free_reference(&ref);
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    check_dbg(name,dbg,0);
+}
+
+int
+main(int argc,char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned unitlen = sizeof(linebytes) - 4;
+    int res = 0;
+
+    linebytes[0] = (Dwarf_Small)unitlen;
+    linebytes[1] = (Dwarf_Small)(unitlen >> 8);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    check_dbg("in-memory",dbg,1);
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    if (errcount) {
+        printf("FAIL test_line_index %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_line_index\n");
+    return 0;
+}
@@ -0,0 +1,576 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks the rows of dwarf_srclines_b() line tables,
+    now kept in one array per table: the row count
+    and every line register of every row must be
+    those of a simulation of the line program.
+
+    Two line tables are made (read from memory, as
+    in jitreader.c) with many sequences and all the
+    standard and extended opcodes that set a row or
+    a register.  The second table must still be
+    right after the first is deallocated and after
+    dwarf_dealloc() of one of its rows.
+
+    ./test_line_rows */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_compile_unit, no children */
+0x01, 0x11, 0x00,
+/* DW_AT_name DW_FORM_string, DW_AT_stmt_list DW_FORM_sec_offset */
+0x03, 0x08, 0x10, 0x17, 0x00, 0x00,
+0x00 };
+/*  The stmt_list of the second CU is set by main(). */
+static Dwarf_Small infobytes[] = {
+0x10, 0x00, 0x00, 0x00, /* unit_length */
+0x04, 0x00,             /* version */
+0x00, 0x00, 0x00, 0x00, /* debug_abbrev_offset */
+0x08,                   /* address_size */
+0x01, 0x74, 0x2e, 0x63, 0x00, /* abbrev 1, "t.c" */
+0x00, 0x00, 0x00, 0x00, /* stmt_list */
+0x10, 0x00, 0x00, 0x00,
+0x04, 0x00,
+0x00, 0x00, 0x00, 0x00,
+0x08,
+0x01, 0x75, 0x2e, 0x63, 0x00, /* abbrev 1, "u.c" */
+0x00, 0x00, 0x00, 0x00 };
+
+#define LINEMAX 150000
+static Dwarf_Small linebytes[LINEMAX];
+static unsigned linelen;
+
+#define SECCOUNT 3
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",sizeof(infobytes),infobytes},
+{".debug_line",0,linebytes}
+};
+static struct testobj_s testobj;
+
+#define LINE_BASE   (-5)
+#define LINE_RANGE  14
+#define OPCODE_BASE 13
+#define FILECOUNT   3
+static const char *filenames[FILECOUNT] = {"a.c","b.c","c.c"};
+
+#define F_IS_STMT        1
+#define F_BASIC_BLOCK    2
+#define F_END_SEQUENCE   4
+#define F_PROLOGUE_END   8
+#define F_EPILOGUE_BEGIN 16
+
+struct row_s {
+    Dwarf_Addr     r_addr;
+    Dwarf_Unsigned r_line;
+    Dwarf_Unsigned r_file;
+    Dwarf_Unsigned r_column;
+    Dwarf_Unsigned r_isa;
+    Dwarf_Unsigned r_discriminator;
+    unsigned       r_flags;
+};
+
+#define TABLECOUNT 2
+#define ROWMAX 12000
+static struct row_s rows[TABLECOUNT][ROWMAX];
+static Dwarf_Unsigned rowcount[TABLECOUNT];
+
+/*  The line registers while making a table. */
+static struct row_s state;
+static unsigned long seed;
+
+static unsigned
+next_random(void)
+{
+    seed = seed*1103515245UL + 12345UL;
+    return (unsigned)((seed >> 16) & 0x7fff);
+}
+
+static void
+put_byte(unsigned v)
+{
+    if (linelen >= LINEMAX) {
+        printf("FAIL line table too large\n");
+        ++errcount;
+        return;
+    }
+    linebytes[linelen++] = (Dwarf_Small)v;
+}
+
+static void
+put_n(Dwarf_Unsigned v,unsigned n)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < n; ++i) {
+        put_byte((unsigned)(v & 0xff));
+        v >>= 8;
+    }
+}
+
+static void
+put_uleb(Dwarf_Unsigned v)
+{
+    do {
+        unsigned b = (unsigned)(v & 0x7f);
+
+        v >>= 7;
+        put_byte(v? (b|0x80):b);
+    } while (v);
+}
+
+static void
+put_sleb(Dwarf_Signed v)
+{
+    for (;;) {
+        unsigned b = (unsigned)(v & 0x7f);
+
+        v >>= 7;
+        if ((v == 0 && !(b & 0x40)) ||
+            (v == -1 && (b & 0x40))) {
+            put_byte(b);
+            return;
+        }
+        put_byte(b|0x80);
+    }
+}
+
+/*  Appends a row of the current registers, then
+    clears those reset after each row. */
+static void
+add_row(unsigned t)
+{
+    if (rowcount[t] >= ROWMAX) {
+        printf("FAIL too many rows\n");
+        ++errcount;
+        return;
+    }
+    rows[t][rowcount[t]++] = state;
+    state.r_discriminator = 0;
+    state.r_flags &= ~(F_BASIC_BLOCK|F_PROLOGUE_END|
+        F_EPILOGUE_BEGIN);
+}
+
+/*  A special opcode moving by a random address and
+    line delta. */
+static void
+put_special(unsigned t)
+{
+    Dwarf_Signed linedelta =
+        (Dwarf_Signed)(next_random()%LINE_RANGE) + LINE_BASE;
+    unsigned addrdelta = next_random()%17;
+
+    if ((Dwarf_Signed)state.r_line + linedelta < 1) {
+        linedelta = 0;
+    }
+    put_byte((unsigned)(linedelta - LINE_BASE) +
+        LINE_RANGE*addrdelta + OPCODE_BASE);
+    state.r_addr += addrdelta;
+    state.r_line = (Dwarf_Unsigned)((Dwarf_Signed)state.r_line +
+        linedelta);
+    add_row(t);
+}
+
+static void
+put_sequence(unsigned t,Dwarf_Addr start,unsigned count)
+{
+    unsigned i = 0;
+    unsigned end = 0;
+
+    memset(&state,0,sizeof(state));
+    state.r_addr = start;
+    state.r_line = 1;
+    state.r_file = 1;
+    state.r_flags = F_IS_STMT;
+    put_byte(0);
+    put_byte(9);
+    put_byte(DW_LNE_set_address);
+    put_n(start,8);
+    for (i = 0; i < count; ++i) {
+        switch (next_random()%7) {
+        case 0:
+            put_special(t);
+            break;
+        case 1: {
+            Dwarf_Unsigned addrdelta = next_random()%5000;
+            Dwarf_Signed linedelta =
+                (Dwarf_Signed)(next_random()%2001) - 1000;
+
+            if ((Dwarf_Signed)state.r_line + linedelta < 1) {
+                linedelta = -linedelta;
+            }
+            put_byte(DW_LNS_advance_pc);
+            put_uleb(addrdelta);
+            put_byte(DW_LNS_advance_line);
+            put_sleb(linedelta);
+            put_byte(DW_LNS_copy);
+            state.r_addr += addrdelta;
+            state.r_line = (Dwarf_Unsigned)(
+                (Dwarf_Signed)state.r_line + linedelta);
+            add_row(t);
+            break;
+        }
+        case 2:
+            state.r_file = 1 + next_random()%FILECOUNT;
+            state.r_column = next_random()%300;
+            put_byte(DW_LNS_set_file);
+            put_uleb(state.r_file);
+            put_byte(DW_LNS_set_column);
+            put_uleb(state.r_column);
+            put_special(t);
+            break;
+        case 3:
+            state.r_flags ^= F_IS_STMT;
+            state.r_flags |= F_BASIC_BLOCK;
+            put_byte(DW_LNS_negate_stmt);
+            put_byte(DW_LNS_set_basic_block);
+            put_byte(DW_LNS_copy);
+            add_row(t);
+            break;
+        case 4:
+            state.r_flags |= F_PROLOGUE_END;
+            state.r_isa = next_random()%4;
+            state.r_discriminator = 1 + next_random()%100000;
+            put_byte(DW_LNS_set_prologue_end);
+            put_byte(DW_LNS_set_isa);
+            put_uleb(state.r_isa);
+            put_byte(0);
+            put_byte(4);
+            put_byte(DW_LNE_set_discriminator);
+            /*  As a three byte ULEB. */
+            put_byte((unsigned)(state.r_discriminator & 0x7f) |
+                0x80);
+            put_byte((unsigned)((state.r_discriminator >> 7) &
+                0x7f) | 0x80);
+            put_byte((unsigned)(state.r_discriminator >> 14));
+            put_special(t);
+            break;
+        case 5:
+            state.r_flags |= F_EPILOGUE_BEGIN;
+            put_byte(DW_LNS_set_epilogue_begin);
+            put_byte(DW_LNS_copy);
+            add_row(t);
+            break;
+        default: {
+            unsigned fixed = next_random()%65536;
+
+            put_byte(DW_LNS_const_add_pc);
+            put_byte(DW_LNS_fixed_advance_pc);
+            put_n(fixed,2);
+            state.r_addr += (255 - OPCODE_BASE)/LINE_RANGE +
+                fixed;
+            put_special(t);
+            break;
+        }
+        }
+    }
+    end = 1 + next_random()%64;
+    put_byte(DW_LNS_const_add_pc);
+    put_byte(DW_LNS_advance_pc);
+    put_uleb(end);
+    state.r_addr += (255 - OPCODE_BASE)/LINE_RANGE + end;
+    put_byte(0);
+    put_byte(1);
+    put_byte(DW_LNE_end_sequence);
+    state.r_flags |= F_END_SEQUENCE;
+    add_row(t);
+}
+
+/*  Appends a version 4 line table of seqcount
+    sequences of about rowsper rows each. */
+static void
+put_table(unsigned t,unsigned seqcount,unsigned rowsper)
+{
+    unsigned start = linelen;
+    unsigned hdrstart = 0;
+    unsigned i = 0;
+    static const Dwarf_Small oplengths[OPCODE_BASE-1] = {
+        0,1,1,1,1,0,0,0,1,0,0,1};
+
+    put_n(0,4);        /* unit_length */
+    put_n(4,2);        /* version */
+    put_n(0,4);        /* header_length */
+    hdrstart = linelen;
+    put_byte(1);       /* minimum_instruction_length */
+    put_byte(1);       /* maximum_operations_per_instruction */
+    put_byte(1);       /* default_is_stmt */
+    put_byte((unsigned)(LINE_BASE & 0xff));
+    put_byte(LINE_RANGE);
+    put_byte(OPCODE_BASE);
+    for (i = 0; i < OPCODE_BASE-1; ++i) {
+        put_byte(oplengths[i]);
+    }
+    put_byte(0);       /* no include directories */
+    for (i = 0; i < FILECOUNT; ++i) {
+        const char *n = filenames[i];
+
+        for ( ; *n; ++n) {
+            put_byte((unsigned char)*n);
+        }
+        put_byte(0);
+        put_byte(0);   /* directory, time, length */
+        put_byte(0);
+        put_byte(0);
+    }
+    put_byte(0);
+    linebytes[start+6] = (Dwarf_Small)(linelen - hdrstart);
+    linebytes[start+7] = (Dwarf_Small)((linelen - hdrstart) >> 8);
+    for (i = 0; i < seqcount; ++i) {
+        put_sequence(t,(Dwarf_Addr)(i+1)*0x1000000 + t*0x100,
+            rowsper/2 + next_random()%rowsper);
+    }
+    linebytes[start] = (Dwarf_Small)(linelen - start - 4);
+    linebytes[start+1] = (Dwarf_Small)((linelen - start - 4) >> 8);
+    linebytes[start+2] = (Dwarf_Small)((linelen - start - 4) >> 16);
+}
+
+static void
+check_row(Dwarf_Debug dbg,unsigned t,Dwarf_Unsigned i,
+    Dwarf_Line line)
+{
+    struct row_s got;
+    const struct row_s *e = 0;
+    Dwarf_Bool flag = FALSE;
+    Dwarf_Bool prologue_end = FALSE;
+    Dwarf_Bool epilogue_begin = FALSE;
+    Dwarf_Error error = 0;
+    char *name = 0;
+    const char *expname = 0;
+    size_t namelen = 0;
+    int res = 0;
+
+    memset(&got,0,sizeof(got));
+    res = dwarf_lineaddr(line,&got.r_addr,&error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineno(line,&got.r_line,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_line_srcfileno(line,&got.r_file,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineoff_b(line,&got.r_column,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_linebeginstatement(line,&flag,&error);
+        got.r_flags |= flag? F_IS_STMT:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineblock(line,&flag,&error);
+        got.r_flags |= flag? F_BASIC_BLOCK:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_lineendsequence(line,&flag,&error);
+        got.r_flags |= flag? F_END_SEQUENCE:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_prologue_end_etc(line,&prologue_end,
+            &epilogue_begin,&got.r_isa,&got.r_discriminator,
+            &error);
+        got.r_flags |= prologue_end? F_PROLOGUE_END:0;
+        got.r_flags |= epilogue_begin? F_EPILOGUE_BEGIN:0;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_linesrc(line,&name,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL table %u row %llu res %d\n",t,
+            (unsigned long long)i,res);
+        ++errcount;
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    e = &rows[t][i];
+    if (got.r_addr != e->r_addr || got.r_line != e->r_line ||
+        got.r_file != e->r_file ||
+        got.r_column != e->r_column ||
+        got.r_isa != e->r_isa ||
+        got.r_discriminator != e->r_discriminator ||
+        got.r_flags != e->r_flags) {
+
+        printf("FAIL table %u row %llu: addr 0x%llx line %llu "
+            "file %llu column %llu isa %llu disc %llu flags %u, "
+            "expected 0x%llx %llu %llu %llu %llu %llu %u\n",
+            t,(unsigned long long)i,
+            (unsigned long long)got.r_addr,
+            (unsigned long long)got.r_line,
+            (unsigned long long)got.r_file,
+            (unsigned long long)got.r_column,
+            (unsigned long long)got.r_isa,
+            (unsigned long long)got.r_discriminator,
+            got.r_flags,
+            (unsigned long long)e->r_addr,
+            (unsigned long long)e->r_line,
+            (unsigned long long)e->r_file,
+            (unsigned long long)e->r_column,
+            (unsigned long long)e->r_isa,
+            (unsigned long long)e->r_discriminator,
+            e->r_flags);
+        ++errcount;
+    }
+    expname = filenames[rows[t][i].r_file - 1];
+    namelen = strlen(name);
+    if (namelen < 3 || strcmp(name + namelen - 3,expname)) {
+        printf("FAIL table %u row %llu file %s not %s\n",t,
+            (unsigned long long)i,name,expname);
+        ++errcount;
+    }
+    dwarf_dealloc(dbg,name,DW_DLA_STRING);
+}
+
+/*  Returns the line context of the next CU, or NULL. */
+static Dwarf_Line_Context
+next_context(Dwarf_Debug dbg)
+{
+    Dwarf_Die cu = 0;
+    Dwarf_Unsigned hdrlen = 0;
+    Dwarf_Half version = 0;
+    Dwarf_Off abbrevoff = 0;
+    Dwarf_Half addrsize = 0;
+    Dwarf_Half offsize = 0;
+    Dwarf_Half extsize = 0;
+    Dwarf_Sig8 sig;
+    Dwarf_Unsigned typeoff = 0;
+    Dwarf_Unsigned nexthdr = 0;
+    Dwarf_Half hdrtype = 0;
+    Dwarf_Unsigned lineversion = 0;
+    Dwarf_Small tablecount = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(&sig,0,sizeof(sig));
+    res = dwarf_next_cu_header_e(dbg,TRUE,&cu,
+        &hdrlen,&version,&abbrevoff,&addrsize,
+        &offsize,&extsize,&sig,&typeoff,&nexthdr,
+        &hdrtype,&error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_srclines_b(cu,&lineversion,&tablecount,
+            &context,&error);
+        dwarf_dealloc_die(cu);
+        check("table count",1,tablecount,__LINE__);
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s\n",dwarf_errmsg(error));
+        ++errcount;
+        dwarf_dealloc_error(dbg,error);
+    }
+    return res == DW_DLV_OK? context:0;
+}
+
+static void
+check_context(Dwarf_Debug dbg,unsigned t,
+    Dwarf_Line_Context context)
+{
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,&error);
+    check("srclines",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    check("row count",rowcount[t],(Dwarf_Unsigned)count,
+        __LINE__);
+    for (i = 0; i < count && (Dwarf_Unsigned)i < rowcount[t];
+        ++i) {
+        check_row(dbg,t,(Dwarf_Unsigned)i,lines[i]);
+    }
+    if (count) {
+        /*  A row is not deallocated by itself: this
+            does nothing, as the later check of the
+            second table shows. */
+        dwarf_dealloc(dbg,lines[0],DW_DLA_LINE);
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Line_Context contexts[TABLECOUNT];
+    unsigned second = 0;
+    int res = 0;
+
+    seed = 7;
+    put_table(0,60,150);
+    second = linelen;
+    put_table(1,5,20);
+    sectiondata[2].ts_size = linelen;
+    infobytes[sizeof(infobytes)-4] = (Dwarf_Small)second;
+    infobytes[sizeof(infobytes)-3] = (Dwarf_Small)(second >> 8);
+    infobytes[sizeof(infobytes)-2] = (Dwarf_Small)(second >> 16);
+    check("rows made",1,rowcount[0] > 5000,__LINE__);
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        return 1;
+    }
+    contexts[0] = next_context(dbg);
+    contexts[1] = next_context(dbg);
+    if (contexts[0] && contexts[1]) {
+        check_context(dbg,0,contexts[0]);
+        check_context(dbg,1,contexts[1]);
+        dwarf_srclines_dealloc_b(contexts[0]);
+        check_context(dbg,1,contexts[1]);
+        dwarf_srclines_dealloc_b(contexts[1]);
+    } else {
+        printf("FAIL missing line table\n");
+        ++errcount;
+        if (contexts[0]) {
+            dwarf_srclines_dealloc_b(contexts[0]);
+        }
+    }
+    dwarf_object_finish(dbg);
+    if (errcount) {
+        printf("FAIL test_line_rows %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_line_rows\n");
+    return 0;
+}
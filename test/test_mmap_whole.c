@@ -0,0 +1,393 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that the Dwarf_Alloc_Mmap_Whole load
+    preference gives the same DWARF as loading with
+    malloc and read.  For an Elf, a Mach-O and a PE
+    object every DIE (offset, tag, and each attribute's
+    number, form and value) and every line table row
+    is folded into a hash, once with each preference.
+    The hashes must match, and with the whole-object
+    mapping the sections must be counted as mmap
+    sections where this build has mmap.
+
+    ./test_mmap_whole -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+struct digest_s {
+    Dwarf_Unsigned g_hash;
+    Dwarf_Unsigned g_diecount;
+    Dwarf_Unsigned g_attrcount;
+    Dwarf_Unsigned g_linecount;
+};
+
+/*  FNV-1a, 64 bit. */
+static void
+add_bytes(struct digest_s *g,const void *p,Dwarf_Unsigned len)
+{
+    const Dwarf_Small *b = (const Dwarf_Small *)p;
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        g->g_hash ^= b[i];
+        g->g_hash *= 0x100000001b3ULL;
+    }
+}
+
+static void
+add_value(struct digest_s *g,Dwarf_Unsigned v)
+{
+    Dwarf_Small b[8];
+    unsigned i = 0;
+
+    for (i = 0; i < 8; ++i) {
+        b[i] = (Dwarf_Small)(v >> (8*i));
+    }
+    add_bytes(g,b,sizeof(b));
+}
+
+/*  The value of an attribute in whichever class
+    its form decodes as. */
+static void
+add_attr(Dwarf_Debug dbg,struct digest_s *g,Dwarf_Attribute attr)
+{
+    Dwarf_Half num = 0;
+    Dwarf_Half form = 0;
+    Dwarf_Unsigned u = 0;
+    Dwarf_Signed s = 0;
+    Dwarf_Off ref = 0;
+    Dwarf_Bool is_info = 0;
+    char *str = 0;
+    Dwarf_Block *block = 0;
+    Dwarf_Ptr exprptr = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    dwarf_whatattr(attr,&num,&error);
+    dwarf_whatform(attr,&form,&error);
+    add_value(g,num);
+    add_value(g,form);
+    ++g->g_attrcount;
+    if (dwarf_formstring(attr,&str,&error) == DW_DLV_OK) {
+        add_bytes(g,str,strlen(str));
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+    error = 0;
+    res = dwarf_global_formref_b(attr,&ref,&is_info,&error);
+    if (res == DW_DLV_OK) {
+        add_value(g,ref);
+        return;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,error);
+        error = 0;
+    }
+    if (dwarf_formudata(attr,&u,&error) == DW_DLV_OK) {
+        add_value(g,u);
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+    error = 0;
+    if (dwarf_formsdata(attr,&s,&error) == DW_DLV_OK) {
+        add_value(g,(Dwarf_Unsigned)s);
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+    error = 0;
+    if (dwarf_formaddr(attr,&u,&error) == DW_DLV_OK) {
+        add_value(g,u);
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+    error = 0;
+    if (dwarf_formexprloc(attr,&u,&exprptr,&error) ==
+        DW_DLV_OK) {
+        add_bytes(g,exprptr,u);
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+    error = 0;
+    if (dwarf_formblock(attr,&block,&error) == DW_DLV_OK) {
+        add_bytes(g,block->bl_data,block->bl_len);
+        dwarf_dealloc(dbg,block,DW_DLA_BLOCK);
+        return;
+    }
+    dwarf_dealloc_error(dbg,error);
+}
+
+static int
+add_die(Dwarf_Debug dbg,struct digest_s *g,Dwarf_Die die,
+    Dwarf_Error *error)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed attrcount = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_dieoffset(die,&off,error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_tag(die,&tag,error);
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    ++g->g_diecount;
+    add_value(g,off);
+    add_value(g,tag);
+    res = dwarf_attrlist(die,&attrs,&attrcount,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    for (i = 0; i < attrcount; ++i) {
+        add_attr(dbg,g,attrs[i]);
+        dwarf_dealloc_attribute(attrs[i]);
+    }
+    dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+    return DW_DLV_OK;
+}
+
+/*  die and its siblings and their children.
+    Deallocates die. */
+static int
+walk_die(Dwarf_Debug dbg,struct digest_s *g,Dwarf_Die die,
+    Dwarf_Error *error)
+{
+    Dwarf_Die cur = die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        res = add_die(dbg,g,cur,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_child(cur,&child,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(dbg,g,child,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+        }
+        res = dwarf_siblingof_c(cur,&sib,error);
+        dwarf_dealloc_die(cur);
+        cur = 0;
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        cur = sib;
+    }
+    if (cur) {
+        dwarf_dealloc_die(cur);
+    }
+    return (res == DW_DLV_NO_ENTRY)? DW_DLV_OK:res;
+}
+
+static int
+add_lines(struct digest_s *g,Dwarf_Die cudie,Dwarf_Error *error)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cudie,&version,&table_count,
+        &context,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,error);
+    for (i = 0; res == DW_DLV_OK && i < count; ++i) {
+        Dwarf_Addr addr = 0;
+        Dwarf_Unsigned lineno = 0;
+        Dwarf_Unsigned fileno = 0;
+
+        res = dwarf_lineaddr(lines[i],&addr,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineno(lines[i],&lineno,error);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_line_srcfileno(lines[i],&fileno,error);
+        }
+        add_value(g,addr);
+        add_value(g,lineno);
+        add_value(g,fileno);
+        ++g->g_linecount;
+    }
+    dwarf_srclines_dealloc_b(context);
+    return res;
+}
+
+static int
+digest_all(Dwarf_Debug dbg,struct digest_s *g,Dwarf_Error *error)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Unsigned abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_offset = 0;
+        Dwarf_Half cu_type = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,1,&cudie,
+            &header_length,&version_stamp,&abbrev_offset,
+            &address_size,&offset_size,&extension_size,
+            &signature,&typeoffset,&next_cu_offset,&cu_type,
+            error);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = add_lines(g,cudie,error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(cudie);
+            return res;
+        }
+        res = walk_die(dbg,g,cudie,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+static int
+run_digest(enum Dwarf_Sec_Alloc_Pref pref,struct digest_s *g,
+    Dwarf_Unsigned *mmap_count)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(g,0,sizeof(*g));
+    g->g_hash = 0xcbf29ce484222325ULL;
+    dwarf_set_load_preference(pref);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        dwarf_set_load_preference(Dwarf_Alloc_Malloc);
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return res;
+    }
+    res = digest_all(dbg,g,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s: %s\n",pathbuf,dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+        ++errcount;
+    }
+    dwarf_get_mmap_count(dbg,mmap_count,0,0,0);
+    dwarf_finish(dbg);
+    /*  Sections load when first used, so the
+        preference is only restored here. */
+    dwarf_set_load_preference(Dwarf_Alloc_Malloc);
+    return res;
+}
+
+static void
+check_path(int argc,char **argv,const char *name)
+{
+    struct digest_s plain;
+    struct digest_s whole;
+    Dwarf_Unsigned mmap_count = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    if (run_digest(Dwarf_Alloc_Malloc,&plain,&mmap_count) !=
+        DW_DLV_OK) {
+        return;
+    }
+    check("malloc mmap count",0,mmap_count,__LINE__);
+    if (run_digest(Dwarf_Alloc_Mmap_Whole,&whole,&mmap_count) !=
+        DW_DLV_OK) {
+        return;
+    }
+#ifdef HAVE_FULL_MMAP
+    check("sections mapped",1,mmap_count > 0,__LINE__);
+#endif /* HAVE_FULL_MMAP */
+    check("DIEs seen",1,plain.g_diecount > 10,__LINE__);
+    check("DIE count",plain.g_diecount,whole.g_diecount,
+        __LINE__);
+    check("attribute count",plain.g_attrcount,
+        whole.g_attrcount,__LINE__);
+    check("line count",plain.g_linecount,whole.g_linecount,
+        __LINE__);
+    check("hash",plain.g_hash,whole.g_hash,__LINE__);
+    if (plain.g_hash != whole.g_hash) {
+        printf("FAIL in %s\n",name);
+    }
+}
+
+int
+main(int argc,char **argv)
+{
+    check_path(argc,argv,"/test/dummyexecutable.debug");
+    check_path(argc,argv,"/test/testuriLE64ELf.testme");
+    check_path(argc,argv,"/test/test-mach-o-32.dSYM");
+    check_path(argc,argv,"/test/testobjLE32PE.exe");
+    if (errcount) {
+        printf("FAIL test_mmap_whole %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_mmap_whole\n");
+    return 0;
+}
@@ -0,0 +1,298 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_preload_sections().
+    test/dummyexecutable.debug is read without preloading
+    to get the expected DIEs and line rows.  Then it and
+    test/dummyexecutablez.debug (the same DWARF with
+    zlib-compressed sections) are read after preloading
+    with several thread counts, and must match.
+    Without zlib and zstd the compressed object is
+    expected to fail with DW_DLE_ZDEBUG_REQUIRES_ZLIB.
+
+    ./test_preload -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memcpy() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+#define PLAINNAME "/test/dummyexecutable.debug"
+#define ZNAME     "/test/dummyexecutablez.debug"
+
+static char plainpath[2000];
+static char zpath[2000];
+
+struct walk_s {
+    Dwarf_Unsigned w_diecount;
+    Dwarf_Unsigned w_offsetsum;
+    Dwarf_Unsigned w_linecount;
+    Dwarf_Unsigned w_linesum;
+};
+
+/*  plainpath and zpath from build_path(). */
+static int
+build_paths(int argc,char **argv)
+{
+    if (build_path(argc,argv,ZNAME)) {
+        return 1;
+    }
+    memcpy(zpath,pathbuf,sizeof(zpath));
+    if (build_path(argc,argv,PLAINNAME)) {
+        return 1;
+    }
+    memcpy(plainpath,pathbuf,sizeof(plainpath));
+    return 0;
+}
+
+static int
+walk_die(Dwarf_Die die,struct walk_s *w,Dwarf_Error *error)
+{
+    Dwarf_Die cur = die;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Off off = 0;
+
+        res = dwarf_dieoffset(cur,&off,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        ++w->w_diecount;
+        w->w_offsetsum += off;
+        res = dwarf_child(cur,&child,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_die(child,w,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+        }
+        res = dwarf_siblingof_c(cur,&sib,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+            cur = die;
+            break;
+        }
+        cur = sib;
+    }
+    if (cur != die) {
+        dwarf_dealloc_die(cur);
+    }
+    dwarf_dealloc_die(die);
+    return res;
+}
+
+static int
+count_lines(Dwarf_Die cudie,struct walk_s *w,Dwarf_Error *error)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cudie,&version,&table_count,
+        &context,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_srclines_from_linecontext(context,&lines,
+        &count,error);
+    for (i = 0; res == DW_DLV_OK && i < count; ++i) {
+        Dwarf_Unsigned lineno = 0;
+
+        res = dwarf_lineno(lines[i],&lineno,error);
+        w->w_linesum += lineno;
+        ++w->w_linecount;
+    }
+    dwarf_srclines_dealloc_b(context);
+    return res;
+}
+
+static int
+walk_all(Dwarf_Debug dbg,struct walk_s *w,Dwarf_Error *error)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Unsigned abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_offset = 0;
+        Dwarf_Half cu_type = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,1,&cudie,
+            &header_length,&version_stamp,&abbrev_offset,
+            &address_size,&offset_size,&extension_size,
+            &signature,&typeoffset,&next_cu_offset,&cu_type,
+            error);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = count_lines(cudie,w,error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(cudie);
+            return res;
+        }
+        res = walk_die(cudie,w,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+/*  Returns DW_DLV_NO_ENTRY when the object cannot be
+    decompressed by this build. */
+static int
+run_walk(const char *path,int preload,unsigned int threads,
+    struct walk_s *w)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(w,0,sizeof(*w));
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",path,res);
+        ++errcount;
+        return res;
+    }
+    if (preload) {
+        res = dwarf_preload_sections(dbg,DW_PRELOAD_ALL,
+            threads,&error);
+        if (res == DW_DLV_OK) {
+            /*  Everything is loaded, so this is a no-op. */
+            res = dwarf_preload_sections(dbg,DW_PRELOAD_ALL,
+                threads,&error);
+        }
+    }
+    if (res == DW_DLV_OK) {
+        res = walk_all(dbg,w,&error);
+    }
+    if (res == DW_DLV_ERROR) {
+        if (dwarf_errno(error) == DW_DLE_ZDEBUG_REQUIRES_ZLIB) {
+            res = DW_DLV_NO_ENTRY;
+        } else {
+            printf("FAIL %s threads %u: %s\n",path,threads,
+                dwarf_errmsg(error));
+            ++errcount;
+        }
+        dwarf_dealloc_error(dbg,error);
+    }
+    dwarf_finish(dbg);
+    return res;
+}
+
+static void
+compare_walk(const char *msg,unsigned int threads,
+    struct walk_s *expect,struct walk_s *got)
+{
+    if (expect->w_diecount == got->w_diecount &&
+        expect->w_offsetsum == got->w_offsetsum &&
+        expect->w_linecount == got->w_linecount &&
+        expect->w_linesum == got->w_linesum) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s threads %u: dies %llu/%llu lines %llu/%llu\n",
+        msg,threads,
+        (unsigned long long)expect->w_diecount,
+        (unsigned long long)got->w_diecount,
+        (unsigned long long)expect->w_linecount,
+        (unsigned long long)got->w_linecount);
+}
+
+int
+main(int argc,char **argv)
+{
+    static const unsigned int threads[] = {0,1,2,4,100};
+    struct walk_s expect;
+    struct walk_s got;
+    unsigned int i = 0;
+    int zres = DW_DLV_OK;
+    int res = 0;
+
+    if (build_paths(argc,argv)) {
+        return 1;
+    }
+    run_walk(plainpath,0,0,&expect);
+    check("DIEs seen",1,expect.w_diecount > 50,__LINE__);
+    check("line rows seen",1,expect.w_linecount > 10,__LINE__);
+    for (i = 0; i < sizeof(threads)/sizeof(threads[0]); ++i) {
+        res = run_walk(plainpath,1,threads[i],&got);
+        if (res == DW_DLV_OK) {
+            compare_walk("plain",threads[i],&expect,&got);
+        }
+        res = run_walk(zpath,1,threads[i],&got);
+        if (res == DW_DLV_OK) {
+            compare_walk("compressed",threads[i],&expect,&got);
+        } else if (res == DW_DLV_NO_ENTRY) {
+            zres = res;
+        }
+    }
+    if (zres == DW_DLV_NO_ENTRY) {
+        printf("Compressed sections not checked: "
+            "no zlib and zstd\n");
+    }
+    if (errcount) {
+        printf("FAIL test_preload %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_preload\n");
+    return 0;
+}
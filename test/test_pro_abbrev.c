@@ -0,0 +1,523 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that the producer shares abbreviations
+    exactly when DIEs need the same one.
+    DIECOUNT DIEs are made with a mix of tags,
+    attribute sets, implicit_const values and children,
+    so many DIEs share each of about two hundred
+    abbreviations.  The produced sections are read back
+    with libdwarf (from memory, as in jitreader.c) and
+    every DIE must be as made.  DIEs with the same tag,
+    children flag, attributes, forms and implicit_const
+    values must have the same abbrev code and others
+    different codes, codes must be numbered in order
+    of first use, and .debug_abbrev must hold each
+    abbreviation once. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* free() realloc() */
+#include <string.h> /* memcpy() memset() strlen() strncmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE */
+#include "testutil.h"
+#include "libdwarfp.h"
+
+#define DIECOUNT 5000
+/*  Every CHILDEVERY DIE gets a child. */
+#define CHILDEVERY 37
+#define MAXSECTS 40
+#define MAXDIES (DIECOUNT + DIECOUNT/CHILDEVERY + 2)
+
+/*  Bits of d_attrs. */
+#define HAS_NAME     1
+#define HAS_SIZE     2
+#define HAS_LINE     4
+#define HAS_IMPLICIT 8
+
+static Dwarf_Half tags[] = {DW_TAG_variable,DW_TAG_member,
+    DW_TAG_base_type,DW_TAG_typedef};
+#define TAGCOUNT (sizeof(tags)/sizeof(tags[0]))
+
+/*  A DIE as made, in pre-order. */
+struct die_s {
+    Dwarf_Half     d_tag;
+    int            d_children;
+    unsigned       d_attrs;
+    Dwarf_Signed   d_implicit;
+    Dwarf_Unsigned d_line;
+};
+static struct die_s dies[MAXDIES];
+static unsigned diecount;
+/*  The DIE first seen with each abbrev code. */
+static unsigned firstdie[MAXDIES+1];
+
+struct sect_s {
+    char            s_name[64];
+    unsigned char  *s_bytes;
+    Dwarf_Unsigned  s_len;
+};
+static struct sect_s sects[MAXSECTS];
+static int nsect;
+
+static struct testobj_section_s sectiondata[MAXSECTS];
+static struct testobj_s testobj;
+
+/*  Section index 0 is not used, as in Elf. */
+static int
+new_section(const char *name,int size,Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,Dwarf_Unsigned link,
+    Dwarf_Unsigned info,Dwarf_Unsigned *sect_name_index,
+    void *user_data,int *error)
+{
+    struct sect_s *s = 0;
+    size_t namelen = strlen(name);
+
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    (void)user_data;
+    if (!strncmp(name,".rel",4)) {
+        /* No relocation sections, as in dwarfgen. */
+        return 0;
+    }
+    if (nsect + 1 >= MAXSECTS ||
+        namelen >= sizeof(s->s_name)) {
+        *error = 1;
+        return -1;
+    }
+    nsect++;
+    s = &sects[nsect];
+    memcpy(s->s_name,name,namelen+1);
+    *sect_name_index = (Dwarf_Unsigned)nsect;
+    return nsect;
+}
+
+static int
+append_bytes(Dwarf_Unsigned elfidx,const void *bytes,
+    Dwarf_Unsigned len)
+{
+    struct sect_s *s = 0;
+    unsigned char *newbytes = 0;
+
+    if (!elfidx || elfidx > (Dwarf_Unsigned)nsect) {
+        printf("FAIL bytes for unknown section %lu\n",
+            (unsigned long)elfidx);
+        ++errcount;
+        return DW_DLV_ERROR;
+    }
+    s = &sects[elfidx];
+    newbytes = (unsigned char *)realloc(s->s_bytes,
+        (size_t)(s->s_len + len));
+    if (!newbytes) {
+        printf("FAIL out of memory\n");
+        ++errcount;
+        return DW_DLV_ERROR;
+    }
+    memcpy(newbytes + s->s_len,bytes,(size_t)len);
+    s->s_bytes = newbytes;
+    s->s_len += len;
+    return DW_DLV_OK;
+}
+
+/*  Adds the attributes of d to pdie. */
+static int
+add_attrs(Dwarf_P_Debug dbg,Dwarf_P_Die pdie,struct die_s *d,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Attribute attr = 0;
+    int res = DW_DLV_OK;
+
+    if (d->d_attrs & HAS_NAME) {
+        res = dwarf_add_AT_name_a(pdie,"n",&attr,error);
+    }
+    if (res == DW_DLV_OK && (d->d_attrs & HAS_SIZE)) {
+        res = dwarf_add_AT_unsigned_const_a(dbg,pdie,
+            DW_AT_byte_size,4,&attr,error);
+    }
+    if (res == DW_DLV_OK && (d->d_attrs & HAS_LINE)) {
+        res = dwarf_add_AT_unsigned_const_a(dbg,pdie,
+            DW_AT_decl_line,d->d_line,&attr,error);
+    }
+    if (res == DW_DLV_OK && (d->d_attrs & HAS_IMPLICIT)) {
+        res = dwarf_add_AT_implicit_const(pdie,
+            DW_AT_decl_column,d->d_implicit,&attr,error);
+    }
+    return res;
+}
+
+/*  DIE i's shape comes from i, varied in a
+    different period for each part. */
+static struct die_s *
+new_die_desc(unsigned i,int children)
+{
+    struct die_s *d = &dies[diecount++];
+
+    d->d_tag = tags[i%TAGCOUNT];
+    d->d_children = children;
+    d->d_attrs = (i/7)%16;
+    d->d_implicit = (Dwarf_Signed)((i/3)%4) - 1;
+    /*  Values under 256 so always DW_FORM_data1. */
+    d->d_line = i%250 + 1;
+    return d;
+}
+
+static int
+add_dies(Dwarf_P_Debug dbg,Dwarf_Error *error)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Attribute attr = 0;
+    struct die_s *d = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    d = &dies[diecount++];
+    d->d_tag = DW_TAG_compile_unit;
+    d->d_children = 1;
+    d->d_attrs = HAS_NAME;
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,
+        0,0,0,0,&cu,error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"abbrev.c",&attr,error);
+    }
+    for (i = 0; res == DW_DLV_OK && i < DIECOUNT; ++i) {
+        int children = (i%CHILDEVERY) == 0;
+        Dwarf_P_Die pdie = 0;
+
+        d = new_die_desc(i,children);
+        res = dwarf_new_die_a(dbg,d->d_tag,cu,0,0,0,&pdie,
+            error);
+        if (res == DW_DLV_OK) {
+            res = add_attrs(dbg,pdie,d,error);
+        }
+        if (res == DW_DLV_OK && children) {
+            Dwarf_P_Die child = 0;
+
+            d = new_die_desc(i+5,0);
+            res = dwarf_new_die_a(dbg,d->d_tag,pdie,0,0,0,
+                &child,error);
+            if (res == DW_DLV_OK) {
+                res = add_attrs(dbg,child,d,error);
+            }
+        }
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return dwarf_add_die_to_debug_a(dbg,cu,error);
+}
+
+static int
+produce(void)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN |
+        DW_DLC_POINTER64 | DW_DLC_OFFSET32 |
+        DW_DLC_SYMBOLIC_RELOCATIONS,
+        new_section,0,0,0,"x86_64","V5",0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        return res;
+    }
+    res = add_dies(dbg,&error);
+    check("add DIEs",DW_DLV_OK,res,__LINE__);
+    if (res == DW_DLV_OK) {
+        res = dwarf_transform_to_disk_form_a(dbg,&nbufs,&error);
+        check("transform",DW_DLV_OK,res,__LINE__);
+    }
+    for (i = 0; res == DW_DLV_OK && i < nbufs; ++i) {
+        Dwarf_Unsigned elfidx = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+
+        res = dwarf_get_section_bytes_a(dbg,i,
+            &elfidx,&len,&bytes,&error);
+        check("section bytes",DW_DLV_OK,res,__LINE__);
+        if (res == DW_DLV_OK) {
+            res = append_bytes(elfidx,bytes,len);
+        }
+    }
+    dwarf_producer_finish_a(dbg,&error);
+    return res;
+}
+
+/*  The DIE as read, described as it was made. */
+static void
+describe_die(Dwarf_Debug dbg,Dwarf_Die die,struct die_s *d)
+{
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed attrcount = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Half children = 0;
+    Dwarf_Error error = 0;
+
+    memset(d,0,sizeof(*d));
+    dwarf_tag(die,&d->d_tag,&error);
+    dwarf_die_abbrev_children_flag(die,&children);
+    d->d_children = children;
+    if (dwarf_attrlist(die,&attrs,&attrcount,&error) !=
+        DW_DLV_OK) {
+        return;
+    }
+    for (i = 0; i < attrcount; ++i) {
+        Dwarf_Half num = 0;
+        Dwarf_Half form = 0;
+
+        dwarf_whatattr(attrs[i],&num,&error);
+        dwarf_whatform(attrs[i],&form,&error);
+        switch (num) {
+        case DW_AT_name:
+            d->d_attrs |= HAS_NAME;
+            break;
+        case DW_AT_byte_size:
+            d->d_attrs |= HAS_SIZE;
+            break;
+        case DW_AT_decl_line:
+            d->d_attrs |= HAS_LINE;
+            dwarf_formudata(attrs[i],&d->d_line,&error);
+            break;
+        case DW_AT_decl_column:
+            check("implicit form",DW_FORM_implicit_const,form,
+                __LINE__);
+            d->d_attrs |= HAS_IMPLICIT;
+            dwarf_formsdata(attrs[i],&d->d_implicit,&error);
+            break;
+        default:
+            break;
+        }
+        dwarf_dealloc_attribute(attrs[i]);
+    }
+    dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+}
+
+/*  Whether two DIEs need the same abbreviation. */
+static int
+same_shape(struct die_s *a,struct die_s *b)
+{
+    return a->d_tag == b->d_tag &&
+        a->d_children == b->d_children &&
+        a->d_attrs == b->d_attrs &&
+        (!(a->d_attrs & HAS_IMPLICIT) ||
+        a->d_implicit == b->d_implicit);
+}
+
+static void
+check_die(Dwarf_Debug dbg,Dwarf_Die die,unsigned *ip,
+    Dwarf_Unsigned *maxcode)
+{
+    struct die_s got;
+    struct die_s *want = 0;
+    Dwarf_Unsigned code = dwarf_die_abbrev_code(die);
+    unsigned i = *ip;
+
+    ++*ip;
+    if (i >= diecount) {
+        return;
+    }
+    want = &dies[i];
+    describe_die(dbg,die,&got);
+    check("tag",want->d_tag,got.d_tag,__LINE__);
+    check("children",want->d_children,got.d_children,__LINE__);
+    check("attributes",want->d_attrs,got.d_attrs,__LINE__);
+    if (want->d_attrs & HAS_LINE) {
+        check("decl_line",want->d_line,got.d_line,__LINE__);
+    }
+    if (want->d_attrs & HAS_IMPLICIT) {
+        check("implicit_const",(Dwarf_Unsigned)want->d_implicit,
+            (Dwarf_Unsigned)got.d_implicit,__LINE__);
+    }
+    if (!code || code > *maxcode + 1 || code > MAXDIES) {
+        check("abbrev code in first use order",*maxcode+1,code,
+            __LINE__);
+        return;
+    }
+    if (code == *maxcode + 1) {
+        unsigned j = 0;
+
+        /*  A new code: no earlier DIE may have
+            needed this abbreviation. */
+        for (j = 1; j <= *maxcode; ++j) {
+            if (same_shape(want,&dies[firstdie[j]])) {
+                printf("FAIL DIE %u has new code %lu, "
+                    "as DIE %u has code %u\n",i,
+                    (unsigned long)code,firstdie[j],j);
+                ++errcount;
+                break;
+            }
+        }
+        firstdie[code] = i;
+        *maxcode = code;
+    } else if (!same_shape(want,&dies[firstdie[code]])) {
+        printf("FAIL DIE %u shares code %lu with DIE %u\n",
+            i,(unsigned long)code,firstdie[code]);
+        ++errcount;
+    }
+}
+
+/*  Pre-order walk of die, its siblings and their
+    children.  Deallocates die. */
+static void
+walk_die(Dwarf_Debug dbg,Dwarf_Die die,unsigned *ip,
+    Dwarf_Unsigned *maxcode)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    while (die) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        check_die(dbg,die,ip,maxcode);
+        res = dwarf_child(die,&child,&error);
+        if (res == DW_DLV_OK) {
+            walk_die(dbg,child,ip,maxcode);
+        }
+        res = dwarf_siblingof_c(die,&sib,&error);
+        dwarf_dealloc_die(die);
+        die = (res == DW_DLV_OK)? sib:0;
+    }
+}
+
+/*  Entries of .debug_abbrev up to the null entry
+    ending the table. */
+static Dwarf_Unsigned
+count_abbrevs(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned count = 0;
+
+    for (;;) {
+        Dwarf_Abbrev abbrev = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Unsigned attrcount = 0;
+        Dwarf_Error error = 0;
+        int res = 0;
+
+        res = dwarf_get_abbrev(dbg,off,&abbrev,&length,
+            &attrcount,&error);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_error(dbg,error);
+            }
+            break;
+        }
+        dwarf_dealloc(dbg,abbrev,DW_DLA_ABBREV);
+        off += length;
+        if (length == 1) {
+            break;
+        }
+        ++count;
+    }
+    return count;
+}
+
+static void
+read_back(void)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Unsigned cu_header_length = 0;
+    Dwarf_Half version_stamp = 0;
+    Dwarf_Off abbrev_offset = 0;
+    Dwarf_Half address_size = 0;
+    Dwarf_Half length_size = 0;
+    Dwarf_Half extension_size = 0;
+    Dwarf_Sig8 signature;
+    Dwarf_Unsigned typeoffset = 0;
+    Dwarf_Unsigned next_cu_header = 0;
+    Dwarf_Half header_cu_type = 0;
+    Dwarf_Unsigned maxcode = 0;
+    unsigned walked = 0;
+    int i = 0;
+    int res = 0;
+
+    for (i = 1; i <= nsect; ++i) {
+        sectiondata[i-1].ts_name = sects[i].s_name;
+        sectiondata[i-1].ts_size = sects[i].s_len;
+        sectiondata[i-1].ts_content = sects[i].s_bytes;
+    }
+    res = testobj_init(&testobj,sectiondata,(unsigned)nsect,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    memset(&signature,0,sizeof(signature));
+    res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+        &cu_header_length,&version_stamp,&abbrev_offset,
+        &address_size,&length_size,&extension_size,
+        &signature,&typeoffset,&next_cu_header,
+        &header_cu_type,&error);
+    check("next cu res",DW_DLV_OK,res,__LINE__);
+    if (res == DW_DLV_OK) {
+        walk_die(dbg,cu_die,&walked,&maxcode);
+    } else if (res == DW_DLV_ERROR) {
+        printf("FAIL %s\n",dwarf_errmsg(error));
+        dwarf_dealloc_error(dbg,error);
+    }
+    check("DIEs read",diecount,walked,__LINE__);
+    check("many DIEs per abbrev",1,maxcode*10 < diecount,
+        __LINE__);
+    check(".debug_abbrev entries",maxcode,count_abbrevs(dbg),
+        __LINE__);
+    dwarf_object_finish(dbg);
+}
+
+int
+main(void)
+{
+    int i = 0;
+
+    if (produce() == DW_DLV_OK) {
+        read_back();
+    } else {
+        ++errcount;
+    }
+    for (i = 1; i <= nsect; ++i) {
+        free(sects[i].s_bytes);
+    }
+    if (errcount) {
+        printf("FAIL test_pro_abbrev %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_pro_abbrev\n");
+    return 0;
+}
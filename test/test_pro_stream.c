@@ -0,0 +1,334 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_pro_set_section_write_callback().
+    The same DWARF is produced twice, once kept in
+    memory and fetched with dwarf_get_section_bytes_a()
+    and once streamed out through the write callback.
+    The .debug_info is made big enough to be streamed
+    in several pieces, and every section must come out
+    byte for byte the same both ways.
+    A write callback that fails must stop the transform
+    with DW_DLE_SECTION_WRITE_ERR. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* free() realloc() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+#include "libdwarfp.h"
+
+/*  Enough DIEs to make a .debug_info of about two
+    megabytes, more than one streamed piece. */
+#define VARCOUNT 40000
+#define MAXSECTS 40
+
+struct sect_s {
+    char            s_name[64];
+    unsigned char  *s_bytes;
+    Dwarf_Unsigned  s_len;
+    Dwarf_Unsigned  s_cap;
+    unsigned        s_writes;
+};
+
+struct output_s {
+    struct sect_s   o_sect[MAXSECTS];
+    int             o_nsect;
+    int             o_fail_write;
+};
+
+static int
+append_bytes(struct output_s *out,Dwarf_Unsigned elfidx,
+    const void *bytes,Dwarf_Unsigned len)
+{
+    struct sect_s *s = 0;
+
+    if (!elfidx || elfidx > (Dwarf_Unsigned)out->o_nsect) {
+        printf("FAIL bytes for unknown section %llu\n",
+            (unsigned long long)elfidx);
+        ++errcount;
+        return DW_DLV_ERROR;
+    }
+    s = &out->o_sect[elfidx];
+    if (s->s_len + len > s->s_cap) {
+        Dwarf_Unsigned newcap = (s->s_len + len)*2;
+        unsigned char *newbytes = 0;
+
+        newbytes = (unsigned char *)realloc(s->s_bytes,
+            (size_t)newcap);
+        if (!newbytes) {
+            printf("FAIL out of memory\n");
+            ++errcount;
+            return DW_DLV_ERROR;
+        }
+        s->s_bytes = newbytes;
+        s->s_cap = newcap;
+    }
+    memcpy(s->s_bytes + s->s_len,bytes,(size_t)len);
+    s->s_len += len;
+    s->s_writes++;
+    return DW_DLV_OK;
+}
+
+/*  Section index 0 is not used, as in Elf. */
+static int
+new_section(const char *name,int size,Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,Dwarf_Unsigned link,
+    Dwarf_Unsigned info,Dwarf_Unsigned *sect_name_index,
+    void *user_data,int *error)
+{
+    struct output_s *out = (struct output_s *)user_data;
+    struct sect_s *s = 0;
+    size_t namelen = strlen(name);
+
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    if (!strncmp(name,".rel",4)) {
+        /* No relocation sections, as in dwarfgen. */
+        return 0;
+    }
+    if (out->o_nsect + 1 >= MAXSECTS ||
+        namelen >= sizeof(s->s_name)) {
+        *error = 1;
+        return -1;
+    }
+    out->o_nsect++;
+    s = &out->o_sect[out->o_nsect];
+    memcpy(s->s_name,name,namelen+1);
+    *sect_name_index = (Dwarf_Unsigned)out->o_nsect;
+    return out->o_nsect;
+}
+
+static int
+write_section(Dwarf_Unsigned elfidx,Dwarf_Ptr bytes,
+    Dwarf_Unsigned len,void *user_data)
+{
+    struct output_s *out = (struct output_s *)user_data;
+
+    if (out->o_fail_write) {
+        return DW_DLV_ERROR;
+    }
+    return append_bytes(out,elfidx,bytes,len);
+}
+
+static void
+free_output(struct output_s *out)
+{
+    int i = 0;
+
+    for (i = 1; i <= out->o_nsect; ++i) {
+        free(out->o_sect[i].s_bytes);
+        out->o_sect[i].s_bytes = 0;
+    }
+}
+
+static int
+add_dies(Dwarf_P_Debug dbg,Dwarf_Error *error)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Attribute attr = 0;
+    char name[64];
+    unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,
+        0,0,0,0,&cu,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_add_AT_name_a(cu,"stream.c",&attr,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < VARCOUNT; ++i) {
+        Dwarf_P_Die var = 0;
+
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,
+            cu,0,0,0,&var,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        snprintf(name,sizeof(name),
+            "variable_%06u_with_a_name_long_enough",i);
+        res = dwarf_add_AT_name_a(var,name,&attr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_add_AT_unsigned_const_a(dbg,var,
+            DW_AT_byte_size,(Dwarf_Unsigned)(i%17 +1),
+            &attr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return dwarf_add_die_to_debug_a(dbg,cu,error);
+}
+
+/*  Returns the DW_DLV code of the transform, and the
+    error number through errnum if it failed. */
+static int
+produce(struct output_s *out,int stream,int *errnum)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+    int tres = 0;
+
+    *errnum = 0;
+    res = dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN |
+        DW_DLC_POINTER64 | DW_DLC_OFFSET32 |
+        DW_DLC_SYMBOLIC_RELOCATIONS,
+        new_section,0,0,out,"x86_64","V4",0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        ++errcount;
+        return res;
+    }
+    if (stream) {
+        res = dwarf_pro_set_section_write_callback(dbg,
+            write_section,out,&error);
+        check("set write callback",DW_DLV_OK,res,__LINE__);
+    }
+    res = add_dies(dbg,&error);
+    check("add DIEs",DW_DLV_OK,res,__LINE__);
+    tres = dwarf_transform_to_disk_form_a(dbg,&nbufs,&error);
+    if (tres == DW_DLV_ERROR) {
+        *errnum = (int)dwarf_errno(error);
+    } else if (stream) {
+        Dwarf_Unsigned elfidx = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+
+        check("streamed buffer count",0,nbufs,__LINE__);
+        res = dwarf_get_section_bytes_a(dbg,0,
+            &elfidx,&len,&bytes,&error);
+        check("streamed section bytes",DW_DLV_NO_ENTRY,
+            res,__LINE__);
+    } else {
+        for (i = 0; i < nbufs; ++i) {
+            Dwarf_Unsigned elfidx = 0;
+            Dwarf_Unsigned len = 0;
+            Dwarf_Ptr bytes = 0;
+
+            res = dwarf_get_section_bytes_a(dbg,i,
+                &elfidx,&len,&bytes,&error);
+            check("section bytes",DW_DLV_OK,res,__LINE__);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            append_bytes(out,elfidx,bytes,len);
+        }
+    }
+    res = dwarf_producer_finish_a(dbg,&error);
+    check("producer finish",DW_DLV_OK,res,__LINE__);
+    return tres;
+}
+
+static struct sect_s *
+find_section(struct output_s *out,const char *name)
+{
+    int i = 0;
+
+    for (i = 1; i <= out->o_nsect; ++i) {
+        if (!strcmp(out->o_sect[i].s_name,name)) {
+            return &out->o_sect[i];
+        }
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    static struct output_s buffered;
+    static struct output_s streamed;
+    static struct output_s failed;
+    struct sect_s *info = 0;
+    int errnum = 0;
+    int res = 0;
+    int i = 0;
+
+    res = produce(&buffered,0,&errnum);
+    check("buffered transform",DW_DLV_OK,res,__LINE__);
+    res = produce(&streamed,1,&errnum);
+    check("streamed transform",DW_DLV_OK,res,__LINE__);
+
+    check("section count",buffered.o_nsect,
+        streamed.o_nsect,__LINE__);
+    for (i = 1; i <= buffered.o_nsect &&
+        i <= streamed.o_nsect; ++i) {
+        struct sect_s *b = &buffered.o_sect[i];
+        struct sect_s *s = &streamed.o_sect[i];
+
+        if (strcmp(b->s_name,s->s_name)) {
+            printf("FAIL section %d is %s buffered "
+                "but %s streamed\n",i,b->s_name,s->s_name);
+            ++errcount;
+            continue;
+        }
+        check(b->s_name,b->s_len,s->s_len,__LINE__);
+        if (b->s_len == s->s_len && b->s_len &&
+            memcmp(b->s_bytes,s->s_bytes,(size_t)b->s_len)) {
+            printf("FAIL %s bytes differ\n",b->s_name);
+            ++errcount;
+        }
+    }
+    info = find_section(&streamed,".debug_info");
+    check("streamed .debug_info",1,info != 0,__LINE__);
+    if (info) {
+        check(".debug_info over 1MB",1,
+            info->s_len > 1024*1024,__LINE__);
+        check(".debug_info in pieces",1,
+            info->s_writes > 1,__LINE__);
+    }
+
+    failed.o_fail_write = 1;
+    res = produce(&failed,1,&errnum);
+    check("failed write transform",DW_DLV_ERROR,res,__LINE__);
+    check("failed write errno",DW_DLE_SECTION_WRITE_ERR,
+        errnum,__LINE__);
+
+    free_output(&buffered);
+    free_output(&streamed);
+    free_output(&failed);
+    if (errcount) {
+        printf("FAIL test_pro_stream %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_pro_stream\n");
+    return 0;
+}
@@ -0,0 +1,396 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks that reading objects leaves the shared file
+    offset alone, so two Dwarf_Debug can work from one fd.
+    Two Dwarf_Debug are opened with dwarf_init_b() on the
+    same fd and walk the CUs and DIEs of an Elf and of a
+    PE object in turn, one DIE each, after the file offset
+    was moved to a known place.  Both walks must see what a
+    walk alone sees, and where pread() is used the file
+    offset must be where it was put.
+    The PE section names and sizes libdwarf reports
+    (the section headers are read as a group) must be
+    those in the section headers of the file.
+
+    ./test_shared_fd -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fclose() fopen() fread() printf() */
+#include <string.h> /* memset() strcmp() */
+
+#ifdef _WIN32
+#ifdef HAVE_STDAFX_H
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+#include <io.h> /* close() lseek() open() */
+#endif /* _WIN32 */
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* close() lseek() */
+#endif /* HAVE_UNISTD_H */
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h> /* open() O_RDONLY */
+#endif /* HAVE_FCNTL_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE */
+#include "testutil.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif /* O_BINARY */
+
+/*  Where the file offset is put before reading. */
+#define FD_MARK 17
+
+struct walker_s {
+    Dwarf_Debug    w_dbg;
+    Dwarf_Die      w_die;
+    Dwarf_Bool     w_done;
+    Dwarf_Unsigned w_diecount;
+    Dwarf_Unsigned w_offsetsum;
+};
+
+/*  Next CU DIE into w_die, or w_done. */
+static int
+next_cu(struct walker_s *w,Dwarf_Error *error)
+{
+    Dwarf_Unsigned header_length = 0;
+    Dwarf_Half version_stamp = 0;
+    Dwarf_Unsigned abbrev_offset = 0;
+    Dwarf_Half address_size = 0;
+    Dwarf_Half offset_size = 0;
+    Dwarf_Half extension_size = 0;
+    Dwarf_Sig8 signature;
+    Dwarf_Unsigned typeoffset = 0;
+    Dwarf_Unsigned next_cu_offset = 0;
+    Dwarf_Half cu_type = 0;
+    int res = 0;
+
+    memset(&signature,0,sizeof(signature));
+    res = dwarf_next_cu_header_e(w->w_dbg,1,&w->w_die,
+        &header_length,&version_stamp,&abbrev_offset,
+        &address_size,&offset_size,&extension_size,
+        &signature,&typeoffset,&next_cu_offset,&cu_type,
+        error);
+    if (res == DW_DLV_NO_ENTRY) {
+        w->w_done = TRUE;
+        return DW_DLV_OK;
+    }
+    return res;
+}
+
+/*  The parents of w_die, to go back to when a
+    subtree is done. */
+#define MAXDEPTH 100
+struct stack_s {
+    Dwarf_Die s_die[MAXDEPTH];
+    int       s_depth;
+};
+
+/*  Counts w_die and moves w_die on in pre-order:
+    child, else sibling, else the sibling of the
+    nearest parent with one, else the next CU. */
+static int
+step(struct walker_s *w,struct stack_s *st,Dwarf_Error *error)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Die child = 0;
+    Dwarf_Die sib = 0;
+    int res = 0;
+
+    res = dwarf_dieoffset(w->w_die,&off,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    ++w->w_diecount;
+    w->w_offsetsum += off;
+    res = dwarf_child(w->w_die,&child,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        if (st->s_depth >= MAXDEPTH) {
+            printf("FAIL DIE tree deeper than %d\n",MAXDEPTH);
+            return DW_DLV_ERROR;
+        }
+        st->s_die[st->s_depth++] = w->w_die;
+        w->w_die = child;
+        return DW_DLV_OK;
+    }
+    for (;;) {
+        res = dwarf_siblingof_c(w->w_die,&sib,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        dwarf_dealloc_die(w->w_die);
+        w->w_die = 0;
+        if (res == DW_DLV_OK) {
+            w->w_die = sib;
+            return DW_DLV_OK;
+        }
+        if (!st->s_depth) {
+            break;
+        }
+        w->w_die = st->s_die[--st->s_depth];
+    }
+    return next_cu(w,error);
+}
+
+static int
+open_walker(int fd,struct walker_s *w,Dwarf_Error *error)
+{
+    int res = 0;
+
+    memset(w,0,sizeof(*w));
+    res = dwarf_init_b(fd,DW_GROUPNUMBER_ANY,0,0,&w->w_dbg,
+        error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_init_b %s res %d\n",pathbuf,res);
+        ++errcount;
+    }
+    return res;
+}
+
+static void
+report(struct walker_s *w,Dwarf_Error error,int line)
+{
+    printf("FAIL walk of %s line %d: %s\n",pathbuf,line,
+        dwarf_errmsg(error));
+    dwarf_dealloc_error(w->w_dbg,error);
+    ++errcount;
+}
+
+/*  One walker alone, then two in turn on one fd. */
+static void
+check_shared(int argc,char **argv,const char *name)
+{
+    struct walker_s alone;
+    struct walker_s w[2];
+    struct stack_s st[2];
+    Dwarf_Error error = 0;
+    int fd = -1;
+    int i = 0;
+    int res = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    fd = open(pathbuf,O_RDONLY|O_BINARY);
+    if (fd < 0) {
+        printf("FAIL cannot open %s\n",pathbuf);
+        ++errcount;
+        return;
+    }
+    memset(st,0,sizeof(st));
+    res = open_walker(fd,&alone,&error);
+    if (res == DW_DLV_OK) {
+        res = next_cu(&alone,&error);
+    }
+    while (res == DW_DLV_OK && !alone.w_done) {
+        res = step(&alone,&st[0],&error);
+    }
+    if (res == DW_DLV_ERROR) {
+        report(&alone,error,__LINE__);
+    }
+    dwarf_finish(alone.w_dbg);
+    if (res != DW_DLV_OK) {
+        close(fd);
+        return;
+    }
+    check("DIEs seen",1,alone.w_diecount > 10,__LINE__);
+
+    memset(st,0,sizeof(st));
+    memset(w,0,sizeof(w));
+    for (i = 0; i < 2 && res == DW_DLV_OK; ++i) {
+        res = open_walker(fd,&w[i],&error);
+    }
+    /*  dwarf_init_b() finds the file size with a seek,
+        reading must not move the offset. */
+    lseek(fd,FD_MARK,SEEK_SET);
+    for (i = 0; i < 2 && res == DW_DLV_OK; ++i) {
+        res = next_cu(&w[i],&error);
+        if (res == DW_DLV_ERROR) {
+            report(&w[i],error,__LINE__);
+        }
+    }
+    while (res == DW_DLV_OK && !(w[0].w_done && w[1].w_done)) {
+        for (i = 0; i < 2 && res == DW_DLV_OK; ++i) {
+            if (!w[i].w_done) {
+                res = step(&w[i],&st[i],&error);
+                if (res == DW_DLV_ERROR) {
+                    report(&w[i],error,__LINE__);
+                }
+            }
+        }
+    }
+#ifdef HAVE_PREAD
+    check("fd offset unchanged",FD_MARK,
+        (Dwarf_Unsigned)lseek(fd,0,SEEK_CUR),__LINE__);
+#endif /* HAVE_PREAD */
+    for (i = 0; i < 2; ++i) {
+        check("DIE count",alone.w_diecount,w[i].w_diecount,
+            __LINE__);
+        check("DIE offset sum",alone.w_offsetsum,
+            w[i].w_offsetsum,__LINE__);
+        while (st[i].s_depth) {
+            dwarf_dealloc_die(st[i].s_die[--st[i].s_depth]);
+        }
+        if (w[i].w_die) {
+            dwarf_dealloc_die(w[i].w_die);
+        }
+        if (w[i].w_dbg) {
+            dwarf_finish(w[i].w_dbg);
+        }
+    }
+    close(fd);
+}
+
+static unsigned long
+get_le(const unsigned char *p,int len)
+{
+    unsigned long v = 0;
+
+    while (len--) {
+        v = (v << 8) | p[len];
+    }
+    return v;
+}
+
+/*  The section headers of a PE file read with stdio,
+    long names looked up in the COFF string table,
+    against what libdwarf reports.
+    libdwarf section 0 is the empty one, so PE
+    section i is libdwarf section i+1. */
+static void
+check_pe_sections(int argc,char **argv,const char *name)
+{
+    static unsigned char file[100000];
+    size_t filesize = 0;
+    unsigned long pe = 0;
+    unsigned long nsec = 0;
+    unsigned long strtab = 0;
+    unsigned long sh = 0;
+    unsigned long i = 0;
+    FILE *fin = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (build_path(argc,argv,name)) {
+        ++errcount;
+        return;
+    }
+    fin = fopen(pathbuf,"rb");
+    if (!fin) {
+        printf("FAIL cannot open %s\n",pathbuf);
+        ++errcount;
+        return;
+    }
+    filesize = fread(file,1,sizeof(file),fin);
+    fclose(fin);
+    pe = get_le(file+0x3c,4);
+    if (filesize == sizeof(file) || pe+24 > filesize) {
+        printf("FAIL %s not a small PE file\n",pathbuf);
+        ++errcount;
+        return;
+    }
+    nsec = get_le(file+pe+6,2);
+    strtab = get_le(file+pe+12,4) + 18*get_le(file+pe+16,4);
+    sh = pe + 24 + get_le(file+pe+20,2);
+    res = dwarf_init_path(pathbuf,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",pathbuf,res);
+        ++errcount;
+        return;
+    }
+    check("section count",nsec+1,dwarf_get_section_count(dbg),
+        __LINE__);
+    for (i = 0; i < nsec && sh + 40*(i+1) <= filesize; ++i) {
+        unsigned char *hdr = file + sh + 40*i;
+        char pename[9];
+        const char *secname = pename;
+        const char *dwname = 0;
+        Dwarf_Addr addr = 0;
+        Dwarf_Unsigned size = 0;
+        Dwarf_Unsigned flags = 0;
+        Dwarf_Unsigned offset = 0;
+
+        memcpy(pename,hdr,8);
+        pename[8] = 0;
+        if (pename[0] == '/') {
+            unsigned long soff = 0;
+            const char *cp = pename+1;
+
+            for ( ; *cp; ++cp) {
+                soff = soff*10 + (unsigned long)(*cp - '0');
+            }
+            if (strtab + soff >= filesize) {
+                printf("FAIL bad long name %s\n",pename);
+                ++errcount;
+                break;
+            }
+            secname = (const char *)file + strtab + soff;
+        }
+        res = dwarf_get_section_info_by_index_a(dbg,(int)i+1,
+            &dwname,&addr,&size,&flags,&offset,&error);
+        if (res != DW_DLV_OK) {
+            printf("FAIL section %lu res %d\n",i+1,res);
+            ++errcount;
+            break;
+        }
+        if (strcmp(dwname,secname)) {
+            printf("FAIL section %lu name %s, header says %s\n",
+                i+1,dwname,secname);
+            ++errcount;
+        }
+        check("section size",get_le(hdr+8,4),size,__LINE__);
+    }
+    dwarf_finish(dbg);
+}
+
+int
+main(int argc,char **argv)
+{
+    check_shared(argc,argv,"/test/dummyexecutable.debug");
+    check_shared(argc,argv,"/test/testobjLE32PE.exe");
+    check_pe_sections(argc,argv,"/test/testobjLE32PE.exe");
+    if (errcount) {
+        printf("FAIL test_shared_fd %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_shared_fd\n");
+    return 0;
+}
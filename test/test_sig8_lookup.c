@@ -0,0 +1,298 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_find_die_given_sig8() with many type
+    units.  A DWARF5 .debug_info of TUCOUNT type units,
+    with a compile unit after every tenth, is built in
+    memory (as in jitreader.c).  The signatures differ
+    in only a few bits, and two type units share one
+    signature.  Each signature must give the type DIE
+    of its unit (the first of the two for the shared
+    one), looked up in a scrambled order on a fresh
+    Dwarf_Debug and after a partial walk of the units.
+    Signatures not present must give DW_DLV_NO_ENTRY. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h" /* TRUE FALSE */
+#include "testutil.h"
+
+#define TUCOUNT 400
+/*  The type unit whose signature is also that of
+    the type unit before it. */
+#define DUPTU 77
+
+static Dwarf_Small abbrevbytes[] = {
+/* 1: DW_TAG_type_unit, children, no attributes */
+0x01, 0x41, 0x01, 0x00, 0x00,
+/* 2: DW_TAG_base_type, no children, DW_AT_byte_size data2 */
+0x02, 0x24, 0x00, 0x0b, 0x05, 0x00, 0x00,
+/* 3: DW_TAG_compile_unit, no children, DW_AT_name string */
+0x03, 0x11, 0x00, 0x03, 0x08, 0x00, 0x00,
+0x00 };
+static Dwarf_Small infobytes[TUCOUNT*50];
+
+#define SECCOUNT 2
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_abbrev",sizeof(abbrevbytes),abbrevbytes},
+{".debug_info",0,infobytes}
+};
+static struct testobj_s testobj;
+
+/*  The offset and byte size of the type DIE of
+    each type unit. */
+static Dwarf_Off typeoffsets[TUCOUNT];
+static Dwarf_Unsigned typesizes[TUCOUNT];
+
+static void
+put_n(Dwarf_Unsigned *off,Dwarf_Unsigned v,unsigned len)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < len; ++i) {
+        infobytes[(*off)++] = (Dwarf_Small)(v >> (8*i));
+    }
+}
+
+/*  Signatures differ only in bytes 2 and 7, so
+    they agree in most of any bits a hash takes. */
+static void
+make_sig(unsigned k,Dwarf_Sig8 *sig)
+{
+    unsigned i = 0;
+
+    if (k == DUPTU) {
+        k = DUPTU-1;
+    }
+    for (i = 0; i < 8; ++i) {
+        sig->signature[i] = (char)(0xa0+i);
+    }
+    sig->signature[2] = (char)(k & 0xff);
+    sig->signature[7] = (char)(k >> 8);
+}
+
+static void
+build_info(void)
+{
+    Dwarf_Unsigned off = 0;
+    unsigned k = 0;
+
+    for (k = 0; k < TUCOUNT; ++k) {
+        Dwarf_Unsigned unitoff = off;
+        Dwarf_Unsigned typeoffoff = 0;
+        Dwarf_Sig8 sig;
+        unsigned i = 0;
+
+        if (k%10 == 5) {
+            put_n(&off,0,4);       /* unit_length, below */
+            put_n(&off,5,2);       /* version */
+            put_n(&off,DW_UT_compile,1);
+            put_n(&off,8,1);       /* address_size */
+            put_n(&off,0,4);       /* debug_abbrev_offset */
+            put_n(&off,3,1);
+            put_n(&off,'c',1);
+            put_n(&off,0,1);
+            put_n(&unitoff,off - unitoff - 4,4);
+            unitoff = off;
+        }
+        make_sig(k,&sig);
+        put_n(&off,0,4);           /* unit_length, below */
+        put_n(&off,5,2);           /* version */
+        put_n(&off,DW_UT_type,1);
+        put_n(&off,8,1);           /* address_size */
+        put_n(&off,0,4);           /* debug_abbrev_offset */
+        for (i = 0; i < 8; ++i) {
+            put_n(&off,(Dwarf_Small)sig.signature[i],1);
+        }
+        typeoffoff = off;
+        put_n(&off,0,4);           /* type_offset, below */
+        put_n(&off,1,1);
+        /*  k%3 other types before the one signed for,
+            one after. */
+        for (i = 0; i < k%3; ++i) {
+            put_n(&off,2,1);
+            put_n(&off,i,2);
+        }
+        typeoffsets[k] = off;
+        typesizes[k] = 1000+k;
+        put_n(&typeoffoff,off - unitoff,4);
+        put_n(&off,2,1);
+        put_n(&off,typesizes[k],2);
+        put_n(&off,2,1);
+        put_n(&off,k%3,2);
+        put_n(&off,0,1);           /* end of children */
+        put_n(&unitoff,off - unitoff - 4,4);
+    }
+    sectiondata[1].ts_size = off;
+}
+
+static void
+check_sig(Dwarf_Debug dbg,unsigned k)
+{
+    /*  The first of two units with one signature
+        is the one found. */
+    unsigned expect = (k == DUPTU)? DUPTU-1:k;
+    Dwarf_Sig8 sig;
+    Dwarf_Die die = 0;
+    Dwarf_Bool is_info = FALSE;
+    Dwarf_Off off = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    make_sig(k,&sig);
+    res = dwarf_find_die_given_sig8(dbg,&sig,&die,&is_info,
+        &error);
+    check("find res",DW_DLV_OK,res,__LINE__);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            printf("FAIL %s\n",dwarf_errmsg(error));
+            dwarf_dealloc_error(dbg,error);
+        }
+        return;
+    }
+    check("is_info",TRUE,is_info,__LINE__);
+    dwarf_dieoffset(die,&off,&error);
+    check("type die offset",typeoffsets[expect],off,__LINE__);
+    res = dwarf_bytesize(die,&size,&error);
+    check("byte size res",DW_DLV_OK,res,__LINE__);
+    check("byte size",typesizes[expect],size,__LINE__);
+    dwarf_dealloc_die(die);
+}
+
+/*  Signatures next to those present. */
+static void
+check_missing(Dwarf_Debug dbg)
+{
+    Dwarf_Sig8 sig;
+    Dwarf_Die die = 0;
+    Dwarf_Bool is_info = FALSE;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    make_sig(TUCOUNT,&sig);
+    res = dwarf_find_die_given_sig8(dbg,&sig,&die,&is_info,
+        &error);
+    check("missing sig past the last",DW_DLV_NO_ENTRY,res,
+        __LINE__);
+    make_sig(3,&sig);
+    sig.signature[0] ^= 1;
+    res = dwarf_find_die_given_sig8(dbg,&sig,&die,&is_info,
+        &error);
+    check("missing sig one bit off",DW_DLV_NO_ENTRY,res,
+        __LINE__);
+    make_sig(DUPTU,&sig);
+    sig.signature[2] = (char)DUPTU;
+    res = dwarf_find_die_given_sig8(dbg,&sig,&die,&is_info,
+        &error);
+    check("missing sig of the duplicate",DW_DLV_NO_ENTRY,res,
+        __LINE__);
+}
+
+/*  Reads the first count unit headers. */
+static void
+walk_units(Dwarf_Debug dbg,unsigned count)
+{
+    unsigned n = 0;
+
+    for (n = 0; n < count; ++n) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version_stamp = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        Dwarf_Error error = 0;
+        int res = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,TRUE,&cu_die,
+            &cu_header_length,&version_stamp,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_header,
+            &header_cu_type,&error);
+        check("next cu res",DW_DLV_OK,res,__LINE__);
+        if (res != DW_DLV_OK) {
+            if (res == DW_DLV_ERROR) {
+                printf("FAIL %s\n",dwarf_errmsg(error));
+                dwarf_dealloc_error(dbg,error);
+            }
+            return;
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+}
+
+/*  walked: how many unit headers to read first. */
+static void
+check_all(unsigned walked)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    unsigned n = 0;
+    int res = 0;
+
+    res = testobj_init(&testobj,sectiondata,SECCOUNT,
+        &dbg,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL testobj_init res %d\n",res);
+        ++errcount;
+        return;
+    }
+    walk_units(dbg,walked);
+    for (n = 0; n < TUCOUNT; ++n) {
+        /*  241 is prime, so every unit is looked up. */
+        check_sig(dbg,(n*241 + 17)%TUCOUNT);
+    }
+    check_missing(dbg);
+    dwarf_object_finish(dbg);
+}
+
+int
+main(void)
+{
+    build_info();
+    check_all(0);
+    check_all(TUCOUNT/3);
+    if (errcount) {
+        printf("FAIL test_sig8_lookup %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_sig8_lookup\n");
+    return 0;
+}
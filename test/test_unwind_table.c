@@ -0,0 +1,596 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_make_unwind_table() and
+    dwarf_lookup_unwind_table().  A table is made
+    for each object's FDEs, written to a temporary
+    file and read back into new memory.  At every pc
+    of every FDE, and around them, a lookup in the
+    table read back must give the rules that
+    dwarf_get_fde_info_for_all_regs3_b() gives for
+    the pc, or DW_DLV_NO_ENTRY where no usable FDE
+    covers the pc.  After dwarf_finish() the lookups
+    must still match those in the original table.
+
+    The FDEs are the hand-made .debug_frame of
+    test_fde_rows.c, including an FDE that cannot be
+    evaluated past its second row, and the .eh_frame
+    of test/dummyexecutable and
+    test/testuriLE64ELf.testme.
+
+    ./test_unwind_table -f <path to source tree>
+    or with DWTOPSRCDIR set in the environment. */
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fread() fwrite() printf() tmpfile() */
+#include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memcmp() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+static Dwarf_Half columns[] = {3,6,12};
+#define COLUMNCOUNT (sizeof(columns)/sizeof(columns[0]))
+
+static Dwarf_Small framebytes[] = {
+/* CIE version 1, "", code align 1, data align -8, ra 16 */
+0x14, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff,
+0x01, 0x00, 0x01, 0x78, 0x10,
+0x0c, 0x07, 0x08,       /* DW_CFA_def_cfa r7 8 */
+0x90, 0x01,             /* DW_CFA_offset r16 1 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* FDE 0x1000..0x1040 */
+0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x41,                   /* DW_CFA_advance_loc 1 */
+0x0e, 0x10,             /* DW_CFA_def_cfa_offset 16 */
+0x86, 0x02,             /* DW_CFA_offset r6 2 */
+0x43,                   /* DW_CFA_advance_loc 3 */
+0x0d, 0x06,             /* DW_CFA_def_cfa_register r6 */
+0x0a,                   /* DW_CFA_remember_state */
+0x60,                   /* DW_CFA_advance_loc 32 */
+0x0c, 0x07, 0x08,       /* DW_CFA_def_cfa r7 8 */
+0xc6,                   /* DW_CFA_restore r6 */
+0x10, 0x03, 0x02, 0x70, 0x00, /* DW_CFA_expression r3 breg0 0 */
+0x44,                   /* DW_CFA_advance_loc 4 */
+0x0b,                   /* DW_CFA_restore_state */
+0x00, 0x00, 0x00,
+/* FDE 0x2000..0x2030 */
+0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* DW_CFA_set_loc 0x2010 */
+0x01, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x18,             /* DW_CFA_def_cfa_offset 24 */
+/* DW_CFA_set_loc 0x2008, going backwards */
+0x01, 0x08, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x83, 0x03,             /* DW_CFA_offset r3 3 */
+/* DW_CFA_set_loc 0x2020 */
+0x01, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0e, 0x20,             /* DW_CFA_def_cfa_offset 32 */
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+/* FDE 0x3000..0x3020 */
+0x2c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x42,                   /* DW_CFA_advance_loc 2 */
+0x0e, 0x10,             /* DW_CFA_def_cfa_offset 16 */
+/* DW_CFA_set_loc 0x3008 */
+0x01, 0x08, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x86, 0x02,             /* DW_CFA_offset r6 2 */
+0x48,                   /* DW_CFA_advance_loc 8 */
+0x08, 0x06,             /* DW_CFA_same_value r6 */
+0x07, 0x03,             /* DW_CFA_undefined r3 */
+0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+#define SECCOUNT 1
+static struct testobj_section_s sectiondata[SECCOUNT] = {
+{".debug_frame",sizeof(framebytes),framebytes}
+};
+static struct testobj_s testobj;
+
+/*  Converts a rule as dwarf_make_unwind_table()
+    documents it. */
+static void
+convert_rule(Dwarf_Regtable_Entry3 *entry,Dwarf_Half column,
+    Dwarf_Half same_value,Dwarf_Half undefined_value,
+    Dwarf_Unwind_Rule *out)
+{
+    memset(out,0,sizeof(*out));
+    out->ur_column = column;
+    switch (entry->dw_value_type) {
+    case DW_EXPR_OFFSET:
+        if (entry->dw_offset_relevant) {
+            out->ur_kind = DW_UNWIND_OFFSET;
+            out->ur_offset = (Dwarf_Signed)entry->dw_offset;
+        } else if (entry->dw_regnum == same_value) {
+            out->ur_kind = DW_UNWIND_SAME_VALUE;
+        } else if (entry->dw_regnum == undefined_value) {
+            out->ur_kind = DW_UNWIND_UNDEFINED;
+        } else {
+            out->ur_kind = DW_UNWIND_REGISTER;
+            out->ur_register = entry->dw_regnum;
+        }
+        break;
+    case DW_EXPR_VAL_OFFSET:
+        out->ur_kind = DW_UNWIND_VAL_OFFSET;
+        out->ur_offset = (Dwarf_Signed)entry->dw_offset;
+        break;
+    case DW_EXPR_VAL_EXPRESSION:
+        out->ur_kind = DW_UNWIND_VAL_EXPRESSION;
+        break;
+    default:
+        out->ur_kind = DW_UNWIND_EXPRESSION;
+        break;
+    }
+}
+
+/*  The object being checked. */
+struct frames_s {
+    Dwarf_Debug     fr_dbg;
+    int             fr_in_memory;
+    Dwarf_Cie      *fr_cies;
+    Dwarf_Signed    fr_cie_count;
+    Dwarf_Fde      *fr_fdes;
+    Dwarf_Signed    fr_fde_count;
+    Dwarf_Regtable3 fr_regtab;
+    Dwarf_Half      fr_cfa_col;
+    Dwarf_Half      fr_same_value;
+    Dwarf_Half      fr_undefined_value;
+    /*  Per FDE: its range and whether the table
+        is expected to hold it. */
+    Dwarf_Addr     *fr_low;
+    Dwarf_Addr     *fr_high;
+    int            *fr_used;
+};
+
+static int
+open_frames(const char *path,struct frames_s *f)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned rulecount = 0;
+    int res = 0;
+
+    memset(f,0,sizeof(*f));
+    if (path) {
+        res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+            0,0,&f->fr_dbg,&error);
+    } else {
+        f->fr_in_memory = 1;
+        res = testobj_init(&testobj,sectiondata,SECCOUNT,
+            &f->fr_dbg,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s res %d\n",
+            path?path:"in-memory object",res);
+        f->fr_dbg = 0;
+        return res;
+    }
+    if (path) {
+        res = dwarf_get_fde_list_eh(f->fr_dbg,&f->fr_cies,
+            &f->fr_cie_count,&f->fr_fdes,&f->fr_fde_count,&error);
+    } else {
+        res = dwarf_get_fde_list(f->fr_dbg,&f->fr_cies,
+            &f->fr_cie_count,&f->fr_fdes,&f->fr_fde_count,&error);
+    }
+    if (res != DW_DLV_OK) {
+        printf("FAIL getting FDEs res %d %s\n",res,
+            res == DW_DLV_ERROR?dwarf_errmsg(error):"");
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(f->fr_dbg,error);
+        }
+        f->fr_fdes = 0;
+        return DW_DLV_ERROR;
+    }
+    rulecount = dwarf_set_frame_rule_table_size(f->fr_dbg,1);
+    dwarf_set_frame_rule_table_size(f->fr_dbg,
+        (Dwarf_Half)rulecount);
+    f->fr_cfa_col = dwarf_set_frame_cfa_value(f->fr_dbg,1);
+    dwarf_set_frame_cfa_value(f->fr_dbg,f->fr_cfa_col);
+    f->fr_same_value = dwarf_set_frame_same_value(f->fr_dbg,1);
+    dwarf_set_frame_same_value(f->fr_dbg,f->fr_same_value);
+    f->fr_undefined_value =
+        dwarf_set_frame_undefined_value(f->fr_dbg,1);
+    dwarf_set_frame_undefined_value(f->fr_dbg,
+        f->fr_undefined_value);
+    f->fr_regtab.rt3_reg_table_size = (Dwarf_Half)rulecount;
+    f->fr_regtab.rt3_rules = (struct Dwarf_Regtable_Entry3_s *)
+        calloc(rulecount,sizeof(struct Dwarf_Regtable_Entry3_s));
+    f->fr_low = (Dwarf_Addr *)calloc((size_t)f->fr_fde_count+1,
+        sizeof(Dwarf_Addr));
+    f->fr_high = (Dwarf_Addr *)calloc((size_t)f->fr_fde_count+1,
+        sizeof(Dwarf_Addr));
+    f->fr_used = (int *)calloc((size_t)f->fr_fde_count+1,
+        sizeof(int));
+    if (!f->fr_regtab.rt3_rules || !f->fr_low || !f->fr_high ||
+        !f->fr_used) {
+        printf("FAIL out of memory\n");
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+static void
+close_frames(struct frames_s *f)
+{
+    free(f->fr_regtab.rt3_rules);
+    free(f->fr_low);
+    free(f->fr_high);
+    free(f->fr_used);
+    if (!f->fr_dbg) {
+        return;
+    }
+    if (f->fr_fdes) {
+        dwarf_dealloc_fde_cie_list(f->fr_dbg,f->fr_cies,
+            f->fr_cie_count,f->fr_fdes,f->fr_fde_count);
+    }
+    if (f->fr_in_memory) {
+        dwarf_object_finish(f->fr_dbg);
+    } else {
+        dwarf_finish(f->fr_dbg);
+    }
+    f->fr_dbg = 0;
+}
+
+/*  Gets the expected row of FDE i at pc.
+    Returns DW_DLV_NO_ENTRY if the rules for pc
+    cannot be found. */
+static int
+expected_row(struct frames_s *f,Dwarf_Signed i,Dwarf_Addr pc,
+    Dwarf_Unwind_Rule *rules)
+{
+    Dwarf_Regtable3 *rt = &f->fr_regtab;
+    Dwarf_Fde fde = f->fr_fdes[i];
+    Dwarf_Cie cie = 0;
+    Dwarf_Unsigned bytes_in_cie = 0;
+    Dwarf_Small version = 0;
+    char *augmenter = 0;
+    Dwarf_Unsigned code_align = 0;
+    Dwarf_Signed data_align = 0;
+    Dwarf_Half ra = 0;
+    Dwarf_Small *initial = 0;
+    Dwarf_Unsigned initial_len = 0;
+    Dwarf_Half offset_size = 0;
+    Dwarf_Addr row_pc = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned c = 0;
+    int res = 0;
+
+    memset(&rt->rt3_cfa_rule,0,sizeof(rt->rt3_cfa_rule));
+    memset(rt->rt3_rules,0,rt->rt3_reg_table_size*
+        sizeof(struct Dwarf_Regtable_Entry3_s));
+    res = dwarf_get_fde_info_for_all_regs3(fde,pc,rt,
+        &row_pc,&error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_get_cie_of_fde(fde,&cie,&error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_get_cie_info_b(cie,&bytes_in_cie,&version,
+            &augmenter,&code_align,&data_align,&ra,
+            &initial,&initial_len,&offset_size,&error);
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(f->fr_dbg,error);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    memset(&rules[0],0,sizeof(rules[0]));
+    rules[0].ur_column = f->fr_cfa_col;
+    if (rt->rt3_cfa_rule.dw_value_type != DW_EXPR_OFFSET) {
+        rules[0].ur_kind = DW_UNWIND_EXPRESSION;
+    } else if (rt->rt3_cfa_rule.dw_regnum !=
+        f->fr_same_value &&
+        rt->rt3_cfa_rule.dw_regnum != f->fr_undefined_value) {
+        rules[0].ur_kind = DW_UNWIND_CFA_REG_OFFSET;
+        rules[0].ur_register = rt->rt3_cfa_rule.dw_regnum;
+        rules[0].ur_offset =
+            (Dwarf_Signed)rt->rt3_cfa_rule.dw_offset;
+    }
+    if (ra < rt->rt3_reg_table_size) {
+        convert_rule(&rt->rt3_rules[ra],ra,f->fr_same_value,
+            f->fr_undefined_value,&rules[1]);
+    } else {
+        memset(&rules[1],0,sizeof(rules[1]));
+        rules[1].ur_column = ra;
+    }
+    for (c = 0; c < COLUMNCOUNT; ++c) {
+        convert_rule(&rt->rt3_rules[columns[c]],columns[c],
+            f->fr_same_value,f->fr_undefined_value,
+            &rules[2+c]);
+    }
+    return DW_DLV_OK;
+}
+
+/*  Marks the FDEs the table should hold: those
+    not overlapping an earlier one and with every
+    pc evaluable. */
+static void
+mark_used_fdes(struct frames_s *f)
+{
+    Dwarf_Unwind_Rule rules[2+COLUMNCOUNT];
+    Dwarf_Addr last_end = 0;
+    int have_end = 0;
+    Dwarf_Signed i = 0;
+
+    for (i = 0; i < f->fr_fde_count; ++i) {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Error error = 0;
+        Dwarf_Addr pc = 0;
+
+        if (dwarf_get_fde_range(f->fr_fdes[i],&f->fr_low[i],
+            &len,0,0,0,0,0,&error) != DW_DLV_OK) {
+            printf("FAIL no range for FDE %d\n",(int)i);
+            ++errcount;
+            continue;
+        }
+        f->fr_high[i] = f->fr_low[i] + len;
+        if (f->fr_high[i] <= f->fr_low[i] ||
+            (have_end && f->fr_low[i] < last_end)) {
+            continue;
+        }
+        f->fr_used[i] = 1;
+        for (pc = f->fr_low[i]; pc < f->fr_high[i]; ++pc) {
+            if (expected_row(f,i,pc,rules) != DW_DLV_OK) {
+                f->fr_used[i] = 0;
+                break;
+            }
+        }
+        if (f->fr_used[i]) {
+            have_end = 1;
+            last_end = f->fr_high[i];
+        }
+    }
+}
+
+/*  Writes the table to a temporary file and reads it
+    back into new memory, as a saved table would be. */
+static void *
+write_and_read_back(void *table,Dwarf_Unsigned size)
+{
+    FILE *f = tmpfile();
+    void *copy = 0;
+
+    if (!f) {
+        printf("FAIL cannot create a temporary file\n");
+        return 0;
+    }
+    if (fwrite(table,1,(size_t)size,f) != (size_t)size) {
+        printf("FAIL writing the unwind table\n");
+        fclose(f);
+        return 0;
+    }
+    rewind(f);
+    /*  malloc() memory is suitably aligned for any
+        type, so 8 byte aligned. */
+    copy = malloc((size_t)size);
+    if (!copy) {
+        printf("FAIL out of memory\n");
+        fclose(f);
+        return 0;
+    }
+    if (fread(copy,1,(size_t)size,f) != (size_t)size) {
+        printf("FAIL reading the unwind table back\n");
+        free(copy);
+        copy = 0;
+    }
+    fclose(f);
+    return copy;
+}
+
+static void
+check_pc(const char *name,struct frames_s *f,
+    void *table,Dwarf_Unsigned size,Dwarf_Addr pc)
+{
+    Dwarf_Unwind_Rule expect[2+COLUMNCOUNT];
+    const Dwarf_Unwind_Rule *rules = 0;
+    Dwarf_Unsigned rule_count = 0;
+    Dwarf_Addr row_pc = 0;
+    Dwarf_Addr next_row_pc = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Signed i = 0;
+    int eres = DW_DLV_NO_ENTRY;
+    int res = 0;
+
+    for (i = 0; i < f->fr_fde_count; ++i) {
+        if (f->fr_used[i] && pc >= f->fr_low[i] &&
+            pc < f->fr_high[i]) {
+            eres = expected_row(f,i,pc,expect);
+            if (eres == DW_DLV_OK &&
+                expect[0].ur_kind == DW_UNWIND_UNDEFINED) {
+                eres = DW_DLV_NO_ENTRY;
+            }
+            break;
+        }
+    }
+    res = dwarf_lookup_unwind_table(table,size,pc,&row_pc,
+        &next_row_pc,&rules,&rule_count,&error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL %s pc 0x%llx: %s\n",name,
+            (unsigned long long)pc,dwarf_errmsg(error));
+        dwarf_dealloc_error(0,error);
+        ++errcount;
+        return;
+    }
+    if (res != eres) {
+        printf("FAIL %s pc 0x%llx res %d expected %d\n",name,
+            (unsigned long long)pc,res,eres);
+        ++errcount;
+        return;
+    }
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    if (rule_count != 2+COLUMNCOUNT ||
+        row_pc > pc || next_row_pc <= pc ||
+        memcmp(rules,expect,sizeof(expect))) {
+        printf("FAIL %s pc 0x%llx rules differ, row 0x%llx"
+            " next 0x%llx\n",name,(unsigned long long)pc,
+            (unsigned long long)row_pc,
+            (unsigned long long)next_row_pc);
+        ++errcount;
+    }
+}
+
+/*  The same answer from both tables. */
+static void
+compare_tables(const char *name,void *t1,Dwarf_Unsigned s1,
+    void *t2,Dwarf_Unsigned s2,Dwarf_Addr pc)
+{
+    const Dwarf_Unwind_Rule *r1 = 0;
+    const Dwarf_Unwind_Rule *r2 = 0;
+    Dwarf_Unsigned c1 = 0;
+    Dwarf_Unsigned c2 = 0;
+    Dwarf_Addr p1 = 0;
+    Dwarf_Addr p2 = 0;
+    Dwarf_Addr n1 = 0;
+    Dwarf_Addr n2 = 0;
+    int res1 = 0;
+    int res2 = 0;
+
+    res1 = dwarf_lookup_unwind_table(t1,s1,pc,&p1,&n1,&r1,
+        &c1,0);
+    res2 = dwarf_lookup_unwind_table(t2,s2,pc,&p2,&n2,&r2,
+        &c2,0);
+    if (res1 != res2 || (res1 == DW_DLV_OK &&
+        (p1 != p2 || n1 != n2 || c1 != c2 ||
+        memcmp(r1,r2,(size_t)c1*sizeof(Dwarf_Unwind_Rule))))) {
+        printf("FAIL %s pc 0x%llx differs after dwarf_finish\n",
+            name,(unsigned long long)pc);
+        ++errcount;
+    }
+}
+
+static void
+check_frames(const char *name,const char *path,
+    Dwarf_Signed minfdes)
+{
+    struct frames_s f;
+    void *table = 0;
+    void *copy = 0;
+    const Dwarf_Unwind_Rule *rules = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Addr lowest = ~(Dwarf_Addr)0;
+    Dwarf_Addr highest = 0;
+    Dwarf_Addr pc = 0;
+    Dwarf_Signed i = 0;
+    int used = 0;
+    int res = 0;
+
+    if (open_frames(path,&f) != DW_DLV_OK) {
+        ++errcount;
+        close_frames(&f);
+        return;
+    }
+    if (f.fr_fde_count < minfdes) {
+        printf("FAIL %s has %d FDEs\n",name,(int)f.fr_fde_count);
+        ++errcount;
+    }
+    mark_used_fdes(&f);
+    res = dwarf_make_unwind_table(f.fr_fdes,f.fr_fde_count,
+        columns,COLUMNCOUNT,&table,&size,&error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s dwarf_make_unwind_table res %d %s\n",
+            name,res,res == DW_DLV_ERROR?dwarf_errmsg(error):"");
+        ++errcount;
+        close_frames(&f);
+        return;
+    }
+    copy = write_and_read_back(table,size);
+    if (!copy) {
+        ++errcount;
+        dwarf_dealloc_unwind_table(table);
+        close_frames(&f);
+        return;
+    }
+    for (i = 0; i < f.fr_fde_count; ++i) {
+        if (!f.fr_used[i]) {
+            continue;
+        }
+        ++used;
+        if (f.fr_low[i] < lowest) {
+            lowest = f.fr_low[i];
+        }
+        if (f.fr_high[i] > highest) {
+            highest = f.fr_high[i];
+        }
+    }
+    if (!used) {
+        printf("FAIL %s no FDE is usable\n",name);
+        ++errcount;
+    }
+    /*  Every pc of every FDE, the gaps between them
+        and a little either side. */
+    if (used) {
+        lowest = lowest > 16? lowest-16:0;
+        for (pc = lowest; pc < highest+16; ++pc) {
+            check_pc(name,&f,copy,size,pc);
+        }
+    }
+    res = dwarf_lookup_unwind_table(copy,size-1,lowest,0,0,
+        &rules,0,&error);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,error);
+    } else {
+        printf("FAIL %s truncated table accepted\n",name);
+        ++errcount;
+    }
+    close_frames(&f);
+    /*  No Dwarf_Debug is needed to use a table. */
+    for (pc = lowest; used && pc < highest+16; ++pc) {
+        compare_tables(name,table,size,copy,size,pc);
+    }
+    free(copy);
+    dwarf_dealloc_unwind_table(table);
+}
+
+int
+main(int argc,char **argv)
+{
+    check_frames("in-memory",0,3);
+    if (build_path(argc,argv,"/test/dummyexecutable")) {
+        return 1;
+    }
+    check_frames("dummyexecutable",pathbuf,5);
+    if (build_path(argc,argv,"/test/testuriLE64ELf.testme")) {
+        return 1;
+    }
+    check_frames("testuriLE64ELf.testme",pathbuf,3);
+    if (errcount) {
+        printf("FAIL test_unwind_table %d errors\n",errcount);
+        return 1;
+    }
+    printf("PASS test_unwind_table\n");
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* getenv() */
+#include <string.h> /* memcpy() memset() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "testutil.h"
+
+int errcount;
+char pathbuf[2000];
+
+void
+check(const char *msg,Dwarf_Unsigned expect,
+    Dwarf_Unsigned got,int line)
+{
+    if (expect == got) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s expected %llu got %llu line %d\n",
+        msg,(unsigned long long)expect,
+        (unsigned long long)got,line);
+}
+
+int
+build_path(int argc,char **argv,const char *name)
+{
+    const char *base = 0;
+    size_t baselen = 0;
+    size_t namelen = strlen(name);
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        base = argv[2];
+    } else if (argc > 1) {
+        printf("Expected -f <path to source tree>\n");
+        return 1;
+    } else {
+        base = getenv("DWTOPSRCDIR");
+        if (!base) {
+            printf("Expected environment variable "
+                "DWTOPSRCDIR with path of "
+                "base directory (usually called 'code')\n");
+            return 1;
+        }
+    }
+    baselen = strlen(base);
+    if (baselen + namelen + 1 > sizeof(pathbuf)) {
+        printf("FAIL path too long: %s\n",base);
+        return 1;
+    }
+    memcpy(pathbuf,base,baselen);
+    memcpy(pathbuf+baselen,name,namelen+1);
+    return 0;
+}
+
+static int
+tsinfo(void *obj,Dwarf_Unsigned section_index,
+    Dwarf_Obj_Access_Section_a *return_section,
+    int *error)
+{
+    struct testobj_s *to = (struct testobj_s *)obj;
+    struct testobj_section_s *s = 0;
+
+    *error = 0;
+    if (section_index > to->to_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    memset(return_section,0,sizeof(*return_section));
+    return_section->as_name = "";
+    return_section->as_entrysize = 1;
+    if (!section_index) {
+        return DW_DLV_OK;
+    }
+    s = to->to_sections + section_index - 1;
+    return_section->as_name = s->ts_name;
+    return_section->as_size = s->ts_size;
+    return DW_DLV_OK;
+}
+static Dwarf_Small
+tborder(void *obj)
+{
+    (void)obj;
+    return DW_END_little;
+}
+static Dwarf_Small
+tlensize(void *obj)
+{
+    (void)obj;
+    return 4;
+}
+static Dwarf_Small
+tptrsize(void *obj)
+{
+    (void)obj;
+    return 8;
+}
+static Dwarf_Unsigned
+tfilesize(void *obj)
+{
+    struct testobj_s *to = (struct testobj_s *)obj;
+    Dwarf_Unsigned total = 0;
+    unsigned i = 0;
+
+    for (i = 0; i < to->to_count; ++i) {
+        total += to->to_sections[i].ts_size;
+    }
+    return total;
+}
+static Dwarf_Unsigned
+tseccount(void *obj)
+{
+    struct testobj_s *to = (struct testobj_s *)obj;
+
+    return to->to_count + 1;
+}
+static int
+tloadsec(void *obj,Dwarf_Unsigned secindex,
+    Dwarf_Small **rdata,int *error)
+{
+    struct testobj_s *to = (struct testobj_s *)obj;
+
+    *error = 0;
+    if (!secindex || secindex > to->to_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *rdata = to->to_sections[secindex-1].ts_content;
+    return DW_DLV_OK;
+}
+
+static const Dwarf_Obj_Access_Methods_a testobj_methods = {
+    tsinfo,tborder,tlensize,tptrsize,tfilesize,
+    tseccount,tloadsec,0,0,0
+};
+
+int
+testobj_init(struct testobj_s *obj,
+    struct testobj_section_s *sections,
+    unsigned count,
+    Dwarf_Debug *dbg,
+    Dwarf_Error *error)
+{
+    obj->to_sections = sections;
+    obj->to_count = count;
+    obj->to_interface.ai_object = obj;
+    obj->to_interface.ai_methods = &testobj_methods;
+    return dwarf_object_init_b(&obj->to_interface,0,0,
+        DW_GROUPNUMBER_ANY,dbg,error);
+}
@@ -0,0 +1,90 @@
+/*
+  Copyright 2026 agent. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Shared by the libdwarf tests in this directory:
+    failure counting, the path of a test object in
+    the source tree, and a Dwarf_Debug read from
+    sections in memory (as in jitreader.c). */
+
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  The count of failed checks. */
+extern int errcount;
+
+/*  Set by build_path(). */
+extern char pathbuf[2000];
+
+/*  Counts and reports a failure unless
+    expect == got. */
+void check(const char *msg,Dwarf_Unsigned expect,
+    Dwarf_Unsigned got,int line);
+
+/*  Sets pathbuf to name appended to the source tree
+    path given by -f <path> or by DWTOPSRCDIR
+    in the environment.
+    Returns 0 on success, else 1 after
+    reporting why. */
+int build_path(int argc,char **argv,const char *name);
+
+/*  A section of an in-memory object. */
+struct testobj_section_s {
+    const char    *ts_name;
+    Dwarf_Unsigned ts_size;
+    Dwarf_Small   *ts_content;
+};
+
+/*  An in-memory object: little-endian, 4 byte
+    offsets and 8 byte addresses. The sections
+    are numbered from 1 (section 0 is the usual
+    empty one). The section array and this struct
+    must stay in place until dwarf_object_finish(),
+    though the sections may be altered before
+    they are loaded. */
+struct testobj_s {
+    struct testobj_section_s    *to_sections;
+    unsigned                     to_count;
+    Dwarf_Obj_Access_Interface_a to_interface;
+};
+
+/*  dwarf_object_init_b() on count sections.
+    Finish with dwarf_object_finish(). */
+int testobj_init(struct testobj_s *obj,
+    struct testobj_section_s *sections,
+    unsigned count,
+    Dwarf_Debug *dbg,
+    Dwarf_Error *error);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* TESTUTIL_H */